@@ -315,7 +315,7 @@ void ColumnDecimal<T>::insertDisjunctFrom(const IColumn & src, const std::vector
 #pragma GCC diagnostic pop
 
 template <typename T>
-ColumnPtr ColumnDecimal<T>::filter(const IColumn::Filter & filt, ssize_t result_size_hint) const
+ColumnPtr ColumnDecimal<T>::filter(const IColumn::Filter & filt, ssize_t /*result_size_hint*/) const
 {
     size_t size = data.size();
     if (size != filt.size())
@@ -324,25 +324,10 @@ ColumnPtr ColumnDecimal<T>::filter(const IColumn::Filter & filt, ssize_t result_
     auto res = this->create(0, scale);
     Container & res_data = res->getData();
 
-    if (result_size_hint)
-    {
-        if (result_size_hint < 0)
-            result_size_hint = countBytesInFilter(filt);
-        res_data.reserve(result_size_hint);
-    }
-
-    const UInt8 * filt_pos = filt.data();
-    const UInt8 * filt_end = filt_pos + size;
-    const T * data_pos = data.data();
-
-    while (filt_pos < filt_end)
-    {
-        if (*filt_pos)
-            res_data.push_back(*data_pos);
-
-        ++filt_pos;
-        ++data_pos;
-    }
+    /// Allocate the result at once, so that the passed rows are copied without checking the capacity.
+    res_data.resize(countBytesInFilter(filt));
+    [[maybe_unused]] size_t copied = filterFixedSizeData(filt.data(), data.data(), size, res_data.data());
+    assert(copied == res_data.size());
 
     return res;
 }
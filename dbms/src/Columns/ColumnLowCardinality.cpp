@@ -0,0 +1,340 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnLowCardinality.h>
+#include <Columns/Collator.h>
+#include <Common/Exception.h>
+#include <Common/HashTable/HashMap.h>
+#include <Common/typeid_cast.h>
+#include <DataStreams/ColumnGathererStream.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int ILLEGAL_COLUMN;
+extern const int LOGICAL_ERROR;
+} // namespace ErrorCodes
+
+ColumnLowCardinality::ColumnLowCardinality(MutableColumnPtr && dictionary_, MutableColumnPtr && indexes_)
+    : dictionary(std::move(dictionary_))
+    , indexes(std::move(indexes_))
+{
+    if (!typeid_cast<const ColumnString *>(dictionary.get()))
+        throw Exception("The dictionary of ColumnLowCardinality must be ColumnString, got " + dictionary->getName(), ErrorCodes::ILLEGAL_COLUMN);
+    if (!typeid_cast<const ColumnIndexes *>(indexes.get()))
+        throw Exception("The indexes of ColumnLowCardinality must be ColumnUInt32, got " + indexes->getName(), ErrorCodes::ILLEGAL_COLUMN);
+}
+
+MutableColumnPtr ColumnLowCardinality::tryEncode(const ColumnString & column, size_t max_dictionary_size)
+{
+    using ValueToIndex = HashMap<StringRef, Index, StringRefHash>;
+
+    const size_t rows = column.size();
+    auto new_dictionary = ColumnString::create();
+    auto new_indexes = ColumnIndexes::create();
+    auto & codes = new_indexes->getData();
+    codes.resize(rows);
+
+    ValueToIndex value_to_index;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        // The keys refer to the memory of `column`, which outlives `value_to_index`.
+        StringRef value = column.getDataAt(i);
+        ValueToIndex::LookupResult it;
+        bool inserted;
+        value_to_index.emplace(value, it, inserted);
+        if (inserted)
+        {
+            if (value_to_index.size() > max_dictionary_size)
+                return nullptr;
+            it->getMapped() = new_dictionary->size();
+            new_dictionary->insertData(value.data, value.size);
+        }
+        codes[i] = it->getMapped();
+    }
+    return ColumnLowCardinality::create(std::move(new_dictionary), std::move(new_indexes));
+}
+
+MutableColumnPtr ColumnLowCardinality::convertToFullColumn() const
+{
+    const auto & dict = getDictionary();
+    const auto & codes = getIndexesData();
+    const size_t rows = codes.size();
+
+    size_t total_bytes = 0;
+    for (size_t i = 0; i < rows; ++i)
+        total_bytes += dict.getDataAtWithTerminatingZero(codes[i]).size;
+
+    auto res = ColumnString::create();
+    auto & res_chars = res->getChars();
+    auto & res_offsets = res->getOffsets();
+    res_chars.resize(total_bytes);
+    res_offsets.resize(rows);
+
+    size_t pos = 0;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        StringRef value = dict.getDataAtWithTerminatingZero(codes[i]);
+        memcpy(&res_chars[pos], value.data, value.size);
+        pos += value.size;
+        res_offsets[i] = pos;
+    }
+    return res;
+}
+
+ColumnString & ColumnLowCardinality::getDictionaryMutable()
+{
+    dictionary = (*std::move(dictionary)).mutate();
+    return static_cast<ColumnString &>(dictionary->assumeMutableRef());
+}
+
+ColumnLowCardinality::Index ColumnLowCardinality::appendToDictionary(const char * pos, size_t length)
+{
+    auto & dict = getDictionaryMutable();
+    dict.insertData(pos, length);
+    return static_cast<Index>(dict.size() - 1);
+}
+
+MutableColumnPtr ColumnLowCardinality::cloneResized(size_t new_size) const
+{
+    auto res = ColumnLowCardinality::create(dictionary->assumeMutable(), ColumnIndexes::create());
+    const size_t count = std::min(size(), new_size);
+    res->getIndexes().insertRangeFrom(*indexes, 0, count);
+    if (new_size > count)
+        res->insertManyDefaults(new_size - count);
+    return res;
+}
+
+void ColumnLowCardinality::insert(const Field & x)
+{
+    const auto & s = DB::get<const String &>(x);
+    getIndexes().getData().push_back(appendToDictionary(s.data(), s.size()));
+}
+
+void ColumnLowCardinality::insertData(const char * pos, size_t length)
+{
+    getIndexes().getData().push_back(appendToDictionary(pos, length));
+}
+
+void ColumnLowCardinality::insertDefault()
+{
+    getIndexes().getData().push_back(appendToDictionary("", 0));
+}
+
+void ColumnLowCardinality::insertManyDefaults(size_t length)
+{
+    if (length == 0)
+        return;
+    auto & codes = getIndexes().getData();
+    codes.resize_fill(codes.size() + length, appendToDictionary("", 0));
+}
+
+void ColumnLowCardinality::insertFrom(const IColumn & src, size_t n)
+{
+    const auto * src_lc = typeid_cast<const ColumnLowCardinality *>(&src);
+    if (src_lc && src_lc->dictionary.get() == dictionary.get())
+    {
+        getIndexes().getData().push_back(src_lc->getIndexAt(n));
+        return;
+    }
+    StringRef value = src.getDataAt(n);
+    getIndexes().getData().push_back(appendToDictionary(value.data, value.size));
+}
+
+void ColumnLowCardinality::insertRangeFrom(const IColumn & src, size_t start, size_t length)
+{
+    const auto * src_lc = typeid_cast<const ColumnLowCardinality *>(&src);
+    if (src_lc && src_lc->dictionary.get() == dictionary.get())
+    {
+        getIndexes().insertRangeFrom(*src_lc->indexes, start, length);
+        return;
+    }
+    if (length == 0)
+        return;
+    if (start + length > src.size())
+        throw Exception(
+            fmt::format("Parameters are out of bound in ColumnLowCardinality::insertRangeFrom method, start={}, length={}, src.size()={}", start, length, src.size()),
+            ErrorCodes::LOGICAL_ERROR);
+
+    auto & dict = getDictionaryMutable();
+    auto & codes = getIndexes().getData();
+    codes.reserve(codes.size() + length);
+    if (src_lc)
+    {
+        // Copy each used entry of the source dictionary only once.
+        static constexpr Index INVALID_INDEX = std::numeric_limits<Index>::max();
+        PaddedPODArray<Index> remap(src_lc->dictionary->size(), INVALID_INDEX);
+        const auto & src_dict = src_lc->getDictionary();
+        const auto & src_codes = src_lc->getIndexesData();
+        for (size_t i = start; i < start + length; ++i)
+        {
+            Index & code = remap[src_codes[i]];
+            if (code == INVALID_INDEX)
+            {
+                StringRef value = src_dict.getDataAt(src_codes[i]);
+                dict.insertData(value.data, value.size);
+                code = static_cast<Index>(dict.size() - 1);
+            }
+            codes.push_back(code);
+        }
+        return;
+    }
+    for (size_t i = start; i < start + length; ++i)
+    {
+        StringRef value = src.getDataAt(i);
+        dict.insertData(value.data, value.size);
+        codes.push_back(static_cast<Index>(dict.size() - 1));
+    }
+}
+
+void ColumnLowCardinality::insertManyFrom(const IColumn & src, size_t position, size_t length)
+{
+    if (length == 0)
+        return;
+    Index code;
+    const auto * src_lc = typeid_cast<const ColumnLowCardinality *>(&src);
+    if (src_lc && src_lc->dictionary.get() == dictionary.get())
+    {
+        code = src_lc->getIndexAt(position);
+    }
+    else
+    {
+        StringRef value = src.getDataAt(position);
+        code = appendToDictionary(value.data, value.size);
+    }
+    auto & codes = getIndexes().getData();
+    codes.resize_fill(codes.size() + length, code);
+}
+
+void ColumnLowCardinality::insertDisjunctFrom(const IColumn & src, const std::vector<size_t> & position_vec)
+{
+    getIndexes().getData().reserve(size() + position_vec.size());
+    for (auto position : position_vec)
+        insertFrom(src, position);
+}
+
+const char * ColumnLowCardinality::deserializeAndInsertFromArena(const char * pos, const TiDB::TiDBCollatorPtr & collator)
+{
+    auto & dict = getDictionaryMutable();
+    const char * res = dict.deserializeAndInsertFromArena(pos, collator);
+    getIndexes().getData().push_back(static_cast<Index>(dict.size() - 1));
+    return res;
+}
+
+void ColumnLowCardinality::updateHashWithValues(IColumn::HashValues & hash_values, const TiDB::TiDBCollatorPtr & collator, String & sort_key_container) const
+{
+    const auto & codes = getIndexesData();
+    for (size_t i = 0; i < codes.size(); ++i)
+        dictionary->updateHashWithValue(codes[i], hash_values[i], collator, sort_key_container);
+}
+
+void ColumnLowCardinality::updateWeakHash32(WeakHash32 & hash, const TiDB::TiDBCollatorPtr & collator, String & sort_key_container) const
+{
+    convertToFullColumn()->updateWeakHash32(hash, collator, sort_key_container);
+}
+
+ColumnPtr ColumnLowCardinality::filter(const Filter & filt, ssize_t result_size_hint) const
+{
+    return ColumnLowCardinality::create(dictionary, indexes->filter(filt, result_size_hint));
+}
+
+ColumnPtr ColumnLowCardinality::permute(const Permutation & perm, size_t limit) const
+{
+    return ColumnLowCardinality::create(dictionary, indexes->permute(perm, limit));
+}
+
+ColumnPtr ColumnLowCardinality::cut(size_t start, size_t length) const
+{
+    return ColumnLowCardinality::create(dictionary, indexes->cut(start, length));
+}
+
+ColumnPtr ColumnLowCardinality::replicateRange(size_t start_row, size_t end_row, const IColumn::Offsets & replicate_offsets) const
+{
+    return ColumnLowCardinality::create(dictionary, indexes->replicateRange(start_row, end_row, replicate_offsets));
+}
+
+int ColumnLowCardinality::compareAt(size_t n, size_t m, const IColumn & rhs_, int /*nan_direction_hint*/) const
+{
+    return getDataAtWithTerminatingZero(n).compare(rhs_.getDataAtWithTerminatingZero(m));
+}
+
+int ColumnLowCardinality::compareAt(size_t n, size_t m, const IColumn & rhs_, int /*nan_direction_hint*/, const ICollator & collator) const
+{
+    auto a = getDataAt(n);
+    auto b = rhs_.getDataAt(m);
+    return collator.compare(a.data, a.size, b.data, b.size);
+}
+
+void ColumnLowCardinality::getPermutationByRanks(const PaddedPODArray<UInt32> & ranks, bool reverse, size_t limit, Permutation & res) const
+{
+    const auto & codes = getIndexesData();
+    const size_t s = codes.size();
+    res.resize(s);
+    for (size_t i = 0; i < s; ++i)
+        res[i] = i;
+
+    if (limit >= s)
+        limit = 0;
+
+    auto less = [&](size_t a, size_t b) {
+        return reverse ? ranks[codes[a]] > ranks[codes[b]] : ranks[codes[a]] < ranks[codes[b]];
+    };
+    if (limit)
+        std::partial_sort(res.begin(), res.begin() + limit, res.end(), less);
+    else
+        std::sort(res.begin(), res.end(), less);
+}
+
+namespace
+{
+/// ranks[i] is the position of dictionary entry i after sorting the dictionary.
+PaddedPODArray<UInt32> permutationToRanks(const IColumn::Permutation & perm)
+{
+    PaddedPODArray<UInt32> ranks(perm.size());
+    for (size_t i = 0; i < perm.size(); ++i)
+        ranks[perm[i]] = i;
+    return ranks;
+}
+} // namespace
+
+void ColumnLowCardinality::getPermutation(bool reverse, size_t limit, int nan_direction_hint, Permutation & res) const
+{
+    // Sort the dictionary once instead of comparing the strings of every pair of rows.
+    Permutation dict_perm;
+    dictionary->getPermutation(false, 0, nan_direction_hint, dict_perm);
+    getPermutationByRanks(permutationToRanks(dict_perm), reverse, limit, res);
+}
+
+void ColumnLowCardinality::getPermutation(const ICollator & collator, bool reverse, size_t limit, int nan_direction_hint, Permutation & res) const
+{
+    Permutation dict_perm;
+    dictionary->getPermutation(collator, false, 0, nan_direction_hint, dict_perm);
+    getPermutationByRanks(permutationToRanks(dict_perm), reverse, limit, res);
+}
+
+void ColumnLowCardinality::gather(ColumnGathererStream & gatherer)
+{
+    gatherer.gather(*this);
+}
+
+void ColumnLowCardinality::getExtremes(Field & min, Field & max) const
+{
+    convertToFullColumn()->getExtremes(min, max);
+}
+
+} // namespace DB
@@ -0,0 +1,160 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsNumber.h>
+#include <Columns/IColumn.h>
+
+namespace DB
+{
+/// A dictionary-encoded string column. It stores the distinct values in a `ColumnString`
+/// dictionary and one UInt32 code per row pointing into the dictionary.
+///
+/// The column is logically the same as a `ColumnString`, and is only produced by the
+/// storage layer for low-cardinality string columns. Operations which only reorder or drop
+/// rows (filter/permute/cut/...) work on the codes and share the dictionary. Functions that
+/// don't know about the column get the full column via `convertToFullColumnIfLowCardinality`.
+///
+/// Note the dictionary may contain duplicated or unused values after inserting rows from
+/// other columns, so never assume two different codes mean two different values.
+class ColumnLowCardinality final : public COWPtrHelper<IColumn, ColumnLowCardinality>
+{
+private:
+    friend class COWPtrHelper<IColumn, ColumnLowCardinality>;
+
+    ColumnLowCardinality(MutableColumnPtr && dictionary_, MutableColumnPtr && indexes_);
+    ColumnLowCardinality(const ColumnLowCardinality &) = default;
+
+public:
+    using Base = COWPtrHelper<IColumn, ColumnLowCardinality>;
+    using Index = UInt32;
+    using ColumnIndexes = ColumnVector<Index>;
+
+    static Ptr create(const ColumnPtr & dictionary_, const ColumnPtr & indexes_)
+    {
+        return ColumnLowCardinality::create(dictionary_->assumeMutable(), indexes_->assumeMutable());
+    }
+
+    template <typename... Args, typename = typename std::enable_if<IsMutableColumns<Args...>::value>::type>
+    static MutablePtr create(Args &&... args)
+    {
+        return Base::create(std::forward<Args>(args)...);
+    }
+
+    /// Encode `column` with a dictionary. Returns nullptr if there are more than
+    /// `max_dictionary_size` distinct values, the caller should keep the full column then.
+    static MutableColumnPtr tryEncode(const ColumnString & column, size_t max_dictionary_size);
+
+    const char * getFamilyName() const override { return "LowCardinality"; }
+    std::string getName() const override { return "LowCardinality(" + dictionary->getName() + ")"; }
+
+    Ptr convertToFullColumnIfLowCardinality() const override { return convertToFullColumn(); }
+    /// Decode the column into a `ColumnString`.
+    MutableColumnPtr convertToFullColumn() const;
+
+    MutableColumnPtr cloneResized(size_t size) const override;
+    size_t size() const override { return indexes->size(); }
+
+    Field operator[](size_t n) const override { return (*dictionary)[getIndexAt(n)]; }
+    void get(size_t n, Field & res) const override { dictionary->get(getIndexAt(n), res); }
+    StringRef getDataAt(size_t n) const override { return dictionary->getDataAt(getIndexAt(n)); }
+    StringRef getDataAtWithTerminatingZero(size_t n) const override { return dictionary->getDataAtWithTerminatingZero(getIndexAt(n)); }
+
+    void insert(const Field & x) override;
+    void insertFrom(const IColumn & src, size_t n) override;
+    void insertRangeFrom(const IColumn & src, size_t start, size_t length) override;
+    void insertManyFrom(const IColumn & src, size_t position, size_t length) override;
+    void insertDisjunctFrom(const IColumn & src, const std::vector<size_t> & position_vec) override;
+    void insertData(const char * pos, size_t length) override;
+    void insertDefault() override;
+    void insertManyDefaults(size_t length) override;
+    void popBack(size_t n) override { getIndexes().popBack(n); }
+
+    StringRef serializeValueIntoArena(size_t n, Arena & arena, char const *& begin, const TiDB::TiDBCollatorPtr & collator, String & sort_key_container) const override
+    {
+        return dictionary->serializeValueIntoArena(getIndexAt(n), arena, begin, collator, sort_key_container);
+    }
+    const char * deserializeAndInsertFromArena(const char * pos, const TiDB::TiDBCollatorPtr & collator) override;
+
+    void updateHashWithValue(size_t n, SipHash & hash, const TiDB::TiDBCollatorPtr & collator, String & sort_key_container) const override
+    {
+        dictionary->updateHashWithValue(getIndexAt(n), hash, collator, sort_key_container);
+    }
+    void updateHashWithValues(IColumn::HashValues & hash_values, const TiDB::TiDBCollatorPtr & collator, String & sort_key_container) const override;
+    void updateWeakHash32(WeakHash32 & hash, const TiDB::TiDBCollatorPtr & collator, String & sort_key_container) const override;
+
+    ColumnPtr filter(const Filter & filt, ssize_t result_size_hint) const override;
+    ColumnPtr permute(const Permutation & perm, size_t limit) const override;
+    ColumnPtr cut(size_t start, size_t length) const override;
+
+    int compareAt(size_t n, size_t m, const IColumn & rhs_, int nan_direction_hint) const override;
+    int compareAt(size_t n, size_t m, const IColumn & rhs_, int nan_direction_hint, const ICollator & collator) const override;
+    void getPermutation(bool reverse, size_t limit, int nan_direction_hint, Permutation & res) const override;
+    void getPermutation(const ICollator & collator, bool reverse, size_t limit, int nan_direction_hint, Permutation & res) const override;
+
+    ColumnPtr replicateRange(size_t start_row, size_t end_row, const IColumn::Offsets & replicate_offsets) const override;
+
+    MutableColumns scatter(ColumnIndex num_columns, const Selector & selector) const override
+    {
+        return scatterImpl<ColumnLowCardinality>(num_columns, selector);
+    }
+
+    void scatterTo(ScatterColumns & columns, const Selector & selector) const override
+    {
+        scatterToImpl<ColumnLowCardinality>(columns, selector);
+    }
+
+    void gather(ColumnGathererStream & gatherer_stream) override;
+
+    void getExtremes(Field & min, Field & max) const override;
+
+    void reserve(size_t n) override { getIndexes().reserve(n); }
+    size_t byteSize() const override { return dictionary->byteSize() + indexes->byteSize(); }
+    size_t allocatedBytes() const override { return dictionary->allocatedBytes() + indexes->allocatedBytes(); }
+
+    void forEachSubcolumn(ColumnCallback callback) override
+    {
+        callback(dictionary);
+        callback(indexes);
+    }
+
+    bool isColumnLowCardinality() const override { return true; }
+    bool canBeInsideNullable() const override { return true; }
+
+    const ColumnString & getDictionary() const { return static_cast<const ColumnString &>(*dictionary); }
+    const ColumnPtr & getDictionaryPtr() const { return dictionary; }
+
+    ColumnIndexes & getIndexes() { return static_cast<ColumnIndexes &>(indexes->assumeMutableRef()); }
+    const ColumnIndexes & getIndexes() const { return static_cast<const ColumnIndexes &>(*indexes); }
+    const ColumnIndexes::Container & getIndexesData() const { return getIndexes().getData(); }
+
+    Index getIndexAt(size_t n) const { return getIndexesData()[n]; }
+
+private:
+    /// The dictionary may be shared with the columns created by filter/permute/..., copy it before appending.
+    ColumnString & getDictionaryMutable();
+
+    /// Append a new value to the dictionary and return its code.
+    Index appendToDictionary(const char * pos, size_t length);
+
+    /// Returns the permutation of rows sorted by `ranks` of their dictionary entries.
+    void getPermutationByRanks(const PaddedPODArray<UInt32> & ranks, bool reverse, size_t limit, Permutation & res) const;
+
+    ColumnPtr dictionary;
+    ColumnPtr indexes;
+};
+
+} // namespace DB
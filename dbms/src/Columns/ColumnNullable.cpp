@@ -122,6 +122,13 @@ void ColumnNullable::updateWeakHash32(WeakHash32 & hash, const TiDB::TiDBCollato
             hash_data[row] = old_hash_data[row];
 }
 
+ColumnPtr ColumnNullable::convertToFullColumnIfLowCardinality() const
+{
+    if (!nested_column->isColumnLowCardinality())
+        return getPtr();
+    return ColumnNullable::create(nested_column->convertToFullColumnIfLowCardinality(), null_map);
+}
+
 MutableColumnPtr ColumnNullable::cloneResized(size_t new_size) const
 {
     MutableColumnPtr new_nested_col = getNestedColumn().cloneResized(new_size);
@@ -58,6 +58,7 @@ public:
     const char * getFamilyName() const override { return "Nullable"; }
     std::string getName() const override { return "Nullable(" + nested_column->getName() + ")"; }
     MutableColumnPtr cloneResized(size_t size) const override;
+    ColumnPtr convertToFullColumnIfLowCardinality() const override;
     size_t size() const override { return nested_column->size(); }
     bool isNullAt(size_t n) const override { return static_cast<const ColumnUInt8 &>(*null_map).getData()[n] != 0; }
     Field operator[](size_t n) const override;
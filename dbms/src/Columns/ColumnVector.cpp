@@ -26,10 +26,6 @@
 #include <cstring>
 #include <ext/bit_cast.h>
 
-#if __SSE2__
-#include <emmintrin.h>
-#endif
-
 
 namespace DB
 {
@@ -204,7 +200,7 @@ void ColumnVector<T>::insertRangeFrom(const IColumn & src, size_t start, size_t
 }
 
 template <typename T>
-ColumnPtr ColumnVector<T>::filter(const IColumn::Filter & filt, ssize_t result_size_hint) const
+ColumnPtr ColumnVector<T>::filter(const IColumn::Filter & filt, ssize_t /*result_size_hint*/) const
 {
     size_t size = data.size();
     if (size != filt.size())
@@ -213,60 +209,10 @@ ColumnPtr ColumnVector<T>::filter(const IColumn::Filter & filt, ssize_t result_s
     auto res = this->create();
     Container & res_data = res->getData();
 
-    if (result_size_hint)
-    {
-        if (result_size_hint < 0)
-            result_size_hint = countBytesInFilter(filt);
-        res_data.reserve(result_size_hint);
-    }
-
-    const UInt8 * filt_pos = &filt[0];
-    const UInt8 * filt_end = filt_pos + size;
-    const T * data_pos = &data[0];
-
-#if __SSE2__
-    /** A slightly more optimized version.
-        * Based on the assumption that often pieces of consecutive values
-        *  completely pass or do not pass the filter.
-        * Therefore, we will optimistically check the parts of `SIMD_BYTES` values.
-        */
-
-    static constexpr size_t SIMD_BYTES = 16;
-    const __m128i zero16 = _mm_setzero_si128();
-    const UInt8 * filt_end_sse = filt_pos + size / SIMD_BYTES * SIMD_BYTES;
-
-    while (filt_pos < filt_end_sse)
-    {
-        int mask = _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(filt_pos)), zero16));
-
-        if (0 == mask)
-        {
-            /// Nothing is inserted.
-        }
-        else if (0xFFFF == mask)
-        {
-            res_data.insert(data_pos, data_pos + SIMD_BYTES);
-        }
-        else
-        {
-            for (size_t i = 0; i < SIMD_BYTES; ++i)
-                if (filt_pos[i])
-                    res_data.push_back(data_pos[i]);
-        }
-
-        filt_pos += SIMD_BYTES;
-        data_pos += SIMD_BYTES;
-    }
-#endif
-
-    while (filt_pos < filt_end)
-    {
-        if (*filt_pos)
-            res_data.push_back(*data_pos);
-
-        ++filt_pos;
-        ++data_pos;
-    }
+    /// Allocate the result at once, so that the passed rows are copied without checking the capacity.
+    res_data.resize(countBytesInFilter(filt));
+    [[maybe_unused]] size_t copied = filterFixedSizeData(filt.data(), data.data(), size, res_data.data());
+    assert(copied == res_data.size());
 
     return res;
 }
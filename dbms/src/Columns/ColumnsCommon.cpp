@@ -14,8 +14,10 @@
 
 #include <Columns/ColumnsCommon.h>
 #include <Columns/IColumn.h>
+#include <Common/TargetSpecific.h>
 #include <common/memcpy.h>
 
+#include <algorithm>
 #include <bit>
 
 #ifdef TIFLASH_ENABLE_AVX_SUPPORT
@@ -122,6 +124,78 @@ size_t countBytesInFilterWithNull(const IColumn::Filter & filt, const UInt8 * nu
     return CountBytesInFilterWithNull(filt, null_map, 0, filt.size());
 }
 
+namespace
+{
+/// Deal with 64 rows at a time. The 64 filter bytes are converted into a bit mask, which is vectorized
+/// by the compiler for every target. The common cases that all or none of the 64 rows pass the filter
+/// need only one comparison, otherwise only the passed rows are visited by counting the trailing zeros.
+TIFLASH_DECLARE_MULTITARGET_FUNCTION_TP(
+    (typename T),
+    (T),
+    size_t,
+    filterFixedSizeDataImpl,
+    (filt, src, size, dst),
+    (const UInt8 * __restrict filt,
+     const T * __restrict src,
+     size_t size,
+     T * __restrict dst),
+    {
+        static constexpr size_t BATCH_SIZE = 64;
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + BATCH_SIZE <= size; i += BATCH_SIZE)
+        {
+            UInt64 mask = 0;
+            for (size_t j = 0; j < BATCH_SIZE; ++j)
+                mask |= static_cast<UInt64>(filt[i + j] != 0) << j;
+
+            if (mask == 0)
+                continue;
+
+            if (mask == ~static_cast<UInt64>(0))
+            {
+                std::copy(src + i, src + i + BATCH_SIZE, dst + count);
+                count += BATCH_SIZE;
+                continue;
+            }
+
+            while (mask)
+            {
+                dst[count++] = src[i + std::countr_zero(mask)];
+                mask &= mask - 1;
+            }
+        }
+        for (; i < size; ++i)
+        {
+            if (filt[i])
+                dst[count++] = src[i];
+        }
+        return count;
+    })
+} // namespace
+
+template <typename T>
+size_t filterFixedSizeData(const UInt8 * filt, const T * src, size_t size, T * dst)
+{
+    return filterFixedSizeDataImpl<T>(filt, src, size, dst);
+}
+
+template size_t filterFixedSizeData<UInt8>(const UInt8 *, const UInt8 *, size_t, UInt8 *);
+template size_t filterFixedSizeData<UInt16>(const UInt8 *, const UInt16 *, size_t, UInt16 *);
+template size_t filterFixedSizeData<UInt32>(const UInt8 *, const UInt32 *, size_t, UInt32 *);
+template size_t filterFixedSizeData<UInt64>(const UInt8 *, const UInt64 *, size_t, UInt64 *);
+template size_t filterFixedSizeData<UInt128>(const UInt8 *, const UInt128 *, size_t, UInt128 *);
+template size_t filterFixedSizeData<Int8>(const UInt8 *, const Int8 *, size_t, Int8 *);
+template size_t filterFixedSizeData<Int16>(const UInt8 *, const Int16 *, size_t, Int16 *);
+template size_t filterFixedSizeData<Int32>(const UInt8 *, const Int32 *, size_t, Int32 *);
+template size_t filterFixedSizeData<Int64>(const UInt8 *, const Int64 *, size_t, Int64 *);
+template size_t filterFixedSizeData<Float32>(const UInt8 *, const Float32 *, size_t, Float32 *);
+template size_t filterFixedSizeData<Float64>(const UInt8 *, const Float64 *, size_t, Float64 *);
+template size_t filterFixedSizeData<Decimal32>(const UInt8 *, const Decimal32 *, size_t, Decimal32 *);
+template size_t filterFixedSizeData<Decimal64>(const UInt8 *, const Decimal64 *, size_t, Decimal64 *);
+template size_t filterFixedSizeData<Decimal128>(const UInt8 *, const Decimal128 *, size_t, Decimal128 *);
+template size_t filterFixedSizeData<Decimal256>(const UInt8 *, const Decimal256 *, size_t, Decimal256 *);
+
 std::vector<size_t> countColumnsSizeInSelector(IColumn::ColumnIndex num_columns, const IColumn::Selector & selector)
 {
     std::vector<size_t> counts(num_columns);
@@ -26,6 +26,12 @@ size_t countBytesInFilter(const UInt8 * filt, size_t sz);
 size_t countBytesInFilter(const IColumn::Filter & filt);
 size_t countBytesInFilterWithNull(const IColumn::Filter & filt, const UInt8 * null_map);
 
+/// Copy the elements of `src` whose bytes in `filt` are not zero into `dst`, returns the number of copied elements.
+/// `dst` must have room for `countBytesInFilter(filt, size)` elements. The implementation is dispatched
+/// to SSE4/AVX2/AVX512 at runtime, see `Common/TargetSpecific.h`.
+template <typename T>
+size_t filterFixedSizeData(const UInt8 * filt, const T * src, size_t size, T * dst);
+
 /// Returns vector with num_columns elements. vector[i] is the count of i values in selector.
 /// Selector must contain values from 0 to num_columns - 1. NOTE: this is not checked.
 std::vector<size_t> countColumnsSizeInSelector(IColumn::ColumnIndex num_columns, const IColumn::Selector & selector);
@@ -61,6 +61,11 @@ public:
       */
     virtual Ptr convertToFullColumnIfConst() const { return {}; }
 
+    /** If column is dictionary-encoded (ColumnLowCardinality), return the decoded column, otherwise return the column itself.
+      * Note it also decodes the nested column of ColumnNullable.
+      */
+    virtual Ptr convertToFullColumnIfLowCardinality() const { return getPtr(); }
+
     /// Creates empty column with the same type.
     virtual MutablePtr cloneEmpty() const { return cloneResized(0); }
 
@@ -377,6 +382,10 @@ public:
     /// Column stores a constant value. It's true only for ColumnConst wrapper.
     virtual bool isColumnConst() const { return false; }
 
+    /// Column stores dictionary codes instead of values. It's true only for ColumnLowCardinality.
+    /// Note that ColumnNullable(ColumnLowCardinality) is not considered.
+    virtual bool isColumnLowCardinality() const { return false; }
+
     /// It's a special kind of column, that contain single value, but is not a ColumnConst.
     virtual bool isDummy() const { return false; }
 
@@ -0,0 +1,107 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnDecimal.h>
+#include <Columns/ColumnsCommon.h>
+#include <Columns/ColumnsNumber.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <random>
+
+namespace DB
+{
+namespace tests
+{
+namespace
+{
+/// Filters with random bytes, all passed and all filtered batches, and a tail that is not a multiple of 64.
+IColumn::Filter genFilter(size_t size, std::mt19937 & rng)
+{
+    IColumn::Filter filter(size);
+    std::uniform_int_distribution<int> dist(0, 3);
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (i / 64 % 3 == 0)
+            filter[i] = dist(rng) == 0 ? 0 : static_cast<UInt8>(dist(rng));
+        else
+            filter[i] = i / 64 % 3 == 1;
+    }
+    return filter;
+}
+
+template <typename ColumnType>
+void checkFilter(const ColumnType & column, const IColumn::Filter & filter)
+{
+    auto res = column.filter(filter, -1);
+    ASSERT_EQ(res->size(), countBytesInFilter(filter));
+    size_t j = 0;
+    for (size_t i = 0; i < filter.size(); ++i)
+    {
+        if (filter[i])
+        {
+            ASSERT_EQ((*res)[j], column[i]) << "row " << i;
+            ++j;
+        }
+    }
+}
+} // namespace
+
+TEST(ColumnFilterTest, FixedSize)
+try
+{
+    std::mt19937 rng(42);
+    for (size_t size : {0, 1, 63, 64, 65, 1000, 8192})
+    {
+        auto filter = genFilter(size, rng);
+
+        auto int_column = ColumnInt64::create();
+        auto float_column = ColumnFloat32::create();
+        auto decimal_column = ColumnDecimal<Decimal128>::create(0, 2);
+        for (size_t i = 0; i < size; ++i)
+        {
+            int_column->insert(Field(static_cast<Int64>(rng())));
+            float_column->insert(Field(static_cast<Float64>(i) / 3));
+            decimal_column->insert(Field(DecimalField<Decimal128>(static_cast<Int128>(i) * 100 + 1, 2)));
+        }
+        checkFilter(*int_column, filter);
+        checkFilter(*float_column, filter);
+        checkFilter(*decimal_column, filter);
+    }
+}
+CATCH
+
+TEST(ColumnFilterTest, FilterFixedSizeData)
+try
+{
+    std::mt19937 rng(1);
+    std::vector<UInt64> src(1000);
+    for (auto & v : src)
+        v = rng();
+    auto filter = genFilter(src.size(), rng);
+
+    std::vector<UInt64> dst(countBytesInFilter(filter));
+    ASSERT_EQ(filterFixedSizeData(filter.data(), src.data(), src.size(), dst.data()), dst.size());
+
+    std::vector<UInt64> expected;
+    for (size_t i = 0; i < src.size(); ++i)
+    {
+        if (filter[i])
+            expected.push_back(src[i]);
+    }
+    ASSERT_EQ(dst, expected);
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
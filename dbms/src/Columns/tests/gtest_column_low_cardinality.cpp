@@ -0,0 +1,140 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnLowCardinality.h>
+#include <Columns/ColumnNullable.h>
+#include <Common/SipHash.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+namespace DB
+{
+namespace tests
+{
+namespace
+{
+ColumnPtr encode(const std::vector<String> & values, size_t max_dictionary_size = 1000)
+{
+    auto column = createColumn<String>(values).column;
+    return ColumnLowCardinality::tryEncode(typeid_cast<const ColumnString &>(*column), max_dictionary_size);
+}
+
+ColumnPtr decode(const ColumnPtr & column)
+{
+    return column->convertToFullColumnIfLowCardinality();
+}
+} // namespace
+
+TEST(ColumnLowCardinalityTest, EncodeAndDecode)
+try
+{
+    auto column = encode({"a", "bb", "a", "", "bb", "a"});
+    ASSERT_TRUE(column->isColumnLowCardinality());
+    const auto & lc = typeid_cast<const ColumnLowCardinality &>(*column);
+    ASSERT_EQ(lc.getDictionary().size(), 3);
+    ASSERT_EQ(lc.size(), 6);
+    ASSERT_EQ(lc.getDataAt(1).toString(), "bb");
+    ASSERT_EQ(lc[3].get<String>(), "");
+    ASSERT_COLUMN_EQ(createColumn<String>({"a", "bb", "a", "", "bb", "a"}).column, decode(column));
+
+    // Too many distinct values
+    ASSERT_EQ(encode({"a", "b", "c"}, 2).get(), nullptr);
+}
+CATCH
+
+TEST(ColumnLowCardinalityTest, FilterAndPermute)
+try
+{
+    auto column = encode({"x", "y", "x", "z", "y"});
+    const auto & dictionary = typeid_cast<const ColumnLowCardinality &>(*column).getDictionaryPtr();
+
+    IColumn::Filter filter{1, 0, 0, 1, 1};
+    auto filtered = column->filter(filter, -1);
+    ASSERT_TRUE(filtered->isColumnLowCardinality());
+    // The dictionary is shared
+    ASSERT_EQ(typeid_cast<const ColumnLowCardinality &>(*filtered).getDictionaryPtr().get(), dictionary.get());
+    ASSERT_COLUMN_EQ(createColumn<String>({"x", "z", "y"}).column, decode(filtered));
+
+    IColumn::Permutation perm;
+    column->getPermutation(false, 0, 1, perm);
+    ASSERT_COLUMN_EQ(createColumn<String>({"x", "x", "y", "y", "z"}).column, decode(column->permute(perm, 0)));
+    column->getPermutation(true, 2, 1, perm);
+    ASSERT_COLUMN_EQ(createColumn<String>({"z", "y"}).column, decode(column->permute(perm, 2)));
+
+    ASSERT_COLUMN_EQ(createColumn<String>({"y", "x"}).column, decode(column->cut(1, 2)));
+}
+CATCH
+
+TEST(ColumnLowCardinalityTest, Insert)
+try
+{
+    auto column = encode({"a", "b", "a"});
+    auto other = encode({"c", "a", "c"});
+    auto full = createColumn<String>({"d", "e"}).column;
+
+    auto res = column->cloneEmpty();
+    res->insertRangeFrom(*column, 0, 3);
+    res->insertRangeFrom(*other, 1, 2);
+    res->insertFrom(*full, 1);
+    res->insertManyFrom(*other, 0, 2);
+    res->insert(Field(String("f")));
+    res->insertDefault();
+    ASSERT_COLUMN_EQ(createColumn<String>({"a", "b", "a", "a", "c", "e", "c", "c", "f", ""}).column, decode(std::move(res)));
+
+    // Inserting into a column must not change the columns sharing the same dictionary
+    auto filtered = column->filter(IColumn::Filter{1, 1, 0}, -1);
+    auto mutable_filtered = (*std::move(filtered)).mutate();
+    mutable_filtered->insertFrom(*full, 0);
+    ASSERT_COLUMN_EQ(createColumn<String>({"a", "b", "d"}).column, decode(std::move(mutable_filtered)));
+    ASSERT_EQ(typeid_cast<const ColumnLowCardinality &>(*column).getDictionary().size(), 2);
+    ASSERT_COLUMN_EQ(createColumn<String>({"a", "b", "a"}).column, decode(column));
+}
+CATCH
+
+TEST(ColumnLowCardinalityTest, CompareAndHash)
+try
+{
+    auto column = encode({"a", "b", "a"});
+    auto full = createColumn<String>({"a", "b", "a"}).column;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            ASSERT_EQ(column->compareAt(i, j, *full, 1), full->compareAt(i, j, *full, 1));
+            ASSERT_EQ(column->compareAt(i, j, *column, 1), full->compareAt(i, j, *full, 1));
+        }
+
+        SipHash lc_hash;
+        SipHash full_hash;
+        String sort_key_container;
+        column->updateHashWithValue(i, lc_hash, nullptr, sort_key_container);
+        full->updateHashWithValue(i, full_hash, nullptr, sort_key_container);
+        ASSERT_EQ(lc_hash.get64(), full_hash.get64());
+    }
+}
+CATCH
+
+TEST(ColumnLowCardinalityTest, Nullable)
+try
+{
+    auto column = ColumnNullable::create(encode({"a", "b", "a"}), createColumn<UInt8>({0, 1, 0}).column);
+    auto full = column->convertToFullColumnIfLowCardinality();
+    ASSERT_TRUE(full->isColumnNullable());
+    ASSERT_FALSE(static_cast<const ColumnNullable &>(*full).getNestedColumn().isColumnLowCardinality());
+    ASSERT_COLUMN_EQ(createColumn<Nullable<String>>({"a", {}, "a"}).column, full);
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
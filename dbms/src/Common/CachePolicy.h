@@ -0,0 +1,134 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <common/types.h>
+
+#include <algorithm>
+#include <cctype>
+#include <optional>
+#include <vector>
+
+namespace DB
+{
+/// The eviction policies of the local caches of the remote data.
+enum class CachePolicy
+{
+    /// Evict the least recently used items.
+    LRU,
+    /// Segmented LRU with TinyLFU admission. The items accessed only once are evicted before the items
+    /// accessed repeatedly, and a new item is rejected if it is accessed less frequently than the item
+    /// to be evicted for it. So a large scan over the cold data does not flush the hot data.
+    TinyLFU,
+};
+
+/// Parse the policy from the configuration, the names are case-insensitive, e.g. "lru" or "tinylfu".
+inline std::optional<CachePolicy> parseCachePolicy(String name)
+{
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+    if (name == "lru")
+        return CachePolicy::LRU;
+    if (name == "tinylfu")
+        return CachePolicy::TinyLFU;
+    return std::nullopt;
+}
+
+/// A Count-Min sketch that estimates the access frequencies of the keys with a fixed amount of memory.
+/// The counters saturate at 15, and all of them are halved after every `10 * width` increments,
+/// so that the frequencies of the keys that are no longer accessed decay over time.
+class FrequencySketch
+{
+public:
+    /// `width` is the number of counters of each row, it should not be less than the number of cached items.
+    explicit FrequencySketch(size_t width) { resize(width); }
+
+    /// Grow the sketch if the cache holds more items than `width` now. The recorded frequencies are kept.
+    void ensureCapacity(size_t width)
+    {
+        if (width > mask + 1)
+            resize(width);
+    }
+
+    void increment(UInt64 hash)
+    {
+        bool added = false;
+        for (size_t row = 0; row < depth; ++row)
+        {
+            auto & counter = counters[indexOf(hash, row)];
+            if (counter < max_count)
+            {
+                ++counter;
+                added = true;
+            }
+        }
+        if (added && ++additions >= sample_size)
+            reset();
+    }
+
+    UInt8 estimate(UInt64 hash) const
+    {
+        UInt8 freq = max_count;
+        for (size_t row = 0; row < depth; ++row)
+            freq = std::min(freq, counters[indexOf(hash, row)]);
+        return freq;
+    }
+
+private:
+    // Double hashing, every row takes `mask + 1` continuous counters.
+    size_t indexOf(UInt64 hash, size_t row) const
+    {
+        const UInt64 h = hash + row * ((hash >> 32) | 1);
+        return row * (mask + 1) + (h & mask);
+    }
+
+    void resize(size_t width)
+    {
+        size_t w = 1;
+        while (w < width)
+            w <<= 1;
+        // The width is a power of 2, a key at `h & mask` moves to `h & new_mask`, whose low bits are the
+        // same. So copying every counter to the positions with the same low bits keeps the estimates.
+        std::vector<UInt8> new_counters(depth * w, 0);
+        if (!counters.empty())
+        {
+            const size_t old_width = mask + 1;
+            for (size_t row = 0; row < depth; ++row)
+            {
+                for (size_t i = 0; i < w; ++i)
+                    new_counters[row * w + i] = counters[row * old_width + (i & mask)];
+            }
+        }
+        mask = w - 1;
+        sample_size = 10 * w;
+        counters = std::move(new_counters);
+    }
+
+    void reset()
+    {
+        for (auto & counter : counters)
+            counter >>= 1;
+        additions /= 2;
+    }
+
+    static constexpr size_t depth = 4;
+    static constexpr UInt8 max_count = 15;
+
+    size_t mask = 0;
+    size_t sample_size = 0;
+    size_t additions = 0;
+    std::vector<UInt8> counters;
+};
+
+} // namespace DB
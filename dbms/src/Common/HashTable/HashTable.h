@@ -1093,6 +1093,13 @@ public:
         return const_cast<std::decay_t<decltype(*this)> *>(this)->find(x, hash_value);
     }
 
+    /// Prefetch the cell where the lookup of a key with `hash_value` starts. Used by batched
+    /// lookups to overlap the cache misses of different keys.
+    void ALWAYS_INLINE prefetch(size_t hash_value) const
+    {
+        __builtin_prefetch(&buf[grower.place(hash_value)]);
+    }
+
     std::enable_if_t<Grower::performs_linear_probing_with_single_step, bool>
         ALWAYS_INLINE erase(const Key & x)
     {
@@ -0,0 +1,419 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Common/IOUring.h>
+#include <Common/ProfileEvents.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <tuple>
+
+#if TIFLASH_USE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#endif
+
+namespace ProfileEvents
+{
+extern const Event IOUringSubmit;
+extern const Event IOUringReadBytes;
+extern const Event IOUringPrefetchBytes;
+} // namespace ProfileEvents
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int AIO_SUBMIT_ERROR;
+extern const int CANNOT_READ_FROM_FILE_DESCRIPTOR;
+extern const int ATTEMPT_TO_READ_AFTER_EOF;
+} // namespace ErrorCodes
+
+namespace
+{
+std::atomic<bool> io_uring_enabled{false};
+
+constexpr unsigned IO_URING_ENTRIES = 64;
+
+enum class ReadResult
+{
+    Finished,
+    ReadAgain,
+    EndOfFile,
+    Error,
+};
+
+/// Handle the result `res` of reading the rest of `req` once, `err` is the errno if `res` < 0.
+/// Shared by pread and io_uring, so that they handle the interrupted reads, short reads and
+/// the end of file in the same way. The requests of zero size are never read.
+ReadResult onReadResult(const IOUring::ReadRequest & req, size_t & bytes_read, ssize_t res, int err)
+{
+    if (res < 0)
+        return err == EINTR || err == EAGAIN ? ReadResult::ReadAgain : ReadResult::Error;
+    if (res == 0)
+        return ReadResult::EndOfFile;
+    bytes_read += res;
+    // Short read, read the rest
+    return bytes_read < req.size ? ReadResult::ReadAgain : ReadResult::Finished;
+}
+
+[[noreturn]] void throwReadError(const IOUring::ReadRequest & req, size_t bytes_read, ReadResult result, int err)
+{
+    if (result == ReadResult::EndOfFile)
+        throw Exception(fmt::format("Attempt to read after eof, fd={} offset={} size={} read={}", req.fd, req.offset, req.size, bytes_read), ErrorCodes::ATTEMPT_TO_READ_AFTER_EOF);
+    throwFromErrno(fmt::format("Cannot read from fd {}, offset={} size={} read={}", req.fd, req.offset, req.size, bytes_read), ErrorCodes::CANNOT_READ_FROM_FILE_DESCRIPTOR, err);
+}
+
+void preadFully(const IOUring::ReadRequest & req)
+{
+    if (req.size == 0)
+        return;
+    size_t bytes_read = 0;
+    for (;;)
+    {
+        ssize_t res = ::pread(req.fd, req.buf + bytes_read, req.size - bytes_read, req.offset + bytes_read);
+        const int err = res < 0 ? errno : 0;
+        switch (auto result = onReadResult(req, bytes_read, res, err); result)
+        {
+        case ReadResult::Finished:
+            return;
+        case ReadResult::ReadAgain:
+            continue;
+        default:
+            throwReadError(req, bytes_read, result, err);
+        }
+    }
+}
+
+#if TIFLASH_USE_IO_URING
+int ioUringSetup(unsigned entries, io_uring_params * params)
+{
+    return syscall(__NR_io_uring_setup, entries, params);
+}
+
+int ioUringEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+    return syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0);
+}
+#endif
+} // namespace
+
+void IOUring::setEnabled(bool enabled_)
+{
+    io_uring_enabled.store(enabled_, std::memory_order_relaxed);
+}
+
+bool IOUring::isEnabled()
+{
+    return io_uring_enabled.load(std::memory_order_relaxed);
+}
+
+void IOUring::readBatch(std::vector<ReadRequest> & requests)
+{
+    if (requests.empty())
+        return;
+    if (auto * ring = getThreadLocal(); ring != nullptr)
+    {
+        ring->read(requests);
+        return;
+    }
+
+    for (const auto & req : requests)
+        preadFully(req);
+}
+
+void IOUring::prefetchBatch(const std::vector<PrefetchRequest> & requests)
+{
+    if (requests.empty())
+        return;
+    if (auto * ring = getThreadLocal(); ring != nullptr)
+        ring->prefetch(requests);
+}
+
+IOUring * IOUring::getThreadLocal()
+{
+#if TIFLASH_USE_IO_URING
+    static std::atomic<bool> unavailable{false};
+    if (!isEnabled() || unavailable.load(std::memory_order_relaxed))
+        return nullptr;
+
+    thread_local std::unique_ptr<IOUring> ring;
+    if (!ring)
+    {
+        try
+        {
+            ring = std::make_unique<IOUring>(IO_URING_ENTRIES);
+        }
+        catch (...)
+        {
+            // Usually io_uring is not supported by the kernel or forbidden, don't try again.
+            if (!unavailable.exchange(true))
+                tryLogCurrentException("IOUring", "io_uring is not available, fallback to pread");
+            return nullptr;
+        }
+    }
+    return ring.get();
+#else
+    return nullptr;
+#endif
+}
+
+#if TIFLASH_USE_IO_URING
+IOUring::IOUring(unsigned entries)
+{
+    io_uring_params params{};
+    ring_fd = ioUringSetup(entries, &params);
+    if (ring_fd < 0)
+        throwFromErrno("io_uring_setup failed", ErrorCodes::AIO_SUBMIT_ERROR);
+
+    sq_entries = params.sq_entries;
+    cq_entries = params.cq_entries;
+    sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+    auto map = [&](size_t size, off_t offset) {
+        void * ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, offset);
+        if (ptr == MAP_FAILED)
+        {
+            int saved_errno = errno;
+            release();
+            throwFromErrno("mmap io_uring failed", ErrorCodes::AIO_SUBMIT_ERROR, saved_errno);
+        }
+        return ptr;
+    };
+    sq_ring = map(sq_ring_size, IORING_OFF_SQ_RING);
+    cq_ring = map(cq_ring_size, IORING_OFF_CQ_RING);
+    sqes = static_cast<io_uring_sqe *>(map(sqes_size, IORING_OFF_SQES));
+
+    auto * sq = static_cast<char *>(sq_ring);
+    sq_head = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    auto * cq = static_cast<char *>(cq_ring);
+    cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+}
+
+IOUring::~IOUring()
+{
+    // Wait for the prefetches, the kernel may still be using the ring.
+    try
+    {
+        while (in_flight > 0)
+        {
+            submit(in_flight);
+            reap([](size_t, Int32) {});
+        }
+    }
+    catch (...)
+    {
+        tryLogCurrentException("IOUring");
+    }
+    release();
+}
+
+void IOUring::release()
+{
+    if (sqes != nullptr)
+        munmap(sqes, sqes_size);
+    if (cq_ring != nullptr)
+        munmap(cq_ring, cq_ring_size);
+    if (sq_ring != nullptr)
+        munmap(sq_ring, sq_ring_size);
+    if (ring_fd >= 0)
+        ::close(ring_fd);
+    sqes = nullptr;
+    cq_ring = nullptr;
+    sq_ring = nullptr;
+    ring_fd = -1;
+}
+
+io_uring_sqe * IOUring::getSQE()
+{
+    const unsigned head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+    const unsigned tail = *sq_tail + sq_prepared;
+    if (tail - head >= sq_entries || in_flight + sq_prepared >= cq_entries)
+        return nullptr;
+
+    const unsigned index = tail & *sq_mask;
+    sq_array[index] = index;
+    ++sq_prepared;
+    auto * sqe = &sqes[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+void IOUring::submit(unsigned min_complete)
+{
+    if (sq_prepared > 0)
+    {
+        __atomic_store_n(sq_tail, *sq_tail + sq_prepared, __ATOMIC_RELEASE);
+        in_flight += sq_prepared;
+        sq_prepared = 0;
+    }
+    min_complete = std::min(min_complete, in_flight);
+
+    for (;;)
+    {
+        // The entries not consumed by the kernel yet, they are left in the queue if the last call is interrupted.
+        const unsigned to_submit = *sq_tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+        if (to_submit == 0 && min_complete == 0)
+            return;
+        ProfileEvents::increment(ProfileEvents::IOUringSubmit);
+        if (ioUringEnter(ring_fd, to_submit, min_complete, min_complete > 0 ? IORING_ENTER_GETEVENTS : 0) >= 0)
+            return;
+        if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+            throwFromErrno("io_uring_enter failed", ErrorCodes::AIO_SUBMIT_ERROR);
+    }
+}
+
+template <typename Callback>
+void IOUring::reap(Callback && callback)
+{
+    unsigned head = *cq_head;
+    const unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head)
+    {
+        const auto & cqe = cqes[head & *cq_mask];
+        --in_flight;
+        // user_data is 0 for prefetches, otherwise it is the index of request + 1.
+        if (cqe.user_data != 0)
+            callback(static_cast<size_t>(cqe.user_data - 1), cqe.res);
+    }
+    __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+}
+
+void IOUring::read(std::vector<ReadRequest> & requests)
+{
+    std::vector<iovec> iovecs(requests.size());
+    std::vector<size_t> bytes_read(requests.size(), 0);
+    std::vector<size_t> to_submit;
+    to_submit.reserve(requests.size());
+    for (size_t i = requests.size(); i > 0; --i)
+    {
+        // A read of zero size returns 0, which can not be told from the end of file.
+        if (requests[i - 1].size > 0)
+            to_submit.push_back(i - 1);
+    }
+
+    unsigned reading = 0;
+    // The first error. Stop submitting once an error happens, but must wait for
+    // the submitted reads because the kernel is still writing into the buffers.
+    std::optional<std::tuple<size_t, ReadResult, Int32>> error;
+    while ((!to_submit.empty() && !error) || reading > 0)
+    {
+        while (!to_submit.empty() && !error)
+        {
+            auto * sqe = getSQE();
+            if (sqe == nullptr)
+                break;
+            const size_t i = to_submit.back();
+            to_submit.pop_back();
+            const auto & req = requests[i];
+            iovecs[i].iov_base = req.buf + bytes_read[i];
+            iovecs[i].iov_len = req.size - bytes_read[i];
+            sqe->opcode = IORING_OP_READV;
+            sqe->fd = req.fd;
+            sqe->addr = reinterpret_cast<UInt64>(&iovecs[i]);
+            sqe->len = 1;
+            sqe->off = req.offset + bytes_read[i];
+            sqe->user_data = i + 1;
+            ++reading;
+        }
+
+        // Wait for all the submitted reads in one syscall. Wait for at least one completion even
+        // if nothing is submitted, it means the queue is full of the prefetches.
+        submit(std::max<unsigned>(reading, 1));
+        reap([&](size_t i, Int32 res) {
+            --reading;
+            if (res > 0)
+                ProfileEvents::increment(ProfileEvents::IOUringReadBytes, res);
+            const Int32 err = res < 0 ? -res : 0;
+            switch (auto result = onReadResult(requests[i], bytes_read[i], res, err); result)
+            {
+            case ReadResult::Finished:
+                break;
+            case ReadResult::ReadAgain:
+                to_submit.push_back(i);
+                break;
+            default:
+                if (!error)
+                    error.emplace(i, result, err);
+            }
+        });
+    }
+
+    if (error)
+    {
+        const auto & [i, result, err] = *error;
+        throwReadError(requests[i], bytes_read[i], result, err);
+    }
+}
+
+void IOUring::prefetch(const std::vector<PrefetchRequest> & requests)
+{
+// IORING_OP_FADVISE is added in Linux 5.6, along with IORING_FEAT_RW_CUR_POS.
+#ifdef IORING_FEAT_RW_CUR_POS
+    // Free the completion queue from the previous prefetches.
+    reap([](size_t, Int32) {});
+    for (const auto & req : requests)
+    {
+        if (req.fd < 0 || req.size == 0)
+            continue;
+        auto * sqe = getSQE();
+        // Too many prefetches in flight, it is only a hint so just drop the rest.
+        if (sqe == nullptr)
+            break;
+        sqe->opcode = IORING_OP_FADVISE;
+        sqe->fd = req.fd;
+        sqe->off = req.offset;
+        sqe->len = std::min<size_t>(req.size, std::numeric_limits<UInt32>::max());
+        sqe->fadvise_advice = POSIX_FADV_WILLNEED;
+        sqe->user_data = 0;
+        ProfileEvents::increment(ProfileEvents::IOUringPrefetchBytes, sqe->len);
+    }
+    submit(0);
+#else
+    (void)requests;
+#endif
+}
+#else
+IOUring::IOUring(unsigned)
+{
+    throw Exception("io_uring is not supported on this platform", ErrorCodes::AIO_SUBMIT_ERROR);
+}
+
+IOUring::~IOUring() = default;
+
+void IOUring::release() {}
+void IOUring::read(std::vector<ReadRequest> & requests)
+{
+    for (const auto & req : requests)
+        preadFully(req);
+}
+void IOUring::prefetch(const std::vector<PrefetchRequest> &) {}
+#endif
+
+} // namespace DB
@@ -0,0 +1,116 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <common/types.h>
+#include <sys/types.h>
+
+#include <boost/noncopyable.hpp>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define TIFLASH_USE_IO_URING 1
+#endif
+#endif
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace DB
+{
+/** A small wrapper of io_uring by the raw syscalls, used to submit a batch of reads
+  * on local files in one syscall, instead of blocking on the `pread` of each one.
+  *
+  * Every thread owns its ring, so the ring is never shared and needs no lock.
+  * It is disabled by default, and falls back to `pread` if it is disabled or
+  * the kernel does not support it (e.g. forbidden by seccomp).
+  */
+class IOUring : private boost::noncopyable
+{
+public:
+    struct ReadRequest
+    {
+        int fd;
+        char * buf;
+        size_t size;
+        off_t offset;
+    };
+
+    struct PrefetchRequest
+    {
+        int fd = -1;
+        off_t offset = 0;
+        size_t size = 0;
+    };
+
+    static void setEnabled(bool enabled_);
+    static bool isEnabled();
+
+    /// Read all the requests and wait for them. Throws if any of them fails or meets the end of file.
+    /// Note the data is read from the fd directly, the caller must decrypt it if the file is encrypted.
+    static void readBatch(std::vector<ReadRequest> & requests);
+
+    /// Ask the kernel to read the ranges into the page cache in background, returns without waiting.
+    /// It is only a hint, does nothing if io_uring is not available.
+    static void prefetchBatch(const std::vector<PrefetchRequest> & requests);
+
+    explicit IOUring(unsigned entries);
+    ~IOUring();
+
+private:
+    void release();
+
+    /// Returns the ring of current thread, or nullptr if io_uring is not available.
+    static IOUring * getThreadLocal();
+
+    void read(std::vector<ReadRequest> & requests);
+    void prefetch(const std::vector<PrefetchRequest> & requests);
+
+    /// Returns nullptr if the submission queue is full, or the completion queue may overflow.
+    io_uring_sqe * getSQE();
+    /// Submit the prepared entries and wait for at least `min_complete` completions.
+    void submit(unsigned min_complete);
+    /// Pop the completed entries, the prefetches are dropped.
+    template <typename Callback>
+    void reap(Callback && callback);
+
+    int ring_fd = -1;
+    unsigned sq_entries = 0;
+    unsigned cq_entries = 0;
+    /// Prepared and not submitted entries.
+    unsigned sq_prepared = 0;
+    /// Submitted and not reaped entries, including the prefetches.
+    unsigned in_flight = 0;
+
+    void * sq_ring = nullptr;
+    size_t sq_ring_size = 0;
+    unsigned * sq_head = nullptr;
+    unsigned * sq_tail = nullptr;
+    unsigned * sq_mask = nullptr;
+    unsigned * sq_array = nullptr;
+    io_uring_sqe * sqes = nullptr;
+    size_t sqes_size = 0;
+
+    void * cq_ring = nullptr;
+    size_t cq_ring_size = 0;
+    unsigned * cq_head = nullptr;
+    unsigned * cq_tail = nullptr;
+    unsigned * cq_mask = nullptr;
+    io_uring_cqe * cqes = nullptr;
+};
+
+} // namespace DB
@@ -168,6 +168,8 @@ public:
         return current_weight;
     }
 
+    size_t maxWeight() const { return max_weight; }
+
     size_t count() const
     {
         std::lock_guard cache_lock(mutex);
@@ -29,6 +29,9 @@
     M(ReadBufferAIOReadBytes)                  \
     M(WriteBufferAIOWrite)                     \
     M(WriteBufferAIOWriteBytes)                \
+    M(IOUringSubmit)                           \
+    M(IOUringReadBytes)                        \
+    M(IOUringPrefetchBytes)                    \
                                                \
     M(UncompressedCacheHits)                   \
     M(UncompressedCacheMisses)                 \
@@ -115,6 +118,8 @@
     M(DMSegmentIsEmptySlowPath)                \
     M(DMSegmentIngestDataByReplace)            \
     M(DMSegmentIngestDataIntoDelta)            \
+    M(DMSegmentAggCacheHit)                    \
+    M(DMSegmentAggCacheMiss)                   \
                                                \
     M(FileFSync)                               \
                                                \
@@ -131,6 +136,7 @@
     M(S3CreateMultipartUpload)                 \
     M(S3UploadPart)                            \
     M(S3CompleteMultipartUpload)               \
+    M(S3AbortMultipartUpload)                  \
     M(S3PutObject)                             \
     M(S3GetObject)                             \
     M(S3HeadObject)                            \
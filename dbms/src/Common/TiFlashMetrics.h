@@ -145,7 +145,10 @@ namespace DB
         F(type_seg_split_fg, {"type", "seg_split_fg"}),                                                                                             \
         F(type_seg_split_ingest, {"type", "seg_split_ingest"}),                                                                                     \
         F(type_seg_merge_bg_gc, {"type", "seg_merge_bg_gc"}),                                                                                       \
-        F(type_place_index_update, {"type", "place_index_update"}))                                                                                 \
+        F(type_place_index_update, {"type", "place_index_update"}),                                                                                 \
+        F(type_persist_delta_index, {"type", "persist_delta_index"}),                                                                               \
+        F(type_load_delta_index, {"type", "load_delta_index"}),                                                                                     \
+        F(type_warm_up_segment, {"type", "warm_up_segment"}))                                                                                       \
     M(tiflash_storage_subtask_duration_seconds, "Bucketed histogram of storage's sub task duration", Histogram,                                     \
         F(type_delta_merge_bg, {{"type", "delta_merge_bg"}}, ExpBuckets{0.001, 2, 20}),                                                             \
         F(type_delta_merge_bg_gc, {{"type", "delta_merge_bg_gc"}}, ExpBuckets{0.001, 2, 20}),                                                       \
@@ -157,7 +160,10 @@ namespace DB
         F(type_seg_split_fg, {{"type", "seg_split_fg"}}, ExpBuckets{0.001, 2, 20}),                                                                 \
         F(type_seg_split_ingest, {{"type", "seg_split_ingest"}}, ExpBuckets{0.001, 2, 20}),                                                         \
         F(type_seg_merge_bg_gc, {{"type", "seg_merge_bg_gc"}}, ExpBuckets{0.001, 2, 20}),                                                           \
-        F(type_place_index_update, {{"type", "place_index_update"}}, ExpBuckets{0.001, 2, 20}))                                                     \
+        F(type_place_index_update, {{"type", "place_index_update"}}, ExpBuckets{0.001, 2, 20}),                                                     \
+        F(type_persist_delta_index, {{"type", "persist_delta_index"}}, ExpBuckets{0.001, 2, 20}),                                                   \
+        F(type_load_delta_index, {{"type", "load_delta_index"}}, ExpBuckets{0.001, 2, 20}),                                                         \
+        F(type_warm_up_segment, {{"type", "warm_up_segment"}}, ExpBuckets{0.001, 2, 20}))                                                           \
     M(tiflash_storage_throughput_bytes, "Calculate the throughput of tasks of storage in bytes", Gauge,           /**/                              \
         F(type_write, {"type", "write"}),                                                                         /**/                              \
         F(type_ingest, {"type", "ingest"}),                                                                       /**/                              \
@@ -249,6 +255,10 @@ namespace DB
         F(type_apply_snapshot_flush, {{"type", "snapshot_flush"}}, ExpBuckets{0.05, 2, 10}))                                                        \
     M(tiflash_raft_process_keys, "Total number of keys processed in some types of Raft commands", Counter,                                          \
         F(type_apply_snapshot, {"type", "apply_snapshot"}), F(type_ingest_sst, {"type", "ingest_sst"}))                                             \
+    M(tiflash_raft_sst2dt_stage_bytes, "Total bytes processed by each stage of converting SST files to DTFiles", Counter,                           \
+        F(type_read_sst, {"type", "read_sst"}), F(type_decode, {"type", "decode"}), F(type_write_dtfile, {"type", "write_dtfile"}))                 \
+    M(tiflash_raft_sst2dt_stage_seconds, "Total seconds spent by each stage of converting SST files to DTFiles", Counter,                           \
+        F(type_read_sst, {"type", "read_sst"}), F(type_decode, {"type", "decode"}), F(type_write_dtfile, {"type", "write_dtfile"}))                 \
     M(tiflash_raft_apply_write_command_duration_seconds, "Bucketed histogram of applying write command Raft logs", Histogram,                       \
         F(type_write, {{"type", "write"}}, ExpBuckets{0.0005, 2, 20}),                                                                              \
         F(type_admin, {{"type", "admin"}}, ExpBuckets{0.0005, 2, 20}),                                                                              \
@@ -302,7 +312,8 @@ namespace DB
         F(type_get_cache_miss, {"type", "get_cache_miss"}),                                                                                         \
         F(type_get_cache_part, {"type", "get_cache_part"}),                                                                                         \
         F(type_get_cache_hit, {"type", "get_cache_hit"}),                                                                                           \
-        F(type_get_cache_copy, {"type", "get_cache_copy"}))                                                                                         \
+        F(type_get_cache_copy, {"type", "get_cache_copy"}),                                                                                         \
+        F(type_scan_sharing_attach, {"type", "scan_sharing_attach"}))                                                                               \
     M(tiflash_storage_read_thread_gauge, "The gauge of storage read thread", Gauge,                                                                 \
         F(type_merged_task, {"type", "merged_task"}))                                                                                               \
     M(tiflash_storage_read_thread_seconds, "Bucketed histogram of read thread", Histogram,                                                          \
@@ -402,11 +413,13 @@ namespace DB
         F(type_dtfile_full, {"type", "dtfile_full"}),                                                                                               \
         F(type_dtfile_download, {"type", "dtfile_download"}),                                                                                       \
         F(type_dtfile_download_failed, {"type", "dtfile_download_failed"}),                                                                         \
+        F(type_dtfile_admission_reject, {"type", "dtfile_admission_reject"}),                                                                       \
         F(type_page_hit, {"type", "page_hit"}),                                                                                                     \
         F(type_page_miss, {"type", "page_miss"}),                                                                                                   \
         F(type_page_evict, {"type", "page_evict"}),                                                                                                 \
         F(type_page_full, {"type", "page_full"}),                                                                                                   \
-        F(type_page_download, {"type", "page_download"}))                                                                                           \
+        F(type_page_download, {"type", "page_download"}),                                                                                           \
+        F(type_page_admission_reject, {"type", "page_admission_reject"}))                                                                           \
     M(tiflash_storage_remote_cache_bytes, "Flow of remote cache", Counter,                                                                          \
         F(type_dtfile_evict_bytes, {"type", "dtfile_evict_bytes"}),                                                                                 \
         F(type_dtfile_download_bytes, {"type", "dtfile_download_bytes"}),                                                                           \
@@ -0,0 +1,64 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/CachePolicy.h>
+#include <gtest/gtest.h>
+
+namespace DB
+{
+namespace tests
+{
+TEST(CachePolicyTest, Parse)
+{
+    ASSERT_EQ(parseCachePolicy("lru"), CachePolicy::LRU);
+    ASSERT_EQ(parseCachePolicy("LRU"), CachePolicy::LRU);
+    ASSERT_EQ(parseCachePolicy("TinyLFU"), CachePolicy::TinyLFU);
+    ASSERT_EQ(parseCachePolicy("arc"), std::nullopt);
+}
+
+TEST(CachePolicyTest, FrequencySketch)
+{
+    FrequencySketch sketch(64);
+    std::hash<String> hash;
+
+    ASSERT_EQ(sketch.estimate(hash("hot")), 0);
+    for (size_t i = 0; i < 5; ++i)
+        sketch.increment(hash("hot"));
+    sketch.increment(hash("cold"));
+    ASSERT_EQ(sketch.estimate(hash("hot")), 5);
+    ASSERT_EQ(sketch.estimate(hash("cold")), 1);
+
+    // Saturated at 15.
+    for (size_t i = 0; i < 20; ++i)
+        sketch.increment(hash("hot"));
+    ASSERT_EQ(sketch.estimate(hash("hot")), 15);
+
+    // The frequencies are halved after 10 * width increments.
+    for (size_t i = 0; i < 640; ++i)
+        sketch.increment(hash(fmt::format("key_{}", i)));
+    ASSERT_LE(sketch.estimate(hash("hot")), 7);
+
+    // Growing the sketch keeps the frequencies.
+    const auto hot_freq = sketch.estimate(hash("hot"));
+    ASSERT_GT(hot_freq, 0);
+    sketch.ensureCapacity(32);
+    ASSERT_EQ(sketch.estimate(hash("hot")), hot_freq);
+    sketch.ensureCapacity(1000);
+    ASSERT_EQ(sketch.estimate(hash("hot")), hot_freq);
+    sketch.increment(hash("hot"));
+    ASSERT_EQ(sketch.estimate(hash("hot")), hot_freq + 1);
+}
+
+} // namespace tests
+} // namespace DB
@@ -0,0 +1,142 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/IOUring.h>
+#include <Poco/File.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <random>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int ATTEMPT_TO_READ_AFTER_EOF;
+} // namespace ErrorCodes
+
+namespace tests
+{
+class IOUringTest : public ::testing::TestWithParam<bool>
+{
+protected:
+    void SetUp() override
+    {
+        auto dir = TiFlashTestEnv::getTemporaryPath("IOUringTest");
+        Poco::File(dir).createDirectories();
+        path = dir + "/data";
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        ASSERT_GE(fd, 0);
+
+        data.resize(1024 * 1024);
+        std::mt19937 rng(0);
+        for (auto & c : data)
+            c = static_cast<char>(rng());
+        ASSERT_EQ(::pwrite(fd, data.data(), data.size(), 0), static_cast<ssize_t>(data.size()));
+
+        IOUring::setEnabled(GetParam());
+    }
+
+    void TearDown() override
+    {
+        IOUring::setEnabled(false);
+        ::close(fd);
+        Poco::File(path).remove();
+    }
+
+    String path;
+    int fd = -1;
+    String data;
+};
+
+TEST_P(IOUringTest, ReadBatch)
+try
+{
+    std::mt19937 rng(1);
+    // More requests than the entries of ring
+    for (size_t round = 0; round < 3; ++round)
+    {
+        IOUring::prefetchBatch({{fd, 0, 4096}, {fd, 8192, 100000}});
+
+        std::vector<String> bufs(300);
+        std::vector<IOUring::ReadRequest> requests;
+        for (auto & buf : bufs)
+        {
+            size_t size = rng() % 5000;
+            off_t offset = rng() % (data.size() - size);
+            buf.resize(size);
+            requests.push_back({fd, buf.data(), size, offset});
+        }
+        IOUring::readBatch(requests);
+        for (size_t i = 0; i < requests.size(); ++i)
+            ASSERT_EQ(bufs[i], data.substr(requests[i].offset, requests[i].size)) << i;
+    }
+}
+CATCH
+
+TEST_P(IOUringTest, ReadAfterEOF)
+try
+{
+    String buf(100, 0);
+    String ok(100, 0);
+    std::vector<IOUring::ReadRequest> requests{
+        {fd, ok.data(), ok.size(), 0},
+        {fd, buf.data(), buf.size(), static_cast<off_t>(data.size() - 10)},
+    };
+    ASSERT_THROW(IOUring::readBatch(requests), DB::Exception);
+    ASSERT_EQ(buf.substr(0, 10), data.substr(data.size() - 10));
+}
+CATCH
+
+TEST_P(IOUringTest, ReadZeroSize)
+try
+{
+    // The requests of zero size are skipped, even at the end of file.
+    String buf(100, 0);
+    std::vector<IOUring::ReadRequest> requests{
+        {fd, nullptr, 0, 0},
+        {fd, buf.data(), buf.size(), 100},
+        {fd, nullptr, 0, static_cast<off_t>(data.size())},
+        {fd, nullptr, 0, static_cast<off_t>(data.size() + 4096)},
+    };
+    IOUring::readBatch(requests);
+    ASSERT_EQ(buf, data.substr(100, 100));
+}
+CATCH
+
+TEST_P(IOUringTest, ReadAfterEOFErrorCode)
+try
+{
+    // Both pread and io_uring report the end of file in the same way.
+    String buf(100, 0);
+    std::vector<IOUring::ReadRequest> requests{
+        {fd, buf.data(), buf.size(), static_cast<off_t>(data.size() + 10)},
+    };
+    try
+    {
+        IOUring::readBatch(requests);
+        FAIL() << "should throw";
+    }
+    catch (const DB::Exception & e)
+    {
+        ASSERT_EQ(e.code(), ErrorCodes::ATTEMPT_TO_READ_AFTER_EOF) << e.message();
+    }
+}
+CATCH
+
+INSTANTIATE_TEST_CASE_P(EnableIOUring, IOUringTest, ::testing::Bool());
+
+} // namespace tests
+} // namespace DB
@@ -0,0 +1,127 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/SmallObjectPoolAllocator.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <map>
+
+namespace DB
+{
+namespace tests
+{
+namespace
+{
+using Map = std::map<Int64, String, std::less<Int64>, SmallObjectPoolAllocator<std::pair<const Int64, String>>>;
+
+Map genMap(Int64 begin, Int64 end)
+{
+    Map map;
+    for (Int64 i = begin; i < end; ++i)
+        map.emplace_hint(map.end(), i, std::to_string(i));
+    return map;
+}
+
+void checkMap(const Map & map, Int64 begin, Int64 end)
+{
+    ASSERT_EQ(map.size(), static_cast<size_t>(end - begin));
+    Int64 i = begin;
+    for (const auto & [key, value] : map)
+    {
+        ASSERT_EQ(key, i);
+        ASSERT_EQ(value, std::to_string(i));
+        ++i;
+    }
+}
+} // namespace
+
+TEST(SmallObjectPoolAllocatorTest, InsertAndErase)
+try
+{
+    auto map = genMap(0, 1000);
+    checkMap(map, 0, 1000);
+
+    // The erased nodes are reused
+    for (auto it = map.begin(); it != map.end();)
+        it = it->first % 2 ? std::next(it) : map.erase(it);
+    ASSERT_EQ(map.size(), 500);
+    for (Int64 i = 0; i < 1000; i += 2)
+        map.emplace(i, std::to_string(i));
+    checkMap(map, 0, 1000);
+}
+CATCH
+
+TEST(SmallObjectPoolAllocatorTest, UsedAndReservedBytes)
+try
+{
+    auto map = genMap(0, 10000);
+    const auto & pools = map.get_allocator().getPools();
+    const auto used = pools.usedBytes();
+    const auto reserved = pools.reservedBytes();
+    ASSERT_GT(used, 0);
+    ASSERT_GE(reserved, used);
+
+    // The erased nodes are still reserved
+    map.erase(map.begin(), map.find(9000));
+    ASSERT_EQ(pools.usedBytes(), used / 10);
+    ASSERT_EQ(pools.reservedBytes(), reserved);
+
+    // Rebuilding the map releases them
+    Map rebuilt;
+    for (auto & [key, value] : map)
+        rebuilt.emplace_hint(rebuilt.end(), key, std::move(value));
+    map = std::move(rebuilt);
+    const auto & new_pools = map.get_allocator().getPools();
+    ASSERT_EQ(new_pools.usedBytes(), used / 10);
+    ASSERT_LT(new_pools.reservedBytes(), reserved / 4);
+    checkMap(map, 9000, 10000);
+
+    map.clear();
+    ASSERT_EQ(new_pools.usedBytes(), 0);
+}
+CATCH
+
+TEST(SmallObjectPoolAllocatorTest, MoveAndCopy)
+try
+{
+    auto map = genMap(0, 100);
+
+    // The moved-from map can be used again
+    Map moved(std::move(map));
+    checkMap(moved, 0, 100);
+    map.emplace(100, "100");
+    checkMap(map, 100, 101);
+    ASSERT_NE(map.get_allocator(), moved.get_allocator());
+
+    Map assigned;
+    assigned.emplace(0, "0");
+    assigned = std::move(moved);
+    checkMap(assigned, 0, 100);
+    moved = genMap(200, 300);
+    checkMap(moved, 200, 300);
+
+    // The copy owns its pools
+    Map copied(assigned);
+    ASSERT_NE(copied.get_allocator(), assigned.get_allocator());
+    assigned.clear();
+    checkMap(copied, 0, 100);
+
+    std::swap(copied, moved);
+    checkMap(copied, 200, 300);
+    checkMap(moved, 0, 100);
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
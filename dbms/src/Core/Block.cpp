@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Columns/ColumnConst.h>
+#include <Columns/ColumnNullable.h>
 #include <Common/Exception.h>
 #include <Common/FieldVisitors.h>
 #include <Common/typeid_cast.h>
@@ -460,8 +461,15 @@ Names Block::getNames() const
 }
 
 
+static bool containsLowCardinality(const IColumn & column)
+{
+    if (column.isColumnNullable())
+        return static_cast<const ColumnNullable &>(column).getNestedColumn().isColumnLowCardinality();
+    return column.isColumnLowCardinality();
+}
+
 template <typename ReturnType>
-static ReturnType checkBlockStructure(const Block & lhs, const Block & rhs, const std::string & context_description)
+static ReturnType checkBlockStructure(const Block & lhs, const Block & rhs, const std::string & context_description, bool allow_low_cardinality = false)
 {
     auto on_error = [](const std::string & message [[maybe_unused]], int code [[maybe_unused]]) {
         if constexpr (std::is_same_v<ReturnType, void>)
@@ -497,6 +505,10 @@ static ReturnType checkBlockStructure(const Block & lhs, const Block & rhs, cons
             {
                 // FIXME: We enable return const column here, but find a good way to check equality.
             }
+            else if (allow_low_cardinality && (containsLowCardinality(*actual.column) || containsLowCardinality(*expected.column)))
+            {
+                // A dictionary-encoded string column is logically the same as a full string column.
+            }
             else
             {
                 return on_error("Block structure mismatch in " + context_description + " stream: different columns:\n"
@@ -629,9 +641,9 @@ bool blocksHaveEqualStructure(const Block & lhs, const Block & rhs)
 }
 
 
-void assertBlocksHaveEqualStructure(const Block & lhs, const Block & rhs, const std::string & context_description)
+void assertBlocksHaveEqualStructure(const Block & lhs, const Block & rhs, const std::string & context_description, bool allow_low_cardinality)
 {
-    checkBlockStructure<void>(lhs, rhs, context_description);
+    checkBlockStructure<void>(lhs, rhs, context_description, allow_low_cardinality);
 }
 
 
@@ -196,7 +196,9 @@ Block popBlocksListFront(BlocksList & blocks);
 bool blocksHaveEqualStructure(const Block & lhs, const Block & rhs);
 
 /// Throw exception when blocks are different.
-void assertBlocksHaveEqualStructure(const Block & lhs, const Block & rhs, const std::string & context_description);
+/// If `allow_low_cardinality` is true, a ColumnLowCardinality is considered the same as the full string column,
+/// which is used to check the blocks returned by a stream against its header.
+void assertBlocksHaveEqualStructure(const Block & lhs, const Block & rhs, const std::string & context_description, bool allow_low_cardinality = false);
 
 /// Calculate difference in structure of blocks and write description into output strings. NOTE It doesn't compare values of constant columns.
 void getBlocksDifference(const Block & lhs, const Block & rhs, std::string & out_lhs_diff, std::string & out_rhs_diff);
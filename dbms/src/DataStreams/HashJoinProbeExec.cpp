@@ -67,6 +67,16 @@ void HashJoinProbeExec::waitUntilAllProbeFinished()
     join->waitUntilAllProbeFinished();
 }
 
+bool HashJoinProbeExec::isAllBuildFinished()
+{
+    return join->isAllBuildFinished();
+}
+
+bool HashJoinProbeExec::isAllProbeFinished()
+{
+    return join->isAllProbeFinished();
+}
+
 void HashJoinProbeExec::restoreBuild()
 {
     restore_build_stream->readPrefix();
@@ -115,19 +125,24 @@ PartitionBlock HashJoinProbeExec::getProbeBlock()
 
 Block HashJoinProbeExec::probe()
 {
-    if (probe_process_info.all_rows_joined_finish)
-    {
-        auto partition_block = getProbeBlock();
-        if (partition_block)
-        {
-            join->checkTypes(partition_block.block);
-            probe_process_info.resetBlock(std::move(partition_block.block), partition_block.partition_index);
-        }
-        else
-        {
-            return {};
-        }
-    }
+    if (needPrepareProbeBlock() && !prepareProbeBlock())
+        return {};
+    return joinProbeBlock();
+}
+
+bool HashJoinProbeExec::prepareProbeBlock()
+{
+    assert(needPrepareProbeBlock());
+    auto partition_block = getProbeBlock();
+    if (!partition_block)
+        return false;
+    join->checkTypes(partition_block.block);
+    probe_process_info.resetBlock(std::move(partition_block.block), partition_block.partition_index);
+    return true;
+}
+
+Block HashJoinProbeExec::joinProbeBlock()
+{
     return join->joinBlock(probe_process_info);
 }
 
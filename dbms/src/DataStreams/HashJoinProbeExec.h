@@ -50,6 +50,10 @@ public:
 
     void waitUntilAllProbeFinished();
 
+    bool isAllBuildFinished();
+
+    bool isAllProbeFinished();
+
     HashJoinProbeExecPtr tryGetRestoreExec();
 
     void cancel();
@@ -61,6 +65,12 @@ public:
     void onProbeStart();
     // Returns empty block if probe finish.
     Block probe();
+    // `probe` is split into `prepareProbeBlock` and `joinProbeBlock` for the pipeline model,
+    // because `prepareProbeBlock` may read the spilled data from disk and should be executed in io thread.
+    bool needPrepareProbeBlock() const { return probe_process_info.all_rows_joined_finish; }
+    // Returns false if there is no more probe block.
+    bool prepareProbeBlock();
+    Block joinProbeBlock();
     // Returns true if the probe_exec ends.
     // Returns false if the probe_exec continues to execute.
     bool onProbeFinish();
@@ -106,7 +106,7 @@ Block IProfilingBlockInputStream::read(FilterPtr & res_filter, bool return_filte
     {
         Block header = getHeader();
         if (header)
-            assertBlocksHaveEqualStructure(res, header, getName());
+            assertBlocksHaveEqualStructure(res, header, getName(), /*allow_low_cardinality=*/true);
     }
 #endif
 
@@ -12,11 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/ColumnsCommon.h>
 #include <DataStreams/RuntimeFilter.h>
 #include <Interpreters/Set.h>
 #include <Storages/DeltaMerge/FilterParser/FilterParser.h>
 #include <common/logger_useful.h>
 
+#include <algorithm>
+
 namespace DB
 {
 
@@ -56,6 +59,11 @@ void RuntimeFilter::setINValuesSet(const std::shared_ptr<Set> & in_values_set_)
     in_values_set = in_values_set_;
 }
 
+void RuntimeFilter::setBloomFilterMaxValues(size_t bloom_filter_max_values_)
+{
+    bloom_filter_max_values = bloom_filter_max_values_;
+}
+
 void RuntimeFilter::build()
 {
     if (!DM::FilterParser::isRSFilterSupportType(target_expr.field_type().tp()))
@@ -101,14 +109,70 @@ void RuntimeFilter::updateValues(const ColumnWithTypeAndName & values, const Log
         }
         break;
     case tipb::MIN_MAX:
+    {
+        if (values.column->empty())
+            break;
+        Field block_min;
+        Field block_max;
+        values.column->getExtremes(block_min, block_max);
+        // All values are null
+        if (block_min.isNull())
+            break;
+        std::lock_guard<std::mutex> lock(values_mtx);
+        if (min_value.isNull() || block_min < min_value)
+            min_value = block_min;
+        if (max_value.isNull() || max_value < block_max)
+            max_value = block_max;
+        break;
+    }
     case tipb::BLOOM_FILTER:
-        // todo
+    {
+        ColumnPtr column = values.column;
+        if (ColumnPtr converted = column->convertToFullColumnIfConst())
+            column = converted;
+        std::lock_guard<std::mutex> lock(values_mtx);
+        DM::BloomFilterIndex::collectHashes(*column, nullptr, bloom_filter_hashes);
+        // Only distinct values are counted. Dedup only when the size is doubled since the last dedup,
+        // so that the hashes are not sorted again for every block once the limit is passed.
+        if (bloom_filter_hashes.size() > std::max(bloom_filter_max_values, 2 * bloom_filter_dedup_size))
+            dedupBloomFilterHashes(log);
         break;
     }
+    }
+}
+
+bool RuntimeFilter::dedupBloomFilterHashes(const LoggerPtr & log)
+{
+    std::sort(bloom_filter_hashes.begin(), bloom_filter_hashes.end());
+    bloom_filter_hashes.erase(std::unique(bloom_filter_hashes.begin(), bloom_filter_hashes.end()), bloom_filter_hashes.end());
+    bloom_filter_dedup_size = bloom_filter_hashes.size();
+    if (bloom_filter_hashes.size() <= bloom_filter_max_values)
+        return true;
+    std::string tmp_err_msg = fmt::format("The rf bloom filter values exceed the limit {}", bloom_filter_max_values);
+    std::vector<UInt64>().swap(bloom_filter_hashes);
+    updateStatus(RuntimeFilterStatus::FAILED, tmp_err_msg);
+    LOG_WARNING(log, "cancel runtime filter id:{}, reason: {} ", id, tmp_err_msg);
+    return false;
 }
 
 void RuntimeFilter::finalize(const LoggerPtr & log)
 {
+    if (isFailed())
+    {
+        return;
+    }
+    // The bloom filter must be built before the rf is ready, it is read-only after that.
+    if (rf_type == tipb::BLOOM_FILTER)
+    {
+        std::lock_guard<std::mutex> lock(values_mtx);
+        // The hashes may be not deduped since the limit is passed
+        if (bloom_filter_hashes.size() > bloom_filter_max_values && !dedupBloomFilterHashes(log))
+            return;
+        auto filter = std::make_shared<DM::BloomFilterIndex>();
+        filter->addPack(bloom_filter_hashes);
+        bloom_filter = filter;
+        std::vector<UInt64>().swap(bloom_filter_hashes);
+    }
     if (!updateStatus(RuntimeFilterStatus::READY))
     {
         return;
@@ -120,8 +184,10 @@ void RuntimeFilter::finalize(const LoggerPtr & log)
         rf_values_info = fmt::format("number of IN values:{}", in_values_set->getTotalRowCount());
         break;
     case tipb::MIN_MAX:
+        rf_values_info = fmt::format("min:{} max:{}", min_value.toString(), max_value.toString());
+        break;
     case tipb::BLOOM_FILTER:
-        // TODO
+        rf_values_info = fmt::format("bloom filter bytes:{}", bloom_filter->byteSize());
         break;
     }
     LOG_INFO(log, "finalize runtime filter id:{}, rf values info:{}", id, rf_values_info);
@@ -206,11 +272,36 @@ DM::RSOperatorPtr RuntimeFilter::parseToRSOperator(DM::ColumnDefines & columns_t
     case tipb::IN:
         return DM::FilterParser::parseRFInExpr(rf_type, target_expr, columns_to_read, in_values_set->getUniqueSetElements());
     case tipb::MIN_MAX:
+        return DM::FilterParser::parseRFMinMaxExpr(rf_type, target_expr, columns_to_read, min_value, max_value);
     case tipb::BLOOM_FILTER:
-        // TODO
+        // The bloom filter is applied row by row by `filterBlock`
     default:
         throw Exception("Unsupported rf type");
     }
 }
 
+bool RuntimeFilter::filterBlock(Block & block, const DM::ColumnDefines & columns_to_read) const
+{
+    if (rf_type != tipb::BLOOM_FILTER || !bloom_filter)
+        return false;
+    auto target_column = DM::FilterParser::getRFTargetColumnDefine(target_expr, columns_to_read);
+    if (!target_column || !block.has(target_column->name))
+        return false;
+
+    ColumnPtr column = block.getByName(target_column->name).column;
+    if (ColumnPtr converted = column->convertToFullColumnIfConst())
+        column = converted;
+    IColumn::Filter filter;
+    bloom_filter->checkRows(0, *column, filter);
+    size_t passed_rows = countBytesInFilter(filter);
+    if (passed_rows == block.rows())
+        return false;
+    for (size_t i = 0; i < block.columns(); ++i)
+    {
+        auto & col = block.getByPosition(i);
+        col.column = col.column->filter(filter, passed_rows);
+    }
+    return true;
+}
+
 } // namespace DB
\ No newline at end of file
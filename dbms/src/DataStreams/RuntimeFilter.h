@@ -18,6 +18,7 @@
 #include <Interpreters/Set.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
 #include <Storages/DeltaMerge/Filter/RSOperator.h>
+#include <Storages/DeltaMerge/Index/BloomFilterIndex.h>
 #include <tipb/executor.pb.h>
 
 namespace DB
@@ -60,6 +61,8 @@ public:
 
     void setINValuesSet(const std::shared_ptr<Set> & in_values_set_);
 
+    void setBloomFilterMaxValues(size_t bloom_filter_max_values_);
+
     void build();
 
     void updateValues(const ColumnWithTypeAndName & values, const LoggerPtr & log);
@@ -76,10 +79,20 @@ public:
 
     DM::RSOperatorPtr parseToRSOperator(DM::ColumnDefines & columns_to_read);
 
+    /// Whether the rf can be pushed down as a pack level rs operator.
+    bool isPackLevelFilter() const { return rf_type == tipb::IN || rf_type == tipb::MIN_MAX; }
+
+    /// Only for bloom filter rf, filter the rows of `block` which is read from `columns_to_read`.
+    /// Return false if nothing is filtered.
+    bool filterBlock(Block & block, const DM::ColumnDefines & columns_to_read) const;
+
     const int id;
 
 private:
     bool updateStatus(RuntimeFilterStatus status_, const std::string & reason = "");
+    // Dedup `bloom_filter_hashes` and fail the rf if the distinct values exceed the limit, require `values_mtx`.
+    // Returns false if the rf is failed.
+    bool dedupBloomFilterHashes(const LoggerPtr & log);
 
     tipb::Expr source_expr;
     tipb::Expr target_expr;
@@ -95,7 +108,19 @@ private:
     // only used for In predicate
     // thread safe
     SetPtr in_values_set;
-    // todo min max
+
+    // used for the min max and bloom filter while building
+    std::mutex values_mtx;
+    // only used for min max, null if no values
+    Field min_value;
+    Field max_value;
+    // only used for bloom filter
+    size_t bloom_filter_max_values = 0;
+    std::vector<UInt64> bloom_filter_hashes;
+    // the size of `bloom_filter_hashes` after the last dedup
+    size_t bloom_filter_dedup_size = 0;
+    // only used for bloom filter, built in finalize and read-only after that
+    DM::BloomFilterIndexPtr bloom_filter;
 
     // used for await or signal
     std::mutex inner_mutex;
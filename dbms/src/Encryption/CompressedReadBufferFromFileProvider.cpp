@@ -24,6 +24,27 @@ namespace ErrorCodes
 extern const int SEEK_POSITION_OUT_OF_BOUND;
 }
 
+namespace
+{
+size_t getChecksumFrameHeaderSize(ChecksumAlgo checksum_algorithm)
+{
+    switch (checksum_algorithm)
+    {
+    case ChecksumAlgo::None:
+        return sizeof(ChecksumFrame<Digest::None>);
+    case ChecksumAlgo::CRC32:
+        return sizeof(ChecksumFrame<Digest::CRC32>);
+    case ChecksumAlgo::CRC64:
+        return sizeof(ChecksumFrame<Digest::CRC64>);
+    case ChecksumAlgo::City128:
+        return sizeof(ChecksumFrame<Digest::City128>);
+    case ChecksumAlgo::XXH3:
+        return sizeof(ChecksumFrame<Digest::XXH3>);
+    }
+    return 0;
+}
+} // namespace
+
 template <bool has_checksum>
 bool CompressedReadBufferFromFileProvider<has_checksum>::nextImpl()
 {
@@ -77,6 +98,8 @@ CompressedReadBufferFromFileProvider<has_checksum>::CompressedReadBufferFromFile
     , p_file_in(
           createReadBufferFromFileBaseByFileProvider(file_provider, path, encryption_path, estimated_size, read_limiter_, checksum_algorithm, checksum_frame_size))
     , file_in(*p_file_in)
+    , frame_size(checksum_frame_size)
+    , frame_header_size(getChecksumFrameHeaderSize(checksum_algorithm))
 {
     this->compressed_in = &file_in;
 }
@@ -110,6 +133,21 @@ void CompressedReadBufferFromFileProvider<has_checksum>::seek(size_t offset_in_c
     }
 }
 
+template <bool has_checksum>
+IOUring::PrefetchRequest CompressedReadBufferFromFileProvider<has_checksum>::getPrefetchRequest(
+    size_t begin_offset_in_compressed_file,
+    size_t end_offset_in_compressed_file) const
+{
+    if (frame_size == 0)
+        return {file_in.getFD(), static_cast<off_t>(begin_offset_in_compressed_file), end_offset_in_compressed_file - begin_offset_in_compressed_file};
+
+    // Every frame in file has a header before the data.
+    const size_t frame_size_in_file = frame_header_size + frame_size;
+    const size_t begin_frame = begin_offset_in_compressed_file / frame_size;
+    const size_t end_frame = (end_offset_in_compressed_file + frame_size - 1) / frame_size;
+    return {file_in.getFD(), static_cast<off_t>(begin_frame * frame_size_in_file), (end_frame - begin_frame) * frame_size_in_file};
+}
+
 template <bool has_checksum>
 size_t CompressedReadBufferFromFileProvider<has_checksum>::readBig(char * to, size_t n)
 {
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <Common/Checksum.h>
+#include <Common/IOUring.h>
 #include <Encryption/FileProvider.h>
 #include <IO/CompressedReadBufferBase.h>
 #include <IO/ReadBufferFromFileBase.h>
@@ -36,6 +37,10 @@ struct CompressedSeekableReaderBuffer : public BufferWithOwnMemory<ReadBuffer>
 
     virtual void seek(size_t offset_in_compressed_file, size_t offset_in_decompressed_block) = 0;
 
+    /// Returns the range in file of the compressed data in [begin, end), used for prefetching.
+    /// The fd of the result is -1 if the file is not a local file.
+    virtual IOUring::PrefetchRequest getPrefetchRequest(size_t begin_offset_in_compressed_file, size_t end_offset_in_compressed_file) const = 0;
+
     CompressedSeekableReaderBuffer()
         : BufferWithOwnMemory<ReadBuffer>(0)
     {}
@@ -59,6 +64,9 @@ private:
     std::unique_ptr<ReadBufferFromFileBase> p_file_in;
     ReadBufferFromFileBase & file_in;
     size_t size_compressed = 0;
+    /// The size of checksum frames, 0 if the file is not split into frames.
+    size_t frame_size = 0;
+    size_t frame_header_size = 0;
 
     bool nextImpl() override;
 
@@ -87,6 +95,8 @@ public:
 
     size_t readBig(char * to, size_t n) override;
 
+    IOUring::PrefetchRequest getPrefetchRequest(size_t begin_offset_in_compressed_file, size_t end_offset_in_compressed_file) const override;
+
     void setProfileCallback(
         const ReadBufferFromFileBase::ProfileCallback & profile_callback_,
         clockid_t clock_type_ = CLOCK_MONOTONIC_COARSE) override
@@ -36,6 +36,11 @@ public:
 
     ssize_t pread(char * buf, size_t size, off_t offset) const override;
 
+    void afterReadFromFd(char * buf, size_t size, off_t offset) const override
+    {
+        stream->decrypt(offset, buf, size);
+    }
+
     void close() override
     {
         file->close();
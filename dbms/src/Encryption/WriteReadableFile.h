@@ -34,6 +34,10 @@ public:
 
     virtual ssize_t pread(char * buf, size_t size, off_t offset) const = 0;
 
+    // Process the data read from `getFd()` directly instead of by `pread`, e.g. by `IOUring::readBatch`.
+    // The encrypted file decrypts the data in place.
+    virtual void afterReadFromFd(char * /*buf*/, size_t /*size*/, off_t /*offset*/) const {}
+
     virtual int fsync() = 0;
 
     virtual int getFd() const = 0;
@@ -1154,7 +1154,16 @@ void DAGExpressionAnalyzer::appendRuntimeFilterProperties(RuntimeFilterPtr & run
         break;
     case tipb::MIN_MAX:
     case tipb::BLOOM_FILTER:
-        // todo
+        // The values of source column are compared with (min max) or hashed as (bloom filter) the values of target column directly,
+        // so only integer and date-like types are supported.
+        if (!DM::BloomFilterIndex::isSupportType(name_and_type.type) || removeNullable(name_and_type.type)->isString())
+        {
+            throw TiFlashException(Errors::Coprocessor::Unimplemented,
+                                   "The runtime filter doesn't support source expr type:{}, rf_id:{}",
+                                   name_and_type.type->getName(),
+                                   runtime_filter->id);
+        }
+        runtime_filter->setBloomFilterMaxValues(settings.rf_max_bloom_filter_values);
         break;
     }
 }
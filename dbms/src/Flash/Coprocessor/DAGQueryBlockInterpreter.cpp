@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Common/FailPoint.h>
+#include <Common/SipHash.h>
 #include <Common/ThresholdUtils.h>
 #include <Common/TiFlashException.h>
 #include <Core/NamesAndTypes.h>
@@ -23,6 +24,7 @@
 #include <DataStreams/HashJoinBuildBlockInputStream.h>
 #include <DataStreams/HashJoinProbeBlockInputStream.h>
 #include <DataStreams/LimitBlockInputStream.h>
+#include <DataStreams/MergingAggregatedMemoryEfficientBlockInputStream.h>
 #include <DataStreams/MockExchangeSenderInputStream.h>
 #include <DataStreams/MockTableScanBlockInputStream.h>
 #include <DataStreams/NullBlockInputStream.h>
@@ -209,10 +211,15 @@ void DAGQueryBlockInterpreter::handleTableScan(const TiDBTableScan & table_scan,
     }
     else
     {
-        DAGStorageInterpreter storage_interpreter(context, table_scan, filter_conditions, max_streams);
+        // Only try to compute the aggregation segment by segment when it is right above the table scan.
+        const bool try_segment_aggregation = query_block.aggregation != nullptr
+            && !enableFineGrainedShuffle(query_block.aggregation->fine_grained_shuffle_stream_count());
+        DAGStorageInterpreter storage_interpreter(context, table_scan, filter_conditions, max_streams, try_segment_aggregation);
         storage_interpreter.execute(pipeline);
 
         analyzer = std::move(storage_interpreter.analyzer);
+        segment_aggregation = std::move(storage_interpreter.segment_aggregation);
+        segment_aggregation_streams = std::move(storage_interpreter.segment_aggregation_streams);
     }
 }
 
@@ -296,6 +303,7 @@ void DAGQueryBlockInterpreter::handleJoin(const tipb::Join & join, DAGPipeline &
         join_non_equal_conditions,
         max_block_size,
         settings.shallow_copy_cross_probe_threshold,
+        settings.join_probe_batch_size,
         match_helper_name,
         flag_mapped_entry_helper_name,
         0,
@@ -469,6 +477,125 @@ void DAGQueryBlockInterpreter::executeAggregation(
     }
 }
 
+/// The filter and the partial aggregation are computed by the local streams of storage segment by segment,
+/// so that the partial results of the segments whose data is not changed can be read from SegmentAggCache.
+/// Then the partial results are merged here.
+void DAGQueryBlockInterpreter::executeSegmentAggregation(
+    DAGPipeline & pipeline,
+    const ExpressionActionsPtr & expression_actions_ptr,
+    const Names & key_names,
+    const TiDB::TiDBCollators & collators,
+    AggregateDescriptions & aggregate_descriptions,
+    bool is_final_agg)
+{
+    assert(segment_aggregation && !segment_aggregation_streams.empty());
+    const Settings & settings = context.getSettingsRef();
+
+    // The streams of storage output the table scan columns before segment_aggregation is initialized.
+    const Block scan_header = segment_aggregation_streams[0]->getHeader();
+    ExpressionActionsPtr before_where;
+    String filter_column_name;
+    ExpressionActionsPtr project_after_where;
+    const auto filter_conditions = FilterConditions::filterConditionsFrom(query_block.selection_name, query_block.selection);
+    if (filter_conditions.hasValue() && likely(!settings.force_push_down_all_filters_to_scan))
+    {
+        NamesAndTypes source_columns;
+        for (const auto & col : scan_header)
+            source_columns.emplace_back(col.name, col.type);
+        DAGExpressionAnalyzer filter_analyzer(std::move(source_columns), context);
+        std::tie(before_where, filter_column_name, project_after_where) = ::DB::buildPushDownFilter(filter_conditions.conditions, filter_analyzer);
+    }
+
+    Block before_agg_header = expression_actions_ptr->getSampleBlock();
+    AggregationInterpreterHelper::fillArgColumnNumbers(aggregate_descriptions, before_agg_header);
+    SpillConfig spill_config(
+        context.getTemporaryPath(),
+        fmt::format("{}_aggregation", log->identifier()),
+        settings.max_cached_data_bytes_in_spiller,
+        settings.max_spilled_rows_per_file,
+        settings.max_spilled_bytes_per_file,
+        context.getFileProvider());
+    auto params = AggregationInterpreterHelper::buildParams(
+        context,
+        before_agg_header,
+        segment_aggregation_streams.size(),
+        1,
+        key_names,
+        collators,
+        aggregate_descriptions,
+        is_final_agg,
+        spill_config);
+    // The partial result of a segment is kept in memory to be cached, so it is never spilled.
+    params.setMaxBytesBeforeExternalGroupBy(0);
+
+    const auto req_id = log->identifier();
+    auto transform = [=](const BlockInputStreamPtr & segment_stream) -> BlockInputStreamPtr {
+        BlockInputStreamPtr stream = segment_stream;
+        if (before_where)
+        {
+            stream = std::make_shared<FilterBlockInputStream>(stream, before_where, filter_column_name, req_id);
+            stream = std::make_shared<ExpressionBlockInputStream>(stream, project_after_where, req_id);
+        }
+        stream = std::make_shared<ExpressionBlockInputStream>(stream, expression_actions_ptr, req_id);
+        return std::make_shared<AggregatingBlockInputStream>(stream, params, /*final*/ false, req_id);
+    };
+    segment_aggregation->init(genSegmentAggregationFingerprint(is_final_agg), params.getHeader(/*final*/ false), transform);
+
+    pipeline.streams = segment_aggregation_streams;
+    if (key_names.empty() && !params.empty_result_for_aggregation_by_empty_set)
+    {
+        // Make sure there is one row in the result even if no segment is read.
+        pipeline.streams.push_back(transform(std::make_shared<NullBlockInputStream>(scan_header)));
+    }
+
+    BlockInputStreamPtr stream = std::make_shared<MergingAggregatedMemoryEfficientBlockInputStream>(
+        pipeline.streams,
+        params,
+        true,
+        max_streams,
+        settings.aggregation_memory_efficient_merge_threads ? static_cast<size_t>(settings.aggregation_memory_efficient_merge_threads) : static_cast<size_t>(settings.max_threads),
+        req_id);
+    stream->setExtraInfo("merge segment aggregation");
+    pipeline.streams.resize(1);
+    pipeline.firstStream() = std::move(stream);
+
+    // should record for agg before restore concurrency. See #3804.
+    recordProfileStreams(pipeline, query_block.aggregation_name);
+    restorePipelineConcurrency(pipeline);
+}
+
+/// The partial results of segments can be shared by the aggregations with the same fingerprint.
+String DAGQueryBlockInterpreter::genSegmentAggregationFingerprint(bool is_final_agg) const
+{
+    SipHash hash;
+    auto update_executor = [&](const tipb::Executor * executor) {
+        if (executor == nullptr)
+        {
+            hash.update(static_cast<UInt8>(0));
+            return;
+        }
+        // The executor ids are different between queries, and they don't affect the result.
+        tipb::Executor copy = *executor;
+        copy.clear_executor_id();
+        hash.update(copy.SerializeAsString());
+    };
+    update_executor(query_block.source);
+    update_executor(query_block.selection);
+    update_executor(query_block.aggregation);
+    hash.update(is_final_agg);
+    hash.update(context.getSettingsRef().force_push_down_all_filters_to_scan.get());
+    hash.update(AggregationInterpreterHelper::isGroupByCollationSensitive(context));
+    hash.update(dagContext().getFlags());
+    hash.update(dagContext().getSQLMode());
+    hash.update(context.getTimezoneInfo().timezone_name);
+    hash.update(context.getTimezoneInfo().timezone_offset);
+
+    UInt64 lo;
+    UInt64 hi;
+    hash.get128(lo, hi);
+    return fmt::format("{:016x}{:016x}", hi, lo);
+}
+
 void DAGQueryBlockInterpreter::executeWindowOrder(DAGPipeline & pipeline, SortDescription sort_desc, bool enable_fine_grained_shuffle)
 {
     orderStreams(pipeline, max_streams, sort_desc, 0, enable_fine_grained_shuffle, context, log);
@@ -679,7 +806,10 @@ void DAGQueryBlockInterpreter::executeImpl(DAGPipeline & pipeline)
     if (res.before_aggregation)
     {
         // execute aggregation
-        executeAggregation(pipeline, res.before_aggregation, res.aggregation_keys, res.aggregation_collators, res.aggregate_descriptions, res.is_final_agg, res.enable_fine_grained_shuffle_agg);
+        if (segment_aggregation && !res.before_where && !res.enable_fine_grained_shuffle_agg)
+            executeSegmentAggregation(pipeline, res.before_aggregation, res.aggregation_keys, res.aggregation_collators, res.aggregate_descriptions, res.is_final_agg);
+        else
+            executeAggregation(pipeline, res.before_aggregation, res.aggregation_keys, res.aggregation_collators, res.aggregate_descriptions, res.is_final_agg, res.enable_fine_grained_shuffle_agg);
     }
     if (res.before_having)
     {
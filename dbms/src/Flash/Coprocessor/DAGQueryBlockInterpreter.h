@@ -85,6 +85,14 @@ private:
         AggregateDescriptions & aggregate_descriptions,
         bool is_final_agg,
         bool enable_fine_grained_shuffle);
+    void executeSegmentAggregation(
+        DAGPipeline & pipeline,
+        const ExpressionActionsPtr & expression_actions_ptr,
+        const Names & key_names,
+        const TiDB::TiDBCollators & collators,
+        AggregateDescriptions & aggregate_descriptions,
+        bool is_final_agg);
+    String genSegmentAggregationFingerprint(bool is_final_agg) const;
     void executeProject(DAGPipeline & pipeline, NamesWithAliases & project_cols, const String & extra_info = "");
     void handleExchangeSender(DAGPipeline & pipeline);
     void handleMockExchangeSender(DAGPipeline & pipeline);
@@ -108,6 +116,10 @@ private:
 
     std::unique_ptr<DAGExpressionAnalyzer> analyzer;
 
+    /// Transferred from DAGStorageInterpreter, see `DAGStorageInterpreter::segment_aggregation`.
+    DM::SegmentAggregationPtr segment_aggregation;
+    BlockInputStreams segment_aggregation_streams;
+
     LoggerPtr log;
 };
 } // namespace DB
@@ -257,11 +257,13 @@ DAGStorageInterpreter::DAGStorageInterpreter(
     Context & context_,
     const TiDBTableScan & table_scan_,
     const FilterConditions & filter_conditions_,
-    size_t max_streams_)
+    size_t max_streams_,
+    bool try_segment_aggregation_)
     : context(context_)
     , table_scan(table_scan_)
     , filter_conditions(filter_conditions_)
     , max_streams(max_streams_)
+    , try_segment_aggregation(try_segment_aggregation_)
     , log(Logger::get(context.getDAGContext()->log ? context.getDAGContext()->log->identifier() : ""))
     , logical_table_id(table_scan.getLogicalTableID())
     , tmt(context.getTMTContext())
@@ -380,10 +382,14 @@ void DAGStorageInterpreter::executeImpl(DAGPipeline & pipeline)
     dag_context.scan_context_map[table_scan.getTableScanExecutorID()] = scan_context;
     mvcc_query_info->scan_context = scan_context;
 
+    if (canSegmentAggregation())
+        segment_aggregation = std::make_shared<DM::SegmentAggregation>();
+
     if (!mvcc_query_info->regions_query_info.empty())
     {
         buildLocalStreams(pipeline, context.getSettingsRef().max_block_size);
     }
+    segment_aggregation_streams = pipeline.streams;
 
     // Should build `remote_requests` and `null_stream` under protect of `table_structure_lock`.
     auto null_stream_if_empty = std::make_shared<NullBlockInputStream>(storage_for_logical_table->getSampleBlockForColumns(required_columns));
@@ -453,12 +459,24 @@ void DAGStorageInterpreter::executeImpl(DAGPipeline & pipeline)
         recordProfileStreams(pipeline, table_scan.getTableScanExecutorID());
         if (filter_conditions.hasValue())
             recordProfileStreams(pipeline, filter_conditions.executor_id);
+        segment_aggregation.reset();
+        segment_aggregation_streams.clear();
         return;
     }
     /// handle timezone/duration cast for local and remote table scan.
-    executeCastAfterTableScan(remote_read_streams_start_index, pipeline);
+    bool has_cast = executeCastAfterTableScan(remote_read_streams_start_index, pipeline);
     recordProfileStreams(pipeline, table_scan.getTableScanExecutorID());
 
+    /// The partial aggregation can only be pushed down to the segments if all the data is read by the local streams
+    /// of storage and the streams are not wrapped by other streams than the pushed down filter.
+    /// Most of the cases are excluded by `canSegmentAggregation` before building the streams, only the regions
+    /// that fail to be read locally while building the streams are found here.
+    if (has_cast || !remote_requests.empty() || segment_aggregation_streams.empty())
+    {
+        segment_aggregation.reset();
+        segment_aggregation_streams.clear();
+    }
+
     /// handle filter conditions for local and remote table scan.
     /// If force_push_down_all_filters_to_scan is set, we will build all filter conditions in scan.
     /// todo add runtime filter in Filter input stream
@@ -469,6 +487,37 @@ void DAGStorageInterpreter::executeImpl(DAGPipeline & pipeline)
     }
 }
 
+bool DAGStorageInterpreter::canSegmentAggregation() const
+{
+    if (!try_segment_aggregation)
+        return false;
+    const auto & settings = context.getSettingsRef();
+    if (!settings.dt_enable_segment_agg_cache || !context.getSegmentAggCache())
+        return false;
+    // The results of segments are merged without order, and they can not be reused if the rows read
+    // from a segment depend on the other parts of the query.
+    if (dagContext().is_disaggregated_task
+        || table_scan.isPartitionTableScan()
+        || table_scan.keepOrder()
+        || !table_scan.getRuntimeFilterIDs().empty()
+        || !generated_column_infos.empty())
+        return false;
+
+    // Decide it before building the streams, because the storage disables the read thread and the split of
+    // segment read tasks for the segment aggregation. The streams must not be wrapped by the casts, and all
+    // the regions must be read locally.
+    if (std::find(may_need_add_cast_column.begin(), may_need_add_cast_column.end(), true) != may_need_add_cast_column.end())
+        return false;
+    if (mvcc_query_info->regions_query_info.empty() || !region_retry_from_local_region.empty())
+        return false;
+    for (const auto physical_table_id : table_scan.getPhysicalTableIDs())
+    {
+        if (!dagContext().getTableRegionsInfoByTableID(physical_table_id).remote_regions.empty())
+            return false;
+    }
+    return true;
+}
+
 // Apply learner read to ensure we can get strong consistent with TiKV Region
 // leaders. If the local Regions do not match the requested Regions, then build
 // request to retry fetching data from other nodes.
@@ -524,7 +573,7 @@ void DAGStorageInterpreter::executeCastAfterTableScan(
     }
 }
 
-void DAGStorageInterpreter::executeCastAfterTableScan(
+bool DAGStorageInterpreter::executeCastAfterTableScan(
     size_t remote_read_streams_start_index,
     DAGPipeline & pipeline)
 {
@@ -542,6 +591,7 @@ void DAGStorageInterpreter::executeCastAfterTableScan(
             stream->setExtraInfo("cast after local tableScan");
         }
     }
+    return has_cast;
 }
 
 std::vector<pingcap::coprocessor::CopTask> DAGStorageInterpreter::buildCopTasks(const std::vector<RemoteRequest> & remote_requests)
@@ -771,6 +821,8 @@ std::unordered_map<TableID, SelectQueryInfo> DAGStorageInterpreter::generateSele
         query_info.req_id = fmt::format("{} table_id={}", log->identifier(), table_id);
         query_info.keep_order = table_scan.keepOrder();
         query_info.is_fast_scan = table_scan.isFastScan();
+        query_info.enable_low_cardinality = table_scan.isLowCardinalityEnabled() && context.getSettingsRef().dt_enable_low_cardinality_string;
+        query_info.segment_aggregation = segment_aggregation;
         return query_info;
     };
     RUNTIME_CHECK_MSG(mvcc_query_info->scan_context != nullptr, "Unexpected null scan_context");
@@ -22,6 +22,7 @@
 #include <Flash/Coprocessor/TiDBTableScan.h>
 #include <Flash/Pipeline/Exec/PipelineExecBuilder.h>
 #include <Storages/DeltaMerge/Remote/DisaggSnapshot_fwd.h>
+#include <Storages/DeltaMerge/SegmentAggCache.h>
 #include <Storages/RegionQueryInfo.h>
 #include <Storages/SelectQueryInfo.h>
 #include <Storages/TableLockHolder.h>
@@ -47,7 +48,8 @@ public:
         Context & context_,
         const TiDBTableScan & table_scan,
         const FilterConditions & filter_conditions_,
-        size_t max_streams_);
+        size_t max_streams_,
+        bool try_segment_aggregation_ = false);
 
     DISALLOW_MOVE(DAGStorageInterpreter);
 
@@ -59,6 +61,12 @@ public:
 
     std::unique_ptr<DAGExpressionAnalyzer> analyzer;
 
+    /// Not null if the aggregation above the table scan can be computed segment by segment.
+    /// `segment_aggregation_streams` are the local streams of the storage, they output the partial aggregation
+    /// results of segments after `segment_aggregation` is initialized. See `DM::SegmentAggregation`.
+    DM::SegmentAggregationPtr segment_aggregation;
+    BlockInputStreams segment_aggregation_streams;
+
 private:
     struct StorageWithStructureLock
     {
@@ -119,7 +127,8 @@ private:
         PipelineExecGroupBuilder & group_builder,
         const std::vector<RemoteRequest> & remote_requests);
 
-    void executeCastAfterTableScan(
+    /// Return whether any cast is added.
+    bool executeCastAfterTableScan(
         size_t remote_read_streams_start_index,
         DAGPipeline & pipeline);
 
@@ -130,6 +139,8 @@ private:
 
     void prepare();
 
+    bool canSegmentAggregation() const;
+
     void executeImpl(DAGPipeline & pipeline);
 
     void executeImpl(PipelineExecutorStatus & exec_status, PipelineExecGroupBuilder & group_builder);
@@ -147,6 +158,7 @@ private:
     const TiDBTableScan & table_scan;
     const FilterConditions & filter_conditions;
     const size_t max_streams;
+    const bool try_segment_aggregation;
     LoggerPtr log;
 
     /// derived from other members, doesn't change during DAGStorageInterpreter's lifetime
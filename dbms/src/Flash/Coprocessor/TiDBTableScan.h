@@ -66,6 +66,17 @@ public:
         return is_fast_scan;
     }
 
+    /// Only set when the output of the table scan is only consumed by a filter and an aggregation,
+    /// which can work on dictionary-encoded string columns.
+    void setEnableLowCardinality(bool enable_low_cardinality_)
+    {
+        enable_low_cardinality = enable_low_cardinality_;
+    }
+    bool isLowCardinalityEnabled() const
+    {
+        return enable_low_cardinality;
+    }
+
     const tipb::Executor * getTableScanPB() const
     {
         return table_scan;
@@ -106,6 +117,7 @@ private:
 
     bool keep_order;
     bool is_fast_scan;
+    bool enable_low_cardinality = false;
     std::vector<Int32> runtime_filter_ids;
     int max_wait_time_ms;
 };
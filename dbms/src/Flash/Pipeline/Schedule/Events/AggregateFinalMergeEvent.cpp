@@ -0,0 +1,33 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Pipeline/Schedule/Events/AggregateFinalMergeEvent.h>
+#include <Flash/Pipeline/Schedule/Tasks/AggregateFinalMergeTask.h>
+#include <Operators/AggregateContext.h>
+
+namespace DB
+{
+void AggregateFinalMergeEvent::scheduleImpl()
+{
+    assert(agg_context);
+    agg_context->initParallelMerge();
+    for (size_t bucket_num = 0; bucket_num < static_cast<size_t>(MergingBuckets::NUM_BUCKETS); ++bucket_num)
+        addTask(std::make_unique<AggregateFinalMergeTask>(mem_tracker, log->identifier(), exec_status, shared_from_this(), agg_context, bucket_num));
+}
+
+void AggregateFinalMergeEvent::finishImpl()
+{
+    agg_context.reset();
+}
+} // namespace DB
@@ -0,0 +1,34 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Pipeline/Schedule/Events/HashJoinFinalSpillEvent.h>
+#include <Flash/Pipeline/Schedule/Tasks/HashJoinFinalSpillTask.h>
+#include <Interpreters/Join.h>
+
+namespace DB
+{
+void HashJoinFinalSpillEvent::scheduleImpl()
+{
+    assert(join);
+    for (auto partition_index : partition_indexes)
+        addTask(std::make_unique<HashJoinFinalSpillTask>(mem_tracker, log->identifier(), exec_status, shared_from_this(), join, partition_index));
+}
+
+void HashJoinFinalSpillEvent::finishImpl()
+{
+    /// All partitions have been spilled, the build spiller can be finished now.
+    join->finishBuildSpill();
+    join.reset();
+}
+} // namespace DB
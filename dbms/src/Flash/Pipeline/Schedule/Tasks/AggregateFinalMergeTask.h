@@ -0,0 +1,44 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Flash/Pipeline/Schedule/Tasks/EventTask.h>
+
+namespace DB
+{
+class AggregateContext;
+using AggregateContextPtr = std::shared_ptr<AggregateContext>;
+
+class AggregateFinalMergeTask : public EventTask
+{
+public:
+    AggregateFinalMergeTask(
+        MemoryTrackerPtr mem_tracker_,
+        const String & req_id,
+        PipelineExecutorStatus & exec_status_,
+        const EventPtr & event_,
+        AggregateContextPtr agg_context_,
+        size_t bucket_num_);
+
+protected:
+    ExecTaskStatus doExecuteImpl() override;
+
+    void doFinalizeImpl() override;
+
+private:
+    AggregateContextPtr agg_context;
+    size_t bucket_num;
+};
+} // namespace DB
@@ -0,0 +1,44 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Flash/Pipeline/Schedule/Tasks/IOEventTask.h>
+
+namespace DB
+{
+class Join;
+using JoinPtr = std::shared_ptr<Join>;
+
+class HashJoinFinalSpillTask : public IOEventTask
+{
+public:
+    HashJoinFinalSpillTask(
+        MemoryTrackerPtr mem_tracker_,
+        const String & req_id,
+        PipelineExecutorStatus & exec_status_,
+        const EventPtr & event_,
+        JoinPtr join_,
+        size_t partition_index_);
+
+protected:
+    ExecTaskStatus doExecuteIOImpl() override;
+
+    void doFinalizeImpl() override;
+
+private:
+    JoinPtr join;
+    size_t partition_index;
+};
+} // namespace DB
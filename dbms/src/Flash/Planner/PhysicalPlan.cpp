@@ -60,6 +60,17 @@ bool pushDownSelection(Context & context, const PhysicalPlanNodePtr & plan, cons
     }
     return false;
 }
+
+/// The aggregation and filter can work on dictionary-encoded string columns, let the table scan
+/// under them return low-cardinality string columns in that format.
+void enableLowCardinalityForAggregation(const PhysicalPlanNodePtr & plan)
+{
+    auto node = plan;
+    if (node->tp() == PlanType::Filter)
+        node = node->children(0);
+    if (node->tp() == PlanType::TableScan)
+        std::static_pointer_cast<PhysicalTableScan>(node)->enableLowCardinality();
+}
 } // namespace
 
 void PhysicalPlan::build(const tipb::DAGRequest * dag_request)
@@ -115,9 +126,13 @@ void PhysicalPlan::build(const tipb::Executor * executor)
     case tipb::ExecType::TypeStreamAgg:
         RUNTIME_CHECK_MSG(executor->aggregation().group_by_size() == 0, "Group by key is not supported in StreamAgg");
     case tipb::ExecType::TypeAggregation:
+    {
         GET_METRIC(tiflash_coprocessor_executor_count, type_agg).Increment();
-        pushBack(PhysicalAggregation::build(context, executor_id, log, executor->aggregation(), FineGrainedShuffle(executor), popBack()));
+        auto child = popBack();
+        enableLowCardinalityForAggregation(child);
+        pushBack(PhysicalAggregation::build(context, executor_id, log, executor->aggregation(), FineGrainedShuffle(executor), child));
         break;
+    }
     case tipb::ExecType::TypeExchangeSender:
     {
         GET_METRIC(tiflash_coprocessor_executor_count, type_exchange_sender).Increment();
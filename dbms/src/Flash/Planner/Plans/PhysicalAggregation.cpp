@@ -194,8 +194,16 @@ void PhysicalAggregation::buildPipelineExecGroup(
         aggregate_descriptions,
         is_final_agg,
         spill_config);
+    // Only the partial aggregation can bypass the hash table, the final aggregation will merge the output rows with the same key.
+    const auto & settings = context.getSettingsRef();
+    size_t bypass_sample_rows = is_final_agg ? 0 : settings.partial_agg_bypass_sample_rows;
     group_builder.transform([&](auto & builder) {
-        builder.appendTransformOp(std::make_unique<LocalAggregateTransform>(exec_status, log->identifier(), params));
+        builder.appendTransformOp(std::make_unique<LocalAggregateTransform>(
+            exec_status,
+            log->identifier(),
+            params,
+            bypass_sample_rows,
+            settings.partial_agg_bypass_ratio));
     });
 
     executeExpression(exec_status, group_builder, expr_after_agg, log);
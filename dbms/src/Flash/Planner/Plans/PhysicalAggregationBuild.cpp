@@ -15,6 +15,8 @@
 #include <Flash/Coprocessor/AggregationInterpreterHelper.h>
 #include <Flash/Coprocessor/InterpreterUtils.h>
 #include <Flash/Executor/PipelineExecutorStatus.h>
+#include <Flash/Pipeline/Schedule/Events/AggregateFinalConvertEvent.h>
+#include <Flash/Pipeline/Schedule/Events/AggregateFinalMergeEvent.h>
 #include <Flash/Pipeline/Schedule/Events/AggregateFinalSpillEvent.h>
 #include <Flash/Planner/Plans/PhysicalAggregationBuild.h>
 #include <Interpreters/Context.h>
@@ -56,6 +58,7 @@ void PhysicalAggregationBuild::buildPipelineExecGroup(
         is_final_agg,
         spill_config);
     aggregate_context->initBuild(params, concurrency, /*hook=*/[&]() { return exec_status.isCancelled(); });
+    enable_parallel_final_merge = context.getSettingsRef().enable_parallel_agg_final_merge;
 
     size_t build_index = 0;
     group_builder.transform([&](auto & builder) {
@@ -66,7 +69,7 @@ void PhysicalAggregationBuild::buildPipelineExecGroup(
 EventPtr PhysicalAggregationBuild::doSinkComplete(PipelineExecutorStatus & exec_status)
 {
     if (!aggregate_context->hasSpilledData())
-        return nullptr;
+        return mergeInParallel(exec_status);
 
     /// Currently, the aggregation spill algorithm requires all bucket data to be spilled,
     /// so a new event is added here to execute the final spill.
@@ -88,4 +91,21 @@ EventPtr PhysicalAggregationBuild::doSinkComplete(PipelineExecutorStatus & exec_
     }
     return nullptr;
 }
+
+EventPtr PhysicalAggregationBuild::mergeInParallel(PipelineExecutorStatus & exec_status)
+{
+    if (!enable_parallel_final_merge || !aggregate_context->canMergeInParallel())
+        return nullptr;
+
+    /// The two-level data is merged by bucket in parallel before convergent.
+    /// If some of the data is still single level, convert them to two-level in parallel first.
+    /// ...──►AggregateBuildSinkOp──┐                                                            ┌──►AggregateFinalMergeTask[bucket 0]
+    /// ...──►AggregateBuildSinkOp──┼──►[AggregateFinalConvertEvent]──►AggregateFinalMergeEvent──┼──►...
+    /// ...──►AggregateBuildSinkOp──┘                                                            └──►AggregateFinalMergeTask[bucket 255]
+    auto mem_tracker = current_memory_tracker ? current_memory_tracker->shared_from_this() : nullptr;
+    auto indexes = aggregate_context->getIndexesToConvertToTwoLevel();
+    if (!indexes.empty())
+        return std::make_shared<AggregateFinalConvertEvent>(exec_status, mem_tracker, log->identifier(), aggregate_context, std::move(indexes));
+    return std::make_shared<AggregateFinalMergeEvent>(exec_status, mem_tracker, log->identifier(), aggregate_context);
+}
 } // namespace DB
@@ -58,6 +58,8 @@ public:
 private:
     EventPtr doSinkComplete(PipelineExecutorStatus & exec_status) override;
 
+    EventPtr mergeInParallel(PipelineExecutorStatus & exec_status);
+
     DISABLE_USELESS_FUNCTION_FOR_BREAKER
 
 private:
@@ -67,5 +69,6 @@ private:
     bool is_final_agg;
     AggregateDescriptions aggregate_descriptions;
     AggregateContextPtr aggregate_context;
+    bool enable_parallel_final_merge = false;
 };
 } // namespace DB
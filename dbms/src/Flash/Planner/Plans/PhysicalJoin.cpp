@@ -122,12 +122,6 @@ PhysicalPlanNodePtr PhysicalJoin::build(
 
     const Settings & settings = context.getSettingsRef();
     size_t max_bytes_before_external_join = settings.max_bytes_before_external_join;
-    if (settings.enforce_enable_pipeline && max_bytes_before_external_join > 0)
-    {
-        // Currently, the pipeline model does not support disk-based join, so when enforce_enable_pipeline is true, the disk-based join will be disabled.
-        max_bytes_before_external_join = 0;
-        LOG_WARNING(log, "Pipeline model does not support disk-based join, so set max_bytes_before_external_join = 0");
-    }
     SpillConfig build_spill_config(context.getTemporaryPath(), fmt::format("{}_hash_join_0_build", log->identifier()), settings.max_cached_data_bytes_in_spiller, settings.max_spilled_rows_per_file, settings.max_spilled_bytes_per_file, context.getFileProvider());
     SpillConfig probe_spill_config(context.getTemporaryPath(), fmt::format("{}_hash_join_0_probe", log->identifier()), settings.max_cached_data_bytes_in_spiller, settings.max_spilled_rows_per_file, settings.max_spilled_bytes_per_file, context.getFileProvider());
     size_t max_block_size = settings.max_block_size;
@@ -159,6 +153,7 @@ PhysicalPlanNodePtr PhysicalJoin::build(
         join_non_equal_conditions,
         max_block_size,
         settings.shallow_copy_cross_probe_threshold,
+        settings.join_probe_batch_size,
         match_helper_name,
         flag_mapped_entry_helper_name,
         0,
@@ -252,6 +247,10 @@ void PhysicalJoin::buildPipeline(
     Context & context,
     PipelineExecutorStatus & exec_status)
 {
+    // In the pipeline model, the spilled data is flushed by io threads.
+    // In fine grained mode, `PhysicalJoinBuild::doSinkComplete` will not be called, so the final build spill is done by the last `HashJoinBuildSink` in io thread.
+    join_ptr->setDelaySpill(/*delay_final_build_spill=*/!fine_grained_shuffle.enable());
+
     // Break the pipeline for join build.
     auto join_build = std::make_shared<PhysicalJoinBuild>(
         executor_id,
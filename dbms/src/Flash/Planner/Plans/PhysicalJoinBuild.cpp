@@ -14,6 +14,7 @@
 
 #include <Flash/Coprocessor/InterpreterUtils.h>
 #include <Flash/Pipeline/Exec/PipelineExecBuilder.h>
+#include <Flash/Pipeline/Schedule/Events/HashJoinFinalSpillEvent.h>
 #include <Flash/Planner/Plans/PhysicalJoinBuild.h>
 #include <Operators/HashJoinBuildSink.h>
 
@@ -34,4 +35,23 @@ void PhysicalJoinBuild::buildPipelineExecGroup(
     join_ptr->initBuild(group_builder.getCurrentHeader(), group_builder.concurrency());
     join_ptr->setInitActiveBuildThreads();
 }
+
+EventPtr PhysicalJoinBuild::doSinkComplete(PipelineExecutorStatus & exec_status)
+{
+    if (!join_ptr->isEnableSpill())
+        return nullptr;
+
+    /// The spilled partitions need to spill all the remaining build data before probe,
+    /// so a new event is added here to execute the final spill in parallel.
+    /// ...──►HashJoinBuildSink[local spill]──┐                                         ┌──►HashJoinFinalSpillTask
+    /// ...──►HashJoinBuildSink[local spill]──┼──►[final spill]HashJoinFinalSpillEvent──┼──►HashJoinFinalSpillTask
+    /// ...──►HashJoinBuildSink[local spill]──┘                                         └──►HashJoinFinalSpillTask
+    auto partition_indexes = join_ptr->getSpilledPartitionIndexesWithLock();
+    if (!partition_indexes.empty())
+    {
+        auto mem_tracker = current_memory_tracker ? current_memory_tracker->shared_from_this() : nullptr;
+        return std::make_shared<HashJoinFinalSpillEvent>(exec_status, mem_tracker, log->identifier(), join_ptr, std::move(partition_indexes));
+    }
+    return nullptr;
+}
 } // namespace DB
@@ -43,6 +43,8 @@ public:
         Context & /*context*/,
         size_t /*concurrency*/) override;
 
+    EventPtr doSinkComplete(PipelineExecutorStatus & exec_status) override;
+
 private:
     DISABLE_USELESS_FUNCTION_FOR_BREAKER
 
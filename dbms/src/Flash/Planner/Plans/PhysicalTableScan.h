@@ -49,6 +49,9 @@ public:
 
     const String & getFilterConditionsId() const;
 
+    /// The output is only filtered and aggregated, so that the storage can return dictionary-encoded string columns.
+    void enableLowCardinality() { tidb_table_scan.setEnableLowCardinality(true); }
+
     void buildPipelineExecGroup(
         PipelineExecutorStatus & /*exec_status*/,
         PipelineExecGroupBuilder & group_builder,
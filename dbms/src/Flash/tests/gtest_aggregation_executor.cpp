@@ -571,6 +571,37 @@ try
 }
 CATCH
 
+TEST_F(AggExecutorTestRunner, ParallelFinalMerge)
+try
+{
+    /// The parallel final merge of two-level data in the pipeline model should return the same result as
+    /// the merge in convergent.
+    std::vector<String> tables{"big_table_1", "big_table_2", "big_table_3", "big_table_4"};
+    std::vector<size_t> concurrences{1, 2, 10};
+    context.context->setSetting("group_by_two_level_threshold_bytes", Field(static_cast<UInt64>(0)));
+    context.context->setSetting("group_by_two_level_threshold", Field(static_cast<UInt64>(1)));
+    enablePipeline(true);
+    for (const auto & table : tables)
+    {
+        std::vector<std::shared_ptr<tipb::DAGRequest>> requests{
+            context.scan("test_db", table).aggregation({Max(col("value")), Count(col("value"))}, {col("key")}).build(context),
+            context.scan("test_db", table).aggregation({Min(col("key")), Count(col("key"))}, {col("value")}).build(context),
+            context.scan("test_db", table).aggregation({Count(col("value"))}, {col("key"), col("value")}).build(context),
+        };
+        for (const auto & request : requests)
+        {
+            for (auto concurrency : concurrences)
+            {
+                context.context->setSetting("enable_parallel_agg_final_merge", "false");
+                auto expect = executeStreams(request, concurrency);
+                context.context->setSetting("enable_parallel_agg_final_merge", "true");
+                ASSERT_COLUMNS_EQ_UR(expect, executeStreams(request, concurrency));
+            }
+        }
+    }
+}
+CATCH
+
 TEST_F(AggExecutorTestRunner, SplitAggOutput)
 try
 {
@@ -2361,6 +2361,102 @@ try
 }
 CATCH
 
+TEST_F(JoinExecutorTestRunner, BatchedProbe)
+try
+{
+    /// The batched probe (join_probe_batch_size > 0) must return the same result as the row by row probe
+    /// for all join kinds, with one int key, one string key or multiple keys, and with or without other condition.
+    auto gen_table = [](size_t rows, size_t key_mod, size_t key_step, const String & str_prefix) {
+        std::vector<std::optional<Int32>> a;
+        std::vector<std::optional<String>> s;
+        std::vector<std::optional<Int32>> b;
+        for (size_t i = 0; i < rows; ++i)
+        {
+            /// Keys repeat and some of them are null, so there are rows matched many times, once and never.
+            const auto key = static_cast<Int32>((i * key_step) % key_mod);
+            a.push_back(i % 37 == 0 ? std::nullopt : std::make_optional(key));
+            s.push_back(i % 41 == 0 ? std::nullopt : std::make_optional(fmt::format("{}{}", str_prefix, key % 300)));
+            b.push_back(static_cast<Int32>(i % 13));
+        }
+        return ColumnsWithTypeAndName{toNullableVec<Int32>("a", a), toNullableVec<String>("s", s), toNullableVec<Int32>("b", b)};
+    };
+    const MockColumnInfoVec column_infos{{"a", TiDB::TP::TypeLong}, {"s", TiDB::TP::TypeString}, {"b", TiDB::TP::TypeLong}};
+    context.addMockTable("batched_probe", "t", column_infos, gen_table(3000, 1000, 1, "key_"), 3);
+    context.addMockTable("batched_probe", "s", column_infos, gen_table(2000, 1500, 7, "key_"), 3);
+
+    const std::vector<ASTs> join_keys{{col("a")}, {col("s")}, {col("a"), col("s")}};
+    const std::vector<ASTs> other_conds{{}, {lt(col("t.b"), col("s.b"))}};
+    const std::vector<UInt64> batch_sizes{1, 7, 256};
+    /// A small block size makes the probe of a block stop in the middle of a batch.
+    context.context->setSetting("max_block_size", Field(static_cast<UInt64>(1000)));
+    for (const auto join_type : join_types)
+    {
+        for (const auto & keys : join_keys)
+        {
+            for (const auto & other_cond : other_conds)
+            {
+                /// inner_index = 0 builds the hash table from the left table, which covers the right outer/semi/anti join.
+                for (size_t inner_index : {0, 1})
+                {
+                    if (inner_index == 0 && (join_type == tipb::JoinType::TypeLeftOuterSemiJoin || join_type == tipb::JoinType::TypeAntiLeftOuterSemiJoin))
+                        continue;
+                    auto request = context.scan("batched_probe", "t")
+                                       .join(context.scan("batched_probe", "s"), join_type, keys, {}, {}, other_cond, {}, 0, false, inner_index)
+                                       .build(context);
+                    context.context->setSetting("join_probe_batch_size", Field(static_cast<UInt64>(0)));
+                    const auto expect = executeStreams(request, 4);
+                    for (auto batch_size : batch_sizes)
+                    {
+                        SCOPED_TRACE(fmt::format("join_type={} keys={} other_cond={} inner_index={} batch_size={}", tipb::JoinType_Name(join_type), keys.size(), other_cond.size(), inner_index, batch_size));
+                        context.context->setSetting("join_probe_batch_size", Field(batch_size));
+                        WRAP_FOR_JOIN_TEST_BEGIN
+                        ASSERT_COLUMNS_EQ_UR(expect, executeStreams(request, 4));
+                        WRAP_FOR_JOIN_TEST_END
+                    }
+                }
+            }
+        }
+    }
+}
+CATCH
+
+TEST_F(JoinExecutorTestRunner, BatchedProbeWithLongSerializedKeys)
+try
+{
+    /// The serialized keys of a batch are much larger than the first chunk of an arena (4 KiB),
+    /// so the keys of a batch are spread over several chunks.
+    auto gen_table = [](size_t rows, size_t key_mod) {
+        std::vector<std::optional<String>> s1;
+        std::vector<std::optional<String>> s2;
+        for (size_t i = 0; i < rows; ++i)
+        {
+            const auto key = i % key_mod;
+            s1.push_back(i % 31 == 0 ? std::nullopt : std::make_optional(fmt::format("{:0>100}", key)));
+            s2.push_back(std::make_optional(fmt::format("{:x>80}", key % 17)));
+        }
+        return ColumnsWithTypeAndName{toNullableVec<String>("s1", s1), toNullableVec<String>("s2", s2)};
+    };
+    const MockColumnInfoVec column_infos{{"s1", TiDB::TP::TypeString}, {"s2", TiDB::TP::TypeString}};
+    context.addMockTable("batched_probe_long_key", "t", column_infos, gen_table(2000, 700), 2);
+    context.addMockTable("batched_probe_long_key", "s", column_infos, gen_table(1000, 900), 2);
+
+    for (const auto join_type : {tipb::JoinType::TypeInnerJoin, tipb::JoinType::TypeLeftOuterJoin, tipb::JoinType::TypeSemiJoin, tipb::JoinType::TypeAntiSemiJoin})
+    {
+        auto request = context.scan("batched_probe_long_key", "t")
+                           .join(context.scan("batched_probe_long_key", "s"), join_type, {col("s1"), col("s2")})
+                           .build(context);
+        context.context->setSetting("join_probe_batch_size", Field(static_cast<UInt64>(0)));
+        const auto expect = executeStreams(request, 2);
+        for (auto batch_size : {static_cast<UInt64>(256), static_cast<UInt64>(1024)})
+        {
+            SCOPED_TRACE(fmt::format("join_type={} batch_size={}", tipb::JoinType_Name(join_type), batch_size));
+            context.context->setSetting("join_probe_batch_size", Field(batch_size));
+            ASSERT_COLUMNS_EQ_UR(expect, executeStreams(request, 2));
+        }
+    }
+}
+CATCH
+
 #undef WRAP_FOR_JOIN_TEST_BEGIN
 #undef WRAP_FOR_JOIN_TEST_END
 
@@ -69,6 +69,28 @@ try
         Expect expect{{"table_scan_0", {2, 1}}, {"exchange_receiver_1", {4, concurrency}}, {"Join_2", {3, concurrency}}};
         testForExecutionSummary(request, expect);
     }
+
+    {
+        // with min max runtime filter, the pack of k1 = 1 is skipped
+        mock::MockRuntimeFilter rf(1, col("k1"), col("k1"), "exchange_receiver_1", "table_scan_0", tipb::MIN_MAX);
+        auto request = context
+                           .scan("test_db", "left_table", std::vector<int>{1})
+                           .join(context.receive("right_exchange_table"), tipb::JoinType::TypeInnerJoin, {col("k1")}, rf)
+                           .build(context);
+        Expect expect{{"table_scan_0", {2, 1}}, {"exchange_receiver_1", {4, concurrency}}, {"Join_2", {3, concurrency}}};
+        testForExecutionSummary(request, expect);
+    }
+
+    {
+        // with bloom filter runtime filter, the row of k1 = 1 is filtered
+        mock::MockRuntimeFilter rf(1, col("k1"), col("k1"), "exchange_receiver_1", "table_scan_0", tipb::BLOOM_FILTER);
+        auto request = context
+                           .scan("test_db", "left_table", std::vector<int>{1})
+                           .join(context.receive("right_exchange_table"), tipb::JoinType::TypeInnerJoin, {col("k1")}, rf)
+                           .build(context);
+        Expect expect{{"table_scan_0", {2, 1}}, {"exchange_receiver_1", {4, concurrency}}, {"Join_2", {3, concurrency}}};
+        testForExecutionSummary(request, expect);
+    }
 }
 CATCH
 
@@ -27,6 +27,15 @@ public:
     }
 };
 
+#define WRAP_FOR_SPILL_TEST_BEGIN                  \
+    std::vector<bool> pipeline_bools{false, true}; \
+    for (auto enable_pipeline : pipeline_bools)    \
+    {                                              \
+        enablePipeline(enable_pipeline);
+
+#define WRAP_FOR_SPILL_TEST_END \
+    }
+
 TEST_F(SpillJoinTestRunner, SimpleJoinSpill)
 try
 {
@@ -92,12 +101,14 @@ try
 
             {
                 context.context->setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(10000)));
+                WRAP_FOR_SPILL_TEST_BEGIN
                 ASSERT_THROW(executeStreams(request), Exception);
                 auto concurrences = {2, 5, 10};
                 for (auto concurrency : concurrences)
                 {
                     ASSERT_COLUMNS_EQ_UR(expected_cols[i * simple_test_num + j], executeStreams(request, concurrency));
                 }
+                WRAP_FOR_SPILL_TEST_END
             }
         }
     }
@@ -119,6 +130,7 @@ try
     auto concurrences = {2, 5, 10};
     const ColumnsWithTypeAndName expect = {toNullableVec<Int32>({1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4, 5, 5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 0, 0, 0}), toNullableVec<Int32>({2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2}), toNullableVec<Int32>({1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4, 5, 5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 0, 0, 0})};
     context.context->setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(10000)));
+    WRAP_FOR_SPILL_TEST_BEGIN
     for (const auto & join_restore_concurrency : join_restore_concurrences)
     {
         context.context->setSetting("join_restore_concurrency", Field(static_cast<Int64>(join_restore_concurrency)));
@@ -128,6 +140,7 @@ try
             ASSERT_COLUMNS_EQ_UR(expect, executeStreams(request, concurrency));
         }
     }
+    WRAP_FOR_SPILL_TEST_END
 }
 CATCH
 
@@ -340,5 +353,8 @@ try
 }
 CATCH
 
+#undef WRAP_FOR_SPILL_TEST_BEGIN
+#undef WRAP_FOR_SPILL_TEST_END
+
 } // namespace tests
 } // namespace DB
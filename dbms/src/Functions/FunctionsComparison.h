@@ -1162,6 +1162,8 @@ public:
 
     size_t getNumberOfArguments() const override { return 2; }
 
+    bool canBeExecutedOnLowCardinalityDictionary() const override { return true; }
+
     /// Get result types by argument types. If the function does not apply to these arguments, throw an exception.
     DataTypePtr getReturnTypeImpl(const DataTypes & arguments) const override
     {
@@ -247,6 +247,7 @@ public:
 
     bool isVariadic() const override { return true; }
     ColumnNumbers getArgumentsThatAreAlwaysConstant() const override { return {3}; }
+    bool canBeExecutedOnLowCardinalityDictionary() const override { return true; }
 
     DataTypePtr getReturnTypeImpl(const DataTypes & arguments) const override
     {
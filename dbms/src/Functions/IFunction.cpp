@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Columns/ColumnConst.h>
+#include <Columns/ColumnLowCardinality.h>
 #include <Columns/ColumnNullable.h>
 #include <Common/typeid_cast.h>
 #include <DataTypes/DataTypeNothing.h>
@@ -212,6 +213,98 @@ bool IExecutableFunction::defaultImplementationForNulls(Block & block, const Col
     return false;
 }
 
+bool IExecutableFunction::defaultImplementationForLowCardinalityColumns(Block & block, const ColumnNumbers & args, size_t result) const
+{
+    const ColumnLowCardinality * low_cardinality_column = nullptr;
+    size_t num_low_cardinality_args = 0;
+    bool others_are_constant = true;
+    for (auto arg : args)
+    {
+        const auto & column = block.getByPosition(arg).column;
+        if (column->isColumnLowCardinality())
+        {
+            low_cardinality_column = static_cast<const ColumnLowCardinality *>(column.get());
+            ++num_low_cardinality_args;
+        }
+        else if (column->isColumnNullable() && static_cast<const ColumnNullable &>(*column).getNestedColumn().isColumnLowCardinality())
+        {
+            // Only happens when the function does not use the default implementation for nulls.
+            ++num_low_cardinality_args;
+            others_are_constant = false;
+        }
+        else if (!column->isColumnConst())
+        {
+            others_are_constant = false;
+        }
+    }
+
+    if (num_low_cardinality_args == 0)
+        return false;
+
+    const size_t rows = block.rows();
+    if (num_low_cardinality_args == 1 && others_are_constant && canBeExecutedOnLowCardinalityDictionary()
+        && low_cardinality_column->getDictionary().size() < rows)
+    {
+        /// Execute the function on each value of the dictionary once, and expand the result by the codes.
+        const ColumnPtr & dictionary = low_cardinality_column->getDictionaryPtr();
+        const size_t dictionary_size = dictionary->size();
+
+        Block temporary_block;
+        const size_t arguments_size = args.size();
+        for (auto arg : args)
+        {
+            const ColumnWithTypeAndName & column = block.getByPosition(arg);
+            if (column.column->isColumnLowCardinality())
+                temporary_block.insert({dictionary, column.type, column.name});
+            else
+                temporary_block.insert({column.column->cloneResized(dictionary_size), column.type, column.name});
+        }
+        temporary_block.insert(block.getByPosition(result));
+
+        ColumnNumbers temporary_argument_numbers(arguments_size);
+        for (size_t i = 0; i < arguments_size; ++i)
+            temporary_argument_numbers[i] = i;
+
+        execute(temporary_block, temporary_argument_numbers, arguments_size);
+
+        const ColumnPtr & dictionary_result = temporary_block.getByPosition(arguments_size).column;
+        const auto & codes = low_cardinality_column->getIndexesData();
+        if (dictionary_result->isColumnConst())
+        {
+            block.getByPosition(result).column = dictionary_result->cloneResized(rows);
+        }
+        else if (const auto * dictionary_result_u8 = typeid_cast<const ColumnUInt8 *>(dictionary_result.get()))
+        {
+            const auto & dictionary_data = dictionary_result_u8->getData();
+            auto col_res = ColumnUInt8::create(rows);
+            auto & res_data = col_res->getData();
+            for (size_t i = 0; i < rows; ++i)
+                res_data[i] = dictionary_data[codes[i]];
+            block.getByPosition(result).column = std::move(col_res);
+        }
+        else
+        {
+            auto col_res = dictionary_result->cloneEmpty();
+            col_res->reserve(rows);
+            for (size_t i = 0; i < rows; ++i)
+                col_res->insertFrom(*dictionary_result, codes[i]);
+            block.getByPosition(result).column = std::move(col_res);
+        }
+        return true;
+    }
+
+    /// Otherwise execute the function with the decoded columns.
+    Block temporary_block = block;
+    for (auto arg : args)
+    {
+        auto & column = temporary_block.getByPosition(arg).column;
+        column = column->convertToFullColumnIfLowCardinality();
+    }
+    execute(temporary_block, args, result);
+    block.getByPosition(result).column = temporary_block.getByPosition(result).column;
+    return true;
+}
+
 void IExecutableFunction::execute(Block & block, const ColumnNumbers & args, size_t result) const
 {
     if (defaultImplementationForConstantArguments(block, args, result))
@@ -220,6 +313,9 @@ void IExecutableFunction::execute(Block & block, const ColumnNumbers & args, siz
     if (defaultImplementationForNulls(block, args, result))
         return;
 
+    if (defaultImplementationForLowCardinalityColumns(block, args, result))
+        return;
+
     executeImpl(block, args, result);
 }
 
@@ -77,9 +77,17 @@ protected:
       */
     virtual ColumnNumbers getArgumentsThatAreAlwaysConstant() const { return {}; }
 
+    /** Arguments of ColumnLowCardinality are converted to full columns before executing the function by default.
+      * If the result of the function only depends on the value of each row, and the function has one
+      *  ColumnLowCardinality argument and all other arguments are constant, the function could return true
+      *  to be executed on the dictionary only, then the result is expanded by the codes of the column.
+      */
+    virtual bool canBeExecutedOnLowCardinalityDictionary() const { return false; }
+
 private:
     bool defaultImplementationForNulls(Block & block, const ColumnNumbers & args, size_t result) const;
     bool defaultImplementationForConstantArguments(Block & block, const ColumnNumbers & args, size_t result) const;
+    bool defaultImplementationForLowCardinalityColumns(Block & block, const ColumnNumbers & args, size_t result) const;
 };
 
 using ExecutableFunctionPtr = std::shared_ptr<IExecutableFunction>;
@@ -258,6 +266,7 @@ public:
     virtual bool useDefaultImplementationForNulls() const { return true; }
     virtual bool useDefaultImplementationForConstants() const { return false; }
     virtual ColumnNumbers getArgumentsThatAreAlwaysConstant() const { return {}; }
+    virtual bool canBeExecutedOnLowCardinalityDictionary() const { return false; }
 
     /// Override these functions to change default implementation behavior. See details in IFunctionBase.
     virtual bool isSuitableForConstantFolding() const { return true; }
@@ -319,6 +328,7 @@ protected:
     bool useDefaultImplementationForNulls() const final { return function->useDefaultImplementationForNulls(); }
     bool useDefaultImplementationForConstants() const final { return function->useDefaultImplementationForConstants(); }
     ColumnNumbers getArgumentsThatAreAlwaysConstant() const final { return function->getArgumentsThatAreAlwaysConstant(); }
+    bool canBeExecutedOnLowCardinalityDictionary() const final { return function->canBeExecutedOnLowCardinalityDictionary(); }
 
 private:
     std::shared_ptr<IFunction> function;
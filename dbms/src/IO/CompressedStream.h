@@ -32,6 +32,20 @@ enum class CompressionMethod
     LZ4HC = 2, /// The format is the same as for LZ4. The difference is only in compression.
     ZSTD = 3, /// Experimental algorithm: https://github.com/Cyan4973/zstd
     NONE = 4, /// No compression
+    Lightweight = 5, /// Lightweight encodings chosen by the statistics of data, see LightweightCompression.h
+};
+
+/** The data type hint for lightweight compression.
+  * For integers, the value is the size of the integer in bytes.
+  */
+enum class CompressionDataType : uint8_t
+{
+    Unknown = 0, /// Lightweight compression will fallback to LZ4
+    Int8 = 1,
+    Int16 = 2,
+    Int32 = 4,
+    Int64 = 8,
+    String = 0x10, /// The format of `DataTypeString::serializeBinaryBulk`
 };
 
 /** The compressed block format is as follows:
@@ -52,6 +66,8 @@ enum class CompressionMethod
   *
   * 0x90 - ZSTD
   *
+  * 0x9a - Lightweight. The header is the same as LZ4.
+  *
   * All sizes are little endian.
   */
 
@@ -60,6 +76,7 @@ enum class CompressionMethodByte : uint8_t
     NONE = 0x02,
     LZ4 = 0x82,
     ZSTD = 0x90,
+    Lightweight = 0x9a,
     // COL_END is not a compreesion method, but a flag of column end used in compact file.
     COL_END = 0x66,
 };
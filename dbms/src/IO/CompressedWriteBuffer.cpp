@@ -14,6 +14,7 @@
 
 #include <Core/Types.h>
 #include <IO/CompressedWriteBuffer.h>
+#include <IO/LightweightCompression.h>
 #include <city.h>
 #include <common/unaligned.h>
 #include <lz4.h>
@@ -93,6 +94,23 @@ size_t CompressionEncode(
 
         break;
     }
+    case CompressionMethod::Lightweight:
+    {
+        static constexpr size_t header_size = 1 + sizeof(UInt32) + sizeof(UInt32);
+        compressed_buffer.resize(header_size + LightweightCompression::compressBound(source.size()));
+        compressed_buffer[0] = static_cast<UInt8>(CompressionMethodByte::Lightweight);
+
+        compressed_size = header_size
+            + LightweightCompression::compress(source.data(), source.size(), compression_settings.data_type, &compressed_buffer[header_size]);
+
+        UInt32 compressed_size_32 = compressed_size;
+        UInt32 uncompressed_size_32 = source.size();
+
+        unalignedStore<UInt32>(&compressed_buffer[1], compressed_size_32);
+        unalignedStore<UInt32>(&compressed_buffer[5], uncompressed_size_32);
+
+        break;
+    }
     case CompressionMethod::NONE:
     {
         static constexpr size_t header_size = 1 + sizeof(UInt32) + sizeof(UInt32);
@@ -25,6 +25,8 @@ struct CompressionSettings
 {
     CompressionMethod method;
     int level;
+    /// Only used by `CompressionMethod::Lightweight` to choose the encodings for the data.
+    CompressionDataType data_type = CompressionDataType::Unknown;
 
     CompressionSettings()
         : CompressionSettings(CompressionMethod::LZ4)
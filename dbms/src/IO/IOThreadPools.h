@@ -38,6 +38,14 @@ struct RNPreparerTrait
 {
 };
 
+struct S3ReadAheadTrait
+{
+};
+
+struct S3UploadTrait
+{
+};
+
 } // namespace io_pool_details
 
 // TODO: Move these out.
@@ -45,4 +53,6 @@ using DataStoreS3Pool = IOThreadPool<io_pool_details::DataStoreS3Trait>;
 using S3FileCachePool = IOThreadPool<io_pool_details::S3FileCacheTrait>;
 using RNRemoteReadTaskPool = IOThreadPool<io_pool_details::RemoteReadTaskTrait>;
 using RNPagePreparerPool = IOThreadPool<io_pool_details::RNPreparerTrait>;
+using S3ReadAheadPool = IOThreadPool<io_pool_details::S3ReadAheadTrait>;
+using S3UploadPool = IOThreadPool<io_pool_details::S3UploadTrait>;
 } // namespace DB
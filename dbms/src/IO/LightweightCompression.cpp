@@ -0,0 +1,592 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <IO/LightweightCompression.h>
+#include <IO/VarInt.h>
+#include <common/likely.h>
+#include <common/unaligned.h>
+#include <fmt/format.h>
+#include <lz4.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int CANNOT_COMPRESS;
+extern const int CANNOT_DECOMPRESS;
+} // namespace ErrorCodes
+
+namespace LightweightCompression
+{
+namespace
+{
+constexpr size_t PAYLOAD_HEADER_SIZE = 2;
+
+/// Only use lightweight encodings if the data can be at least halved,
+/// otherwise the general purpose compression is likely to be better.
+inline bool isWorthEncoding(size_t encoded_size, size_t source_size)
+{
+    return encoded_size * 2 <= source_size;
+}
+
+inline UInt8 bitWidth(UInt64 x)
+{
+    return x == 0 ? 0 : 64 - __builtin_clzll(x);
+}
+
+inline size_t bitPackedBytes(size_t count, UInt8 bits)
+{
+    return (count * bits + 7) / 8;
+}
+
+/// Pack the lowest `bits` bits of `get(i)` for i in [0, count) into `dest` in little endian.
+template <typename Getter>
+char * bitPack(size_t count, UInt8 bits, Getter && get, char * dest)
+{
+    if (bits == 0)
+        return dest;
+    UInt64 buffer = 0;
+    size_t filled = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        UInt64 v = get(i);
+        buffer |= v << filled;
+        if (filled + bits >= 64)
+        {
+            unalignedStore<UInt64>(dest, buffer);
+            dest += sizeof(UInt64);
+            size_t spill = filled + bits - 64;
+            buffer = spill == 0 ? 0 : v >> (bits - spill);
+            filled = spill;
+        }
+        else
+        {
+            filled += bits;
+        }
+    }
+    for (size_t i = 0; i < (filled + 7) / 8; ++i)
+        *dest++ = static_cast<char>(buffer >> (i * 8));
+    return dest;
+}
+
+/// Call `set(i, value)` for each value packed by `bitPack`.
+template <typename Setter>
+const char * bitUnpack(const char * source, const char * source_end, size_t count, UInt8 bits, Setter && set)
+{
+    if (unlikely(source + bitPackedBytes(count, bits) > source_end))
+        throw Exception("Cannot decompress lightweight data: bit-packed data is truncated", ErrorCodes::CANNOT_DECOMPRESS);
+    if (bits == 0)
+    {
+        for (size_t i = 0; i < count; ++i)
+            set(i, 0);
+        return source;
+    }
+
+    auto load = [&](const char * p) -> UInt64 {
+        if (likely(p + sizeof(UInt64) <= source_end))
+            return unalignedLoad<UInt64>(p);
+        UInt64 x = 0;
+        for (size_t i = 0; p + i < source_end; ++i)
+            x |= static_cast<UInt64>(static_cast<UInt8>(p[i])) << (i * 8);
+        return x;
+    };
+    const UInt64 mask = bits == 64 ? ~0ULL : (1ULL << bits) - 1;
+    size_t bit_pos = 0;
+    for (size_t i = 0; i < count; ++i, bit_pos += bits)
+    {
+        const char * p = source + bit_pos / 8;
+        const size_t shift = bit_pos % 8;
+        UInt64 v = load(p) >> shift;
+        if (shift + bits > 64)
+            v |= static_cast<UInt64>(static_cast<UInt8>(p[sizeof(UInt64)])) << (64 - shift);
+        set(i, v & mask);
+    }
+    return source + bitPackedBytes(count, bits);
+}
+
+size_t compressLZ4(const char * source, size_t source_size, char * dest)
+{
+    int res = LZ4_compress_fast(source, dest, source_size, LZ4_COMPRESSBOUND(source_size), 1);
+    if (unlikely(res <= 0 && source_size > 0))
+        throw Exception("Cannot compress block with LZ4", ErrorCodes::CANNOT_COMPRESS);
+    return res;
+}
+
+template <typename T>
+struct IntegerStat
+{
+    using U = std::make_unsigned_t<T>;
+
+    static constexpr size_t MAX_RUN_LENGTH = std::numeric_limits<UInt16>::max();
+
+    T min;
+    T max;
+    T first_delta{};
+    T min_delta{};
+    T max_delta{};
+    bool is_constant_delta = true;
+    size_t runs = 1;
+
+    IntegerStat(const char * source, size_t count)
+    {
+        T prev = unalignedLoad<T>(source);
+        min = max = prev;
+        size_t run_length = 1;
+        for (size_t i = 1; i < count; ++i)
+        {
+            T v = unalignedLoad<T>(source + i * sizeof(T));
+            min = std::min(min, v);
+            max = std::max(max, v);
+
+            T delta = static_cast<T>(static_cast<U>(v) - static_cast<U>(prev));
+            if (i == 1)
+            {
+                first_delta = min_delta = max_delta = delta;
+            }
+            else
+            {
+                is_constant_delta &= delta == first_delta;
+                min_delta = std::min(min_delta, delta);
+                max_delta = std::max(max_delta, delta);
+            }
+
+            if (v != prev || run_length == MAX_RUN_LENGTH)
+            {
+                ++runs;
+                run_length = 1;
+            }
+            else
+            {
+                ++run_length;
+            }
+            prev = v;
+        }
+    }
+
+    static U range(T from, T to) { return static_cast<U>(to) - static_cast<U>(from); }
+};
+
+template <typename T>
+size_t compressInteger(const char * source, size_t source_size, char * dest)
+{
+    using U = std::make_unsigned_t<T>;
+    const size_t count = source_size / sizeof(T);
+    if (count == 0 || source_size % sizeof(T) != 0)
+    {
+        dest[0] = static_cast<char>(Mode::LZ4);
+        return 1 + compressLZ4(source, source_size, dest + 1);
+    }
+
+    const IntegerStat<T> stat(source, count);
+
+    Mode mode = Mode::LZ4;
+    size_t encoded_size = source_size;
+    auto try_mode = [&](Mode m, size_t size) {
+        if (size < encoded_size)
+        {
+            mode = m;
+            encoded_size = size;
+        }
+    };
+    const UInt8 for_bits = bitWidth(IntegerStat<T>::range(stat.min, stat.max));
+    const UInt8 delta_for_bits = bitWidth(IntegerStat<T>::range(stat.min_delta, stat.max_delta));
+    if (stat.min == stat.max)
+        try_mode(Mode::Constant, sizeof(T));
+    if (count > 1 && stat.is_constant_delta)
+        try_mode(Mode::ConstantDelta, 2 * sizeof(T));
+    try_mode(Mode::RunLength, sizeof(UInt32) + stat.runs * (sizeof(T) + sizeof(UInt16)));
+    try_mode(Mode::FOR, sizeof(T) + 1 + bitPackedBytes(count, for_bits));
+    if (count > 1)
+        try_mode(Mode::DeltaFOR, 2 * sizeof(T) + 1 + bitPackedBytes(count - 1, delta_for_bits));
+    if (!isWorthEncoding(encoded_size, source_size))
+        mode = Mode::LZ4;
+
+    auto value_at = [&](size_t i) {
+        return unalignedLoad<T>(source + i * sizeof(T));
+    };
+
+    char * pos = dest;
+    *pos++ = static_cast<char>(mode);
+    switch (mode)
+    {
+    case Mode::LZ4:
+        pos += compressLZ4(source, source_size, pos);
+        break;
+    case Mode::Constant:
+        unalignedStore<T>(pos, stat.min);
+        pos += sizeof(T);
+        break;
+    case Mode::ConstantDelta:
+        unalignedStore<T>(pos, value_at(0));
+        pos += sizeof(T);
+        unalignedStore<T>(pos, stat.first_delta);
+        pos += sizeof(T);
+        break;
+    case Mode::RunLength:
+    {
+        unalignedStore<UInt32>(pos, stat.runs);
+        pos += sizeof(UInt32);
+        size_t i = 0;
+        while (i < count)
+        {
+            T v = value_at(i);
+            size_t j = i + 1;
+            while (j < count && j - i < IntegerStat<T>::MAX_RUN_LENGTH && value_at(j) == v)
+                ++j;
+            unalignedStore<T>(pos, v);
+            pos += sizeof(T);
+            unalignedStore<UInt16>(pos, j - i);
+            pos += sizeof(UInt16);
+            i = j;
+        }
+        break;
+    }
+    case Mode::FOR:
+        unalignedStore<T>(pos, stat.min);
+        pos += sizeof(T);
+        *pos++ = static_cast<char>(for_bits);
+        pos = bitPack(
+            count,
+            for_bits,
+            [&](size_t i) { return static_cast<UInt64>(IntegerStat<T>::range(stat.min, value_at(i))); },
+            pos);
+        break;
+    case Mode::DeltaFOR:
+        unalignedStore<T>(pos, value_at(0));
+        pos += sizeof(T);
+        unalignedStore<T>(pos, stat.min_delta);
+        pos += sizeof(T);
+        *pos++ = static_cast<char>(delta_for_bits);
+        pos = bitPack(
+            count - 1,
+            delta_for_bits,
+            [&](size_t i) {
+                auto delta = static_cast<T>(static_cast<U>(value_at(i + 1)) - static_cast<U>(value_at(i)));
+                return static_cast<UInt64>(IntegerStat<T>::range(stat.min_delta, delta));
+            },
+            pos);
+        break;
+    default:
+        throw Exception(fmt::format("Unexpected lightweight compression mode {}", static_cast<UInt8>(mode)), ErrorCodes::CANNOT_COMPRESS);
+    }
+    return pos - dest;
+}
+
+template <typename T>
+void decompressInteger(Mode mode, const char * source, const char * source_end, char * dest, size_t dest_size)
+{
+    using U = std::make_unsigned_t<T>;
+    if (unlikely(dest_size % sizeof(T) != 0))
+        throw Exception(fmt::format("Cannot decompress lightweight data: size {} is not a multiple of {}", dest_size, sizeof(T)), ErrorCodes::CANNOT_DECOMPRESS);
+    const size_t count = dest_size / sizeof(T);
+    auto check_size = [&](size_t size) {
+        if (unlikely(source + size > source_end))
+            throw Exception("Cannot decompress lightweight data: data is truncated", ErrorCodes::CANNOT_DECOMPRESS);
+    };
+
+    switch (mode)
+    {
+    case Mode::Constant:
+    {
+        check_size(sizeof(T));
+        T v = unalignedLoad<T>(source);
+        for (size_t i = 0; i < count; ++i)
+            unalignedStore<T>(dest + i * sizeof(T), v);
+        break;
+    }
+    case Mode::ConstantDelta:
+    {
+        check_size(2 * sizeof(T));
+        auto v = static_cast<U>(unalignedLoad<T>(source));
+        auto delta = static_cast<U>(unalignedLoad<T>(source + sizeof(T)));
+        for (size_t i = 0; i < count; ++i, v += delta)
+            unalignedStore<T>(dest + i * sizeof(T), static_cast<T>(v));
+        break;
+    }
+    case Mode::RunLength:
+    {
+        check_size(sizeof(UInt32));
+        auto runs = unalignedLoad<UInt32>(source);
+        source += sizeof(UInt32);
+        check_size(runs * (sizeof(T) + sizeof(UInt16)));
+        size_t i = 0;
+        for (UInt32 r = 0; r < runs; ++r)
+        {
+            T v = unalignedLoad<T>(source);
+            size_t run_length = unalignedLoad<UInt16>(source + sizeof(T));
+            source += sizeof(T) + sizeof(UInt16);
+            if (unlikely(i + run_length > count))
+                throw Exception("Cannot decompress lightweight data: too many values", ErrorCodes::CANNOT_DECOMPRESS);
+            for (size_t j = 0; j < run_length; ++j, ++i)
+                unalignedStore<T>(dest + i * sizeof(T), v);
+        }
+        if (unlikely(i != count))
+            throw Exception("Cannot decompress lightweight data: too few values", ErrorCodes::CANNOT_DECOMPRESS);
+        break;
+    }
+    case Mode::FOR:
+    {
+        check_size(sizeof(T) + 1);
+        auto min = static_cast<U>(unalignedLoad<T>(source));
+        auto bits = static_cast<UInt8>(source[sizeof(T)]);
+        source += sizeof(T) + 1;
+        bitUnpack(source, source_end, count, bits, [&](size_t i, UInt64 v) {
+            unalignedStore<T>(dest + i * sizeof(T), static_cast<T>(min + static_cast<U>(v)));
+        });
+        break;
+    }
+    case Mode::DeltaFOR:
+    {
+        if (count == 0)
+            break;
+        check_size(2 * sizeof(T) + 1);
+        auto v = static_cast<U>(unalignedLoad<T>(source));
+        auto min_delta = static_cast<U>(unalignedLoad<T>(source + sizeof(T)));
+        auto bits = static_cast<UInt8>(source[2 * sizeof(T)]);
+        source += 2 * sizeof(T) + 1;
+        unalignedStore<T>(dest, static_cast<T>(v));
+        bitUnpack(source, source_end, count - 1, bits, [&](size_t i, UInt64 delta) {
+            v += min_delta + static_cast<U>(delta);
+            unalignedStore<T>(dest + (i + 1) * sizeof(T), static_cast<T>(v));
+        });
+        break;
+    }
+    default:
+        throw Exception(fmt::format("Unexpected lightweight compression mode {} for integers", static_cast<UInt8>(mode)), ErrorCodes::CANNOT_DECOMPRESS);
+    }
+}
+
+/// Parse the strings serialized by `DataTypeString::serializeBinaryBulk`, returns false if the data is incomplete
+/// or can not be serialized back to the same bytes.
+/// A compression block may start in the middle of a string, whose chars may happen to be parsed as strings
+/// with non-canonical size, e.g. "\x81\x00" for 1. The dictionary encoding writes the sizes canonically,
+/// so such blocks are rejected to keep the decoded block the same as the source.
+bool parseStrings(const char * source, size_t source_size, std::vector<std::string_view> & strings)
+{
+    const char * pos = source;
+    const char * end = source + source_size;
+    while (pos < end)
+    {
+        const char * size_begin = pos;
+        UInt64 size = 0;
+        bool complete = false;
+        for (size_t i = 0; i < 9 && pos < end; ++i)
+        {
+            auto byte = static_cast<UInt8>(*pos++);
+            size |= static_cast<UInt64>(byte & 0x7F) << (7 * i);
+            if (!(byte & 0x80))
+            {
+                complete = true;
+                break;
+            }
+        }
+        if (!complete || size > static_cast<size_t>(end - pos))
+            return false;
+        if (static_cast<size_t>(pos - size_begin) != getLengthOfVarUInt(size))
+            return false;
+        strings.emplace_back(pos, size);
+        pos += size;
+    }
+    return true;
+}
+
+size_t compressString(const char * source, size_t source_size, char * dest)
+{
+    std::vector<std::string_view> strings;
+    std::vector<std::string_view> dictionary;
+    std::vector<UInt32> indexes;
+    size_t dictionary_bytes = 0;
+    if (source_size > 0 && parseStrings(source, source_size, strings))
+    {
+        std::unordered_map<std::string_view, UInt32> dictionary_index;
+        indexes.reserve(strings.size());
+        for (const auto & s : strings)
+        {
+            auto [iter, inserted] = dictionary_index.try_emplace(s, dictionary.size());
+            if (inserted)
+            {
+                dictionary.push_back(s);
+                dictionary_bytes += getLengthOfVarUInt(s.size()) + s.size();
+                // Stop early if the cardinality is too high.
+                if (!isWorthEncoding(dictionary_bytes, source_size))
+                    break;
+            }
+            indexes.push_back(iter->second);
+        }
+    }
+
+    const UInt8 bits = dictionary.empty() ? 0 : bitWidth(dictionary.size() - 1);
+    const size_t encoded_size = 2 * sizeof(UInt32) + dictionary_bytes + 1 + bitPackedBytes(strings.size(), bits);
+    if (dictionary.empty() || indexes.size() != strings.size() || !isWorthEncoding(encoded_size, source_size))
+    {
+        dest[0] = static_cast<char>(Mode::LZ4);
+        return 1 + compressLZ4(source, source_size, dest + 1);
+    }
+
+    char * pos = dest;
+    *pos++ = static_cast<char>(Mode::Dictionary);
+    unalignedStore<UInt32>(pos, dictionary.size());
+    pos += sizeof(UInt32);
+    for (const auto & s : dictionary)
+    {
+        pos = writeVarUInt(s.size(), pos);
+        memcpy(pos, s.data(), s.size());
+        pos += s.size();
+    }
+    unalignedStore<UInt32>(pos, indexes.size());
+    pos += sizeof(UInt32);
+    *pos++ = static_cast<char>(bits);
+    pos = bitPack(
+        indexes.size(),
+        bits,
+        [&](size_t i) { return static_cast<UInt64>(indexes[i]); },
+        pos);
+    return pos - dest;
+}
+
+void decompressString(Mode mode, const char * source, const char * source_end, char * dest, size_t dest_size)
+{
+    if (unlikely(mode != Mode::Dictionary))
+        throw Exception(fmt::format("Unexpected lightweight compression mode {} for strings", static_cast<UInt8>(mode)), ErrorCodes::CANNOT_DECOMPRESS);
+    auto check_size = [&](size_t size) {
+        if (unlikely(source + size > source_end))
+            throw Exception("Cannot decompress lightweight data: data is truncated", ErrorCodes::CANNOT_DECOMPRESS);
+    };
+
+    check_size(sizeof(UInt32));
+    auto dictionary_size = unalignedLoad<UInt32>(source);
+    source += sizeof(UInt32);
+    // Keep the serialized form (size + chars) of each string, so that it can be copied directly.
+    std::vector<std::string_view> dictionary;
+    dictionary.reserve(dictionary_size);
+    for (UInt32 i = 0; i < dictionary_size; ++i)
+    {
+        const char * begin = source;
+        UInt64 size = 0;
+        source = readVarUInt(size, source, source_end - source);
+        check_size(size);
+        source += size;
+        dictionary.emplace_back(begin, source - begin);
+    }
+
+    check_size(sizeof(UInt32) + 1);
+    auto count = unalignedLoad<UInt32>(source);
+    auto bits = static_cast<UInt8>(source[sizeof(UInt32)]);
+    source += sizeof(UInt32) + 1;
+
+    char * pos = dest;
+    char * dest_end = dest + dest_size;
+    bitUnpack(source, source_end, count, bits, [&](size_t, UInt64 index) {
+        if (unlikely(index >= dictionary.size()))
+            throw Exception("Cannot decompress lightweight data: dictionary index out of range", ErrorCodes::CANNOT_DECOMPRESS);
+        const auto & s = dictionary[index];
+        if (unlikely(pos + s.size() > dest_end))
+            throw Exception("Cannot decompress lightweight data: too many values", ErrorCodes::CANNOT_DECOMPRESS);
+        memcpy(pos, s.data(), s.size());
+        pos += s.size();
+    });
+    if (unlikely(pos != dest_end))
+        throw Exception("Cannot decompress lightweight data: too few values", ErrorCodes::CANNOT_DECOMPRESS);
+}
+} // namespace
+
+size_t compressBound(size_t source_size)
+{
+    // All the lightweight encodings are only used when they are smaller than the source.
+    return PAYLOAD_HEADER_SIZE + LZ4_COMPRESSBOUND(source_size);
+}
+
+size_t compress(const char * source, size_t source_size, CompressionDataType data_type, char * dest)
+{
+    dest[0] = static_cast<char>(data_type);
+    char * payload = dest + 1;
+    size_t payload_size = 0;
+    switch (data_type)
+    {
+    case CompressionDataType::Int8:
+        payload_size = compressInteger<Int8>(source, source_size, payload);
+        break;
+    case CompressionDataType::Int16:
+        payload_size = compressInteger<Int16>(source, source_size, payload);
+        break;
+    case CompressionDataType::Int32:
+        payload_size = compressInteger<Int32>(source, source_size, payload);
+        break;
+    case CompressionDataType::Int64:
+        payload_size = compressInteger<Int64>(source, source_size, payload);
+        break;
+    case CompressionDataType::String:
+        payload_size = compressString(source, source_size, payload);
+        break;
+    default:
+        payload[0] = static_cast<char>(Mode::LZ4);
+        payload_size = 1 + compressLZ4(source, source_size, payload + 1);
+        break;
+    }
+    return 1 + payload_size;
+}
+
+void decompress(const char * source, size_t source_size, char * dest, size_t dest_size)
+{
+    if (unlikely(source_size < PAYLOAD_HEADER_SIZE))
+        throw Exception("Cannot decompress lightweight data: header is truncated", ErrorCodes::CANNOT_DECOMPRESS);
+    const auto data_type = static_cast<CompressionDataType>(source[0]);
+    const auto mode = static_cast<Mode>(source[1]);
+    const char * payload = source + PAYLOAD_HEADER_SIZE;
+    const char * source_end = source + source_size;
+
+    if (mode == Mode::LZ4)
+    {
+        if (unlikely(LZ4_decompress_safe(payload, dest, source_end - payload, dest_size) < 0))
+            throw Exception("Cannot LZ4_decompress_safe", ErrorCodes::CANNOT_DECOMPRESS);
+        return;
+    }
+
+    switch (data_type)
+    {
+    case CompressionDataType::Int8:
+        decompressInteger<Int8>(mode, payload, source_end, dest, dest_size);
+        break;
+    case CompressionDataType::Int16:
+        decompressInteger<Int16>(mode, payload, source_end, dest, dest_size);
+        break;
+    case CompressionDataType::Int32:
+        decompressInteger<Int32>(mode, payload, source_end, dest, dest_size);
+        break;
+    case CompressionDataType::Int64:
+        decompressInteger<Int64>(mode, payload, source_end, dest, dest_size);
+        break;
+    case CompressionDataType::String:
+        decompressString(mode, payload, source_end, dest, dest_size);
+        break;
+    default:
+        throw Exception(fmt::format("Unknown lightweight compression data type {}", static_cast<UInt8>(data_type)), ErrorCodes::CANNOT_DECOMPRESS);
+    }
+}
+
+Mode getMode(const char * source)
+{
+    return static_cast<Mode>(source[1]);
+}
+} // namespace LightweightCompression
+
+} // namespace DB
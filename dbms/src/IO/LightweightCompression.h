@@ -0,0 +1,56 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Core/Types.h>
+#include <IO/CompressedStream.h>
+
+namespace DB
+{
+/** Lightweight encodings for the data of fixed size integers and strings.
+  *
+  * The data is regarded as an array of values of `CompressionDataType`, and the encoding
+  * is chosen for each compressed block by the statistics of the values in the block.
+  * If no lightweight encoding fits the data well, LZ4 is used as a fallback.
+  *
+  * The payload after the compressed block header (see CompressedStream.h) is:
+  *   data_type (1 byte) | mode (1 byte) | encoded data
+  */
+namespace LightweightCompression
+{
+enum class Mode : UInt8
+{
+    LZ4 = 0, /// Fallback to general purpose compression
+    Constant = 1, /// All values are the same
+    ConstantDelta = 2, /// The values are an arithmetic progression, e.g. handle column
+    RunLength = 3, /// Few runs of the same value
+    FOR = 4, /// Frame of reference + bit-packing
+    DeltaFOR = 5, /// Delta + frame of reference + bit-packing, e.g. sorted integers
+    Dictionary = 6, /// Low cardinality strings
+};
+
+/// The max size of the payload of `compress`.
+size_t compressBound(size_t source_size);
+
+/// Returns the size of the payload written into `dest`.
+size_t compress(const char * source, size_t source_size, CompressionDataType data_type, char * dest);
+
+void decompress(const char * source, size_t source_size, char * dest, size_t dest_size);
+
+/// Returns the mode of the payload written by `compress`.
+Mode getMode(const char * source);
+} // namespace LightweightCompression
+
+} // namespace DB
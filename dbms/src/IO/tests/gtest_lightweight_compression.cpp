@@ -0,0 +1,211 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <IO/CompressedReadBuffer.h>
+#include <IO/CompressedWriteBuffer.h>
+#include <IO/LightweightCompression.h>
+#include <IO/ReadBufferFromString.h>
+#include <IO/VarInt.h>
+#include <IO/WriteBufferFromString.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <random>
+
+namespace DB
+{
+namespace tests
+{
+namespace
+{
+template <typename T>
+String toBytes(const std::vector<T> & values)
+{
+    return String(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+}
+
+String toStringBytes(const std::vector<String> & values)
+{
+    String res;
+    for (const auto & v : values)
+    {
+        char buf[16];
+        res.append(buf, writeVarUInt(v.size(), buf) - buf);
+        res.append(v);
+    }
+    return res;
+}
+
+/// Compress and decompress `source`, returns the mode used.
+LightweightCompression::Mode roundTrip(const String & source, CompressionDataType data_type)
+{
+    String compressed(LightweightCompression::compressBound(source.size()), '\0');
+    auto compressed_size = LightweightCompression::compress(source.data(), source.size(), data_type, compressed.data());
+    EXPECT_LE(compressed_size, compressed.size());
+
+    String decompressed(source.size(), '\0');
+    LightweightCompression::decompress(compressed.data(), compressed_size, decompressed.data(), decompressed.size());
+    EXPECT_EQ(decompressed, source);
+    return LightweightCompression::getMode(compressed.data());
+}
+} // namespace
+
+using Mode = LightweightCompression::Mode;
+
+TEST(LightweightCompressionTest, Integer)
+try
+{
+    {
+        std::vector<Int64> values(8192, -42);
+        ASSERT_EQ(roundTrip(toBytes(values), CompressionDataType::Int64), Mode::Constant);
+    }
+    {
+        std::vector<Int64> values(8192);
+        for (size_t i = 0; i < values.size(); ++i)
+            values[i] = 1000 + 3 * i;
+        ASSERT_EQ(roundTrip(toBytes(values), CompressionDataType::Int64), Mode::ConstantDelta);
+        // Values are wrapped around
+        for (size_t i = 0; i < values.size(); ++i)
+            values[i] = static_cast<Int64>(static_cast<UInt64>(std::numeric_limits<Int64>::max()) - 100 + 3 * i);
+        ASSERT_EQ(roundTrip(toBytes(values), CompressionDataType::Int64), Mode::ConstantDelta);
+    }
+    {
+        // Long runs, including runs longer than the max run length
+        std::vector<Int32> values;
+        for (Int32 v : {7, -1, 7, 100})
+            values.insert(values.end(), 70000, v);
+        ASSERT_EQ(roundTrip(toBytes(values), CompressionDataType::Int32), Mode::RunLength);
+    }
+    {
+        std::mt19937_64 rng(42);
+        std::vector<Int64> values(8192);
+        for (auto & v : values)
+            v = 1'000'000'000 + rng() % 1000;
+        ASSERT_EQ(roundTrip(toBytes(values), CompressionDataType::Int64), Mode::FOR);
+
+        // Timestamp-like values which are increasing with small steps
+        Int64 ts = 1'600'000'000'000;
+        for (auto & v : values)
+        {
+            ts += rng() % 16;
+            v = ts;
+        }
+        ASSERT_EQ(roundTrip(toBytes(values), CompressionDataType::Int64), Mode::DeltaFOR);
+    }
+    {
+        std::mt19937_64 rng(42);
+        std::vector<UInt64> values(8192);
+        for (auto & v : values)
+            v = rng();
+        ASSERT_EQ(roundTrip(toBytes(values), CompressionDataType::Int64), Mode::LZ4);
+        // Unsigned values are treated as signed integers with the same width
+        for (auto & v : values)
+            v = std::numeric_limits<UInt64>::max() - rng() % 100;
+        ASSERT_EQ(roundTrip(toBytes(values), CompressionDataType::Int64), Mode::FOR);
+    }
+    {
+        std::vector<UInt8> values(1000);
+        for (size_t i = 0; i < values.size(); ++i)
+            values[i] = i % 3 == 0;
+        ASSERT_EQ(roundTrip(toBytes(values), CompressionDataType::Int8), Mode::FOR);
+    }
+    {
+        // The size is not a multiple of the width
+        String source(1001, 'a');
+        ASSERT_EQ(roundTrip(source, CompressionDataType::Int64), Mode::LZ4);
+        ASSERT_EQ(roundTrip(source, CompressionDataType::Unknown), Mode::LZ4);
+        ASSERT_EQ(roundTrip("", CompressionDataType::Int32), Mode::LZ4);
+    }
+}
+CATCH
+
+TEST(LightweightCompressionTest, String)
+try
+{
+    std::vector<String> values;
+    for (size_t i = 0; i < 10000; ++i)
+        values.push_back(i % 5 == 0 ? "" : "status_" + std::to_string(i % 7));
+    auto source = toStringBytes(values);
+    ASSERT_EQ(roundTrip(source, CompressionDataType::String), Mode::Dictionary);
+
+    // A block may be truncated in the middle of a string, fallback to LZ4
+    ASSERT_EQ(roundTrip(source.substr(0, source.size() - 3), CompressionDataType::String), Mode::LZ4);
+
+    // A block may start in the middle of a string whose chars look like strings with non-canonical sizes,
+    // they can not be encoded back to the same bytes, fallback to LZ4
+    {
+        String chars;
+        for (size_t i = 0; i < 1000; ++i)
+            chars.append("\x81\x00x", 3);
+        auto split_source = toStringBytes({chars});
+        split_source = split_source.substr(getLengthOfVarUInt(chars.size()));
+        ASSERT_EQ(roundTrip(split_source, CompressionDataType::String), Mode::LZ4);
+    }
+
+    // High cardinality
+    values.clear();
+    std::mt19937_64 rng(42);
+    for (size_t i = 0; i < 1000; ++i)
+        values.push_back(std::to_string(rng()));
+    ASSERT_EQ(roundTrip(toStringBytes(values), CompressionDataType::String), Mode::LZ4);
+}
+CATCH
+
+TEST(LightweightCompressionTest, Corrupted)
+try
+{
+    std::vector<Int32> values(1000);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = i % 100;
+    auto source = toBytes(values);
+    String compressed(LightweightCompression::compressBound(source.size()), '\0');
+    auto compressed_size = LightweightCompression::compress(source.data(), source.size(), CompressionDataType::Int32, compressed.data());
+    ASSERT_EQ(LightweightCompression::getMode(compressed.data()), Mode::FOR);
+
+    String decompressed(source.size(), '\0');
+    ASSERT_THROW(LightweightCompression::decompress(compressed.data(), compressed_size / 2, decompressed.data(), decompressed.size()), DB::Exception);
+    ASSERT_THROW(LightweightCompression::decompress(compressed.data(), compressed_size, decompressed.data(), decompressed.size() - 1), DB::Exception);
+}
+CATCH
+
+TEST(LightweightCompressionTest, CompressedBuffer)
+try
+{
+    std::vector<Int64> values(100000);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = i / 1000;
+    auto source = toBytes(values);
+
+    CompressionSettings settings(CompressionMethod::Lightweight);
+    settings.data_type = CompressionDataType::Int64;
+    WriteBufferFromOwnString write_buf;
+    {
+        CompressedWriteBuffer<> compressed_buf(write_buf, settings, 8192);
+        compressed_buf.write(source.data(), source.size());
+        compressed_buf.next();
+    }
+    auto compressed = write_buf.releaseStr();
+    ASSERT_LT(compressed.size(), source.size() / 10);
+    ASSERT_EQ(static_cast<UInt8>(compressed[0]), static_cast<UInt8>(CompressionMethodByte::Lightweight));
+
+    ReadBufferFromString read_buf(compressed);
+    CompressedReadBuffer<> compressed_read_buf(read_buf);
+    String decompressed(source.size(), '\0');
+    compressed_read_buf.readStrict(decompressed.data(), decompressed.size());
+    ASSERT_EQ(decompressed, source);
+    ASSERT_TRUE(compressed_read_buf.eof());
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
@@ -679,6 +679,64 @@ ALWAYS_INLINE void Aggregator::executeImplBatch(
     }
 }
 
+template <typename Method>
+void NO_INLINE Aggregator::executeLowCardinalityImpl(
+    Method & method,
+    Arena * aggregates_pool,
+    size_t rows,
+    const ColumnLowCardinality & key_column,
+    TiDB::TiDBCollators & collators,
+    AggregateFunctionInstruction * aggregate_instructions) const
+{
+    /// The hash table is probed by the values of the dictionary, so that each distinct key of
+    /// the block is hashed and compared only once, and rows are mapped to places by their codes.
+    ColumnRawPtrs dictionary_columns{&key_column.getDictionary()};
+    typename Method::State state(dictionary_columns, key_sizes, collators);
+
+    std::vector<std::string> sort_key_containers;
+    sort_key_containers.resize(params.keys_size, "");
+
+    const auto & codes = key_column.getIndexesData();
+    std::vector<AggregateDataPtr> dictionary_places(key_column.getDictionary().size(), nullptr);
+    std::vector<UInt8> dictionary_found(dictionary_places.size(), 0);
+    std::unique_ptr<AggregateDataPtr[]> places(new AggregateDataPtr[rows]);
+
+    for (size_t i = 0; i < rows; ++i)
+    {
+        const auto index = codes[i];
+        if (!dictionary_found[index])
+        {
+            AggregateDataPtr aggregate_data = nullptr;
+            auto emplace_result = state.emplaceKey(method.data, index, *aggregates_pool, sort_key_containers);
+            if (emplace_result.isInserted())
+            {
+                /// exception-safety - if you can not allocate memory or create states, then destructors will not be called.
+                emplace_result.setMapped(nullptr);
+
+                aggregate_data = aggregates_pool->alignedAlloc(total_size_of_aggregate_states, align_aggregate_states);
+                createAggregateStates(aggregate_data);
+
+                emplace_result.setMapped(aggregate_data);
+            }
+            else
+                aggregate_data = emplace_result.getMapped();
+
+            dictionary_places[index] = aggregate_data;
+            dictionary_found[index] = 1;
+        }
+        places[i] = dictionary_places[index];
+    }
+
+    /// Add values to the aggregate functions.
+    for (AggregateFunctionInstruction * inst = aggregate_instructions; inst->that; ++inst)
+    {
+        if (inst->offsets)
+            inst->batch_that->addBatchArray(rows, places.get(), inst->state_offset, inst->batch_arguments, inst->offsets, aggregates_pool);
+        else
+            inst->batch_that->addBatch(rows, places.get(), inst->state_offset, inst->batch_arguments, aggregates_pool);
+    }
+}
+
 void NO_INLINE Aggregator::executeWithoutKeyImpl(
     AggregatedDataWithoutKey & res,
     size_t rows,
@@ -718,6 +776,12 @@ void Aggregator::prepareAggregateInstructions(Columns columns, AggregateColumns
                 materialized_columns.push_back(converted);
                 aggregate_columns[i][j] = materialized_columns.back().get();
             }
+            /// Aggregate functions don't know about dictionary-encoded columns.
+            if (ColumnPtr converted = aggregate_columns[i][j]->convertToFullColumnIfLowCardinality(); converted.get() != aggregate_columns[i][j])
+            {
+                materialized_columns.push_back(converted);
+                aggregate_columns[i][j] = materialized_columns.back().get();
+            }
         }
 
         aggregate_functions_instructions[i].arguments = aggregate_columns[i].data();
@@ -771,6 +835,11 @@ bool Aggregator::executeOnBlock(
     Columns materialized_columns;
     materialized_columns.reserve(params.keys_size);
 
+    /// A single dictionary-encoded key is aggregated by its dictionary, see `executeLowCardinalityImpl`.
+    const ColumnLowCardinality * low_cardinality_key = nullptr;
+    if (params.keys_size == 1 && columns.at(params.keys[0])->isColumnLowCardinality())
+        low_cardinality_key = static_cast<const ColumnLowCardinality *>(columns.at(params.keys[0]).get());
+
     /// Remember the columns we will work with
     for (size_t i = 0; i < params.keys_size; ++i)
     {
@@ -781,6 +850,11 @@ bool Aggregator::executeOnBlock(
             materialized_columns.push_back(converted);
             key_columns[i] = materialized_columns.back().get();
         }
+        else if (!low_cardinality_key && (converted = key_columns[i]->convertToFullColumnIfLowCardinality()).get() != key_columns[i])
+        {
+            materialized_columns.push_back(converted);
+            key_columns[i] = materialized_columns.back().get();
+        }
     }
 
     AggregateFunctionInstructions aggregate_functions_instructions;
@@ -805,6 +879,24 @@ bool Aggregator::executeOnBlock(
     {
         executeWithoutKeyImpl(result.without_key, num_rows, aggregate_functions_instructions.data(), result.aggregates_pool);
     }
+    else if (low_cardinality_key)
+    {
+#define M(NAME, IS_TWO_LEVEL)                                                                                                                                                                                        \
+    case AggregationMethodType(NAME):                                                                                                                                                                                \
+    {                                                                                                                                                                                                                \
+        executeLowCardinalityImpl(*ToAggregationMethodPtr(NAME, result.aggregation_method_impl), result.aggregates_pool, num_rows, *low_cardinality_key, params.collators, aggregate_functions_instructions.data()); \
+        break;                                                                                                                                                                                                       \
+    }
+
+        switch (result.type)
+        {
+            APPLY_FOR_AGGREGATED_VARIANTS(M)
+        default:
+            break;
+        }
+
+#undef M
+    }
     else
     {
 #define M(NAME, IS_TWO_LEVEL)                                                                                                                                                                 \
@@ -2301,6 +2393,9 @@ Block MergingBuckets::getDataForSingleLevel()
 
 Block MergingBuckets::getDataForTwoLevel(size_t concurrency_index)
 {
+    if (read_concurrency > 0)
+        return getDataForMergedBuckets(concurrency_index);
+
     assert(concurrency_index < two_level_parallel_merge_data.size());
     auto & two_level_merge_data = *two_level_parallel_merge_data[concurrency_index];
 
@@ -2323,28 +2418,64 @@ Block MergingBuckets::getDataForTwoLevel(size_t concurrency_index)
     }
 }
 
+void MergingBuckets::mergeBucket(Int32 bucket_num)
+{
+    RUNTIME_CHECK(is_two_level && concurrency == static_cast<size_t>(NUM_BUCKETS));
+    assert(bucket_num >= 0 && bucket_num < NUM_BUCKETS);
+
+    FAIL_POINT_TRIGGER_EXCEPTION(FailPoints::random_aggregate_merge_failpoint);
+
+    /// Only merge the hash tables here, the merged bucket is converted to blocks when it is read.
+    mergeBucketData(bucket_num, bucket_num);
+}
+
+void MergingBuckets::finishParallelMerge(size_t read_concurrency_)
+{
+    RUNTIME_CHECK(is_two_level && concurrency == static_cast<size_t>(NUM_BUCKETS) && read_concurrency_ > 0);
+    read_concurrency = std::min(read_concurrency_, concurrency);
+    current_bucket_num = 0;
+}
+
+Block MergingBuckets::getDataForMergedBuckets(size_t concurrency_index)
+{
+    assert(concurrency_index < read_concurrency);
+    auto & two_level_merge_data = *two_level_parallel_merge_data[concurrency_index];
+    while (true)
+    {
+        Block out_block = popBlocksListFront(two_level_merge_data);
+        if (likely(out_block))
+            return out_block;
+
+        /// Convert the next merged bucket only after the blocks of the previous one are all read,
+        /// so at most `read_concurrency` buckets are held as blocks at the same time.
+        auto bucket_num = current_bucket_num.fetch_add(1);
+        if (unlikely(bucket_num >= NUM_BUCKETS))
+            return {};
+        convertBucketToBlocks(bucket_num, bucket_num, two_level_merge_data);
+    }
+}
+
 void MergingBuckets::doLevelMerge(Int32 bucket_num, size_t concurrency_index)
 {
     auto & two_level_merge_data = *two_level_parallel_merge_data[concurrency_index];
     assert(two_level_merge_data.empty());
 
+    /// Use the arena of `concurrency_index` to avoid race conditions
+    mergeBucketData(bucket_num, concurrency_index);
+    convertBucketToBlocks(bucket_num, concurrency_index, two_level_merge_data);
+}
+
+void MergingBuckets::mergeBucketData(Int32 bucket_num, size_t arena_index)
+{
     assert(!data.empty());
     auto & merged_data = *data[0];
     auto method = merged_data.type;
-
-    /// Select Arena to avoid race conditions
-    Arena * arena = merged_data.aggregates_pools.at(concurrency_index).get();
+    Arena * arena = merged_data.aggregates_pools.at(arena_index).get();
 
 #define M(NAME)                                                                           \
     case AggregationMethodType(NAME):                                                     \
     {                                                                                     \
         aggregator.mergeBucketImpl<AggregationMethodName(NAME)>(data, bucket_num, arena); \
-        two_level_merge_data = aggregator.convertOneBucketToBlocks(                       \
-            merged_data,                                                                  \
-            *ToAggregationMethodPtr(NAME, merged_data.aggregation_method_impl),           \
-            arena,                                                                        \
-            final,                                                                        \
-            bucket_num);                                                                  \
         break;                                                                            \
     }
     switch (method)
@@ -2356,6 +2487,33 @@ void MergingBuckets::doLevelMerge(Int32 bucket_num, size_t concurrency_index)
 #undef M
 }
 
+void MergingBuckets::convertBucketToBlocks(Int32 bucket_num, size_t arena_index, BlocksList & output)
+{
+    assert(!data.empty());
+    auto & merged_data = *data[0];
+    auto method = merged_data.type;
+    Arena * arena = merged_data.aggregates_pools.at(arena_index).get();
+
+#define M(NAME)                                                                 \
+    case AggregationMethodType(NAME):                                           \
+    {                                                                           \
+        output = aggregator.convertOneBucketToBlocks(                           \
+            merged_data,                                                        \
+            *ToAggregationMethodPtr(NAME, merged_data.aggregation_method_impl), \
+            arena,                                                              \
+            final,                                                              \
+            bucket_num);                                                        \
+        break;                                                                  \
+    }
+    switch (method)
+    {
+        APPLY_FOR_VARIANTS_TWO_LEVEL(M)
+    default:
+        throw Exception("Unknown aggregated data variant.", ErrorCodes::UNKNOWN_AGGREGATED_DATA_VARIANT);
+    }
+#undef M
+}
+
 #undef AggregationMethodName
 #undef AggregationMethodNameTwoLevel
 #undef AggregationMethodType
@@ -16,6 +16,7 @@
 
 #include <Columns/ColumnAggregateFunction.h>
 #include <Columns/ColumnFixedString.h>
+#include <Columns/ColumnLowCardinality.h>
 #include <Columns/ColumnNullable.h>
 #include <Columns/ColumnString.h>
 #include <Columns/ColumnVector.h>
@@ -898,15 +899,37 @@ public:
 
     Block getData(size_t concurrency_index);
 
-    size_t getConcurrency() const { return concurrency; }
+    size_t getConcurrency() const { return read_concurrency > 0 ? read_concurrency : concurrency; }
+
+    bool isTwoLevel() const { return is_two_level; }
+
+    /** Used by the parallel final merge of the pipeline model, in which the hash tables of every bucket
+      *  are merged by an independent task. Each bucket has its own arena, so `concurrency` must be NUM_BUCKETS.
+      *  Different buckets can be merged concurrently.
+      */
+    void mergeBucket(Int32 bucket_num);
+
+    /** Called after all the buckets have been merged by `mergeBucket`.
+      * Then `getData(i)` converts the merged buckets to blocks one by one when they are read,
+      * so that the blocks of all the buckets are not materialized at the same time.
+      */
+    void finishParallelMerge(size_t read_concurrency_);
+
+    static constexpr Int32 NUM_BUCKETS = 256;
 
 private:
     Block getDataForSingleLevel();
 
     Block getDataForTwoLevel(size_t concurrency_index);
 
+    Block getDataForMergedBuckets(size_t concurrency_index);
+
     void doLevelMerge(Int32 bucket_num, size_t concurrency_index);
 
+    void mergeBucketData(Int32 bucket_num, size_t arena_index);
+
+    void convertBucketToBlocks(Int32 bucket_num, size_t arena_index, BlocksList & output);
+
 private:
     const LoggerPtr log;
     const Aggregator & aggregator;
@@ -922,7 +945,9 @@ private:
     std::vector<std::unique_ptr<BlocksList>> two_level_parallel_merge_data;
 
     std::atomic<Int32> current_bucket_num = 0;
-    static constexpr Int32 NUM_BUCKETS = 256;
+
+    /// Only used after `finishParallelMerge`, the number of readers of the merged buckets.
+    size_t read_concurrency = 0;
 };
 using MergingBucketsPtr = std::shared_ptr<MergingBuckets>;
 
@@ -1159,6 +1184,16 @@ protected:
         size_t rows,
         AggregateFunctionInstruction * aggregate_instructions) const;
 
+    /// Process one data block whose only key is a ColumnLowCardinality, look up each dictionary entry only once.
+    template <typename Method>
+    void executeLowCardinalityImpl(
+        Method & method,
+        Arena * aggregates_pool,
+        size_t rows,
+        const ColumnLowCardinality & key_column,
+        TiDB::TiDBCollators & collators,
+        AggregateFunctionInstruction * aggregate_instructions) const;
+
     /// For case when there are no keys (all aggregate into one row).
     static void executeWithoutKeyImpl(
         AggregatedDataWithoutKey & res,
@@ -54,9 +54,12 @@
 #include <Server/RaftConfigParser.h>
 #include <Server/ServerInfo.h>
 #include <Storages/BackgroundProcessingPool.h>
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
 #include <Storages/DeltaMerge/ColumnFile/ColumnFileSchema.h>
 #include <Storages/DeltaMerge/DeltaIndexManager.h>
+#include <Storages/DeltaMerge/Index/BloomFilterIndex.h>
 #include <Storages/DeltaMerge/Index/MinMaxIndex.h>
+#include <Storages/DeltaMerge/SegmentAggCache.h>
 #include <Storages/DeltaMerge/StoragePool.h>
 #include <Storages/IStorage.h>
 #include <Storages/MarkCache.h>
@@ -147,6 +150,9 @@ struct ContextShared
     mutable DBGInvoker dbg_invoker; /// Execute inner functions, debug only.
     mutable MarkCachePtr mark_cache; /// Cache of marks in compressed files.
     mutable DM::MinMaxIndexCachePtr minmax_index_cache; /// Cache of minmax index in compressed files.
+    mutable DM::BloomFilterIndexCachePtr bloom_filter_index_cache; /// Cache of bloom filter index in compressed files.
+    mutable DM::BitmapFilterCachePtr bitmap_filter_cache; /// Cache of the MVCC bitmap filters of segment snapshots.
+    mutable DM::SegmentAggCachePtr segment_agg_cache; /// Cache of the partial aggregation results of segments.
     mutable DM::DeltaIndexManagerPtr delta_index_manager; /// Manage the Delta Indies of Segments.
     ProcessList process_list; /// Executing queries at the moment.
     ViewDependencies view_dependencies; /// Current dependencies
@@ -1364,6 +1370,75 @@ void Context::dropMinMaxIndexCache() const
         shared->minmax_index_cache->reset();
 }
 
+void Context::setBloomFilterIndexCache(size_t cache_size_in_bytes)
+{
+    auto lock = getLock();
+
+    if (shared->bloom_filter_index_cache)
+        throw Exception("Bloom filter index cache has been already created.", ErrorCodes::LOGICAL_ERROR);
+
+    shared->bloom_filter_index_cache = std::make_shared<DM::BloomFilterIndexCache>(cache_size_in_bytes);
+}
+
+DM::BloomFilterIndexCachePtr Context::getBloomFilterIndexCache() const
+{
+    auto lock = getLock();
+    return shared->bloom_filter_index_cache;
+}
+
+void Context::dropBloomFilterIndexCache() const
+{
+    auto lock = getLock();
+    if (shared->bloom_filter_index_cache)
+        shared->bloom_filter_index_cache->reset();
+}
+
+void Context::setBitmapFilterCache(size_t cache_size_in_bytes)
+{
+    auto lock = getLock();
+
+    if (shared->bitmap_filter_cache)
+        throw Exception("Bitmap filter cache has been already created.", ErrorCodes::LOGICAL_ERROR);
+
+    shared->bitmap_filter_cache = std::make_shared<DM::BitmapFilterCache>(cache_size_in_bytes);
+}
+
+DM::BitmapFilterCachePtr Context::getBitmapFilterCache() const
+{
+    auto lock = getLock();
+    return shared->bitmap_filter_cache;
+}
+
+void Context::dropBitmapFilterCache() const
+{
+    auto lock = getLock();
+    if (shared->bitmap_filter_cache)
+        shared->bitmap_filter_cache->reset();
+}
+
+void Context::setSegmentAggCache(size_t cache_size_in_bytes)
+{
+    auto lock = getLock();
+
+    if (shared->segment_agg_cache)
+        throw Exception("Segment aggregation cache has been already created.", ErrorCodes::LOGICAL_ERROR);
+
+    shared->segment_agg_cache = std::make_shared<DM::SegmentAggCache>(cache_size_in_bytes);
+}
+
+DM::SegmentAggCachePtr Context::getSegmentAggCache() const
+{
+    auto lock = getLock();
+    return shared->segment_agg_cache;
+}
+
+void Context::dropSegmentAggCache() const
+{
+    auto lock = getLock();
+    if (shared->segment_agg_cache)
+        shared->segment_agg_cache->reset();
+}
+
 bool Context::isDeltaIndexLimited() const
 {
     // Don't need to use a lock here, as delta_index_manager should be set at starting up.
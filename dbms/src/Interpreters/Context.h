@@ -108,6 +108,9 @@ enum class PageStorageRunMode : UInt8;
 namespace DM
 {
 class MinMaxIndexCache;
+class BloomFilterIndexCache;
+class BitmapFilterCache;
+class SegmentAggCache;
 class DeltaIndexManager;
 class GlobalStoragePool;
 class SharedBlockSchemas;
@@ -376,6 +379,18 @@ public:
     std::shared_ptr<DM::MinMaxIndexCache> getMinMaxIndexCache() const;
     void dropMinMaxIndexCache() const;
 
+    void setBloomFilterIndexCache(size_t cache_size_in_bytes);
+    std::shared_ptr<DM::BloomFilterIndexCache> getBloomFilterIndexCache() const;
+    void dropBloomFilterIndexCache() const;
+
+    void setBitmapFilterCache(size_t cache_size_in_bytes);
+    std::shared_ptr<DM::BitmapFilterCache> getBitmapFilterCache() const;
+    void dropBitmapFilterCache() const;
+
+    void setSegmentAggCache(size_t cache_size_in_bytes);
+    std::shared_ptr<DM::SegmentAggCache> getSegmentAggCache() const;
+    void dropSegmentAggCache() const;
+
     bool isDeltaIndexLimited() const;
     void setDeltaIndexManager(size_t cache_size_in_bytes);
     std::shared_ptr<DM::DeltaIndexManager> getDeltaIndexManager() const;
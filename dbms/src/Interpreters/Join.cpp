@@ -132,6 +132,7 @@ Join::Join(
     const JoinNonEqualConditions & non_equal_conditions_,
     size_t max_block_size_,
     size_t shallow_copy_cross_probe_threshold_,
+    size_t probe_batch_size_,
     const String & match_helper_name_,
     const String & flag_mapped_entry_helper_name_,
     size_t restore_round_,
@@ -159,6 +160,7 @@ Join::Join(
     , probe_spill_config(probe_spill_config_)
     , join_restore_concurrency(join_restore_concurrency_)
     , shallow_copy_cross_probe_threshold(shallow_copy_cross_probe_threshold_ > 0 ? shallow_copy_cross_probe_threshold_ : std::max(1, max_block_size / 10))
+    , probe_batch_size(probe_batch_size_)
     , tidb_output_column_names(tidb_output_column_names_)
     , is_test(is_test_)
     , log(Logger::get(req_id))
@@ -332,6 +334,7 @@ std::shared_ptr<Join> Join::createRestoreJoin(size_t max_bytes_before_external_j
         non_equal_conditions,
         max_block_size,
         shallow_copy_cross_probe_threshold,
+        probe_batch_size,
         match_helper_name,
         flag_mapped_entry_helper_name,
         restore_round + 1,
@@ -366,7 +369,11 @@ void Join::initBuild(const Block & sample_block, size_t build_concurrency_)
             LOG_WARNING(log, "Join does not support spill, reason: input data from build side contains only constant columns");
         }
         if (max_bytes_before_external_join > 0)
+        {
             build_spiller = std::make_unique<Spiller>(build_spill_config, false, build_concurrency_, build_sample_block, log);
+            if (delay_spill)
+                build_delayed_spill_blocks.resize(build_concurrency_);
+        }
     }
     setSampleBlock(sample_block);
 }
@@ -387,6 +394,8 @@ void Join::initProbe(const Block & sample_block, size_t probe_concurrency_)
         else
         {
             probe_spiller = std::make_unique<Spiller>(probe_spill_config, false, build_concurrency, probe_sample_block, log);
+            if (delay_spill)
+                probe_delayed_spill_blocks.resize(probe_concurrency_);
         }
     }
 }
@@ -474,14 +483,14 @@ void Join::insertFromBlock(const Block & block, size_t stream_index)
                     continue;
                 }
             }
-            build_spiller->spillBlocks(std::move(blocks_to_spill), i);
+            spillBuildBlocks(std::move(blocks_to_spill), i, stream_index);
         }
 #ifdef DBMS_PUBLIC_GTEST
         // for join spill to disk gtest
         if (restore_round == 2)
             return;
 #endif
-        spillMostMemoryUsedPartitionIfNeed();
+        spillMostMemoryUsedPartitionIfNeed(stream_index);
     }
 }
 
@@ -1039,7 +1048,7 @@ Block Join::doJoinBlockHash(ProbeProcessInfo & probe_process_info) const
     auto & offsets_to_replicate = probe_process_info.offsets_to_replicate;
 
     bool enable_spill_join = isEnableSpill();
-    JoinBuildInfo join_build_info{enable_fine_grained_shuffle, fine_grained_shuffle_count, enable_spill_join, is_spilled, build_concurrency, restore_round};
+    JoinBuildInfo join_build_info{enable_fine_grained_shuffle, fine_grained_shuffle_count, enable_spill_join, is_spilled, build_concurrency, restore_round, probe_batch_size};
     JoinPartition::probeBlock(partitions, rows, probe_process_info.key_columns, key_sizes, added_columns, probe_process_info.null_map, filter, current_offset, offsets_to_replicate, right_indexes, collators, join_build_info, probe_process_info, flag_mapped_entry_helper_column);
     FAIL_POINT_TRIGGER_EXCEPTION(FailPoints::random_join_prob_failpoint);
     /// For RIGHT_SEMI/RIGHT_ANTI join without other conditions, hash table has been marked already, just return empty build table header
@@ -1537,7 +1546,8 @@ void Join::workAfterBuildFinish()
 
     if (isEnableSpill())
     {
-        if (hasPartitionSpilled())
+        /// If delay final build spill is enabled, the final spill will be done by the IO threads later, see `finalSpillBuildPartition`.
+        if (hasPartitionSpilled() && !delay_final_build_spill)
         {
             spillAllBuildPartitions();
             build_spiller->finishSpill();
@@ -1583,6 +1593,12 @@ void Join::waitUntilAllBuildFinished() const
         throw Exception(error_message);
 }
 
+bool Join::isAllBuildFinished() const
+{
+    std::lock_guard lock(build_probe_mutex);
+    return active_build_threads == 0 || meet_error || skip_wait;
+}
+
 void Join::finishOneProbe()
 {
     std::unique_lock lock(build_probe_mutex);
@@ -1760,7 +1776,7 @@ IColumn::Selector Join::selectDispatchBlock(const Strings & key_columns_names, c
     return hashToSelector(hash);
 }
 
-void Join::spillMostMemoryUsedPartitionIfNeed()
+void Join::spillMostMemoryUsedPartitionIfNeed(size_t stream_index)
 {
     Int64 target_partition_index = -1;
     size_t max_bytes = 0;
@@ -1807,7 +1823,7 @@ void Join::spillMostMemoryUsedPartitionIfNeed()
         blocks_to_spill = partitions[target_partition_index]->trySpillBuildPartition(true, build_spill_config.max_cached_data_bytes_in_spiller, partition_lock);
         spilled_partition_indexes.push_back(target_partition_index);
     }
-    build_spiller->spillBlocks(std::move(blocks_to_spill), target_partition_index);
+    spillBuildBlocks(std::move(blocks_to_spill), target_partition_index, stream_index);
     LOG_DEBUG(log, fmt::format("all bytes used after spill: {}", getTotalByteCount()));
 }
 
@@ -1828,6 +1844,12 @@ bool Join::hasPartitionSpilled()
     return !spilled_partition_indexes.empty();
 }
 
+std::vector<size_t> Join::getSpilledPartitionIndexesWithLock()
+{
+    std::unique_lock lk(build_probe_mutex);
+    return {spilled_partition_indexes.cbegin(), spilled_partition_indexes.cend()};
+}
+
 std::optional<RestoreInfo> Join::getOneRestoreStream(size_t max_block_size_)
 {
     std::unique_lock lock(build_probe_mutex);
@@ -1902,7 +1924,7 @@ std::optional<RestoreInfo> Join::getOneRestoreStream(size_t max_block_size_)
     }
 }
 
-void Join::dispatchProbeBlock(Block & block, PartitionBlocks & partition_blocks_list)
+void Join::dispatchProbeBlock(Block & block, PartitionBlocks & partition_blocks_list, size_t stream_index)
 {
     Blocks partition_blocks = dispatchBlock(key_names_left, block);
     for (size_t i = 0; i < partition_blocks.size(); ++i)
@@ -1922,7 +1944,7 @@ void Join::dispatchProbeBlock(Block & block, PartitionBlocks & partition_blocks_
         }
         if (need_spill)
         {
-            probe_spiller->spillBlocks(std::move(blocks_to_spill), i);
+            spillProbeBlocks(std::move(blocks_to_spill), i, stream_index);
         }
         else
         {
@@ -1947,6 +1969,66 @@ void Join::spillAllProbePartitions()
     }
 }
 
+void Join::spillBuildBlocks(Blocks && blocks, size_t partition_index, size_t stream_index)
+{
+    if (blocks.empty())
+        return;
+    if (delay_spill)
+        build_delayed_spill_blocks[stream_index].emplace_back(partition_index, std::move(blocks));
+    else
+        build_spiller->spillBlocks(std::move(blocks), partition_index);
+}
+
+void Join::spillProbeBlocks(Blocks && blocks, size_t partition_index, size_t stream_index)
+{
+    if (blocks.empty())
+        return;
+    if (delay_spill)
+        probe_delayed_spill_blocks[stream_index].emplace_back(partition_index, std::move(blocks));
+    else
+        probe_spiller->spillBlocks(std::move(blocks), partition_index);
+}
+
+bool Join::hasBuildSpillData(size_t stream_index) const
+{
+    return delay_spill && stream_index < build_delayed_spill_blocks.size() && !build_delayed_spill_blocks[stream_index].empty();
+}
+
+void Join::flushBuildSpillData(size_t stream_index)
+{
+    assert(delay_spill);
+    SpillBlocksByPartition spill_blocks;
+    spill_blocks.swap(build_delayed_spill_blocks[stream_index]);
+    for (auto & [partition_index, blocks] : spill_blocks)
+        build_spiller->spillBlocks(std::move(blocks), partition_index);
+}
+
+bool Join::hasProbeSpillData(size_t stream_index) const
+{
+    return delay_spill && stream_index < probe_delayed_spill_blocks.size() && !probe_delayed_spill_blocks[stream_index].empty();
+}
+
+void Join::flushProbeSpillData(size_t stream_index)
+{
+    assert(delay_spill);
+    SpillBlocksByPartition spill_blocks;
+    spill_blocks.swap(probe_delayed_spill_blocks[stream_index]);
+    for (auto & [partition_index, blocks] : spill_blocks)
+        probe_spiller->spillBlocks(std::move(blocks), partition_index);
+}
+
+void Join::finalSpillBuildPartition(size_t partition_index)
+{
+    assert(delay_final_build_spill && active_build_threads == 0);
+    build_spiller->spillBlocks(partitions[partition_index]->trySpillBuildPartition(true, build_spill_config.max_cached_data_bytes_in_spiller), partition_index);
+}
+
+void Join::finishBuildSpill()
+{
+    assert(delay_final_build_spill && active_build_threads == 0);
+    build_spiller->finishSpill();
+}
+
 void Join::releaseAllPartitions()
 {
     for (auto & partition : partitions)
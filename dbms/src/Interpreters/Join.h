@@ -151,6 +151,7 @@ public:
          const JoinNonEqualConditions & non_equal_conditions_ = {},
          size_t max_block_size = 0,
          size_t shallow_copy_cross_probe_threshold_ = 0,
+         size_t probe_batch_size_ = 0,
          const String & match_helper_name_ = "",
          const String & flag_mapped_entry_helper_name_ = "",
          size_t restore_round = 0,
@@ -168,6 +169,28 @@ public:
 
     void insertFromBlock(const Block & block, size_t stream_index);
 
+    /** In the pipeline model, the build/probe threads should not do disk IO.
+      * If delay spill is enabled, the blocks to spill are cached by stream_index and should be
+      * flushed by `flushBuildSpillData`/`flushProbeSpillData` in IO threads.
+      * If delay_final_build_spill is true, the final spill of build data after build finished is skipped
+      * in `finishOneBuild` and should be done by `finalSpillBuildPartition` and `finishBuildSpill`.
+      * Must be called before initBuild and initProbe.
+      */
+    void setDelaySpill(bool delay_final_build_spill_)
+    {
+        delay_spill = true;
+        delay_final_build_spill = delay_final_build_spill_;
+    }
+    bool isDelaySpill() const { return delay_spill; }
+
+    bool hasBuildSpillData(size_t stream_index) const;
+    void flushBuildSpillData(size_t stream_index);
+    bool hasProbeSpillData(size_t stream_index) const;
+    void flushProbeSpillData(size_t stream_index);
+
+    void finalSpillBuildPartition(size_t partition_index);
+    void finishBuildSpill();
+
     /** Join data from the map (that was previously built by calls to insertFromBlock) to the block with data from "left" table.
       * Could be called from different threads in parallel.
       */
@@ -190,12 +213,14 @@ public:
     bool hasPartitionSpilledWithLock();
 
     bool hasPartitionSpilled();
+    std::vector<size_t> getSpilledPartitionIndexesWithLock();
 
     bool isSpilled() const { return is_spilled; }
 
     std::optional<RestoreInfo> getOneRestoreStream(size_t max_block_size);
 
-    void dispatchProbeBlock(Block & block, PartitionBlocks & partition_blocks_list);
+    /// stream_index is only used when delay spill is enabled.
+    void dispatchProbeBlock(Block & block, PartitionBlocks & partition_blocks_list, size_t stream_index = 0);
 
     Blocks dispatchBlock(const Strings & key_columns_names, const Block & from_block);
 
@@ -246,6 +271,7 @@ public:
 
     void finishOneBuild();
     void waitUntilAllBuildFinished() const;
+    bool isAllBuildFinished() const;
 
     void finishOneProbe();
     void waitUntilAllProbeFinished() const;
@@ -331,6 +357,12 @@ private:
     Int64 join_restore_concurrency;
     bool is_spilled = false;
     bool disable_spill = false;
+    bool delay_spill = false;
+    bool delay_final_build_spill = false;
+    /// Only used when delay spill is enabled, the blocks to spill of each build/probe stream.
+    using SpillBlocksByPartition = std::vector<std::pair<size_t, Blocks>>;
+    std::vector<SpillBlocksByPartition> build_delayed_spill_blocks;
+    std::vector<SpillBlocksByPartition> probe_delayed_spill_blocks;
     std::atomic<size_t> peak_build_bytes_usage{0};
 
     BlockInputStreams restore_build_streams;
@@ -354,6 +386,8 @@ private:
     CrossProbeMode cross_probe_mode = CrossProbeMode::DEEP_COPY_RIGHT_BLOCK;
     size_t right_rows_to_be_added_when_matched_for_cross_join = 0;
     size_t shallow_copy_cross_probe_threshold;
+    /// The number of rows hashed and prefetched together in hash probe, 0 means probing row by row.
+    size_t probe_batch_size;
 
 private:
     JoinMapMethod join_map_method = JoinMapMethod::EMPTY;
@@ -442,7 +476,9 @@ private:
     void releaseAllPartitions();
 
 
-    void spillMostMemoryUsedPartitionIfNeed();
+    void spillMostMemoryUsedPartitionIfNeed(size_t stream_index);
+    void spillBuildBlocks(Blocks && blocks, size_t partition_index, size_t stream_index);
+    void spillProbeBlocks(Blocks && blocks, size_t partition_index, size_t stream_index);
     std::shared_ptr<Join> createRestoreJoin(size_t max_bytes_before_external_join_);
 
     void workAfterBuildFinish();
@@ -20,6 +20,7 @@
 #include <Interpreters/ProbeProcessInfo.h>
 
 #include <ext/scope_guard.h>
+#include <optional>
 
 namespace DB
 {
@@ -950,6 +951,113 @@ struct RowFlaggedHashMapAdder
     }
 };
 
+/// Used by the batched probe of inner/left outer join. The right rows matched by a batch of probe rows
+/// are recorded first and then inserted into `added_columns` column by column, so that only one
+/// result column is written at a time instead of all of them for each matched row.
+class RightRowsGatherer
+{
+public:
+    void add(const Block * block, size_t row_num)
+    {
+        blocks.push_back(block);
+        row_nums.push_back(row_num);
+    }
+
+    void addDefault() { add(nullptr, 0); }
+
+    void flush(size_t num_columns_to_add, MutableColumns & added_columns, const std::vector<size_t> & right_indexes)
+    {
+        if (blocks.empty())
+            return;
+        size_t rows = blocks.size();
+        for (size_t j = 0; j < num_columns_to_add; ++j)
+        {
+            auto & column = *added_columns[j];
+            size_t position = right_indexes[j];
+            column.reserve(column.size() + rows);
+            for (size_t k = 0; k < rows; ++k)
+            {
+                if (blocks[k] != nullptr)
+                    column.insertFrom(*blocks[k]->getByPosition(position).column, row_nums[k]);
+                else
+                    column.insertDefault();
+            }
+        }
+        blocks.clear();
+        row_nums.clear();
+    }
+
+private:
+    /// nullptr means the row is not matched and a default value should be inserted.
+    PaddedPODArray<const Block *> blocks;
+    PaddedPODArray<size_t> row_nums;
+};
+
+/// The same as `Adder` but records the matched right rows into `RightRowsGatherer`,
+/// only used for inner/left outer join.
+template <ASTTableJoin::Kind KIND, ASTTableJoin::Strictness STRICTNESS, typename Map>
+struct GatherAdder
+{
+    static_assert(KIND == ASTTableJoin::Kind::Inner || KIND == ASTTableJoin::Kind::LeftOuter);
+
+    static bool addFound(const typename Map::ConstLookupResult & it, RightRowsGatherer & gatherer, size_t i, IColumn::Filter * filter, IColumn::Offset & current_offset, IColumn::Offsets * offsets, ProbeProcessInfo & probe_process_info)
+    {
+        it->getMapped().setUsed();
+        if constexpr (STRICTNESS == ASTTableJoin::Strictness::Any)
+        {
+            if constexpr (KIND == ASTTableJoin::Kind::Inner)
+                (*filter)[i] = 1;
+            gatherer.add(it->getMapped().block, it->getMapped().row_num);
+        }
+        else
+        {
+            size_t rows_joined = 0;
+            for (auto current = &static_cast<const typename Map::mapped_type::Base_t &>(it->getMapped()); current != nullptr; current = current->next)
+                ++rows_joined;
+
+            if (current_offset && current_offset + rows_joined > probe_process_info.max_block_size)
+                return true;
+
+            for (auto current = &static_cast<const typename Map::mapped_type::Base_t &>(it->getMapped()); current != nullptr; current = current->next)
+                gatherer.add(current->block, current->row_num);
+
+            current_offset += rows_joined;
+            (*offsets)[i] = current_offset;
+        }
+        return false;
+    }
+
+    static bool addNotFound(RightRowsGatherer & gatherer, size_t i, IColumn::Filter * filter, IColumn::Offset & current_offset, IColumn::Offsets * offsets, ProbeProcessInfo & probe_process_info)
+    {
+        if constexpr (STRICTNESS == ASTTableJoin::Strictness::Any)
+        {
+            if constexpr (KIND == ASTTableJoin::Kind::Inner)
+                (*filter)[i] = 0;
+            else
+                gatherer.addDefault();
+        }
+        else
+        {
+            if constexpr (KIND == ASTTableJoin::Kind::Inner)
+            {
+                (*offsets)[i] = current_offset;
+            }
+            else
+            {
+                if (current_offset && current_offset + 1 > probe_process_info.max_block_size)
+                    return true;
+                ++current_offset;
+                (*offsets)[i] = current_offset;
+                gatherer.addDefault();
+            }
+        }
+        return false;
+    }
+};
+
+/// The distance (in rows) between the row whose bucket is prefetched and the row being looked up in batched probe.
+constexpr size_t PROBE_PREFETCH_DISTANCE = 16;
+
 template <ASTTableJoin::Kind KIND, ASTTableJoin::Strictness STRICTNESS, typename KeyGetter, typename Map, bool has_null_map, bool row_flagged_map>
 void NO_INLINE probeBlockImplTypeCase(
     const JoinPartitions & join_partitions,
@@ -1008,144 +1116,217 @@ void NO_INLINE probeBlockImplTypeCase(
     }
 
     const auto & build_hash_data = build_hash.getData();
-    assert(probe_process_info.start_row < rows);
-    size_t i;
-    bool block_full = false;
-    for (i = probe_process_info.start_row; i < rows; ++i)
-    {
-        if (has_null_map && (*null_map)[i])
+    auto get_segment_index = [&](size_t i, size_t hash_value) -> size_t {
+        if (join_build_info.is_spilled)
+            return probe_process_info.partition_index;
+
+        if (join_build_info.needVirtualDispatchForProbeBlock())
         {
-            if constexpr (row_flagged_map)
+            /// Need to calculate the correct segment_index so that rows with same key will map to the same segment_index both in Build and Prob
+            /// The "reproduce" of segment_index generated in Build phase relies on the facts that:
+            /// Possible pipelines(FineGrainedShuffleWriter => ExchangeReceiver => HashBuild)
+            /// 1. In FineGrainedShuffleWriter, selector value finally maps to packet_stream_id by '% fine_grained_shuffle_count'
+            /// 2. In ExchangeReceiver, build_stream_id = packet_stream_id % build_stream_count;
+            /// 3. In HashBuild, build_concurrency decides map's segment size, and build_steam_id decides the segment index
+            if (join_build_info.enable_fine_grained_shuffle)
             {
-                block_full = RowFlaggedHashMapAdder<Map>::addNotFound(
-                    i,
-                    current_offset,
-                    offsets_to_replicate.get());
-            }
-            /// RightSemi/RightAnti without other conditions, just ignore not matched probe rows
-            else if constexpr (KIND != ASTTableJoin::Kind::RightSemi && KIND != ASTTableJoin::Kind::RightAnti)
-            {
-                block_full = Adder<KIND, STRICTNESS, Map>::addNotFound(
-                    num_columns_to_add,
-                    added_columns,
-                    i,
-                    filter.get(),
-                    current_offset,
-                    offsets_to_replicate.get(),
-                    probe_process_info);
+                auto packet_stream_id = build_hash_data[i] % join_build_info.fine_grained_shuffle_count;
+                if likely (join_build_info.fine_grained_shuffle_count == segment_size)
+                    return packet_stream_id;
+                return packet_stream_id % segment_size;
             }
+            return build_hash_data[i] % join_build_info.build_concurrency;
+        }
+
+        return hash_value % segment_size;
+    };
+
+    auto add_found = [&](typename Map::LookupResult it, size_t i) -> bool {
+        if constexpr (row_flagged_map)
+        {
+            return RowFlaggedHashMapAdder<Map>::addFound(
+                it,
+                num_columns_to_add,
+                added_columns,
+                i,
+                current_offset,
+                offsets_to_replicate.get(),
+                right_indexes,
+                probe_process_info,
+                record_mapped_entry_column);
+        }
+        else if constexpr (KIND == ASTTableJoin::Kind::RightSemi || KIND == ASTTableJoin::Kind::RightAnti)
+        {
+            /// For RightSemi/RightAnti without other conditions, just flag the hash entry is enough
+            it->getMapped().setUsed();
+            return false;
         }
         else
         {
-            auto key_holder = key_getter.getKeyHolder(i, &pool, sort_key_containers);
-            SCOPE_EXIT(keyHolderDiscardKey(key_holder));
-            auto key = keyHolderGetKey(key_holder);
+            it->getMapped().setUsed();
+            return Adder<KIND, STRICTNESS, Map>::addFound(
+                it,
+                num_columns_to_add,
+                added_columns,
+                i,
+                filter.get(),
+                current_offset,
+                offsets_to_replicate.get(),
+                right_indexes,
+                probe_process_info);
+        }
+    };
 
-            size_t hash_value = 0;
-            bool zero_flag = ZeroTraits::check(key);
-            if (!zero_flag)
+    auto add_not_found = [&](size_t i) -> bool {
+        if constexpr (row_flagged_map)
+        {
+            return RowFlaggedHashMapAdder<Map>::addNotFound(
+                i,
+                current_offset,
+                offsets_to_replicate.get());
+        }
+        /// RightSemi/RightAnti without other conditions, just ignore not matched probe rows
+        else if constexpr (KIND != ASTTableJoin::Kind::RightSemi && KIND != ASTTableJoin::Kind::RightAnti)
+        {
+            return Adder<KIND, STRICTNESS, Map>::addNotFound(
+                num_columns_to_add,
+                added_columns,
+                i,
+                filter.get(),
+                current_offset,
+                offsets_to_replicate.get(),
+                probe_process_info);
+        }
+        else
+        {
+            return false;
+        }
+    };
+
+    assert(probe_process_info.start_row < rows);
+    size_t i = probe_process_info.start_row;
+    bool block_full = false;
+    if (join_build_info.probe_batch_size > 0)
+    {
+        /// Batched probe. Looking up a hash map much larger than the cache is bounded by the memory latency of
+        /// the bucket access, so rows are probed in batches:
+        /// 1. compute the hash values and the segments of all the rows in the batch
+        /// 2. look up the hash maps while prefetching the bucket of the row `PROBE_PREFETCH_DISTANCE` rows ahead,
+        ///    so that the cache misses of different rows overlap with each other
+        /// 3. add the results row by row, the matched right rows of inner/left outer join are gathered column by column
+        constexpr bool gather_right_rows = !row_flagged_map && (KIND == ASTTableJoin::Kind::Inner || KIND == ASTTableJoin::Kind::LeftOuter);
+        const size_t batch_size = join_build_info.probe_batch_size;
+        PaddedPODArray<size_t> hash_values(batch_size);
+        PaddedPODArray<size_t> segment_indexes(batch_size);
+        PaddedPODArray<typename Map::LookupResult> lookup_results(batch_size);
+        /// The key of a row is got once and kept from hashing to lookup. Each row of the batch has its own
+        /// sort key containers, because the key may refer to the collation sort key in the containers.
+        using KeyHolder = decltype(key_getter.getKeyHolder(0, &pool, sort_key_containers));
+        std::vector<std::optional<KeyHolder>> key_holders(batch_size);
+        std::vector<std::vector<std::string>> batch_sort_key_containers(batch_size, std::vector<std::string>(sort_key_containers.size()));
+        /// The serialized keys of a batch may span several chunks of an arena, and `Arena::rollback` can only
+        /// roll back within the last chunk, so the keys of each batch are kept in an arena owned by the batch.
+        std::optional<Arena> batch_pool;
+        RightRowsGatherer gatherer;
+        while (i < rows && !block_full)
+        {
+            const size_t batch_begin = i;
+            const size_t batch_rows = std::min(rows - batch_begin, batch_size);
+            batch_pool.emplace();
+
+            for (size_t k = 0; k < batch_rows; ++k)
             {
-                hash_value = all_maps[probe_process_info.partition_index]->hash(key);
+                size_t row = batch_begin + k;
+                if (has_null_map && (*null_map)[row])
+                    continue;
+                auto & key_holder = key_holders[k].emplace(key_getter.getKeyHolder(row, &*batch_pool, batch_sort_key_containers[k]));
+                const auto & key = keyHolderGetKey(key_holder);
+                hash_values[k] = ZeroTraits::check(key) ? 0 : all_maps[probe_process_info.partition_index]->hash(key);
+                segment_indexes[k] = get_segment_index(row, hash_values[k]);
             }
 
-            size_t segment_index = 0;
-            if (join_build_info.is_spilled)
+            auto prefetch = [&](size_t k) {
+                if (!(has_null_map && (*null_map)[batch_begin + k]))
+                    all_maps[segment_indexes[k]]->prefetch(hash_values[k]);
+            };
+            for (size_t k = 0; k < std::min(batch_rows, PROBE_PREFETCH_DISTANCE); ++k)
+                prefetch(k);
+            for (size_t k = 0; k < batch_rows; ++k)
             {
-                segment_index = probe_process_info.partition_index;
+                if (k + PROBE_PREFETCH_DISTANCE < batch_rows)
+                    prefetch(k + PROBE_PREFETCH_DISTANCE);
+                size_t row = batch_begin + k;
+                if (has_null_map && (*null_map)[row])
+                {
+                    lookup_results[k] = nullptr;
+                    continue;
+                }
+                /// do not require segment lock because in join, the hash table can not be changed in probe stage.
+                lookup_results[k] = all_maps[segment_indexes[k]]->find(keyHolderGetKey(*key_holders[k]), hash_values[k]);
             }
-            else if (join_build_info.needVirtualDispatchForProbeBlock())
+            /// The keys are not needed after lookup, they are released with `batch_pool` by the next batch.
+            for (size_t k = 0; k < batch_rows; ++k)
+                key_holders[k].reset();
+
+            for (; i < batch_begin + batch_rows; ++i)
             {
-                /// Need to calculate the correct segment_index so that rows with same key will map to the same segment_index both in Build and Prob
-                /// The "reproduce" of segment_index generated in Build phase relies on the facts that:
-                /// Possible pipelines(FineGrainedShuffleWriter => ExchangeReceiver => HashBuild)
-                /// 1. In FineGrainedShuffleWriter, selector value finally maps to packet_stream_id by '% fine_grained_shuffle_count'
-                /// 2. In ExchangeReceiver, build_stream_id = packet_stream_id % build_stream_count;
-                /// 3. In HashBuild, build_concurrency decides map's segment size, and build_steam_id decides the segment index
-                if (join_build_info.enable_fine_grained_shuffle)
+                auto it = lookup_results[i - batch_begin];
+                if constexpr (gather_right_rows)
                 {
-                    auto packet_stream_id = build_hash_data[i] % join_build_info.fine_grained_shuffle_count;
-                    if likely (join_build_info.fine_grained_shuffle_count == segment_size)
-                        segment_index = packet_stream_id;
+                    if (it != nullptr)
+                        block_full = GatherAdder<KIND, STRICTNESS, Map>::addFound(it, gatherer, i, filter.get(), current_offset, offsets_to_replicate.get(), probe_process_info);
                     else
-                        segment_index = packet_stream_id % segment_size;
+                        block_full = GatherAdder<KIND, STRICTNESS, Map>::addNotFound(gatherer, i, filter.get(), current_offset, offsets_to_replicate.get(), probe_process_info);
                 }
                 else
                 {
-                    segment_index = build_hash_data[i] % join_build_info.build_concurrency;
+                    block_full = it != nullptr ? add_found(it, i) : add_not_found(i);
                 }
+
+                // if block_full is true means that the current offset is greater than max_block_size, we need break the loop.
+                if (block_full)
+                    break;
             }
-            else
+            if constexpr (gather_right_rows)
+                gatherer.flush(num_columns_to_add, added_columns, right_indexes);
+        }
+    }
+    else
+    {
+        for (; i < rows; ++i)
+        {
+            if (has_null_map && (*null_map)[i])
             {
-                segment_index = hash_value % segment_size;
+                block_full = add_not_found(i);
             }
-
-            auto & internal_map = *all_maps[segment_index];
-            /// do not require segment lock because in join, the hash table can not be changed in probe stage.
-            auto it = internal_map.find(key, hash_value);
-            if (it != internal_map.end())
+            else
             {
-                if constexpr (row_flagged_map)
-                {
-                    block_full = RowFlaggedHashMapAdder<Map>::addFound(
-                        it,
-                        num_columns_to_add,
-                        added_columns,
-                        i,
-                        current_offset,
-                        offsets_to_replicate.get(),
-                        right_indexes,
-                        probe_process_info,
-                        record_mapped_entry_column);
-                }
-                else if constexpr (KIND == ASTTableJoin::Kind::RightSemi || KIND == ASTTableJoin::Kind::RightAnti)
+                auto key_holder = key_getter.getKeyHolder(i, &pool, sort_key_containers);
+                SCOPE_EXIT(keyHolderDiscardKey(key_holder));
+                auto key = keyHolderGetKey(key_holder);
+
+                size_t hash_value = 0;
+                bool zero_flag = ZeroTraits::check(key);
+                if (!zero_flag)
                 {
-                    /// For RightSemi/RightAnti without other conditions, just flag the hash entry is enough
-                    it->getMapped().setUsed();
+                    hash_value = all_maps[probe_process_info.partition_index]->hash(key);
                 }
+
+                auto & internal_map = *all_maps[get_segment_index(i, hash_value)];
+                /// do not require segment lock because in join, the hash table can not be changed in probe stage.
+                auto it = internal_map.find(key, hash_value);
+                if (it != internal_map.end())
+                    block_full = add_found(it, i);
                 else
-                {
-                    it->getMapped().setUsed();
-                    block_full = Adder<KIND, STRICTNESS, Map>::addFound(
-                        it,
-                        num_columns_to_add,
-                        added_columns,
-                        i,
-                        filter.get(),
-                        current_offset,
-                        offsets_to_replicate.get(),
-                        right_indexes,
-                        probe_process_info);
-                }
+                    block_full = add_not_found(i);
             }
-            else
+
+            // if block_full is true means that the current offset is greater than max_block_size, we need break the loop.
+            if (block_full)
             {
-                if constexpr (row_flagged_map)
-                {
-                    block_full = RowFlaggedHashMapAdder<Map>::addNotFound(
-                        i,
-                        current_offset,
-                        offsets_to_replicate.get());
-                }
-                /// RightSemi/RightAnti without other conditions, just ignore not matched probe rows
-                else if constexpr (KIND != ASTTableJoin::Kind::RightSemi && KIND != ASTTableJoin::Kind::RightAnti)
-                {
-                    block_full = Adder<KIND, STRICTNESS, Map>::addNotFound(
-                        num_columns_to_add,
-                        added_columns,
-                        i,
-                        filter.get(),
-                        current_offset,
-                        offsets_to_replicate.get(),
-                        probe_process_info);
-                }
+                break;
             }
         }
-
-        // if block_full is true means that the current offset is greater than max_block_size, we need break the loop.
-        if (block_full)
-        {
-            break;
-        }
     }
 
     probe_process_info.updateEndRow<false>(i);
@@ -95,6 +95,8 @@ struct JoinBuildInfo
     bool is_spilled;
     size_t build_concurrency;
     size_t restore_round;
+    /// The number of rows hashed and prefetched together in hash probe, 0 means probing row by row.
+    size_t probe_batch_size;
     bool needVirtualDispatchForProbeBlock() const
     {
         return enable_fine_grained_shuffle || (enable_spill && !is_spilled);
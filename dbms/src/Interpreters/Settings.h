@@ -178,6 +178,7 @@ struct Settings
     M(SettingFloat, dt_bg_gc_delta_delete_ratio_to_trigger_gc, 0.3, "Trigger segment's gc when the ratio of delta delete range to stable exceeds this ratio.")                                                                          \
     M(SettingUInt64, dt_insert_max_rows, 0, "Max rows of insert blocks when write into DeltaTree Engine. By default 0 means no limit.")                                                                                                 \
     M(SettingBool, dt_enable_rough_set_filter, true, "Whether to parse where expression as Rough Set Index filter or not.")                                                                                                             \
+    M(SettingBool, dt_enable_bloom_filter_index, false, "Whether to build bloom filter index for the non-handle columns when writing DTFile. The DTFile can not be read by older versions if enabled.")                                 \
     M(SettingBool, dt_raw_filter_range, true, "[unused] Do range filter or not when read data in raw mode in DeltaTree Engine.")                                                                                                        \
     M(SettingBool, dt_read_delta_only, false, "Only read delta data in DeltaTree Engine.")                                                                                                                                              \
     M(SettingBool, dt_read_stable_only, false, "Only read stable data in DeltaTree Engine.")                                                                                                                                            \
@@ -186,6 +187,12 @@ struct Settings
     M(SettingBool, dt_enable_relevant_place, false, "Enable relevant place or not in DeltaTree Engine.")                                                                                                                                \
     M(SettingBool, dt_enable_skippable_place, true, "Enable skippable place or not in DeltaTree Engine.")                                                                                                                               \
     M(SettingBool, dt_enable_stable_column_cache, true, "Enable column cache for StorageDeltaMerge.")                                                                                                                                   \
+    M(SettingBool, dt_enable_low_cardinality_string, false, "Whether to return low-cardinality string columns of DTFile as dictionary-encoded columns to the filter and aggregation upon table scan.")                                  \
+    M(SettingUInt64, dt_sst_to_dtfile_pipeline_queue_size, 0, "Max number of blocks buffered between decoding SST files and writing DTFiles, and read the column families concurrently. 0 means doing them serially")                   \
+    M(SettingUInt64, dt_persist_delta_index_min_rows, 0, "Persist the delta index into PageStorage after it places at least this number of new delta rows, so it can be loaded after restart or eviction. 0 means disabled")            \
+    M(SettingUInt64, dt_segment_warm_up_read_threshold, 0, "Warm up the delta index and MinMax indexes of a segment in background after it is replaced, if it is read at least this number of times recently. 0 means disabled")        \
+    M(SettingUInt64, dt_segment_warm_up_max_concurrency, 1, "Max number of background threads warming up segments at the same time, which limits the CPU used by warm-up")                                                              \
+    M(SettingDouble, dt_segment_warm_up_cache_usage_ratio, 0.8, "Stop warming up segments when the usage of DeltaIndex or MinMax index cache exceeds this ratio of its capacity")                                                       \
     \
     /* These PageStorage V2 settings are deprecated */ \
     M(SettingUInt64, dt_open_file_max_idle_seconds, 15, "Deprecated. Max idle time of opening files, 0 means infinite.")                                                                                                                \
@@ -216,17 +223,23 @@ struct Settings
                                                                                                                                                                                                                                         \
     M(SettingDouble, dt_page_gc_threshold, 0.5, "Max valid rate of deciding to do a GC in PageStorage")                                                                                                                                 \
     M(SettingBool, dt_enable_read_thread, true, "Enable storage read thread or not")                                                                                                                                                    \
+    M(SettingUInt64, dt_read_prefetch_packs, 8, "The number of next packs of DTFile to prefetch in batches, only works when io_uring is enabled. 0 means no prefetch")                                                                  \
+    M(SettingBool, dt_enable_scan_sharing, false, "Start a fast scan of DTFile from the position of other concurrent scans and wrap around, to share the decoded packs. Only works with read thread")                                   \
     M(SettingBool, dt_enable_bitmap_filter, true, "Use bitmap filter to read data or not")                                                                                                                                              \
+    M(SettingBool, dt_enable_segment_agg_cache, false, "Compute the aggregation on a table scan segment by segment and reuse the cached partial results of unchanged segments. It needs segment_agg_cache_size > 0.")                   \
+    M(SettingDouble, dt_late_materialization_max_passed_ratio, 0.8, "Stop late materialization for the rest segments of a table scan if more rows pass the pushed down filter. >= 1 means never stop")                                  \
     M(SettingDouble, dt_read_thread_count_scale, 1.0, "Number of read thread = number of logical cpu cores * dt_read_thread_count_scale.  Only has meaning at server startup.")                                                         \
     M(SettingDouble, dt_filecache_max_downloading_count_scale, 1.0, "Max downloading task count of FileCache = io thread count * dt_filecache_max_downloading_count_scale.")                                                            \
     M(SettingUInt64, dt_filecache_min_age_seconds, 1800, "Files of the same priority can only be evicted from files that were not accessed within `dt_filecache_min_age_seconds` seconds.")                                             \
+    M(SettingDouble, dt_filecache_evict_high_watermark, 0.95, "Evict the files that are not accessed recently in background when the used space of FileCache exceeds this ratio of the capacity.")                                      \
+    M(SettingDouble, dt_filecache_evict_low_watermark, 0.9, "The background eviction of FileCache stops when the used space is not greater than this ratio of the capacity.")                                                           \
     M(SettingUInt64, dt_small_file_size_threshold, 128 * 1024, "When S3 is enabled, file size less than dt_small_file_size_threshold will be merged before uploading to S3")                                                            \
     M(SettingDouble, dt_merged_file_max_size, 1024 * 1024, "Small files are merged into one or more files not larger than dt_merged_file_max_size")                                                                                     \
     M(SettingDouble, io_thread_count_scale, 5.0, "Number of thread of IOThreadPool = number of logical cpu cores * io_thread_count_scale.  Only has meaning at server startup.")                                                        \
     M(SettingUInt64, init_thread_count_scale, 100, "Number of thread = number of logical cpu cores * init_thread_count_scale. It just works for thread pool for initStores and loadMetadata")                                           \
                                                                                                                                                                                                                                         \
     M(SettingChecksumAlgorithm, dt_checksum_algorithm, ChecksumAlgo::XXH3, "Checksum algorithm for delta tree stable storage")                                                                                                          \
-    M(SettingCompressionMethod, dt_compression_method, CompressionMethod::LZ4, "The method of data compression when writing.")                                                                                                          \
+    M(SettingCompressionMethod, dt_compression_method, CompressionMethod::LZ4, "The method of data compression when writing. The DTFiles written by 'lightweight' can not be read by older versions.")                                  \
     M(SettingInt64, dt_compression_level, 1, "The compression level.")                                                                                                                                                                  \
     \
     M(SettingInt64, remote_checkpoint_interval_seconds, 30, "The interval of uploading checkpoint to the remote store. Unit is second.")                                                                                                \
@@ -242,6 +255,7 @@ struct Settings
     \
     M(SettingUInt64, max_rows_in_set, 0, "Maximum size of the set (in number of elements) resulting from the execution of the IN section.")                                                                                             \
     M(SettingUInt64, rf_max_in_value_set, 1024, "Maximum size of the set (in number of elements) resulting from the execution of the RF IN Predicate.")                                                                                 \
+    M(SettingUInt64, rf_max_bloom_filter_values, 4194304, "Maximum number of distinct values that can be inserted into the RF bloom filter, the RF is disabled if exceeded.")                                                           \
     M(SettingUInt64, max_bytes_in_set, 0, "Maximum size of the set (in bytes in memory) resulting from the execution of the IN section.")                                                                                               \
     M(SettingOverflowMode<false>, set_overflow_mode, OverflowMode::THROW, "What to do when the limit is exceeded.")                                                                                                                     \
                                                                                                                                                                                                                                         \
@@ -300,7 +314,11 @@ struct Settings
     M(SettingBool, force_push_down_all_filters_to_scan, false, "Push down all filters to scan, only used for test")                                                                                                                     \
     M(SettingUInt64, async_recv_version, 1, "1: reactor mode, 2: no additional threads")                                                                                                                                                \
     M(SettingUInt64, recv_queue_size, 0, "size of ExchangeReceiver queue, 0 means the size is set to data_source_mpp_task_num * 50")                                                                                                    \
-    M(SettingUInt64, shallow_copy_cross_probe_threshold, 0, "minimum right rows to use shallow copy probe mode for cross join, default is max(1, max_block_size/10)")
+    M(SettingUInt64, shallow_copy_cross_probe_threshold, 0, "minimum right rows to use shallow copy probe mode for cross join, default is max(1, max_block_size/10)")                                                                   \
+    M(SettingUInt64, join_probe_batch_size, 256, "the number of rows hashed and prefetched together when probing the hash table of join, 0 means probing row by row")                                                                   \
+    M(SettingBool, enable_parallel_agg_final_merge, false, "Whether to merge the buckets of two-level aggregated data in parallel by the task thread pool before convergent, only for the pipeline model")                              \
+    M(SettingUInt64, partial_agg_bypass_sample_rows, 0, "the number of input rows to sample before the partial aggregation decides whether to bypass the hash table, 0 means never bypass")                                             \
+    M(SettingFloat, partial_agg_bypass_ratio, 0.9, "the partial aggregation bypasses the hash table if the ratio of aggregated rows to sampled input rows is not less than it")
 
 // clang-format on
 #define DECLARE(TYPE, NAME, DEFAULT, DESCRIPTION) TYPE NAME{DEFAULT};
@@ -22,10 +22,12 @@
 #include <Storages/PathPool.h>
 #include <Storages/Transaction/FastAddPeer.h>
 
+#include <magic_enum.hpp>
+
 namespace DB
 {
 
-void SharedContextDisagg::initReadNodePageCache(const PathPool & path_pool, const String & cache_dir, size_t cache_capacity)
+void SharedContextDisagg::initReadNodePageCache(const PathPool & path_pool, const String & cache_dir, size_t cache_capacity, CachePolicy cache_policy)
 {
     RUNTIME_CHECK(rn_page_cache_storage == nullptr && rn_page_cache == nullptr);
 
@@ -35,12 +37,12 @@ void SharedContextDisagg::initReadNodePageCache(const PathPool & path_pool, cons
         if (!cache_dir.empty())
         {
             delegator = path_pool.getPSDiskDelegatorFixedDirectory(cache_dir);
-            LOG_INFO(Logger::get(), "Initialize Read Node page cache in cache directory. path={} capacity={}", cache_dir, cache_capacity);
+            LOG_INFO(Logger::get(), "Initialize Read Node page cache in cache directory. path={} capacity={} policy={}", cache_dir, cache_capacity, magic_enum::enum_name(cache_policy));
         }
         else
         {
             delegator = path_pool.getPSDiskDelegatorGlobalMulti(PathPool::read_node_cache_path_prefix);
-            LOG_INFO(Logger::get(), "Initialize Read Node page cache in data directory. capacity={}", cache_capacity);
+            LOG_INFO(Logger::get(), "Initialize Read Node page cache in data directory. capacity={} policy={}", cache_capacity, magic_enum::enum_name(cache_policy));
         }
 
         PageStorageConfig config;
@@ -52,6 +54,7 @@ void SharedContextDisagg::initReadNodePageCache(const PathPool & path_pool, cons
         rn_page_cache = DM::Remote::RNLocalPageCache::create({
             .underlying_storage = rn_page_cache_storage->getUniversalPageStorage(),
             .max_size_bytes = cache_capacity,
+            .policy = cache_policy,
         });
     }
     catch (...)
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <Common/CachePolicy.h>
 #include <Core/TiFlashDisaggregatedMode.h>
 #include <Encryption/FileProvider_fwd.h>
 #include <Interpreters/Context_fwd.h>
@@ -76,7 +77,7 @@ struct SharedContextDisagg : private boost::noncopyable
         : global_context(global_context_)
     {}
 
-    void initReadNodePageCache(const PathPool & path_pool, const String & cache_dir, size_t cache_capacity);
+    void initReadNodePageCache(const PathPool & path_pool, const String & cache_dir, size_t cache_capacity, CachePolicy cache_policy);
 
     /// Note that the unit of max_size is quantity, not byte size. It controls how
     /// **many** of delta index will be maintained.
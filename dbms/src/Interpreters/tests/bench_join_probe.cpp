@@ -0,0 +1,138 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Interpreters/Join.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace DB
+{
+namespace tests
+{
+/// Compare the row by row hash join probe with the batched probe.
+/// Args: {build rows, probe batch size}, 0 probe batch size means probing row by row.
+/// The hash map of 4M build rows is much larger than the last level cache.
+class JoinProbeBench : public benchmark::Fixture
+{
+protected:
+    static constexpr size_t block_size = 8192;
+    static constexpr size_t probe_rows = 1024 * 1024;
+
+    Blocks build_blocks;
+    Blocks probe_blocks;
+
+public:
+    void SetUp(const benchmark::State & state) override
+    {
+        size_t build_rows = state.range(0);
+        std::mt19937_64 rng(build_rows);
+        build_blocks.clear();
+        probe_blocks.clear();
+        for (size_t start = 0; start < build_rows; start += block_size)
+        {
+            size_t rows = std::min(block_size, build_rows - start);
+            auto keys = ColumnUInt64::create();
+            auto values = ColumnInt64::create();
+            for (size_t i = 0; i < rows; ++i)
+            {
+                keys->insert(Field(static_cast<UInt64>(start + i)));
+                values->insert(Field(static_cast<Int64>(rng())));
+            }
+            build_blocks.emplace_back(ColumnsWithTypeAndName{
+                {std::move(keys), std::make_shared<DataTypeUInt64>(), "rk"},
+                {std::move(values), std::make_shared<DataTypeInt64>(), "rv"}});
+        }
+        /// About half of the probe rows are matched.
+        std::uniform_int_distribution<UInt64> dist(0, build_rows * 2 - 1);
+        for (size_t start = 0; start < probe_rows; start += block_size)
+        {
+            auto keys = ColumnUInt64::create();
+            for (size_t i = 0; i < block_size; ++i)
+                keys->insert(Field(dist(rng)));
+            probe_blocks.emplace_back(ColumnsWithTypeAndName{{std::move(keys), std::make_shared<DataTypeUInt64>(), "k"}});
+        }
+    }
+
+    void TearDown(const benchmark::State &) override
+    {
+        build_blocks.clear();
+        probe_blocks.clear();
+    }
+
+    JoinPtr buildJoin(size_t probe_batch_size)
+    {
+        SpillConfig spill_config(TiFlashTestEnv::getTemporaryPath("join_probe_bench"), "join_probe_bench", 0, 0, 0, nullptr);
+        auto join = std::make_shared<Join>(
+            Names{"k"},
+            Names{"rk"},
+            ASTTableJoin::Kind::Inner,
+            ASTTableJoin::Strictness::All,
+            "join_probe_bench",
+            false,
+            0,
+            0,
+            spill_config,
+            spill_config,
+            0,
+            Names{"k", "rv"},
+            TiDB::dummy_collators,
+            JoinNonEqualConditions{},
+            block_size,
+            0,
+            probe_batch_size);
+        join->initBuild(build_blocks.front().cloneEmpty(), 1);
+        join->initProbe(probe_blocks.front().cloneEmpty(), 1);
+        join->setInitActiveBuildThreads();
+        for (const auto & block : build_blocks)
+            join->insertFromBlock(block, 0);
+        join->finishOneBuild();
+        return join;
+    }
+};
+
+BENCHMARK_DEFINE_F(JoinProbeBench, probe)
+(benchmark::State & state)
+try
+{
+    auto join = buildJoin(state.range(1));
+    for (auto _ : state)
+    {
+        size_t result_rows = 0;
+        for (const auto & block : probe_blocks)
+        {
+            ProbeProcessInfo probe_process_info(block_size);
+            probe_process_info.resetBlock(Block(block));
+            while (!probe_process_info.all_rows_joined_finish)
+                result_rows += join->joinBlock(probe_process_info).rows();
+        }
+        benchmark::DoNotOptimize(result_rows);
+    }
+    state.SetItemsProcessed(state.iterations() * probe_rows);
+}
+CATCH
+BENCHMARK_REGISTER_F(JoinProbeBench, probe)
+    ->Unit(benchmark::kMillisecond)
+    ->Args({64 * 1024, 0})
+    ->Args({64 * 1024, 256})
+    ->Args({4 * 1024 * 1024, 0})
+    ->Args({4 * 1024 * 1024, 256})
+    ->Args({16 * 1024 * 1024, 0})
+    ->Args({16 * 1024 * 1024, 256});
+
+} // namespace tests
+} // namespace DB
@@ -68,6 +68,21 @@ void AggregateContext::spillData(size_t task_index)
     aggregator->spill(*many_data[task_index]);
 }
 
+BlocksList AggregateContext::flushData(size_t task_index)
+{
+    assert(status.load() == AggStatus::build);
+    ManyAggregatedDataVariants data{std::move(many_data[task_index])};
+    many_data[task_index] = std::make_shared<AggregatedDataVariants>();
+
+    BlocksList blocks;
+    auto merging_buckets = aggregator->mergeAndConvertToBlocks(data, true, /*max_threads=*/1);
+    if (!merging_buckets)
+        return blocks;
+    while (Block block = merging_buckets->getData(0))
+        blocks.push_back(std::move(block));
+    return blocks;
+}
+
 LocalAggregateRestorerPtr AggregateContext::buildLocalRestorer()
 {
     assert(status.load() == AggStatus::build);
@@ -140,8 +155,63 @@ void AggregateContext::initConvergentPrefix()
     }
 }
 
+bool AggregateContext::canMergeInParallel() const
+{
+    assert(status.load() == AggStatus::build);
+    for (const auto & data : many_data)
+    {
+        if (!data->empty() && data->isTwoLevel())
+            return true;
+    }
+    return false;
+}
+
+std::vector<size_t> AggregateContext::getIndexesToConvertToTwoLevel() const
+{
+    assert(status.load() == AggStatus::build);
+    std::vector<size_t> indexes;
+    for (size_t i = 0; i < many_data.size(); ++i)
+    {
+        if (!many_data[i]->empty() && !many_data[i]->isTwoLevel())
+            indexes.push_back(i);
+    }
+    return indexes;
+}
+
+void AggregateContext::convertToTwoLevel(size_t index)
+{
+    assert(status.load() == AggStatus::build);
+    many_data[index]->convertToTwoLevel();
+}
+
+void AggregateContext::initParallelMerge()
+{
+    assert(status.load() == AggStatus::build);
+
+    initConvergentPrefix();
+
+    /// Every bucket is merged by an independent task, so use one arena and one output list per bucket.
+    merging_buckets = aggregator->mergeAndConvertToBlocks(many_data, true, MergingBuckets::NUM_BUCKETS);
+    RUNTIME_CHECK(merging_buckets && merging_buckets->isTwoLevel());
+    status = AggStatus::parallel_merge;
+}
+
+void AggregateContext::mergeBucket(size_t bucket_num)
+{
+    assert(status.load() == AggStatus::parallel_merge);
+    merging_buckets->mergeBucket(static_cast<Int32>(bucket_num));
+}
+
 void AggregateContext::initConvergent()
 {
+    if (status.load() == AggStatus::parallel_merge)
+    {
+        /// All the buckets have been merged, just read them out.
+        merging_buckets->finishParallelMerge(max_threads);
+        status = AggStatus::convergent;
+        return;
+    }
+
     assert(status.load() == AggStatus::build);
 
     initConvergentPrefix();
@@ -59,10 +59,31 @@ public:
 
     void spillData(size_t task_index);
 
+    size_t getSrcRows(size_t task_index) const { return threads_data[task_index]->src_rows; }
+
+    size_t getAggregatedRows(size_t task_index) const { return many_data[task_index]->size(); }
+
+    /// Convert the aggregated data of `task_index` to blocks and restart with an empty hash table.
+    /// Used by the partial aggregation which bypasses the hash table, see `LocalAggregateTransform`.
+    BlocksList flushData(size_t task_index);
+
     LocalAggregateRestorerPtr buildLocalRestorer();
 
     std::vector<SharedAggregateRestorerPtr> buildSharedRestorer(PipelineExecutorStatus & exec_status);
 
+    /// The parallel final merge of two-level data, see `AggregateFinalMergeEvent`.
+    /// Returns false if there is no two-level data, then the data is merged by `initConvergent` as usual.
+    bool canMergeInParallel() const;
+
+    /// The indexes of the single level data which need to be converted to two-level before the parallel merge.
+    std::vector<size_t> getIndexesToConvertToTwoLevel() const;
+
+    void convertToTwoLevel(size_t index);
+
+    void initParallelMerge();
+
+    void mergeBucket(size_t bucket_num);
+
     void initConvergent();
 
     // Called before convergent to trace aggregate statistics and handle empty table with result case.
@@ -80,8 +101,9 @@ private:
     bool empty_result_for_aggregation_by_empty_set = false;
 
     /**
-     * init────►build───┬───►convergent
-     *                  │
+     * init────►build───┬───────────────────►convergent
+     *                  │                        ▲
+     *                  ├───►parallel_merge──────┘
      *                  ▼
      *               restore
      */
@@ -89,6 +111,7 @@ private:
     {
         init,
         build,
+        parallel_merge,
         convergent,
         restore,
     };
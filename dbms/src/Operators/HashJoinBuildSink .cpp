@@ -17,16 +17,35 @@
 
 namespace DB
 {
-// TODO support spill.
 OperatorStatus HashJoinBuildSink::writeImpl(Block && block)
 {
     if unlikely (!block)
     {
+        /// `finishOneBuild` may spill data if spill is enabled, so it should be called in io thread.
+        if (join_ptr->isEnableSpill())
+        {
+            is_finish_status = true;
+            return OperatorStatus::IO;
+        }
         join_ptr->finishOneBuild();
         return OperatorStatus::FINISHED;
     }
     join_ptr->insertFromBlock(block, concurrency_build_index);
     block.clear();
+    return join_ptr->hasBuildSpillData(concurrency_build_index)
+        ? OperatorStatus::IO
+        : OperatorStatus::NEED_INPUT;
+}
+
+OperatorStatus HashJoinBuildSink::executeIOImpl()
+{
+    if (join_ptr->hasBuildSpillData(concurrency_build_index))
+        join_ptr->flushBuildSpillData(concurrency_build_index);
+    if (is_finish_status)
+    {
+        join_ptr->finishOneBuild();
+        return OperatorStatus::FINISHED;
+    }
     return OperatorStatus::NEED_INPUT;
 }
 } // namespace DB
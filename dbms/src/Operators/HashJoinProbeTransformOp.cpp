@@ -12,30 +12,43 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Flash/Executor/PipelineExecutorStatus.h>
 #include <Operators/HashJoinProbeTransformOp.h>
 
 #include <magic_enum.hpp>
 
 namespace DB
 {
-// TODO support spill.
 HashJoinProbeTransformOp::HashJoinProbeTransformOp(
     PipelineExecutorStatus & exec_status_,
     const String & req_id,
     const JoinPtr & join_,
-    size_t scan_hash_map_after_probe_stream_index_,
+    size_t op_index_,
     size_t max_block_size,
     const Block & input_header)
     : TransformOp(exec_status_, req_id)
     , join(join_)
     , probe_process_info(max_block_size)
-    , scan_hash_map_after_probe_stream_index(scan_hash_map_after_probe_stream_index_)
+    , op_index(op_index_)
 {
     RUNTIME_CHECK_MSG(join != nullptr, "join ptr should not be null.");
     RUNTIME_CHECK_MSG(join->getProbeConcurrency() > 0, "Join probe concurrency must be greater than 0");
 
-    if (needScanHashMapAfterProbe(join->getKind()))
-        scan_hash_map_after_probe_stream = join->createScanHashMapAfterProbeStream(input_header, scan_hash_map_after_probe_stream_index, join->getProbeConcurrency(), max_block_size);
+    bool need_scan_hash_map_after_probe = needScanHashMapAfterProbe(join->getKind());
+    BlockInputStreamPtr scan_hash_map_after_probe_stream;
+    if (need_scan_hash_map_after_probe)
+        scan_hash_map_after_probe_stream = join->createScanHashMapAfterProbeStream(input_header, op_index, join->getProbeConcurrency(), max_block_size);
+
+    /// The probe of the original join is driven by `transform`, so the probe stream is null here.
+    probe_exec = std::make_shared<HashJoinProbeExec>(
+        join,
+        nullptr,
+        nullptr,
+        need_scan_hash_map_after_probe,
+        op_index,
+        scan_hash_map_after_probe_stream,
+        max_block_size);
+    probe_exec->setCancellationHook([&]() { return exec_status.isCancelled(); });
 }
 
 void HashJoinProbeTransformOp::transformHeaderImpl(Block & header_)
@@ -50,57 +63,99 @@ void HashJoinProbeTransformOp::operateSuffix()
     LOG_DEBUG(log, "Finish join probe, total output rows {}, joined rows {}, scan hash map rows {}", joined_rows + scan_hash_map_rows, joined_rows, scan_hash_map_rows);
 }
 
-void HashJoinProbeTransformOp::probeOnTransform(Block & block)
+void HashJoinProbeTransformOp::switchStatus(ProbeStatus to)
+{
+    LOG_TRACE(log, fmt::format("{} -> {}", magic_enum::enum_name(status), magic_enum::enum_name(to)));
+    status = to;
+}
+
+OperatorStatus HashJoinProbeTransformOp::probeOnTransform(Block & block)
 {
     assert(status == ProbeStatus::PROBE);
     assert(probe_process_info.all_rows_joined_finish);
-    if likely (block)
+    if unlikely (!block)
+        return onProbeFinish(block);
+
+    /// Even if spill is enabled, if spill is not triggered during build,
+    /// there is no need to dispatch probe block.
+    if (join->isSpilled())
     {
-        join->checkTypes(block);
-        probe_process_info.resetBlock(std::move(block), 0);
-        block = join->joinBlock(probe_process_info);
+        join->dispatchProbeBlock(block, probe_partition_blocks, op_index);
+        block.clear();
+        /// The probe data of the spilled partitions should be spilled in io thread.
+        if (join->hasProbeSpillData(op_index))
+            return OperatorStatus::IO;
+        return probePartitionBlocks(block);
     }
+
+    join->checkTypes(block);
+    probe_process_info.resetBlock(std::move(block), 0);
+    block = join->joinBlock(probe_process_info);
+    return handleProbedBlock(block);
+}
+
+OperatorStatus HashJoinProbeTransformOp::probePartitionBlocks(Block & block)
+{
+    assert(status == ProbeStatus::PROBE);
+    assert(probe_process_info.all_rows_joined_finish);
+    if (probe_partition_blocks.empty())
+        return OperatorStatus::NEED_INPUT;
+
+    auto partition_block = std::move(probe_partition_blocks.front());
+    probe_partition_blocks.pop_front();
+    join->checkTypes(partition_block.block);
+    probe_process_info.resetBlock(std::move(partition_block.block), partition_block.partition_index);
+    block = join->joinBlock(probe_process_info);
+    return handleProbedBlock(block);
 }
 
 OperatorStatus HashJoinProbeTransformOp::onProbeFinish(Block & block)
 {
     assert(status == ProbeStatus::PROBE);
-    join->finishOneProbe();
-    if (scan_hash_map_after_probe_stream)
+    /// If spill is enabled, `finishOneProbe` may spill the probe data, so it should be executed in io thread.
+    if (join->isEnableSpill())
     {
-        if (!join->isAllProbeFinished())
-        {
-            status = ProbeStatus::WAIT_PROBE_FINISH;
-            return OperatorStatus::WAITING;
-        }
-        else
-        {
-            status = ProbeStatus::READ_SCAN_HASH_MAP_DATA;
-            scan_hash_map_after_probe_stream->readPrefix();
-            return scanHashMapData(block);
-        }
+        switchStatus(ProbeStatus::PROBE_FINAL_SPILL);
+        return OperatorStatus::IO;
     }
-    else
+
+    if (probe_exec->onProbeFinish())
     {
-        status = ProbeStatus::FINISHED;
+        switchStatus(ProbeStatus::FINISHED);
         return OperatorStatus::HAS_OUTPUT;
     }
+    switchStatus(ProbeStatus::WAIT_PROBE_FINISH);
+    return tryOutputImpl(block);
+}
+
+OperatorStatus HashJoinProbeTransformOp::onAllProbeFinish(Block & block)
+{
+    assert(status == ProbeStatus::WAIT_PROBE_FINISH);
+    if (probe_exec->needScanHashMap())
+    {
+        probe_exec->onScanHashMapAfterProbeStart();
+        switchStatus(ProbeStatus::READ_SCAN_HASH_MAP_DATA);
+        return scanHashMapData(block);
+    }
+    switchStatus(ProbeStatus::GET_RESTORE_JOIN);
+    return OperatorStatus::IO;
 }
 
 OperatorStatus HashJoinProbeTransformOp::scanHashMapData(Block & block)
 {
     assert(status == ProbeStatus::READ_SCAN_HASH_MAP_DATA);
-    assert(scan_hash_map_after_probe_stream);
-    block = scan_hash_map_after_probe_stream->read();
+    block = probe_exec->fetchScanHashMapData();
     if (!block)
     {
-        scan_hash_map_after_probe_stream->readSuffix();
-        status = ProbeStatus::FINISHED;
-    }
-    else
-    {
-        scan_hash_map_rows += block.rows();
+        if (probe_exec->onScanHashMapAfterProbeFinish())
+        {
+            switchStatus(ProbeStatus::FINISHED);
+            return OperatorStatus::HAS_OUTPUT;
+        }
+        switchStatus(ProbeStatus::GET_RESTORE_JOIN);
+        return OperatorStatus::IO;
     }
+    scan_hash_map_rows += block.rows();
     return OperatorStatus::HAS_OUTPUT;
 }
 
@@ -114,11 +169,22 @@ OperatorStatus HashJoinProbeTransformOp::handleProbedBlock(Block & block)
     return OperatorStatus::HAS_OUTPUT;
 }
 
+OperatorStatus HashJoinProbeTransformOp::restoreProbe(Block & block)
+{
+    assert(status == ProbeStatus::RESTORE_PROBE);
+    /// The probe data of restore join is read from disk in io thread.
+    if (probe_exec->needPrepareProbeBlock())
+        return OperatorStatus::IO;
+
+    block = probe_exec->joinProbeBlock();
+    joined_rows += block.rows();
+    return OperatorStatus::HAS_OUTPUT;
+}
+
 OperatorStatus HashJoinProbeTransformOp::transformImpl(Block & block)
 {
     assert(status == ProbeStatus::PROBE);
-    probeOnTransform(block);
-    return handleProbedBlock(block);
+    return probeOnTransform(block);
 }
 
 OperatorStatus HashJoinProbeTransformOp::tryOutputImpl(Block & block)
@@ -127,12 +193,25 @@ OperatorStatus HashJoinProbeTransformOp::tryOutputImpl(Block & block)
     {
     case ProbeStatus::PROBE:
         if (probe_process_info.all_rows_joined_finish)
-            return OperatorStatus::NEED_INPUT;
+            return probePartitionBlocks(block);
 
         block = join->joinBlock(probe_process_info);
         return handleProbedBlock(block);
+    case ProbeStatus::WAIT_PROBE_FINISH:
+        if (!probe_exec->isAllProbeFinished())
+            return OperatorStatus::WAITING;
+        return onAllProbeFinish(block);
     case ProbeStatus::READ_SCAN_HASH_MAP_DATA:
         return scanHashMapData(block);
+    case ProbeStatus::WAIT_BUILD_FINISH:
+        if (!probe_exec->isAllBuildFinished())
+            return OperatorStatus::WAITING;
+        /// after restore build finish, always go to restore probe stage.
+        probe_exec->onProbeStart();
+        switchStatus(ProbeStatus::RESTORE_PROBE);
+        return restoreProbe(block);
+    case ProbeStatus::RESTORE_PROBE:
+        return restoreProbe(block);
     case ProbeStatus::FINISHED:
         return OperatorStatus::HAS_OUTPUT;
     default:
@@ -140,20 +219,51 @@ OperatorStatus HashJoinProbeTransformOp::tryOutputImpl(Block & block)
     }
 }
 
-OperatorStatus HashJoinProbeTransformOp::awaitImpl()
+OperatorStatus HashJoinProbeTransformOp::executeIOImpl()
 {
-    if likely (status == ProbeStatus::WAIT_PROBE_FINISH)
+    switch (status)
     {
-        if (join->isAllProbeFinished())
-        {
-            status = ProbeStatus::READ_SCAN_HASH_MAP_DATA;
-            return OperatorStatus::HAS_OUTPUT;
-        }
-        else
+    case ProbeStatus::PROBE:
+        join->flushProbeSpillData(op_index);
+        return OperatorStatus::HAS_OUTPUT;
+    case ProbeStatus::PROBE_FINAL_SPILL:
+        /// The spilled data must be flushed before `finishOneProbe`.
+        if (join->hasProbeSpillData(op_index))
+            join->flushProbeSpillData(op_index);
+        switchStatus(probe_exec->onProbeFinish() ? ProbeStatus::FINISHED : ProbeStatus::WAIT_PROBE_FINISH);
+        return OperatorStatus::HAS_OUTPUT;
+    case ProbeStatus::GET_RESTORE_JOIN:
+        if (auto restore_probe_exec = probe_exec->tryGetRestoreExec(); restore_probe_exec && likely(!exec_status.isCancelled()))
         {
-            return OperatorStatus::WAITING;
+            probe_exec = std::move(restore_probe_exec);
+            switchStatus(ProbeStatus::RESTORE_BUILD);
+            return OperatorStatus::IO;
         }
+        switchStatus(ProbeStatus::FINISHED);
+        return OperatorStatus::HAS_OUTPUT;
+    case ProbeStatus::RESTORE_BUILD:
+        probe_exec->restoreBuild();
+        switchStatus(ProbeStatus::WAIT_BUILD_FINISH);
+        return OperatorStatus::HAS_OUTPUT;
+    case ProbeStatus::RESTORE_PROBE:
+        if (!probe_exec->prepareProbeBlock())
+            switchStatus(probe_exec->onProbeFinish() ? ProbeStatus::FINISHED : ProbeStatus::WAIT_PROBE_FINISH);
+        return OperatorStatus::HAS_OUTPUT;
+    default:
+        throw Exception(fmt::format("Unexpected status: {}.", magic_enum::enum_name(status)));
+    }
+}
+
+OperatorStatus HashJoinProbeTransformOp::awaitImpl()
+{
+    switch (status)
+    {
+    case ProbeStatus::WAIT_PROBE_FINISH:
+        return probe_exec->isAllProbeFinished() ? OperatorStatus::HAS_OUTPUT : OperatorStatus::WAITING;
+    case ProbeStatus::WAIT_BUILD_FINISH:
+        return probe_exec->isAllBuildFinished() ? OperatorStatus::HAS_OUTPUT : OperatorStatus::WAITING;
+    default:
+        return OperatorStatus::NEED_INPUT;
     }
-    return OperatorStatus::NEED_INPUT;
 }
 } // namespace DB
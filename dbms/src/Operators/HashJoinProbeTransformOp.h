@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <DataStreams/HashJoinProbeExec.h>
 #include <Interpreters/Join.h>
 #include <Operators/Operator.h>
 
@@ -26,7 +27,7 @@ public:
         PipelineExecutorStatus & exec_status_,
         const String & req_id,
         const JoinPtr & join_,
-        size_t scan_hash_map_after_probe_stream_index_,
+        size_t op_index_,
         size_t max_block_size,
         const Block & input_header);
 
@@ -44,37 +45,68 @@ protected:
 
     bool isAwaitable() const override { return true; }
 
+    OperatorStatus executeIOImpl() override;
+
     void transformHeaderImpl(Block & header_) override;
 
     void operateSuffix() override;
 
 private:
-    void probeOnTransform(Block & block);
+    /**
+     * PROBE──►[PROBE_FINAL_SPILL]──►WAIT_PROBE_FINISH──►[READ_SCAN_HASH_MAP_DATA]──►GET_RESTORE_JOIN──►FINISHED
+     *                                       ▲                                              │
+     *                                       │                                              ▼
+     *                                 RESTORE_PROBE◄─────────WAIT_BUILD_FINISH◄───────RESTORE_BUILD
+     *
+     * PROBE_FINAL_SPILL, GET_RESTORE_JOIN, RESTORE_BUILD and the read of RESTORE_PROBE are executed in io thread.
+     * If spill is not enabled, FINISHED is reached after PROBE or READ_SCAN_HASH_MAP_DATA directly.
+     */
+    enum class ProbeStatus
+    {
+        PROBE, /// probe data
+        PROBE_FINAL_SPILL, /// flush the spilled probe data and finish probe
+        WAIT_PROBE_FINISH, /// wait probe finish
+        READ_SCAN_HASH_MAP_DATA, /// output scan hash map after probe data
+        GET_RESTORE_JOIN, /// try to get restore join
+        RESTORE_BUILD, /// build for restore join
+        WAIT_BUILD_FINISH, /// wait restore build finish
+        RESTORE_PROBE, /// probe for restore join
+        FINISHED, /// the final state
+    };
+
+private:
+    OperatorStatus probeOnTransform(Block & block);
+
+    OperatorStatus probePartitionBlocks(Block & block);
 
     OperatorStatus scanHashMapData(Block & block);
 
     OperatorStatus onProbeFinish(Block & block);
 
+    OperatorStatus onAllProbeFinish(Block & block);
+
     OperatorStatus handleProbedBlock(Block & block);
 
+    OperatorStatus restoreProbe(Block & block);
+
+    void switchStatus(ProbeStatus to);
+
 private:
     JoinPtr join;
 
     ProbeProcessInfo probe_process_info;
+    /// Only used when the original join is spilled.
+    PartitionBlocks probe_partition_blocks;
 
-    size_t scan_hash_map_after_probe_stream_index;
-    BlockInputStreamPtr scan_hash_map_after_probe_stream;
+    size_t op_index;
+
+    /// The probe exec of the join currently being probed, it is used for the scan hash map after probe
+    /// and the restore of the spilled partitions.
+    HashJoinProbeExecPtr probe_exec;
 
     size_t joined_rows = 0;
     size_t scan_hash_map_rows = 0;
 
-    enum class ProbeStatus
-    {
-        PROBE, /// probe data
-        WAIT_PROBE_FINISH, /// wait probe finish
-        READ_SCAN_HASH_MAP_DATA, /// output scan hash map after probe data
-        FINISHED, /// the final state
-    };
     ProbeStatus status{ProbeStatus::PROBE};
 };
 } // namespace DB
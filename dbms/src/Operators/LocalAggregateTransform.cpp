@@ -31,10 +31,14 @@ constexpr size_t task_index = 0;
 LocalAggregateTransform::LocalAggregateTransform(
     PipelineExecutorStatus & exec_status_,
     const String & req_id,
-    const Aggregator::Params & params_)
+    const Aggregator::Params & params_,
+    size_t bypass_sample_rows_,
+    double bypass_ratio_)
     : TransformOp(exec_status_, req_id)
     , params(params_)
     , agg_context(req_id)
+    , bypass_sample_rows(params.keys_size > 0 ? bypass_sample_rows_ : 0)
+    , bypass_ratio(bypass_ratio_)
 {
     agg_context.initBuild(params, local_concurrency, /*hook=*/[&]() { return exec_status.isCancelled(); });
 }
@@ -52,7 +56,15 @@ OperatorStatus LocalAggregateTransform::transformImpl(Block & block)
         }
         agg_context.buildOnBlock(task_index, block);
         block.clear();
+        if (tryFromBuildToBypass())
+            return outputBypassBlock(block);
         return tryFromBuildToSpill();
+    case LocalAggStatus::bypass:
+        if unlikely (!block)
+            return fromBuildToConvergent(block);
+        agg_context.buildOnBlock(task_index, block);
+        block.clear();
+        return outputBypassBlock(block);
     default:
         throw Exception(fmt::format("Unexpected status: {}", magic_enum::enum_name(status)));
     }
@@ -60,8 +72,9 @@ OperatorStatus LocalAggregateTransform::transformImpl(Block & block)
 
 OperatorStatus LocalAggregateTransform::fromBuildToConvergent(Block & block)
 {
-    // status from build to convergent.
-    assert(status == LocalAggStatus::build);
+    // status from build or bypass to convergent.
+    assert(status == LocalAggStatus::build || status == LocalAggStatus::bypass);
+    assert(bypass_blocks.empty());
     status = LocalAggStatus::convergent;
     agg_context.initConvergent();
     RUNTIME_CHECK(agg_context.getConvergentConcurrency() == local_concurrency);
@@ -95,12 +108,51 @@ OperatorStatus LocalAggregateTransform::tryFromBuildToSpill()
     return OperatorStatus::NEED_INPUT;
 }
 
+bool LocalAggregateTransform::tryFromBuildToBypass()
+{
+    assert(status == LocalAggStatus::build);
+    if (bypass_sample_rows == 0 || bypass_sampled)
+        return false;
+    size_t src_rows = agg_context.getSrcRows(task_index);
+    if (src_rows < bypass_sample_rows)
+        return false;
+
+    // Only sample once, keep building the hash table if the aggregated rows are reduced enough.
+    bypass_sampled = true;
+    size_t aggregated_rows = agg_context.getAggregatedRows(task_index);
+    if (agg_context.hasSpilledData() || aggregated_rows < static_cast<double>(src_rows) * bypass_ratio)
+        return false;
+
+    LOG_INFO(
+        log,
+        "Aggregated {} rows to {} rows, which is not reduced enough, begin to bypass the hash table for partial aggregation",
+        src_rows,
+        aggregated_rows);
+    status = LocalAggStatus::bypass;
+    return true;
+}
+
+OperatorStatus LocalAggregateTransform::outputBypassBlock(Block & block)
+{
+    assert(status == LocalAggStatus::bypass);
+    // The hash table is small since it only contains one block or the sampled rows,
+    // so it is flushed directly rather than spilled even if `need_spill` is marked.
+    bypass_blocks.splice(bypass_blocks.end(), agg_context.flushData(task_index));
+    return tryOutputImpl(block);
+}
+
 OperatorStatus LocalAggregateTransform::tryOutputImpl(Block & block)
 {
     switch (status)
     {
     case LocalAggStatus::build:
         return OperatorStatus::NEED_INPUT;
+    case LocalAggStatus::bypass:
+        if (bypass_blocks.empty())
+            return OperatorStatus::NEED_INPUT;
+        block = std::move(bypass_blocks.front());
+        bypass_blocks.pop_front();
+        return OperatorStatus::HAS_OUTPUT;
     case LocalAggStatus::convergent:
         block = agg_context.readForConvergent(task_index);
         return OperatorStatus::HAS_OUTPUT;
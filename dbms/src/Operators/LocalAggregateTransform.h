@@ -26,7 +26,9 @@ public:
     LocalAggregateTransform(
         PipelineExecutorStatus & exec_status_,
         const String & req_id,
-        const Aggregator::Params & params_);
+        const Aggregator::Params & params_,
+        size_t bypass_sample_rows_ = 0,
+        double bypass_ratio_ = 1.0);
 
     String getName() const override
     {
@@ -45,6 +47,10 @@ protected:
 private:
     OperatorStatus tryFromBuildToSpill();
 
+    bool tryFromBuildToBypass();
+
+    OperatorStatus outputBypassBlock(Block & block);
+
     OperatorStatus fromBuildToConvergent(Block & block);
 
     OperatorStatus fromBuildToFinalSpillOrRestore();
@@ -53,11 +59,21 @@ private:
     Aggregator::Params params;
     AggregateContext agg_context;
 
+    /// For the partial aggregation, bypass the hash table if the aggregated rows are not reduced
+    /// enough after sampling `bypass_sample_rows` input rows. 0 means never bypass.
+    const size_t bypass_sample_rows;
+    const double bypass_ratio;
+    bool bypass_sampled = false;
+    BlocksList bypass_blocks;
+
     /**
      * spill◄────►build────┬─────────────►restore
-     *              │      │                 ▲
-     *              │      └───►final_spill──┘
-     *              ▼
+     *              │  │   │                 ▲
+     *              │  │   └───►final_spill──┘
+     *              │  ▼
+     *              │ bypass
+     *              │  │
+     *              ▼  ▼
      *           convergent
      */
     enum class LocalAggStatus
@@ -66,6 +82,8 @@ private:
         build,
         // spill the aggregate data into disk.
         spill,
+        // aggregate every block with a new small hash table and output it directly.
+        bypass,
         // convert the aggregate data to block and then output it.
         convergent,
         // spill the rest remaining memory aggregate data.
@@ -67,7 +67,7 @@ OperatorStatus SourceOp::read(Block & block)
     if (block)
     {
         Block header = getHeader();
-        assertBlocksHaveEqualStructure(block, header, getName());
+        assertBlocksHaveEqualStructure(block, header, getName(), /*allow_low_cardinality=*/true);
     }
     assertOperatorStatus(op_status, {OperatorStatus::HAS_OUTPUT});
 #endif
@@ -84,7 +84,7 @@ OperatorStatus TransformOp::transform(Block & block)
     if (block)
     {
         Block header = getHeader();
-        assertBlocksHaveEqualStructure(block, header, getName());
+        assertBlocksHaveEqualStructure(block, header, getName(), /*allow_low_cardinality=*/true);
     }
     assertOperatorStatus(op_status, {OperatorStatus::NEED_INPUT, OperatorStatus::HAS_OUTPUT});
 #endif
@@ -102,7 +102,7 @@ OperatorStatus TransformOp::tryOutput(Block & block)
     if (block)
     {
         Block header = getHeader();
-        assertBlocksHaveEqualStructure(block, header, getName());
+        assertBlocksHaveEqualStructure(block, header, getName(), /*allow_low_cardinality=*/true);
     }
     assertOperatorStatus(op_status, {OperatorStatus::NEED_INPUT, OperatorStatus::HAS_OUTPUT});
 #endif
@@ -129,7 +129,7 @@ OperatorStatus SinkOp::write(Block && block)
     if (block)
     {
         Block header = getHeader();
-        assertBlocksHaveEqualStructure(block, header, getName());
+        assertBlocksHaveEqualStructure(block, header, getName(), /*allow_low_cardinality=*/true);
     }
 #endif
     // TODO collect operator profile info here.
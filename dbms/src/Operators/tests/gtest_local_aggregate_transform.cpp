@@ -0,0 +1,218 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <AggregateFunctions/AggregateFunctionFactory.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Flash/Coprocessor/AggregationInterpreterHelper.h>
+#include <Flash/Executor/PipelineExecutorStatus.h>
+#include <Interpreters/Context.h>
+#include <Operators/LocalAggregateTransform.h>
+#include <TestUtils/AggregationTestUtils.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <map>
+
+namespace DB::tests
+{
+class LocalAggregateTransformTest : public AggregationTest
+{
+public:
+    struct AggResult
+    {
+        UInt64 count = 0;
+        Int64 sum = 0;
+        Int64 max = std::numeric_limits<Int64>::min();
+    };
+    using AggResults = std::map<Int64, AggResult>;
+
+    static Block makeBlock(size_t begin, size_t end, size_t key_mod)
+    {
+        std::vector<Int64> keys;
+        std::vector<Int64> values;
+        for (size_t i = begin; i < end; ++i)
+        {
+            keys.push_back(i % key_mod);
+            values.push_back(i);
+        }
+        return Block{createColumn<Int64>(keys, "key"), createColumn<Int64>(values, "value")};
+    }
+
+    /// Run the partial aggregation `select key, count(value), sum(value), max(value) group by key`
+    /// and return the output blocks. `output_before_end` is set if any block is output before all the input is consumed.
+    static Blocks runPartialAgg(const Blocks & input, size_t bypass_sample_rows, double bypass_ratio, bool & output_before_end)
+    {
+        auto context = TiFlashTestEnv::getContext();
+        const Block header = input.front().cloneEmpty();
+        const auto value_type = std::make_shared<DataTypeInt64>();
+        AggregateDescriptions aggregate_descriptions;
+        for (const auto & name : {"count", "sum", "max"})
+        {
+            AggregateDescription description;
+            description.function = AggregateFunctionFactory::instance().get(name, {value_type}, {});
+            description.argument_names = {"value"};
+            description.column_name = name;
+            aggregate_descriptions.push_back(std::move(description));
+        }
+        AggregationInterpreterHelper::fillArgColumnNumbers(aggregate_descriptions, header);
+        SpillConfig spill_config(context->getTemporaryPath(), "local_agg_test", 0, 0, 0, context->getFileProvider());
+        auto params = AggregationInterpreterHelper::buildParams(
+            *context,
+            header,
+            1,
+            1,
+            {"key"},
+            {nullptr},
+            aggregate_descriptions,
+            /*is_final_agg=*/false,
+            spill_config);
+
+        PipelineExecutorStatus exec_status;
+        LocalAggregateTransform transform(exec_status, "local_agg_test", params, bypass_sample_rows, bypass_ratio);
+        Block transform_header = header;
+        transform.transformHeader(transform_header);
+
+        Blocks output;
+        auto pull_output = [&](OperatorStatus status, Block & block) {
+            while (status == OperatorStatus::HAS_OUTPUT && block)
+            {
+                output.push_back(std::move(block));
+                block = {};
+                status = transform.tryOutput(block);
+            }
+            return status;
+        };
+        output_before_end = false;
+        for (const auto & input_block : input)
+        {
+            Block block = input_block;
+            auto status = pull_output(transform.transform(block), block);
+            EXPECT_EQ(status, OperatorStatus::NEED_INPUT);
+            output_before_end |= !output.empty();
+        }
+        // An empty block marks the end of the input, then the remaining aggregated data is output.
+        Block block;
+        pull_output(transform.transform(block), block);
+        return output;
+    }
+
+    /// The final aggregation which merges the partial results with the same key.
+    static AggResults mergePartialResults(const Blocks & blocks)
+    {
+        AggResults results;
+        for (const auto & block : blocks)
+        {
+            const auto & key_column = block.getByName("key").column;
+            const auto & count_column = block.getByName("count").column;
+            const auto & sum_column = block.getByName("sum").column;
+            const auto & max_column = block.getByName("max").column;
+            for (size_t i = 0; i < block.rows(); ++i)
+            {
+                auto & result = results[key_column->getInt(i)];
+                result.count += count_column->getUInt(i);
+                result.sum += sum_column->getInt(i);
+                result.max = std::max(result.max, max_column->getInt(i));
+            }
+        }
+        return results;
+    }
+
+    static AggResults expectedResults(const Blocks & input)
+    {
+        AggResults results;
+        for (const auto & block : input)
+        {
+            const auto & key_column = block.getByName("key").column;
+            const auto & value_column = block.getByName("value").column;
+            for (size_t i = 0; i < block.rows(); ++i)
+            {
+                auto & result = results[key_column->getInt(i)];
+                ++result.count;
+                result.sum += value_column->getInt(i);
+                result.max = std::max(result.max, value_column->getInt(i));
+            }
+        }
+        return results;
+    }
+
+    static void assertResultsEqual(const AggResults & expected, const AggResults & actual)
+    {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (const auto & [key, result] : expected)
+        {
+            auto iter = actual.find(key);
+            ASSERT_TRUE(iter != actual.end()) << "key=" << key;
+            ASSERT_EQ(result.count, iter->second.count) << "key=" << key;
+            ASSERT_EQ(result.sum, iter->second.sum) << "key=" << key;
+            ASSERT_EQ(result.max, iter->second.max) << "key=" << key;
+        }
+    }
+
+    static constexpr size_t rows = 4096;
+    static constexpr size_t rows_per_block = 256;
+    static constexpr size_t sample_rows = 1024;
+};
+
+TEST_F(LocalAggregateTransformTest, Bypass)
+try
+{
+    // 2048 distinct keys, the sampled 1024 rows are not reduced at all, so the hash table is bypassed.
+    Blocks input;
+    for (size_t begin = 0; begin < rows; begin += rows_per_block)
+        input.push_back(makeBlock(begin, begin + rows_per_block, 2048));
+
+    bool output_before_end = false;
+    auto output = runPartialAgg(input, sample_rows, 0.9, output_before_end);
+    ASSERT_TRUE(output_before_end);
+    size_t output_rows = 0;
+    for (const auto & block : output)
+        output_rows += block.rows();
+    // Each key appears in two blocks after sampling, and they are not merged by the bypassed partial aggregation.
+    ASSERT_GT(output_rows, 2048);
+    assertResultsEqual(expectedResults(input), mergePartialResults(output));
+}
+CATCH
+
+TEST_F(LocalAggregateTransformTest, NotBypass)
+try
+{
+    // 16 distinct keys, the sampled rows are reduced enough, so the hash table is kept.
+    Blocks input;
+    for (size_t begin = 0; begin < rows; begin += rows_per_block)
+        input.push_back(makeBlock(begin, begin + rows_per_block, 16));
+
+    for (size_t bypass_sample_rows : {static_cast<size_t>(0), sample_rows})
+    {
+        bool output_before_end = true;
+        auto output = runPartialAgg(input, bypass_sample_rows, 0.9, output_before_end);
+        ASSERT_FALSE(output_before_end);
+        size_t output_rows = 0;
+        for (const auto & block : output)
+            output_rows += block.rows();
+        ASSERT_EQ(output_rows, 16);
+        assertResultsEqual(expectedResults(input), mergePartialResults(output));
+    }
+
+    // Never bypass if `bypass_sample_rows` is 0 even if the keys are not reduced.
+    input.clear();
+    for (size_t begin = 0; begin < rows; begin += rows_per_block)
+        input.push_back(makeBlock(begin, begin + rows_per_block, rows));
+    bool output_before_end = true;
+    auto output = runPartialAgg(input, 0, 0.9, output_before_end);
+    ASSERT_FALSE(output_before_end);
+    assertResultsEqual(expectedResults(input), mergePartialResults(output));
+}
+CATCH
+
+} // namespace DB::tests
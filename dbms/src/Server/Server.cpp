@@ -21,6 +21,7 @@
 #include <Common/DynamicThreadPool.h>
 #include <Common/Exception.h>
 #include <Common/FailPoint.h>
+#include <Common/IOUring.h>
 #include <Common/Macros.h>
 #include <Common/RedactHelpers.h>
 #include <Common/StringUtils/StringUtils.h>
@@ -778,6 +779,14 @@ void initThreadPool(Poco::Util::LayeredConfiguration & config)
             /*max_threads*/ default_num_threads,
             /*max_free_threads*/ default_num_threads / 2,
             /*queue_size*/ default_num_threads * 2);
+        S3ReadAheadPool::initialize(
+            /*max_threads*/ default_num_threads,
+            /*max_free_threads*/ default_num_threads / 2,
+            /*queue_size*/ default_num_threads * 2);
+        S3UploadPool::initialize(
+            /*max_threads*/ default_num_threads,
+            /*max_free_threads*/ default_num_threads / 2,
+            /*queue_size*/ default_num_threads * 2);
     }
 }
 
@@ -814,6 +823,18 @@ void adjustThreadPoolSize(const Settings & settings, size_t logical_cores)
         S3FileCachePool::instance->setMaxFreeThreads(max_io_thread_count / 2);
         S3FileCachePool::instance->setQueueSize(max_io_thread_count * 2);
     }
+    if (S3ReadAheadPool::instance)
+    {
+        S3ReadAheadPool::instance->setMaxThreads(max_io_thread_count);
+        S3ReadAheadPool::instance->setMaxFreeThreads(max_io_thread_count / 2);
+        S3ReadAheadPool::instance->setQueueSize(max_io_thread_count * 2);
+    }
+    if (S3UploadPool::instance)
+    {
+        S3UploadPool::instance->setMaxThreads(max_io_thread_count);
+        S3UploadPool::instance->setMaxFreeThreads(max_io_thread_count / 2);
+        S3UploadPool::instance->setQueueSize(max_io_thread_count * 2);
+    }
 }
 
 void syncSchemaWithTiDB(
@@ -1282,7 +1303,8 @@ int Server::main(const std::vector<std::string> & /*args*/)
         global_context->getSharedContextDisagg()->initReadNodePageCache(
             global_context->getPathPool(),
             storage_config.remote_cache_config.getPageCacheDir(),
-            storage_config.remote_cache_config.getPageCapacity());
+            storage_config.remote_cache_config.getPageCapacity(),
+            storage_config.remote_cache_config.page_cache_policy);
     }
 
     /// Initialize RateLimiter.
@@ -1361,6 +1383,27 @@ int Server::main(const std::vector<std::string> & /*args*/)
     if (minmax_index_cache_size)
         global_context->setMinMaxIndexCache(minmax_index_cache_size);
 
+    /// Size of cache for bloom filter index, used by DeltaMerge engine.
+    size_t bloom_filter_index_cache_size = config().getUInt64("bloom_filter_index_cache_size", minmax_index_cache_size);
+    if (bloom_filter_index_cache_size)
+        global_context->setBloomFilterIndexCache(bloom_filter_index_cache_size);
+
+    /// Size of cache for the MVCC bitmap filters of segments, used by DeltaMerge engine. Zero means disabled.
+    /// Only used under non-disagg mode.
+    size_t bitmap_filter_cache_size = config().getUInt64("bitmap_filter_cache_size", 0);
+    if (bitmap_filter_cache_size)
+        global_context->setBitmapFilterCache(bitmap_filter_cache_size);
+
+    /// Size of cache for the partial aggregation results of segments, used by DeltaMerge engine. Zero means disabled.
+    /// The queries use it only if `dt_enable_segment_agg_cache` is enabled.
+    size_t segment_agg_cache_size = config().getUInt64("segment_agg_cache_size", 0);
+    if (segment_agg_cache_size)
+        global_context->setSegmentAggCache(segment_agg_cache_size);
+
+    /// Read the pages of PageStorage and prefetch the packs of DTFiles in batches by io_uring.
+    /// It falls back to pread if io_uring is not supported by the kernel.
+    IOUring::setEnabled(config().getBool("enable_io_uring", false));
+
     /// Size of max memory usage of DeltaIndex, used by DeltaMerge engine.
     /// This setting is currently a bit tricky:
     /// - In non-disaggregated mode, its default value is 0, means unlimited, and it
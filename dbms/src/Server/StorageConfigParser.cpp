@@ -40,6 +40,7 @@
 #include <common/logger_useful.h>
 #include <fmt/core.h>
 
+#include <magic_enum.hpp>
 #include <set>
 #include <sstream>
 #include <tuple>
@@ -567,6 +568,15 @@ void StorageS3Config::parse(const String & content)
     RUNTIME_CHECK(request_timeout_ms > 0);
     readConfig(table, "root", root);
     root = getNormalizedS3Root(root); // ensure ends with '/'
+    readConfig(table, "read_coalesce_gap_bytes", read_coalesce_gap_bytes);
+    readConfig(table, "read_ahead_max_bytes", read_ahead_max_bytes);
+    readConfig(table, "read_ahead_concurrency", read_ahead_concurrency);
+    RUNTIME_CHECK(read_ahead_concurrency > 0);
+    readConfig(table, "upload_part_size", upload_part_size);
+    // S3 requires the parts except the last one to be at least 5MiB.
+    RUNTIME_CHECK(upload_part_size >= 5 * 1024 * 1024, upload_part_size);
+    readConfig(table, "upload_concurrency", upload_concurrency);
+    readConfig(table, "upload_max_inflight_bytes", upload_max_inflight_bytes);
     readConfig(table, "enable_http_pool", enable_http_pool);
     readConfig(table, "enable_poco_client", enable_poco_client);
 
@@ -596,7 +606,9 @@ String StorageS3Config::toString() const
         "max_connections={} max_redirections={} "
         "connection_timeout_ms={} request_timeout_ms={} "
         "access_key_id_size={} secret_access_key_size={} "
-        "enable_http_pool={} enable_poco_client={}"
+        "enable_http_pool={} enable_poco_client={} "
+        "read_coalesce_gap_bytes={} read_ahead_max_bytes={} read_ahead_concurrency={} "
+        "upload_part_size={} upload_concurrency={} upload_max_inflight_bytes={}"
         "}}",
         endpoint,
         bucket,
@@ -608,7 +620,13 @@ String StorageS3Config::toString() const
         access_key_id.size(),
         secret_access_key.size(),
         enable_http_pool,
-        enable_poco_client);
+        enable_poco_client,
+        read_coalesce_gap_bytes,
+        read_ahead_max_bytes,
+        read_ahead_concurrency,
+        upload_part_size,
+        upload_concurrency,
+        upload_max_inflight_bytes);
 }
 
 void StorageS3Config::enable(bool check_requirements, const LoggerPtr & log)
@@ -651,14 +669,31 @@ void StorageRemoteCacheConfig::parse(const String & content, const LoggerPtr & l
     readConfig(table, "reserved_rate", reserved_rate);
     RUNTIME_CHECK(std::isgreaterequal(reserved_rate, 0.0) && std::islessequal(reserved_rate, 0.5), reserved_rate);
     RUNTIME_CHECK(std::islessequal(delta_rate + reserved_rate, 1.0), delta_rate, reserved_rate);
+    readConfig(table, "dtfile_chunk_size", dtfile_chunk_size);
+
+    auto read_policy = [&](const String & name, CachePolicy & policy) {
+        String policy_name;
+        readConfig(table, name, policy_name);
+        if (policy_name.empty())
+            return;
+        auto parsed = parseCachePolicy(policy_name);
+        RUNTIME_CHECK_MSG(parsed.has_value(), "Unknown {}: {}, should be lru or tinylfu", name, policy_name);
+        policy = *parsed;
+    };
+    read_policy("dtfile_cache_policy", dtfile_cache_policy);
+    read_policy("page_cache_policy", page_cache_policy);
+
     LOG_INFO(
         log,
-        "StorageRemoteCacheConfig: dir={}, capacity={}, dtfile_level={}, delta_rate={}, reserved_rate={}",
+        "StorageRemoteCacheConfig: dir={}, capacity={}, dtfile_level={}, delta_rate={}, reserved_rate={}, dtfile_chunk_size={}, dtfile_cache_policy={}, page_cache_policy={}",
         dir,
         capacity,
         dtfile_level,
         delta_rate,
-        reserved_rate);
+        reserved_rate,
+        dtfile_chunk_size,
+        magic_enum::enum_name(dtfile_cache_policy),
+        magic_enum::enum_name(page_cache_policy));
 }
 
 bool StorageRemoteCacheConfig::isCacheEnabled() const
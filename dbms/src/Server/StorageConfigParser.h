@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <Common/CachePolicy.h>
 #include <Common/Logger.h>
 #include <Core/Types.h>
 
@@ -112,6 +113,15 @@ struct StorageS3Config
     UInt64 request_timeout_ms = 30000;
     UInt64 max_redirections = 10;
     String root;
+    // The options of reading S3 files, see `S3::S3ReadOptions`. Read-ahead is disabled if `read_ahead_max_bytes` is 0.
+    UInt64 read_coalesce_gap_bytes = 1024 * 1024;
+    UInt64 read_ahead_max_bytes = 0;
+    UInt64 read_ahead_concurrency = 4;
+    // The options of writing S3 files, see `S3::WriteSettings`. The parts of a multipart upload are uploaded
+    // one by one if `upload_concurrency` is 0.
+    UInt64 upload_part_size = 16 * 1024 * 1024;
+    UInt64 upload_concurrency = 4;
+    UInt64 upload_max_inflight_bytes = 128 * 1024 * 1024;
 
     inline static String S3_ACCESS_KEY_ID = "S3_ACCESS_KEY_ID";
     inline static String S3_SECRET_ACCESS_KEY = "S3_SECRET_ACCESS_KEY";
@@ -130,6 +140,10 @@ struct StorageRemoteCacheConfig
     UInt64 dtfile_level = 100;
     double delta_rate = 0.1;
     double reserved_rate = 0.1;
+    // If it is not 0, the DTFiles are cached by the aligned chunks of this size instead of the whole files.
+    UInt64 dtfile_chunk_size = 0;
+    CachePolicy dtfile_cache_policy = CachePolicy::LRU;
+    CachePolicy page_cache_policy = CachePolicy::LRU;
 
     bool isCacheEnabled() const;
     void initCacheDir() const;
@@ -753,6 +753,8 @@ bucket = "s3_bucket"
 access_key_id = "33333333"
 secret_access_key = "44444444"
 root = "root123"
+upload_part_size = 8388608
+upload_concurrency = 8
         )",
     };
 
@@ -813,6 +815,8 @@ root = "root123"
             ASSERT_FALSE(s3_config.isS3Enabled());
             ASSERT_EQ(s3_config.access_key_id, "11111111");
             ASSERT_EQ(s3_config.secret_access_key, "22222222");
+            ASSERT_EQ(s3_config.upload_part_size, 16 * 1024 * 1024);
+            ASSERT_EQ(s3_config.upload_concurrency, 4);
         }
         else if (i == 1)
         {
@@ -823,6 +827,9 @@ root = "root123"
             ASSERT_TRUE(s3_config.isS3Enabled());
             ASSERT_EQ(s3_config.access_key_id, "33333333");
             ASSERT_EQ(s3_config.secret_access_key, "44444444");
+            ASSERT_EQ(s3_config.upload_part_size, 8 * 1024 * 1024);
+            ASSERT_EQ(s3_config.upload_concurrency, 8);
+            ASSERT_EQ(s3_config.upload_max_inflight_bytes, 128 * 1024 * 1024);
         }
         else
         {
@@ -855,6 +862,8 @@ dir = "/tmp/StorageConfigTest/RemoteCacheConfig/0/"
 capacity = 10000000
 dtfile_level = 11
 delta_rate = 0.33
+dtfile_cache_policy = "TinyLFU"
+page_cache_policy = "tinylfu"
         )",
         R"(
 [storage]
@@ -910,6 +919,9 @@ delta_rate = 1.1
             ASSERT_EQ(cache_config.getDTFileCapacity() + cache_config.getPageCapacity() + cache_config.getReservedCapacity(), cache_config.capacity);
             ASSERT_DOUBLE_EQ(cache_config.getDTFileCapacity() * 1.0 / cache_config.capacity, 1.0 - cache_config.delta_rate - cache_config.reserved_rate);
             ASSERT_TRUE(cache_config.isCacheEnabled());
+            auto expected_policy = i == 0 ? CachePolicy::LRU : CachePolicy::TinyLFU;
+            ASSERT_EQ(cache_config.dtfile_cache_policy, expected_policy);
+            ASSERT_EQ(cache_config.page_cache_policy, expected_policy);
         }
         else
         {
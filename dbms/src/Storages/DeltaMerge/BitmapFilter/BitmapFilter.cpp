@@ -16,12 +16,18 @@
 #include <Storages/DeltaMerge/DeltaMergeHelpers.h>
 #include <Storages/DeltaMerge/Segment.h>
 
+#include <bit>
+
 namespace DB::DM
 {
 BitmapFilter::BitmapFilter(UInt32 size_, bool default_value)
-    : filter(size_, default_value)
+    : rows(size_)
+    , words((size_ + WORD_BITS - 1) / WORD_BITS, default_value ? ~0ULL : 0ULL)
     , all_match(default_value)
-{}
+{
+    if (default_value && rows % WORD_BITS != 0)
+        words.back() = (1ULL << (rows % WORD_BITS)) - 1;
+}
 
 void BitmapFilter::set(BlockInputStreamPtr & stream)
 {
@@ -58,8 +64,7 @@ void BitmapFilter::set(const UInt32 * data, UInt32 size, const FilterPtr & f)
     {
         for (UInt32 i = 0; i < size; i++)
         {
-            UInt32 row_id = *(data + i);
-            filter[row_id] = true;
+            setBit(data[i]);
         }
     }
     else
@@ -67,55 +72,96 @@ void BitmapFilter::set(const UInt32 * data, UInt32 size, const FilterPtr & f)
         RUNTIME_CHECK(size == f->size(), size, f->size());
         for (UInt32 i = 0; i < size; i++)
         {
-            UInt32 row_id = *(data + i);
-            filter[row_id] = (*f)[i];
+            if ((*f)[i])
+                setBit(data[i]);
+            else
+                clearBit(data[i]);
         }
     }
 }
 
 void BitmapFilter::set(UInt32 start, UInt32 limit)
 {
-    RUNTIME_CHECK(start + limit <= filter.size(), start, limit, filter.size());
-    std::fill(filter.begin() + start, filter.begin() + start + limit, true);
+    RUNTIME_CHECK(start + limit <= rows, start, limit, rows);
+    const UInt32 end = start + limit;
+    for (; start < end && start % WORD_BITS != 0; ++start)
+        setBit(start);
+    for (; start + WORD_BITS <= end; start += WORD_BITS)
+        words[start / WORD_BITS] = ~0ULL;
+    for (; start < end; ++start)
+        setBit(start);
+}
+
+UInt64 BitmapFilter::getWord(UInt32 pos) const
+{
+    const UInt32 index = pos / WORD_BITS;
+    const UInt32 offset = pos % WORD_BITS;
+    UInt64 word = words[index] >> offset;
+    if (offset != 0 && index + 1 < words.size())
+        word |= words[index + 1] << (WORD_BITS - offset);
+    return word;
+}
+
+bool BitmapFilter::isAllSet(UInt32 start, UInt32 limit) const
+{
+    for (UInt32 i = 0; i < limit; i += WORD_BITS)
+    {
+        const UInt32 n = std::min(WORD_BITS, limit - i);
+        const UInt64 mask = n == WORD_BITS ? ~0ULL : (1ULL << n) - 1;
+        if ((getWord(start + i) & mask) != mask)
+            return false;
+    }
+    return true;
 }
 
 bool BitmapFilter::get(IColumn::Filter & f, UInt32 start, UInt32 limit) const
 {
-    RUNTIME_CHECK(start + limit <= filter.size(), start, limit, filter.size());
-    auto begin = filter.cbegin() + start;
-    auto end = filter.cbegin() + start + limit;
-    if (all_match || std::find(begin, end, false) == end)
+    RUNTIME_CHECK(start + limit <= rows, start, limit, rows);
+    if (all_match || isAllSet(start, limit))
     {
         return true;
     }
-    else
+
+    UInt8 * res = f.data();
+    for (UInt32 i = 0; i < limit; i += WORD_BITS)
     {
-        std::copy(begin, end, f.begin());
-        return false;
+        const UInt64 word = getWord(start + i);
+        const UInt32 n = std::min(WORD_BITS, limit - i);
+        for (UInt32 j = 0; j < n; ++j)
+            res[i + j] = static_cast<UInt8>((word >> j) & 1);
     }
+    return false;
 }
 
 void BitmapFilter::rangeAnd(IColumn::Filter & f, UInt32 start, UInt32 limit) const
 {
-    RUNTIME_CHECK(start + limit <= filter.size() && f.size() == limit);
-    auto begin = filter.cbegin() + start;
-    if (!all_match)
+    RUNTIME_CHECK(start + limit <= rows && f.size() == limit);
+    if (all_match)
+    {
+        return;
+    }
+
+    UInt8 * res = f.data();
+    for (UInt32 i = 0; i < limit; i += WORD_BITS)
     {
-        std::transform(f.begin(), f.end(), begin, f.begin(), [](const UInt8 a, const bool b) { return a != 0 && b; });
+        const UInt64 word = getWord(start + i);
+        const UInt32 n = std::min(WORD_BITS, limit - i);
+        for (UInt32 j = 0; j < n; ++j)
+            res[i + j] = static_cast<UInt8>(res[i + j] != 0) & static_cast<UInt8>((word >> j) & 1);
     }
 }
 
 void BitmapFilter::runOptimize()
 {
-    all_match = std::find(filter.begin(), filter.end(), false) == filter.end();
+    all_match = count() == rows;
 }
 
 String BitmapFilter::toDebugString() const
 {
-    String s(filter.size(), '1');
-    for (UInt32 i = 0; i < filter.size(); i++)
+    String s(rows, '1');
+    for (UInt32 i = 0; i < rows; i++)
     {
-        if (!filter[i])
+        if (!getBit(i))
         {
             s[i] = '0';
         }
@@ -125,6 +171,9 @@ String BitmapFilter::toDebugString() const
 
 size_t BitmapFilter::count() const
 {
-    return std::count(filter.cbegin(), filter.cend(), true);
+    size_t n = 0;
+    for (auto word : words)
+        n += std::popcount(word);
+    return n;
 }
-} // namespace DB::DM
\ No newline at end of file
+} // namespace DB::DM
@@ -15,11 +15,15 @@
 #pragma once
 
 #include <Columns/IColumn.h>
+#include <Common/LRUCache.h>
 #include <DataStreams/IBlockInputStream.h>
 
 namespace DB::DM
 {
 
+/// The visibility of every row in a segment snapshot, after the MVCC and row key filtering.
+/// The bits are packed into 64-bit words, so that checking or applying a range of rows
+/// handles 64 rows at a time and the loops can be vectorized by the compiler.
 class BitmapFilter
 {
 public:
@@ -39,10 +43,54 @@ public:
     String toDebugString() const;
     size_t count() const;
 
+    size_t byteSize() const { return words.size() * sizeof(UInt64); }
+
 private:
-    std::vector<bool> filter;
+    static constexpr UInt32 WORD_BITS = 64;
+
+    void setBit(UInt32 pos) { words[pos / WORD_BITS] |= (1ULL << (pos % WORD_BITS)); }
+    void clearBit(UInt32 pos) { words[pos / WORD_BITS] &= ~(1ULL << (pos % WORD_BITS)); }
+    bool getBit(UInt32 pos) const { return (words[pos / WORD_BITS] >> (pos % WORD_BITS)) & 1; }
+    // Returns the 64 bits start from `pos`, the bits beyond `rows` are 0.
+    UInt64 getWord(UInt32 pos) const;
+    bool isAllSet(UInt32 start, UInt32 limit) const;
+
+    UInt32 rows;
+    // The bits beyond `rows` in the last word are always 0.
+    PaddedPODArray<UInt64> words;
     bool all_match;
 };
 
 using BitmapFilterPtr = std::shared_ptr<BitmapFilter>;
-} // namespace DB::DM
\ No newline at end of file
+
+/// The bitmap filter of a whole segment snapshot.
+struct BitmapFilterCacheEntry
+{
+    BitmapFilterPtr bitmap_filter;
+    /// The max version of the rows in the segment snapshot. The bitmap filter is the same for all
+    /// the reads whose read TSO is not less than it, because all the rows are visible to them.
+    UInt64 max_data_version = 0;
+};
+
+struct BitmapFilterCacheEntryWeightFunction
+{
+    size_t operator()(const BitmapFilterCacheEntry & entry) const { return entry.bitmap_filter->byteSize(); }
+};
+
+/// Cache of the built bitmap filters. The MVCC merge of a segment snapshot is skipped if the same
+/// snapshot is read again with a read TSO not less than the max version of its rows, for example the
+/// repeated queries on the data that is not changing, or the table scans on the same table in one query.
+/// The key is built by `Segment::buildBitmapFilter`.
+class BitmapFilterCache : public LRUCache<String, BitmapFilterCacheEntry, std::hash<String>, BitmapFilterCacheEntryWeightFunction>
+{
+private:
+    using Base = LRUCache<String, BitmapFilterCacheEntry, std::hash<String>, BitmapFilterCacheEntryWeightFunction>;
+
+public:
+    explicit BitmapFilterCache(size_t max_size_in_bytes)
+        : Base(max_size_in_bytes)
+    {}
+};
+
+using BitmapFilterCachePtr = std::shared_ptr<BitmapFilterCache>;
+} // namespace DB::DM
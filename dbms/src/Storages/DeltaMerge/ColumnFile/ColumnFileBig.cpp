@@ -43,6 +43,7 @@ void ColumnFileBig::calculateStat(const DMContext & context)
     auto pack_filter = DMFilePackFilter::loadFrom(
         file,
         index_cache,
+        context.db_context.getGlobalContext().getBloomFilterIndexCache(),
         /*set_cache_if_miss*/ false,
         {segment_range},
         EMPTY_RS_OPERATOR,
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <IO/CompressedStream.h>
 #include <IO/ReadHelpers.h>
 #include <IO/WriteHelpers.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
@@ -37,6 +38,14 @@ struct ColumnStat
     size_t nullmap_data_bytes = 0;
     size_t nullmap_mark_bytes = 0;
     size_t index_bytes = 0;
+    // Serialized in a standalone meta block, so that DMFiles without bloom filter
+    // keep the same meta format.
+    size_t bloom_filter_bytes = 0;
+    // The codec configured for the column data. Only serialized in a standalone meta block when some
+    // columns use lightweight compression. Reading does not depend on it, the codec of each block
+    // is decided by the header of the block.
+    CompressionMethod compression_method = CompressionMethod::LZ4;
+    CompressionDataType compression_data_type = CompressionDataType::Unknown;
     void serializeToBuffer(WriteBuffer & buf) const
     {
         writeIntBinary(col_id, buf);
@@ -87,6 +87,18 @@ struct DMContext : private boost::noncopyable
     const bool read_stable_only;
     const bool enable_relevant_place;
     const bool enable_skippable_place;
+    // Persist the delta index after placing this number of new rows, 0 means never persist.
+    const size_t persist_delta_index_min_rows;
+    // Warm up the replaced segments which are read at least this number of times recently, 0 means never warm up.
+    const size_t warm_up_read_threshold;
+    const size_t warm_up_max_concurrency;
+    const double warm_up_cache_usage_ratio;
+    // Stop using late materialization if more than this ratio of rows pass the pushed down filter.
+    const double late_materialization_max_passed_ratio;
+
+    // Whether the stable layer can return string columns as ColumnLowCardinality to the upper
+    // operators. Set by the read request when the columns are only filtered and aggregated.
+    bool enable_low_cardinality_string = false;
 
     String tracing_id;
 
@@ -127,6 +139,11 @@ public:
         , read_stable_only(settings.dt_read_stable_only)
         , enable_relevant_place(settings.dt_enable_relevant_place)
         , enable_skippable_place(settings.dt_enable_skippable_place)
+        , persist_delta_index_min_rows(settings.dt_persist_delta_index_min_rows)
+        , warm_up_read_threshold(settings.dt_segment_warm_up_read_threshold)
+        , warm_up_max_concurrency(settings.dt_segment_warm_up_max_concurrency)
+        , warm_up_cache_usage_ratio(settings.dt_segment_warm_up_cache_usage_ratio)
+        , late_materialization_max_passed_ratio(settings.dt_late_materialization_max_passed_ratio)
         , tracing_id(tracing_id_)
         , scan_context(scan_context_ ? scan_context_ : std::make_shared<ScanContext>())
     {
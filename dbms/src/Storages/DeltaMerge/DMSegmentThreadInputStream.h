@@ -19,6 +19,7 @@
 #include <Interpreters/Context_fwd.h>
 #include <Storages/DeltaMerge/DMContext.h>
 #include <Storages/DeltaMerge/Segment.h>
+#include <Storages/DeltaMerge/SegmentAggCache.h>
 #include <Storages/DeltaMerge/SegmentReadTaskPool.h>
 
 namespace DB
@@ -39,6 +40,7 @@ class DMSegmentThreadInputStream : public IProfilingBlockInputStream
 
 public:
     /// If handle_real_type_ is empty, means do not convert handle column back to real type.
+    /// If segment_aggregation_ is initialized before reading, return the partial aggregation results of segments instead of the rows.
     DMSegmentThreadInputStream(
         const DMContextPtr & dm_context_,
         const SegmentReadTaskPoolPtr & task_pool_,
@@ -48,7 +50,8 @@ public:
         UInt64 max_version_,
         size_t expected_block_size_,
         ReadMode read_mode_,
-        const String & req_id)
+        const String & req_id,
+        const SegmentAggregationPtr & segment_aggregation_ = nullptr)
         : dm_context(dm_context_)
         , task_pool(task_pool_)
         , after_segment_read(after_segment_read_)
@@ -58,13 +61,19 @@ public:
         , max_version(max_version_)
         , expected_block_size(expected_block_size_)
         , read_mode(read_mode_)
+        , segment_aggregation(segment_aggregation_)
         , log(Logger::get(req_id))
     {
     }
 
     String getName() const override { return NAME; }
 
-    Block getHeader() const override { return header; }
+    Block getHeader() const override
+    {
+        if (segment_aggregation && segment_aggregation->isInitialized())
+            return segment_aggregation->getHeader();
+        return header;
+    }
 
 protected:
     Block readImpl() override
@@ -91,7 +100,13 @@ protected:
                 cur_segment = task->segment;
 
                 auto block_size = std::max(expected_block_size, static_cast<size_t>(dm_context->db_context.getSettingsRef().dt_segment_stable_pack_rows));
-                cur_stream = task->segment->getInputStream(read_mode, *dm_context, columns_to_read, task->read_snapshot, task->ranges, filter, max_version, block_size);
+                auto build_segment_stream = [&]() {
+                    return task->segment->getInputStream(read_mode, *dm_context, columns_to_read, task->read_snapshot, task->ranges, filter, max_version, block_size);
+                };
+                if (segment_aggregation && segment_aggregation->isInitialized())
+                    cur_stream = segment_aggregation->getInputStream(dm_context, task, max_version, build_segment_stream);
+                else
+                    cur_stream = build_segment_stream();
                 LOG_TRACE(log, "Start to read segment, segment={}", cur_segment->simpleInfo());
             }
             FAIL_POINT_PAUSE(FailPoints::pause_when_reading_from_dt_stream);
@@ -128,6 +143,7 @@ private:
     const UInt64 max_version;
     const size_t expected_block_size;
     const ReadMode read_mode;
+    const SegmentAggregationPtr segment_aggregation;
     size_t total_rows = 0;
 
     bool done = false;
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/TargetSpecific.h>
 #include <Storages/DeltaMerge/DMVersionFilterBlockInputStream.h>
 
 namespace ProfileEvents
@@ -23,6 +24,63 @@ namespace DB
 {
 namespace DM
 {
+namespace
+{
+/// The version filters of the tables with Int64 handle. The handles and versions are compared without
+/// branches, so that the loops are vectorized by the compiler for every target.
+/// Check the rows in [0, size), and the row `size` must be readable as the next row of the last one.
+
+/// filter[i] = !deleted && cur_version <= version_limit && (cur_handle != next_handle || next_version > version_limit)
+TIFLASH_DECLARE_MULTITARGET_FUNCTION(
+    void,
+    mvccFilterIntHandle,
+    (handles, versions, deleted, version_limit, size, filter),
+    (const Handle * __restrict handles,
+     const UInt64 * __restrict versions,
+     const UInt8 * __restrict deleted,
+     UInt64 version_limit,
+     size_t size,
+     UInt8 * __restrict filter),
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            filter[i] = static_cast<UInt8>(
+                (deleted[i] == 0) & (versions[i] <= version_limit)
+                & ((handles[i] != handles[i + 1]) | (versions[i + 1] > version_limit)));
+        }
+    })
+
+/// filter[i] = cur_version >= version_limit || ((cur_handle != next_handle || next_version > version_limit) && !deleted)
+/// effective[i] = filter[i] && cur_handle != next_handle
+/// not_clean[i] = filter[i] && (cur_handle == next_handle || deleted)
+/// is_deleted[i] = filter[i] && deleted
+TIFLASH_DECLARE_MULTITARGET_FUNCTION(
+    void,
+    compactFilterIntHandle,
+    (handles, versions, deleted, version_limit, size, filter, effective, not_clean, is_deleted),
+    (const Handle * __restrict handles,
+     const UInt64 * __restrict versions,
+     const UInt8 * __restrict deleted,
+     UInt64 version_limit,
+     size_t size,
+     UInt8 * __restrict filter,
+     UInt8 * __restrict effective,
+     UInt8 * __restrict not_clean,
+     UInt8 * __restrict is_deleted),
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            UInt8 handle_changed = handles[i] != handles[i + 1];
+            UInt8 del = deleted[i] != 0;
+            UInt8 pass = (versions[i] >= version_limit) | ((handle_changed | (versions[i + 1] > version_limit)) & (del ^ 1));
+            filter[i] = pass;
+            effective[i] = pass & handle_changed;
+            not_clean[i] = pass & ((handle_changed ^ 1) | del);
+            is_deleted[i] = pass & del;
+        }
+    })
+} // namespace
+
 template <int MODE>
 void DMVersionFilterBlockInputStream<MODE>::readPrefix()
 {
@@ -73,8 +131,16 @@ Block DMVersionFilterBlockInputStream<MODE>::read(FilterPtr & res_filter, bool r
         }
 
         filter.resize(rows);
+        if constexpr (MODE == DM_VERSION_FILTER_MODE_COMPACT)
+        {
+            effective.resize(rows);
+            not_clean.resize(rows);
+            is_deleted.resize(rows);
+        }
 
-        const size_t batch_rows = (rows - 1) / UNROLL_BATCH * UNROLL_BATCH;
+        // For the Int64 handle, all the rows except the last one are checked by the specialized filters.
+        const auto * int_handle_data = is_common_handle ? nullptr : getColumnVectorDataPtr<Handle>(cur_raw_block, handle_col_pos);
+        const size_t batch_rows = int_handle_data ? rows - 1 : (rows - 1) / UNROLL_BATCH * UNROLL_BATCH;
 
         // The following is trying to unroll the filtering operations,
         // so that optimizer could use vectorized optimization.
@@ -83,201 +149,218 @@ Block DMVersionFilterBlockInputStream<MODE>::read(FilterPtr & res_filter, bool r
         if constexpr (MODE == DM_VERSION_FILTER_MODE_MVCC)
         {
             /// filter[i] = !deleted && cur_version <= version_limit && (cur_handle != next_handle || next_version > version_limit)
+            if (int_handle_data)
             {
-                UInt8 * filter_pos = filter.data();
-                auto * version_pos = const_cast<UInt64 *>(version_col_data->data()) + 1;
-                for (size_t i = 0; i < batch_rows; ++i)
-                {
-                    (*filter_pos) = (*version_pos) > version_limit;
-
-                    ++filter_pos;
-                    ++version_pos;
-                }
+                mvccFilterIntHandle(int_handle_data->data(), version_col_data->data(), delete_col_data->data(), version_limit, batch_rows, filter.data());
             }
-
+            else
             {
-                UInt8 * filter_pos = filter.data();
-                size_t handle_pos = 0;
-                size_t next_handle_pos = handle_pos + 1;
-                for (size_t i = 0; i < batch_rows; ++i)
                 {
-                    (*filter_pos)
-                        |= compare(rowkey_column->getRowKeyValue(handle_pos), rowkey_column->getRowKeyValue(next_handle_pos)) != 0;
-                    ++filter_pos;
-                    ++handle_pos;
-                    ++next_handle_pos;
+                    UInt8 * filter_pos = filter.data();
+                    auto * version_pos = const_cast<UInt64 *>(version_col_data->data()) + 1;
+                    for (size_t i = 0; i < batch_rows; ++i)
+                    {
+                        (*filter_pos) = (*version_pos) > version_limit;
+
+                        ++filter_pos;
+                        ++version_pos;
+                    }
                 }
-            }
 
-            {
-                UInt8 * filter_pos = filter.data();
-                auto * version_pos = const_cast<UInt64 *>(version_col_data->data());
-                for (size_t i = 0; i < batch_rows; ++i)
                 {
-                    (*filter_pos) &= (*version_pos) <= version_limit;
-
-                    ++filter_pos;
-                    ++version_pos;
+                    UInt8 * filter_pos = filter.data();
+                    size_t handle_pos = 0;
+                    size_t next_handle_pos = handle_pos + 1;
+                    for (size_t i = 0; i < batch_rows; ++i)
+                    {
+                        (*filter_pos)
+                            |= compare(rowkey_column->getRowKeyValue(handle_pos), rowkey_column->getRowKeyValue(next_handle_pos)) != 0;
+                        ++filter_pos;
+                        ++handle_pos;
+                        ++next_handle_pos;
+                    }
                 }
-            }
 
-            {
-                UInt8 * filter_pos = filter.data();
-                auto * delete_pos = const_cast<UInt8 *>(delete_col_data->data());
-                for (size_t i = 0; i < batch_rows; ++i)
                 {
-                    (*filter_pos) &= !(*delete_pos);
+                    UInt8 * filter_pos = filter.data();
+                    auto * version_pos = const_cast<UInt64 *>(version_col_data->data());
+                    for (size_t i = 0; i < batch_rows; ++i)
+                    {
+                        (*filter_pos) &= (*version_pos) <= version_limit;
+
+                        ++filter_pos;
+                        ++version_pos;
+                    }
+                }
 
-                    ++filter_pos;
-                    ++delete_pos;
+                {
+                    UInt8 * filter_pos = filter.data();
+                    auto * delete_pos = const_cast<UInt8 *>(delete_col_data->data());
+                    for (size_t i = 0; i < batch_rows; ++i)
+                    {
+                        (*filter_pos) &= !(*delete_pos);
+
+                        ++filter_pos;
+                        ++delete_pos;
+                    }
                 }
             }
         }
         else if constexpr (MODE == DM_VERSION_FILTER_MODE_COMPACT)
         {
             /// filter[i] = cur_version >= version_limit || ((cur_handle != next_handle || next_version > version_limit) && !deleted);
-
+            if (int_handle_data)
             {
-                UInt8 * filter_pos = filter.data();
-                size_t handle_pos = 0;
-                size_t next_handle_pos = handle_pos + 1;
-                for (size_t i = 0; i < batch_rows; ++i)
-                {
-                    (*filter_pos) = compare(rowkey_column->getRowKeyValue(handle_pos), rowkey_column->getRowKeyValue(next_handle_pos)) != 0;
-                    ++filter_pos;
-                    ++handle_pos;
-                    ++next_handle_pos;
-                }
+                compactFilterIntHandle(
+                    int_handle_data->data(),
+                    version_col_data->data(),
+                    delete_col_data->data(),
+                    version_limit,
+                    batch_rows,
+                    filter.data(),
+                    effective.data(),
+                    not_clean.data(),
+                    is_deleted.data());
             }
-
+            else
             {
-                UInt8 * filter_pos = filter.data();
-                auto * version_pos = const_cast<UInt64 *>(version_col_data->data());
-                auto * next_version_pos = version_pos + 1;
-                for (size_t i = 0; i < batch_rows; ++i)
                 {
-                    (*filter_pos) |= (*next_version_pos) > version_limit;
-
-                    ++filter_pos;
-                    ++next_version_pos;
+                    UInt8 * filter_pos = filter.data();
+                    size_t handle_pos = 0;
+                    size_t next_handle_pos = handle_pos + 1;
+                    for (size_t i = 0; i < batch_rows; ++i)
+                    {
+                        (*filter_pos) = compare(rowkey_column->getRowKeyValue(handle_pos), rowkey_column->getRowKeyValue(next_handle_pos)) != 0;
+                        ++filter_pos;
+                        ++handle_pos;
+                        ++next_handle_pos;
+                    }
                 }
-            }
 
-            {
-                UInt8 * filter_pos = filter.data();
-                auto * delete_pos = const_cast<UInt8 *>(delete_col_data->data());
-                for (size_t i = 0; i < batch_rows; ++i)
                 {
-                    (*filter_pos) &= !(*delete_pos);
-
-                    ++filter_pos;
-                    ++delete_pos;
+                    UInt8 * filter_pos = filter.data();
+                    auto * version_pos = const_cast<UInt64 *>(version_col_data->data());
+                    auto * next_version_pos = version_pos + 1;
+                    for (size_t i = 0; i < batch_rows; ++i)
+                    {
+                        (*filter_pos) |= (*next_version_pos) > version_limit;
+
+                        ++filter_pos;
+                        ++next_version_pos;
+                    }
                 }
-            }
 
-            {
-                UInt8 * filter_pos = filter.data();
-                auto * version_pos = const_cast<UInt64 *>(version_col_data->data());
-                for (size_t i = 0; i < batch_rows; ++i)
                 {
-                    (*filter_pos) |= (*version_pos) >= version_limit;
-
-                    ++filter_pos;
-                    ++version_pos;
+                    UInt8 * filter_pos = filter.data();
+                    auto * delete_pos = const_cast<UInt8 *>(delete_col_data->data());
+                    for (size_t i = 0; i < batch_rows; ++i)
+                    {
+                        (*filter_pos) &= !(*delete_pos);
+
+                        ++filter_pos;
+                        ++delete_pos;
+                    }
                 }
-            }
-
-            // Let's set effective.
-            effective.resize(rows);
 
-            {
-                UInt8 * effective_pos = effective.data();
-                size_t handle_pos = 0;
-                size_t next_handle_pos = handle_pos + 1;
-                for (size_t i = 0; i < batch_rows; ++i)
                 {
-                    (*effective_pos)
-                        = compare(rowkey_column->getRowKeyValue(handle_pos), rowkey_column->getRowKeyValue(next_handle_pos)) != 0;
-                    ++effective_pos;
-                    ++handle_pos;
-                    ++next_handle_pos;
+                    UInt8 * filter_pos = filter.data();
+                    auto * version_pos = const_cast<UInt64 *>(version_col_data->data());
+                    for (size_t i = 0; i < batch_rows; ++i)
+                    {
+                        (*filter_pos) |= (*version_pos) >= version_limit;
+
+                        ++filter_pos;
+                        ++version_pos;
+                    }
                 }
-            }
 
-            {
-                UInt8 * effective_pos = effective.data();
-                UInt8 * filter_pos = filter.data();
-                for (size_t i = 0; i < batch_rows; ++i)
+                // Let's set effective.
                 {
-                    (*effective_pos) &= (*filter_pos);
-
-                    ++effective_pos;
-                    ++filter_pos;
+                    UInt8 * effective_pos = effective.data();
+                    size_t handle_pos = 0;
+                    size_t next_handle_pos = handle_pos + 1;
+                    for (size_t i = 0; i < batch_rows; ++i)
+                    {
+                        (*effective_pos)
+                            = compare(rowkey_column->getRowKeyValue(handle_pos), rowkey_column->getRowKeyValue(next_handle_pos)) != 0;
+                        ++effective_pos;
+                        ++handle_pos;
+                        ++next_handle_pos;
+                    }
                 }
-            }
 
-            // Let's set not_clean.
-            not_clean.resize(rows);
-
-            {
-                UInt8 * not_clean_pos = not_clean.data();
-                size_t handle_pos = 0;
-                size_t next_handle_pos = handle_pos + 1;
-                for (size_t i = 0; i < batch_rows; ++i)
                 {
-                    (*not_clean_pos)
-                        = compare(rowkey_column->getRowKeyValue(handle_pos), rowkey_column->getRowKeyValue(next_handle_pos)) == 0;
-                    ++not_clean_pos;
-                    ++handle_pos;
-                    ++next_handle_pos;
+                    UInt8 * effective_pos = effective.data();
+                    UInt8 * filter_pos = filter.data();
+                    for (size_t i = 0; i < batch_rows; ++i)
+                    {
+                        (*effective_pos) &= (*filter_pos);
+
+                        ++effective_pos;
+                        ++filter_pos;
+                    }
                 }
-            }
 
-            {
-                UInt8 * not_clean_pos = not_clean.data();
-                auto * delete_pos = const_cast<UInt8 *>(delete_col_data->data());
-                for (size_t i = 0; i < batch_rows; ++i)
+                // Let's set not_clean.
                 {
-                    (*not_clean_pos) |= (*delete_pos);
-
-                    ++not_clean_pos;
-                    ++delete_pos;
+                    UInt8 * not_clean_pos = not_clean.data();
+                    size_t handle_pos = 0;
+                    size_t next_handle_pos = handle_pos + 1;
+                    for (size_t i = 0; i < batch_rows; ++i)
+                    {
+                        (*not_clean_pos)
+                            = compare(rowkey_column->getRowKeyValue(handle_pos), rowkey_column->getRowKeyValue(next_handle_pos)) == 0;
+                        ++not_clean_pos;
+                        ++handle_pos;
+                        ++next_handle_pos;
+                    }
                 }
-            }
 
-            {
-                UInt8 * not_clean_pos = not_clean.data();
-                UInt8 * filter_pos = filter.data();
-                for (size_t i = 0; i < batch_rows; ++i)
                 {
-                    (*not_clean_pos) &= (*filter_pos);
+                    UInt8 * not_clean_pos = not_clean.data();
+                    auto * delete_pos = const_cast<UInt8 *>(delete_col_data->data());
+                    for (size_t i = 0; i < batch_rows; ++i)
+                    {
+                        (*not_clean_pos) |= (*delete_pos);
+
+                        ++not_clean_pos;
+                        ++delete_pos;
+                    }
+                }
 
-                    ++not_clean_pos;
-                    ++filter_pos;
+                {
+                    UInt8 * not_clean_pos = not_clean.data();
+                    UInt8 * filter_pos = filter.data();
+                    for (size_t i = 0; i < batch_rows; ++i)
+                    {
+                        (*not_clean_pos) &= (*filter_pos);
+
+                        ++not_clean_pos;
+                        ++filter_pos;
+                    }
                 }
-            }
 
-            // Let's set is_delete.
-            is_deleted.resize(rows);
-            {
-                UInt8 * is_deleted_pos = is_deleted.data();
-                auto * delete_pos = const_cast<UInt8 *>(delete_col_data->data());
-                for (size_t i = 0; i < batch_rows; ++i)
+                // Let's set is_delete.
                 {
-                    (*is_deleted_pos) = (*delete_pos);
-                    ++is_deleted_pos;
-                    ++delete_pos;
+                    UInt8 * is_deleted_pos = is_deleted.data();
+                    auto * delete_pos = const_cast<UInt8 *>(delete_col_data->data());
+                    for (size_t i = 0; i < batch_rows; ++i)
+                    {
+                        (*is_deleted_pos) = (*delete_pos);
+                        ++is_deleted_pos;
+                        ++delete_pos;
+                    }
                 }
-            }
 
-            {
-                UInt8 * is_deleted_pos = is_deleted.data();
-                UInt8 * filter_pos = filter.data();
-                for (size_t i = 0; i < batch_rows; ++i)
                 {
-                    (*is_deleted_pos) &= (*filter_pos);
-                    ++is_deleted_pos;
-                    ++filter_pos;
+                    UInt8 * is_deleted_pos = is_deleted.data();
+                    UInt8 * filter_pos = filter.data();
+                    for (size_t i = 0; i < batch_rows; ++i)
+                    {
+                        (*is_deleted_pos) &= (*filter_pos);
+                        ++is_deleted_pos;
+                        ++filter_pos;
+                    }
                 }
             }
 
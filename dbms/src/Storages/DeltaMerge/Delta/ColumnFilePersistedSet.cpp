@@ -29,10 +29,13 @@ namespace DB
 {
 namespace DM
 {
-inline void serializeColumnFilePersisteds(WriteBatches & wbs, PageIdU64 id, const ColumnFilePersisteds & persisted_files)
+inline void serializeColumnFilePersisteds(WriteBatches & wbs, PageIdU64 id, const ColumnFilePersisteds & persisted_files, PageIdU64 delta_index_page_id)
 {
     MemoryWriteBuffer buf(0, COLUMN_FILE_SERIALIZE_BUFFER_SIZE);
     serializeSavedColumnFiles(buf, persisted_files);
+    // Appended after the column files, so that the metadata can still be read by the older versions.
+    if (delta_index_page_id != 0)
+        writeIntBinary(delta_index_page_id, buf);
     auto data_size = buf.count();
     wbs.meta.putPage(id, 0, buf.tryGetReadBuffer(), data_size);
 }
@@ -94,7 +97,14 @@ ColumnFilePersistedSetPtr ColumnFilePersistedSet::restore( //
     Page page = context.storage_pool->metaReader()->read(id);
     ReadBufferFromMemory buf(page.data.begin(), page.data.size());
     auto column_files = deserializeSavedColumnFiles(context, segment_range, buf);
-    return std::make_shared<ColumnFilePersistedSet>(id, column_files);
+    auto persisted_file_set = std::make_shared<ColumnFilePersistedSet>(id, column_files);
+    if (!buf.eof())
+    {
+        PageIdU64 delta_index_page_id;
+        readIntBinary(delta_index_page_id, buf);
+        persisted_file_set->setDeltaIndexPageId(delta_index_page_id);
+    }
+    return persisted_file_set;
 }
 
 ColumnFilePersistedSetPtr ColumnFilePersistedSet::createFromCheckpoint( //
@@ -119,13 +129,15 @@ ColumnFilePersistedSetPtr ColumnFilePersistedSet::createFromCheckpoint( //
 
 void ColumnFilePersistedSet::saveMeta(WriteBatches & wbs) const
 {
-    serializeColumnFilePersisteds(wbs, metadata_id, persisted_files);
+    serializeColumnFilePersisteds(wbs, metadata_id, persisted_files, delta_index_page_id.load());
 }
 
 void ColumnFilePersistedSet::recordRemoveColumnFilesPages(WriteBatches & wbs) const
 {
     for (const auto & file : persisted_files)
         file->removeData(wbs);
+    if (auto page_id = delta_index_page_id.load(); page_id != 0)
+        wbs.removed_meta.delPage(page_id);
 }
 
 ColumnFilePersisteds ColumnFilePersistedSet::diffColumnFiles(const ColumnFiles & previous_column_files) const
@@ -247,7 +259,7 @@ bool ColumnFilePersistedSet::appendPersistedColumnFiles(const ColumnFilePersiste
         new_persisted_files.push_back(file);
     }
     /// Save the new metadata of column files to disk.
-    serializeColumnFilePersisteds(wbs, metadata_id, new_persisted_files);
+    serializeColumnFilePersisteds(wbs, metadata_id, new_persisted_files, delta_index_page_id.load());
     wbs.writeMeta();
 
     /// Commit updates in memory.
@@ -350,7 +362,7 @@ bool ColumnFilePersistedSet::installCompactionResults(const MinorCompactionPtr &
     checkColumnFiles(new_persisted_files);
 
     /// Save the new metadata of column files to disk.
-    serializeColumnFilePersisteds(wbs, metadata_id, new_persisted_files);
+    serializeColumnFilePersisteds(wbs, metadata_id, new_persisted_files, delta_index_page_id.load());
     wbs.writeMeta();
 
     /// Commit updates in memory.
@@ -57,6 +57,10 @@ private:
     std::atomic<size_t> bytes = 0;
     std::atomic<size_t> deletes = 0;
 
+    /// The page that the delta index is persisted into, 0 means the delta index is not persisted.
+    /// It is saved after the column files in the metadata, and removed along with the column files.
+    std::atomic<PageIdU64> delta_index_page_id = 0;
+
     /// below are just state resides in memory
     UInt64 flush_version = 0;
     UInt64 minor_compaction_version = 0;
@@ -135,8 +139,11 @@ public:
     size_t getRows() const { return rows.load(); }
     size_t getBytes() const { return bytes.load(); }
     size_t getDeletes() const { return deletes.load(); }
+    PageIdU64 getDeltaIndexPageId() const { return delta_index_page_id.load(); }
     /// Thread safe part end
 
+    void setDeltaIndexPageId(PageIdU64 page_id) { delta_index_page_id = page_id; }
+
     size_t getTotalCacheRows() const;
     size_t getTotalCacheBytes() const;
     size_t getValidCacheRows() const;
@@ -12,7 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/Stopwatch.h>
 #include <Common/SyncPoint/SyncPoint.h>
+#include <Common/TiFlashMetrics.h>
 #include <Functions/FunctionHelpers.h>
 #include <IO/MemoryReadWriteBuffer.h>
 #include <IO/ReadHelpers.h>
@@ -31,6 +33,44 @@ namespace DB
 {
 namespace DM
 {
+namespace
+{
+/// The format version of the page of persisted delta index.
+constexpr UInt64 DELTA_INDEX_PAGE_VERSION = 1;
+
+/// The delta index places the delta rows into the stable rows, it can only be used on the same stable.
+void serializeStableFiles(WriteBuffer & buf, const DMFiles & stable_files)
+{
+    writeIntBinary(static_cast<UInt64>(stable_files.size()), buf);
+    for (const auto & file : stable_files)
+    {
+        writeIntBinary(file->fileId(), buf);
+        writeIntBinary(file->pageId(), buf);
+        writeIntBinary(static_cast<UInt64>(file->getRows()), buf);
+    }
+}
+
+bool matchStableFiles(ReadBuffer & buf, const DMFiles & stable_files)
+{
+    UInt64 size;
+    readIntBinary(size, buf);
+    if (size != stable_files.size())
+        return false;
+    for (const auto & file : stable_files)
+    {
+        UInt64 file_id;
+        UInt64 page_id;
+        UInt64 rows;
+        readIntBinary(file_id, buf);
+        readIntBinary(page_id, buf);
+        readIntBinary(rows, buf);
+        if (file_id != file->fileId() || page_id != file->pageId() || rows != file->getRows())
+            return false;
+    }
+    return true;
+}
+} // namespace
+
 // ================================================
 // Public methods
 // ================================================
@@ -441,5 +481,113 @@ bool DeltaValueSpace::compact(DMContext & context)
 
     return true;
 }
+
+bool DeltaValueSpace::persistDeltaIndex(DMContext & context, const DMFiles & stable_files)
+{
+    RUNTIME_CHECK(isUpdating(), simpleInfo());
+
+    DeltaIndexPtr cur_delta_index;
+    size_t persisted_rows = 0;
+    size_t persisted_deletes = 0;
+    {
+        std::scoped_lock lock(mutex);
+        if (abandoned.load(std::memory_order_relaxed))
+            return false;
+        cur_delta_index = delta_index;
+        persisted_rows = persisted_file_set->getRows();
+        persisted_deletes = persisted_file_set->getDeletes();
+    }
+
+    auto is_advanced = [&](size_t placed_rows, size_t placed_deletes) {
+        placed_rows = std::min(placed_rows, persisted_rows);
+        return placed_deletes > last_persisted_delta_index_deletes
+            || placed_rows >= last_persisted_delta_index_rows + context.persist_delta_index_min_rows;
+    };
+    // Do a fast check before copying the delta index.
+    if (auto [placed_rows, placed_deletes] = cur_delta_index->getPlacedStatus(); !is_advanced(placed_rows, placed_deletes))
+        return false;
+
+    GET_METRIC(tiflash_storage_subtask_count, type_persist_delta_index).Increment();
+    Stopwatch watch;
+    SCOPE_EXIT({ GET_METRIC(tiflash_storage_subtask_duration_seconds, type_persist_delta_index).Observe(watch.elapsedSeconds()); });
+
+    // Get a copy with consistent placed status. The copy is empty if the delete ranges in the mem table are placed,
+    // because they can not be removed from the index.
+    auto index = cur_delta_index->tryClone(persisted_rows, persisted_deletes);
+    auto [placed_rows, placed_deletes] = index->getPlacedStatus();
+    if ((placed_rows == 0 && placed_deletes == 0) || !is_advanced(placed_rows, placed_deletes))
+        return false;
+    if (placed_rows > persisted_rows)
+    {
+        // The rows in the mem table are not persisted, they are gone after restart.
+        auto delta_tree = index->getDeltaTree();
+        delta_tree->removeInsertsStartFrom(persisted_rows);
+        placed_rows = persisted_rows;
+        index->update(delta_tree, placed_rows, placed_deletes);
+    }
+
+    MemoryWriteBuffer buf(0, COLUMN_FILE_SERIALIZE_BUFFER_SIZE);
+    writeIntBinary(DELTA_INDEX_PAGE_VERSION, buf);
+    serializeStableFiles(buf, stable_files);
+    index->serialize(buf);
+    auto data_size = buf.count();
+
+    {
+        std::scoped_lock lock(mutex);
+        if (abandoned.load(std::memory_order_relaxed))
+            return false;
+
+        WriteBatches wbs(*context.storage_pool, context.getWriteLimiter());
+        auto page_id = persisted_file_set->getDeltaIndexPageId();
+        if (page_id == 0)
+        {
+            // Save the page id in the metadata along with the page, in the same write batch.
+            page_id = context.storage_pool->newMetaPageId();
+            persisted_file_set->setDeltaIndexPageId(page_id);
+            persisted_file_set->saveMeta(wbs);
+        }
+        wbs.meta.putPage(page_id, 0, buf.tryGetReadBuffer(), data_size);
+        wbs.writeMeta();
+
+        last_persisted_delta_index_rows = placed_rows;
+        last_persisted_delta_index_deletes = placed_deletes;
+    }
+
+    LOG_DEBUG(log, "Persist delta index done, placed_rows={} placed_deletes={} bytes={} delta={}", placed_rows, placed_deletes, data_size, simpleInfo());
+    return true;
+}
+
+DeltaIndexPtr DeltaValueSnapshot::loadPersistedDeltaIndex(const DMContext & context, const DMFiles & stable_files) const
+{
+    if (delta_index_page_id == 0)
+        return {};
+
+    GET_METRIC(tiflash_storage_subtask_count, type_load_delta_index).Increment();
+    Stopwatch watch;
+    SCOPE_EXIT({ GET_METRIC(tiflash_storage_subtask_duration_seconds, type_load_delta_index).Observe(watch.elapsedSeconds()); });
+
+    try
+    {
+        // The page could be removed or overwritten after the snapshot is created, check it before using.
+        auto page = context.storage_pool->metaReader()->read(delta_index_page_id);
+        ReadBufferFromMemory buf(page.data.begin(), page.data.size());
+        UInt64 version;
+        readIntBinary(version, buf);
+        if (version != DELTA_INDEX_PAGE_VERSION || !matchStableFiles(buf, stable_files))
+            return {};
+
+        auto index = DeltaIndex::deserialize(buf);
+        auto [placed_rows, placed_deletes] = index->getPlacedStatus();
+        if (placed_rows > persisted_files_snap->getRows() || placed_deletes > persisted_files_snap->getDeletes())
+            return {};
+        return index;
+    }
+    catch (...)
+    {
+        tryLogCurrentException(Logger::get(), fmt::format("Load persisted delta index failed, delta_index_page_id={}", delta_index_page_id));
+        return {};
+    }
+}
+
 } // namespace DM
 } // namespace DB
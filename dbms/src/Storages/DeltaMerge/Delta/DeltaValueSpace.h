@@ -96,6 +96,10 @@ private:
     DeltaIndexPtr delta_index;
     UInt64 delta_index_epoch = 0;
 
+    // The placed status of the delta index persisted last time, only in memory.
+    size_t last_persisted_delta_index_rows = 0;
+    size_t last_persisted_delta_index_deletes = 0;
+
     // Protects the operations in this instance.
     // It is a recursive_mutex because the lock may be also used by the parent segment as its update lock.
     mutable std::recursive_mutex mutex;
@@ -279,6 +283,13 @@ public:
     /// a.k.a. minor compaction.
     bool compact(DMContext & context);
 
+    /// Persist the delta index into PageStorage if it has placed enough new rows since last time, so that it can be
+    /// loaded instead of placing the whole delta again after restart or being evicted by DeltaIndexManager.
+    /// Only the rows and deletes in the persisted column files are persisted. `stable_files` is used to check whether
+    /// the index is still valid when loading.
+    /// The caller must hold the update lock, so that the persisted column files are not changed by other structure updates.
+    bool persistDeltaIndex(DMContext & context, const DMFiles & stable_files);
+
     /**
      * Create a snapshot for read. The snapshot always contains memtable, persisted delta and stable.
      *
@@ -316,6 +327,8 @@ private:
     // The delta index of cached.
     DeltaIndexPtr shared_delta_index;
     UInt64 delta_index_epoch = 0;
+    // The page of the persisted delta index, 0 means there is no persisted delta index.
+    PageIdU64 delta_index_page_id = 0;
 
     ColumnFileSetSnapshotPtr mem_table_snap;
 
@@ -336,6 +349,7 @@ public:
         c->is_update = is_update;
         c->shared_delta_index = shared_delta_index;
         c->delta_index_epoch = delta_index_epoch;
+        c->delta_index_page_id = delta_index_page_id;
         c->mem_table_snap = mem_table_snap->clone();
         c->persisted_files_snap = persisted_files_snap->clone();
 
@@ -373,6 +387,9 @@ public:
     const auto & getSharedDeltaIndex() { return shared_delta_index; }
     size_t getDeltaIndexEpoch() const { return delta_index_epoch; }
 
+    /// Load the persisted delta index. Returns empty if it is not persisted, or not valid for this snapshot any more.
+    DeltaIndexPtr loadPersistedDeltaIndex(const DMContext & context, const DMFiles & stable_files) const;
+
     bool isForUpdate() const { return is_update; }
 };
 
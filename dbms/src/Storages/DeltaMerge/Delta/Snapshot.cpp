@@ -45,6 +45,7 @@ DeltaSnapshotPtr DeltaValueSpace::createSnapshot(const DMContext & context, bool
     snap->mem_table_snap = mem_table_set->createSnapshot(data_from_storage_snap, for_update);
     snap->shared_delta_index = delta_index;
     snap->delta_index_epoch = delta_index_epoch;
+    snap->delta_index_page_id = persisted_file_set->getDeltaIndexPageId();
 
     return snap;
 }
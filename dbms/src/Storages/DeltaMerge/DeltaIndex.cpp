@@ -0,0 +1,102 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <IO/CompressedReadBuffer.h>
+#include <IO/CompressedWriteBuffer.h>
+#include <IO/ReadHelpers.h>
+#include <IO/WriteHelpers.h>
+#include <Storages/DeltaMerge/DeltaIndex.h>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int CORRUPTED_DATA;
+} // namespace ErrorCodes
+
+namespace DM
+{
+/// The entries are compressed and written at the end, so the serialized index must be the last part of the buffer.
+void DeltaIndex::serialize(WriteBuffer & buf) const
+{
+    std::scoped_lock lock(mutex);
+
+    writeIntBinary(static_cast<UInt64>(placed_rows), buf);
+    writeIntBinary(static_cast<UInt64>(placed_deletes), buf);
+    writeIntBinary(static_cast<UInt64>(delta_tree->numEntries()), buf);
+
+    CompressedWriteBuffer compressed(buf);
+    for (auto it = delta_tree->begin(), end = delta_tree->end(); it != end; ++it)
+    {
+        writeIntBinary(it.getSid(), compressed);
+        writeIntBinary(static_cast<UInt8>(it.isInsert()), compressed);
+        writeIntBinary(it.getCount(), compressed);
+        writeIntBinary(it.getValue(), compressed);
+    }
+    compressed.next();
+}
+
+DeltaIndexPtr DeltaIndex::deserialize(ReadBuffer & buf)
+{
+    UInt64 placed_rows;
+    UInt64 placed_deletes;
+    UInt64 num_entries;
+    readIntBinary(placed_rows, buf);
+    readIntBinary(placed_deletes, buf);
+    readIntBinary(num_entries, buf);
+
+    auto delta_tree = std::make_shared<DefaultDeltaTree>();
+    if (num_entries > 0)
+    {
+        // The entries are sorted, replay them one by one and each of them is appended after the existing ones.
+        // The row id of an entry is its stable id plus the inserts minus the deletes before it.
+        CompressedReadBuffer compressed(buf);
+        Int64 delta = 0;
+        for (UInt64 i = 0; i < num_entries; ++i)
+        {
+            UInt64 sid;
+            UInt8 is_insert;
+            UInt32 count;
+            UInt64 value;
+            readIntBinary(sid, compressed);
+            readIntBinary(is_insert, compressed);
+            readIntBinary(count, compressed);
+            readIntBinary(value, compressed);
+
+            const auto rid = static_cast<Int64>(sid) + delta;
+            if (unlikely(rid < 0 || count == 0 || (is_insert && count != 1)))
+                throw Exception(fmt::format("Corrupted delta index entry, sid={} is_insert={} count={} delta={}", sid, is_insert, count, delta), ErrorCodes::CORRUPTED_DATA);
+
+            if (is_insert)
+            {
+                delta_tree->addInsert(rid, value);
+                delta += 1;
+            }
+            else
+            {
+                for (UInt32 c = 0; c < count; ++c)
+                    delta_tree->addDelete(rid);
+                delta -= count;
+            }
+        }
+    }
+
+    if (unlikely(delta_tree->numInserts() > placed_rows))
+        throw Exception(fmt::format("Corrupted delta index, inserts={} placed_rows={}", delta_tree->numInserts(), placed_rows), ErrorCodes::CORRUPTED_DATA);
+
+    return std::make_shared<DeltaIndex>(delta_tree, placed_rows, placed_deletes);
+}
+
+} // namespace DM
+} // namespace DB
@@ -20,6 +20,9 @@
 
 namespace DB
 {
+class ReadBuffer;
+class WriteBuffer;
+
 namespace DM
 {
 class DeltaIndex;
@@ -199,6 +202,13 @@ public:
 
     DeltaIndexPtr tryClone(size_t /*rows*/, size_t deletes) { return tryCloneInner(deletes); }
 
+    /// Serialize the placed status and the entries of the delta tree, so that the index can be persisted
+    /// and restored without placing the delta again.
+    void serialize(WriteBuffer & buf) const;
+
+    /// Rebuild the delta tree from the serialized entries.
+    static DeltaIndexPtr deserialize(ReadBuffer & buf);
+
     DeltaIndexPtr cloneWithUpdates(const Updates & updates)
     {
         if (unlikely(updates.empty()))
@@ -68,6 +68,8 @@ public:
 
     bool isLimit() const { return max_size != 0; }
 
+    size_t maxSize() const { return max_size; }
+
     /// Put the reference of DeltaIndex into this manager.
     void refreshRef(const DeltaIndexPtr & index);
 
@@ -161,6 +161,35 @@ DeltaMergeStore::BackgroundTask DeltaMergeStore::MergeDeltaTaskPool::nextTask(bo
     return task;
 }
 
+// ================================================
+//   WarmUpTaskPool
+// ================================================
+
+void DeltaMergeStore::WarmUpTaskPool::addTask(const SegmentPtr & segment)
+{
+    std::scoped_lock lock(mutex);
+    tasks[segment->segmentId()] = segment;
+}
+
+SegmentPtr DeltaMergeStore::WarmUpTaskPool::nextTask()
+{
+    std::scoped_lock lock(mutex);
+
+    // The number of tasks is limited by the number of segments, a linear scan is cheap enough.
+    auto hottest = tasks.end();
+    for (auto it = tasks.begin(); it != tasks.end(); ++it)
+    {
+        if (hottest == tasks.end() || it->second->getReadHotness() > hottest->second->getReadHotness())
+            hottest = it;
+    }
+    if (hottest == tasks.end())
+        return {};
+
+    auto segment = hottest->second;
+    tasks.erase(hottest);
+    return segment;
+}
+
 // ================================================
 //   DeltaMergeStore
 // ================================================
@@ -451,8 +480,12 @@ void DeltaMergeStore::shutdown()
 
     background_pool.removeTask(background_task_handle);
     blockable_background_pool.removeTask(blockable_background_pool_handle);
+    // Only added under non-disagg mode
+    if (warm_up_task_handle)
+        background_pool.removeTask(warm_up_task_handle);
     background_task_handle = nullptr;
     blockable_background_pool_handle = nullptr;
+    warm_up_task_handle = nullptr;
     LOG_TRACE(log, "Shutdown DeltaMerge end");
 }
 
@@ -1048,17 +1081,22 @@ BlockInputStreams DeltaMergeStore::read(const Context & db_context,
                                         size_t expected_block_size,
                                         const SegmentIdSet & read_segments,
                                         size_t extra_table_id_index,
-                                        ScanContextPtr scan_context)
+                                        ScanContextPtr scan_context,
+                                        bool enable_low_cardinality_string,
+                                        const SegmentAggregationPtr & segment_aggregation)
 {
     // Use the id from MPP/Coprocessor level as tracing_id
     auto dm_context = newDMContext(db_context, db_settings, tracing_id, scan_context);
+    dm_context->enable_low_cardinality_string = enable_low_cardinality_string;
 
     // If keep order is required, disable read thread.
-    auto enable_read_thread = db_context.getSettingsRef().dt_enable_read_thread && !keep_order;
+    // The segment aggregation also disables read thread, because it needs the blocks of a segment to be read by the same stream.
+    auto enable_read_thread = db_context.getSettingsRef().dt_enable_read_thread && !keep_order && !segment_aggregation;
     // SegmentReadTaskScheduler and SegmentReadTaskPool use table_id + segment id as unique ID when read thread is enabled.
     // 'try_split_task' can result in several read tasks with the same id that can cause some trouble.
     // Also, too many read tasks of a segment with different small ranges is not good for data sharing cache.
-    SegmentReadTasks tasks = getReadTasksByRanges(*dm_context, sorted_ranges, num_streams, read_segments, /*try_split_task =*/!enable_read_thread);
+    // The segment aggregation doesn't split tasks either, so that the cached results of segments can be reused by the later reads.
+    SegmentReadTasks tasks = getReadTasksByRanges(*dm_context, sorted_ranges, num_streams, read_segments, /*try_split_task =*/!enable_read_thread && !segment_aggregation);
     auto log_tracing_id = getLogTracingId(*dm_context);
     auto tracing_logger = log->getChild(log_tracing_id);
     LOG_INFO(tracing_logger,
@@ -1117,11 +1155,21 @@ BlockInputStreams DeltaMergeStore::read(const Context & db_context,
                 max_version,
                 expected_block_size,
                 /* read_mode = */ is_fast_scan ? ReadMode::Fast : ReadMode::Normal,
-                log_tracing_id);
-            stream = std::make_shared<AddExtraTableIDColumnInputStream>(
-                stream,
-                extra_table_id_index,
-                physical_table_id);
+                log_tracing_id,
+                segment_aggregation);
+            // The header of the segment aggregation stream is changed after it is initialized,
+            // the extra table id column is not supported.
+            if (!segment_aggregation)
+            {
+                stream = std::make_shared<AddExtraTableIDColumnInputStream>(
+                    stream,
+                    extra_table_id_index,
+                    physical_table_id);
+            }
+            else
+            {
+                RUNTIME_CHECK(extra_table_id_index == InvalidColumnID, extra_table_id_index);
+            }
         }
         res.push_back(stream);
     }
@@ -1146,10 +1194,12 @@ void DeltaMergeStore::read(
     size_t expected_block_size,
     const SegmentIdSet & read_segments,
     size_t extra_table_id_index,
-    ScanContextPtr scan_context)
+    ScanContextPtr scan_context,
+    bool enable_low_cardinality_string)
 {
     // Use the id from MPP/Coprocessor level as tracing_id
     auto dm_context = newDMContext(db_context, db_settings, tracing_id, scan_context);
+    dm_context->enable_low_cardinality_string = enable_low_cardinality_string;
 
     // If keep order is required, disable read thread.
     auto enable_read_thread = db_context.getSettingsRef().dt_enable_read_thread && !keep_order;
@@ -1733,6 +1783,9 @@ SegmentReadTasks DeltaMergeStore::getReadTasksByRanges(
     bool try_split_task)
 {
     SegmentReadTasks tasks;
+    // Segments are only warmed up under non-disagg mode, see `tryAddWarmUpTasks`.
+    const bool record_read_hotness = dm_context.warm_up_read_threshold != 0
+        && global_context.getSharedContextDisagg()->notDisaggregatedMode();
 
     std::shared_lock lock(read_write_mutex);
 
@@ -1758,6 +1811,8 @@ SegmentReadTasks DeltaMergeStore::getReadTasksByRanges(
                 auto segment_snap = segment->createSnapshot(dm_context, false, CurrentMetrics::DT_SnapshotOfRead);
                 if (unlikely(!segment_snap))
                     throw Exception("Failed to get segment snap", ErrorCodes::LOGICAL_ERROR);
+                if (record_read_hotness)
+                    segment->addReadHotness(1);
                 tasks.push_back(std::make_shared<SegmentReadTask>(segment, segment_snap));
             }
 
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <Common/Stopwatch.h>
 #include <Common/UniThreadPool.h>
 #include <Core/Block.h>
 #include <Core/SortDescription.h>
@@ -29,6 +30,7 @@
 #include <Storages/DeltaMerge/Remote/DisaggSnapshot_fwd.h>
 #include <Storages/DeltaMerge/RowKeyRange.h>
 #include <Storages/DeltaMerge/ScanContext.h>
+#include <Storages/DeltaMerge/SegmentAggCache.h>
 #include <Storages/DeltaMerge/SegmentReadTaskPool.h>
 #include <Storages/Page/PageStorage_fwd.h>
 #include <Storages/Transaction/DecodingStorageSchemaSnapshot.h>
@@ -245,6 +247,33 @@ public:
         BackgroundTask nextTask(bool is_heavy, const LoggerPtr & log_);
     };
 
+    /// The hot segments waiting to be warmed up after they are replaced. The hottest one is popped first.
+    class WarmUpTaskPool
+    {
+#ifndef DBMS_PUBLIC_GTEST
+    private:
+#else
+    public:
+#endif
+
+        std::unordered_map<PageIdU64, SegmentPtr> tasks;
+
+        std::mutex mutex;
+
+    public:
+        size_t length()
+        {
+            std::scoped_lock lock(mutex);
+            return tasks.size();
+        }
+
+        /// Add the segment, or replace the older version of the segment with the same id.
+        void addTask(const SegmentPtr & segment);
+
+        /// Return nullptr if there is no task.
+        SegmentPtr nextTask();
+    };
+
     DeltaMergeStore(Context & db_context, //
                     bool data_path_contains_database_name,
                     const String & db_name,
@@ -347,6 +376,8 @@ public:
     ///     when is_fast_scan == false, we will read rows with MVCC filtering, del mark !=0  filter and sorted merge.
     ///     when is_fast_scan == true, we will read rows without MVCC and sorted merge.
     /// `sorted_ranges` should be already sorted and merged.
+    /// If `segment_aggregation` is not null, the segments are read one by one in every stream, so that
+    /// the aggregation can be computed segment by segment once it is initialized.
     BlockInputStreams read(const Context & db_context,
                            const DB::Settings & db_settings,
                            const ColumnDefines & columns_to_read,
@@ -362,7 +393,9 @@ public:
                            size_t expected_block_size = DEFAULT_BLOCK_SIZE,
                            const SegmentIdSet & read_segments = {},
                            size_t extra_table_id_index = InvalidColumnID,
-                           ScanContextPtr scan_context = nullptr);
+                           ScanContextPtr scan_context = nullptr,
+                           bool enable_low_cardinality_string = false,
+                           const SegmentAggregationPtr & segment_aggregation = nullptr);
 
 
     /// Read rows in two modes:
@@ -385,7 +418,8 @@ public:
         size_t expected_block_size = DEFAULT_BLOCK_SIZE,
         const SegmentIdSet & read_segments = {},
         size_t extra_table_id_index = InvalidColumnID,
-        ScanContextPtr scan_context = nullptr);
+        ScanContextPtr scan_context = nullptr,
+        bool enable_low_cardinality_string = false);
 
     Remote::DisaggPhysicalTableReadSnapshotPtr
     writeNodeBuildRemoteReadSnapshot(
@@ -635,6 +669,19 @@ private:
         const DMFilePtr & data_file,
         const ColumnFilePersisteds & column_file_persisteds);
 
+    /**
+     * Place the delta index and load the MinMax indexes of the stable of the segment into the caches,
+     * so that the following reads do not need to build them.
+     * Skip the caches whose usage exceeds `dm_context.warm_up_cache_usage_ratio`.
+     */
+    void segmentWarmUp(DMContext & dm_context, const SegmentPtr & segment);
+
+    /**
+     * Let the new segments inherit the read hotness of the replaced segment, and add them
+     * to the warm-up tasks if they are hot enough.
+     */
+    void tryAddWarmUpTasks(const DMContext & dm_context, UInt64 read_hotness, const std::vector<SegmentPtr> & new_segments);
+
     // isSegmentValid should be protected by lock on `read_write_mutex`
     bool isSegmentValid(const std::shared_lock<std::shared_mutex> &, const SegmentPtr & segment)
     {
@@ -674,6 +721,10 @@ private:
 
     bool handleBackgroundTask(bool heavy);
 
+    bool handleWarmUpTask();
+    /// Warm up the hottest segment in `warm_up_tasks`. Return false if there is no task.
+    bool warmUpNextSegment(DMContext & dm_context);
+
     void restoreStableFiles() const;
     void restoreStableFilesFromLocal() const;
 
@@ -725,6 +776,8 @@ public:
     BackgroundProcessingPool & blockable_background_pool;
     BackgroundProcessingPool::TaskHandle blockable_background_pool_handle;
 
+    BackgroundProcessingPool::TaskHandle warm_up_task_handle;
+
     /// end of range -> segment
     SegmentSortedMap segments;
     /// Mainly for debug.
@@ -732,6 +785,10 @@ public:
 
     MergeDeltaTaskPool background_tasks;
 
+    WarmUpTaskPool warm_up_tasks;
+    // Only accessed by the warm-up task, which is run by one thread at a time.
+    Stopwatch last_decay_read_hotness_watch;
+
     std::atomic<DB::Timestamp> latest_gc_safe_point = 0;
 
     RowKeyValue next_gc_check_key;
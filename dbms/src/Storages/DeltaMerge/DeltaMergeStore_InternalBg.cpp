@@ -25,6 +25,7 @@
 #include <Storages/PathPool.h>
 #include <Storages/Transaction/TMTContext.h>
 
+#include <ext/scope_guard.h>
 #include <magic_enum.hpp>
 #include <memory>
 
@@ -39,10 +40,19 @@ namespace FailPoints
 {
 extern const char pause_before_dt_background_delta_merge[];
 extern const char pause_until_dt_background_delta_merge[];
+extern const char skip_background_segment_warm_up[];
 } // namespace FailPoints
 
 namespace DM
 {
+namespace
+{
+// The read hotness of segments is halved every this period.
+constexpr double DECAY_READ_HOTNESS_INTERVAL_SECONDS = 60;
+
+// The number of segments being warmed up by all the tables.
+std::atomic<size_t> warming_up_segments = 0;
+} // namespace
 
 // A callback class for scanning the DMFiles on local filesystem
 class LocalDMFileGcScanner final
@@ -277,8 +287,11 @@ void DeltaMergeStore::setUpBackgroundTask(const DMContextPtr & dm_context)
 
     // Under disagg mode, a write node could serve large amount of data, place delta index tasks
     // after restart is useless and waste of S3 reading. Only do it when deployed non-disagg mode.
+    // So does warming up the hot segments.
     if (global_context.getSharedContextDisagg()->notDisaggregatedMode())
     {
+        warm_up_task_handle = background_pool.addTask([this] { return handleWarmUpTask(); }, /*multi*/ false);
+
         // Generate place delta index tasks
         for (auto & [end, segment] : segments)
         {
@@ -430,6 +443,66 @@ bool DeltaMergeStore::handleBackgroundTask(bool heavy)
     return true;
 }
 
+bool DeltaMergeStore::handleWarmUpTask()
+{
+    fiu_do_on(FailPoints::skip_background_segment_warm_up, { return false; });
+
+    if (shutdown_called.load(std::memory_order_relaxed))
+        return false;
+
+    // The read hotness is not recorded when warm-up is disabled, nothing to decay or warm up.
+    if (global_context.getSettingsRef().dt_segment_warm_up_read_threshold == 0)
+        return false;
+
+    if (last_decay_read_hotness_watch.elapsedSeconds() >= DECAY_READ_HOTNESS_INTERVAL_SECONDS)
+    {
+        std::shared_lock lock(read_write_mutex);
+        for (const auto & [id, segment] : id_to_segment)
+        {
+            (void)id;
+            segment->decayReadHotness();
+        }
+        last_decay_read_hotness_watch.restart();
+    }
+
+    if (warm_up_tasks.length() == 0)
+        return false;
+
+    auto dm_context = newDMContext(global_context, global_context.getSettingsRef(), "warm_up");
+    // Limit the number of background threads used by warm-up among all the tables.
+    if (warming_up_segments.fetch_add(1, std::memory_order_relaxed) >= dm_context->warm_up_max_concurrency)
+    {
+        warming_up_segments.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+    SCOPE_EXIT({ warming_up_segments.fetch_sub(1, std::memory_order_relaxed); });
+
+    return warmUpNextSegment(*dm_context);
+}
+
+bool DeltaMergeStore::warmUpNextSegment(DMContext & dm_context)
+{
+    auto segment = warm_up_tasks.nextTask();
+    if (!segment)
+        return false;
+    {
+        std::shared_lock lock(read_write_mutex);
+        if (!isSegmentValid(lock, segment))
+            return true;
+    }
+
+    try
+    {
+        segmentWarmUp(dm_context, segment);
+    }
+    catch (...)
+    {
+        // Warm-up is only an optimization, the failure should not affect the other background tasks.
+        tryLogCurrentException(log, fmt::format("Warm up segment failed, segment={}", segment->simpleInfo()));
+    }
+    return true;
+}
+
 namespace GC
 
 {
@@ -14,10 +14,16 @@
 
 #include <Common/SyncPoint/SyncPoint.h>
 #include <Common/TiFlashMetrics.h>
+#include <Interpreters/Context.h>
+#include <Interpreters/SharedContexts/Disagg.h>
+#include <Storages/DeltaMerge/DeltaIndexManager.h>
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
+#include <Storages/DeltaMerge/File/DMFilePackFilter.h>
 #include <Storages/DeltaMerge/Segment.h>
+#include <Storages/DeltaMerge/StableValueSpace.h>
 #include <Storages/DeltaMerge/WriteBatchesImpl.h>
 
+#include <ext/scope_guard.h>
 #include <magic_enum.hpp>
 
 namespace CurrentMetrics
@@ -202,6 +208,8 @@ SegmentPair DeltaMergeStore::segmentSplit(DMContext & dm_context, const SegmentP
         GET_METRIC(tiflash_storage_throughput_rows, type_split).Decrement(duplicated_rows);
     }
 
+    tryAddWarmUpTasks(dm_context, segment->getReadHotness(), {new_left, new_right});
+
     if constexpr (DM_RUN_CHECK)
         check(dm_context.db_context);
 
@@ -337,6 +345,11 @@ SegmentPtr DeltaMergeStore::segmentMerge(DMContext & dm_context, const std::vect
     GET_METRIC(tiflash_storage_throughput_bytes, type_merge).Increment(delta_bytes);
     GET_METRIC(tiflash_storage_throughput_rows, type_merge).Increment(delta_rows);
 
+    UInt64 read_hotness = 0;
+    for (const auto & seg : ordered_segments)
+        read_hotness += seg->getReadHotness();
+    tryAddWarmUpTasks(dm_context, read_hotness, {merged});
+
     if constexpr (DM_RUN_CHECK)
         check(dm_context.db_context);
 
@@ -477,6 +490,8 @@ SegmentPtr DeltaMergeStore::segmentMergeDelta(
     GET_METRIC(tiflash_storage_throughput_bytes, type_delta_merge).Increment(delta_bytes);
     GET_METRIC(tiflash_storage_throughput_rows, type_delta_merge).Increment(delta_rows);
 
+    tryAddWarmUpTasks(dm_context, segment->getReadHotness(), {new_segment});
+
     if constexpr (DM_RUN_CHECK)
         check(dm_context.db_context);
 
@@ -581,6 +596,8 @@ SegmentPtr DeltaMergeStore::segmentIngestData(
         }
     }
 
+    tryAddWarmUpTasks(dm_context, segment->getReadHotness(), {new_segment});
+
     if constexpr (DM_RUN_CHECK)
         check(dm_context.db_context);
 
@@ -624,12 +641,85 @@ SegmentPtr DeltaMergeStore::segmentDangerouslyReplaceDataFromCheckpoint(
 
     wbs.writeRemoves();
 
+    tryAddWarmUpTasks(dm_context, segment->getReadHotness(), {new_segment});
+
     if constexpr (DM_RUN_CHECK)
         check(dm_context.db_context);
 
     return new_segment;
 }
 
+void DeltaMergeStore::tryAddWarmUpTasks(const DMContext & dm_context, UInt64 read_hotness, const std::vector<SegmentPtr> & new_segments)
+{
+    if (dm_context.warm_up_read_threshold == 0)
+        return;
+    // Under disagg mode, the write node does not serve the reads by itself, warming up the delta index
+    // and the indexes of DTFiles on S3 is useless and waste of S3 reading. The same as `setUpBackgroundTask`.
+    if (!global_context.getSharedContextDisagg()->notDisaggregatedMode())
+        return;
+
+    for (const auto & new_segment : new_segments)
+        new_segment->addReadHotness(read_hotness);
+
+    if (read_hotness < dm_context.warm_up_read_threshold)
+        return;
+    if (shutdown_called.load(std::memory_order_relaxed))
+        return;
+
+    for (const auto & new_segment : new_segments)
+        warm_up_tasks.addTask(new_segment);
+    if (warm_up_task_handle)
+        warm_up_task_handle->wake();
+}
+
+void DeltaMergeStore::segmentWarmUp(DMContext & dm_context, const SegmentPtr & segment)
+{
+    GET_METRIC(tiflash_storage_subtask_count, type_warm_up_segment).Increment();
+    Stopwatch watch;
+    SCOPE_EXIT({ GET_METRIC(tiflash_storage_subtask_duration_seconds, type_warm_up_segment).Observe(watch.elapsedSeconds()); });
+
+    const auto & global_context = dm_context.db_context.getGlobalContext();
+    const auto max_usage_ratio = dm_context.warm_up_cache_usage_ratio;
+
+    // The DeltaIndex is only limited by the DeltaIndexManager when it is enabled.
+    bool place_delta_index = true;
+    if (global_context.isDeltaIndexLimited())
+    {
+        auto manager = global_context.getDeltaIndexManager();
+        place_delta_index = manager->currentSize() < manager->maxSize() * max_usage_ratio;
+    }
+    if (place_delta_index)
+        segment->placeDeltaIndex(dm_context);
+
+    size_t loaded_files = 0;
+    const auto & stable_files = segment->getStable()->getDMFiles();
+    if (auto index_cache = global_context.getMinMaxIndexCache(); index_cache)
+    {
+        for (const auto & file : stable_files)
+        {
+            if (index_cache->weight() >= index_cache->maxWeight() * max_usage_ratio)
+                break;
+            DMFilePackFilter::loadIndexesToCache(
+                file,
+                index_cache,
+                global_context.getBloomFilterIndexCache(),
+                global_context.getFileProvider(),
+                dm_context.getReadLimiter());
+            ++loaded_files;
+        }
+    }
+
+    LOG_DEBUG(
+        log,
+        "WarmUp - Finish, segment={} read_hotness={} place_delta_index={} loaded_index_files={}/{} cost={:.3f}s",
+        segment->simpleInfo(),
+        segment->getReadHotness(),
+        place_delta_index,
+        loaded_files,
+        stable_files.size(),
+        watch.elapsedSeconds());
+}
+
 bool DeltaMergeStore::doIsSegmentValid(const SegmentPtr & segment)
 {
     if (segment->hasAbandoned())
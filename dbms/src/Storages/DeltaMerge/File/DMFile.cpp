@@ -67,6 +67,7 @@ inline constexpr static const char * FOLDER_PREFIX_DROPPED = ".del.dmf_";
 inline constexpr static const char * DATA_FILE_SUFFIX = ".dat";
 inline constexpr static const char * INDEX_FILE_SUFFIX = ".idx";
 inline constexpr static const char * MARK_FILE_SUFFIX = ".mrk";
+inline constexpr static const char * BLOOM_FILTER_FILE_SUFFIX = ".bf";
 
 inline String getNGCPath(const String & prefix)
 {
@@ -196,6 +197,11 @@ String DMFile::colMarkCacheKey(const FileNameBase & file_name_base) const
     return colMarkPath(file_name_base);
 }
 
+String DMFile::colBloomFilterCacheKey(const FileNameBase & file_name_base) const
+{
+    return colBloomFilterPath(file_name_base);
+}
+
 bool DMFile::isColIndexExist(const ColId & col_id) const
 {
     if (useMetaV2())
@@ -209,6 +215,19 @@ bool DMFile::isColIndexExist(const ColId & col_id) const
     }
 }
 
+bool DMFile::isColBloomFilterExist(const ColId & col_id) const
+{
+    if (useMetaV2())
+    {
+        auto itr = column_stats.find(col_id);
+        return itr != column_stats.end() && itr->second.bloom_filter_bytes > 0;
+    }
+    else
+    {
+        return column_bloom_filters.count(col_id) != 0;
+    }
+}
+
 size_t DMFile::colIndexSize(ColId id)
 {
     if (useMetaV2())
@@ -228,6 +247,25 @@ size_t DMFile::colIndexSize(ColId id)
     }
 }
 
+size_t DMFile::colBloomFilterSize(ColId id)
+{
+    if (useMetaV2())
+    {
+        if (auto itr = column_stats.find(id); itr != column_stats.end() && itr->second.bloom_filter_bytes > 0)
+        {
+            return itr->second.bloom_filter_bytes;
+        }
+        else
+        {
+            throw Exception(ErrorCodes::FILE_DOESNT_EXIST, "Bloom filter of {} not exist", id);
+        }
+    }
+    else
+    {
+        return colBloomFilterSizeByName(getFileNameBase(id));
+    }
+}
+
 size_t DMFile::colDataSize(ColId id, bool is_null_map)
 {
     if (useMetaV2())
@@ -269,6 +307,11 @@ EncryptionPath DMFile::encryptionMarkPath(const FileNameBase & file_name_base) c
     return EncryptionPath(encryptionBasePath(), file_name_base + details::MARK_FILE_SUFFIX);
 }
 
+EncryptionPath DMFile::encryptionBloomFilterPath(const FileNameBase & file_name_base) const
+{
+    return EncryptionPath(encryptionBasePath(), file_name_base + details::BLOOM_FILTER_FILE_SUFFIX);
+}
+
 EncryptionPath DMFile::encryptionMetaPath() const
 {
     return EncryptionPath(encryptionBasePath(), metaFileName());
@@ -311,6 +354,10 @@ String DMFile::colMarkFileName(const FileNameBase & file_name_base)
 {
     return file_name_base + details::MARK_FILE_SUFFIX;
 }
+String DMFile::colBloomFilterFileName(const FileNameBase & file_name_base)
+{
+    return file_name_base + details::BLOOM_FILTER_FILE_SUFFIX;
+}
 
 DMFile::OffsetAndSize DMFile::writeMetaToBuffer(WriteBuffer & buffer)
 {
@@ -814,6 +861,10 @@ void DMFile::initializeIndices()
         {
             column_indices.insert(decode(removeSuffix(name, strlen(details::INDEX_FILE_SUFFIX)))); // strip tailing `.idx`
         }
+        else if (endsWith(name, details::BLOOM_FILTER_FILE_SUFFIX))
+        {
+            column_bloom_filters.insert(decode(removeSuffix(name, strlen(details::BLOOM_FILTER_FILE_SUFFIX)))); // strip tailing `.bf`
+        }
     }
 }
 
@@ -867,16 +918,61 @@ DMFile::MetaBlockHandle DMFile::writeMergedSubFilePosotionsToBuffer(WriteBuffer
     return MetaBlockHandle{MetaBlockType::MergedSubFilePos, offset, buffer.count() - offset};
 }
 
+DMFile::MetaBlockHandle DMFile::writeColumnBloomFilterToBuffer(WriteBuffer & buffer)
+{
+    auto offset = buffer.count();
+    UInt64 count = 0;
+    for (const auto & [id, stat] : column_stats)
+        count += stat.bloom_filter_bytes > 0;
+    writeIntBinary(count, buffer);
+    for (const auto & [id, stat] : column_stats)
+    {
+        if (stat.bloom_filter_bytes > 0)
+        {
+            writeIntBinary(id, buffer);
+            writeIntBinary(stat.bloom_filter_bytes, buffer);
+        }
+    }
+    return MetaBlockHandle{MetaBlockType::ColumnBloomFilter, offset, buffer.count() - offset};
+}
+
+DMFile::MetaBlockHandle DMFile::writeColumnCodecToBuffer(WriteBuffer & buffer)
+{
+    auto offset = buffer.count();
+    dtpb::ColumnCodecs codecs;
+    for (const auto & [id, stat] : column_stats)
+    {
+        auto * codec = codecs.add_codec();
+        codec->set_col_id(id);
+        codec->set_compression_method(static_cast<UInt64>(stat.compression_method));
+        codec->set_data_type(static_cast<UInt64>(stat.compression_data_type));
+    }
+    String s;
+    codecs.SerializeToString(&s);
+    writeString(s.data(), s.size(), buffer);
+    return MetaBlockHandle{MetaBlockType::ColumnCodec, offset, buffer.count() - offset};
+}
+
 void DMFile::finalizeMetaV2(WriteBuffer & buffer)
 {
     auto tmp_buffer = WriteBufferFromOwnString{};
-    std::array meta_block_handles = {
+    std::vector<MetaBlockHandle> meta_block_handles = {
         writeSLPackStatToBuffer(tmp_buffer),
         writeSLPackPropertyToBuffer(tmp_buffer),
         writeColumnStatToBuffer(tmp_buffer),
         writeMergedSubFilePosotionsToBuffer(tmp_buffer),
     };
-    writePODBinary(meta_block_handles, tmp_buffer);
+    // Keep the meta readable by the older versions if there is no bloom filter.
+    bool has_bloom_filter = std::any_of(column_stats.begin(), column_stats.end(), [](const auto & c) { return c.second.bloom_filter_bytes > 0; });
+    if (has_bloom_filter)
+        meta_block_handles.push_back(writeColumnBloomFilterToBuffer(tmp_buffer));
+    bool has_lightweight_codec = std::any_of(column_stats.begin(), column_stats.end(), [](const auto & c) {
+        return c.second.compression_method == CompressionMethod::Lightweight;
+    });
+    if (has_lightweight_codec)
+        meta_block_handles.push_back(writeColumnCodecToBuffer(tmp_buffer));
+    for (const auto & handle : meta_block_handles)
+        writePODBinary(handle, tmp_buffer);
     writeIntBinary(static_cast<UInt64>(meta_block_handles.size()), tmp_buffer);
     writeIntBinary(version, tmp_buffer);
 
@@ -954,6 +1050,9 @@ void DMFile::parseMetaV2(std::string_view buffer)
     ptr = ptr - sizeof(UInt64);
     auto meta_block_handle_count = *(reinterpret_cast<const UInt64 *>(ptr));
 
+    // The handles are parsed in reverse order, but the bloom filter and codec blocks depend on the column stats.
+    std::string_view column_bloom_filter_block;
+    std::string_view column_codec_block;
     for (UInt64 i = 0; i < meta_block_handle_count; ++i)
     {
         ptr = ptr - sizeof(MetaBlockHandle);
@@ -972,10 +1071,20 @@ void DMFile::parseMetaV2(std::string_view buffer)
         case MetaBlockType::MergedSubFilePos:
             parseMergedSubFilePos(buffer.substr(handle->offset, handle->size));
             break;
+        case MetaBlockType::ColumnBloomFilter:
+            column_bloom_filter_block = buffer.substr(handle->offset, handle->size);
+            break;
+        case MetaBlockType::ColumnCodec:
+            column_codec_block = buffer.substr(handle->offset, handle->size);
+            break;
         default:
             throw Exception(ErrorCodes::INCORRECT_DATA, "MetaBlockType {} is not recognized", magic_enum::enum_name(handle->type));
         }
     }
+    if (!column_bloom_filter_block.empty())
+        parseColumnBloomFilter(column_bloom_filter_block);
+    if (!column_codec_block.empty())
+        parseColumnCodec(column_codec_block);
 }
 
 void DMFile::parseColumnStat(std::string_view buffer)
@@ -1012,6 +1121,37 @@ void DMFile::parseMergedSubFilePos(std::string_view buffer)
     }
 }
 
+void DMFile::parseColumnBloomFilter(std::string_view buffer)
+{
+    ReadBufferFromString rbuf(buffer);
+    UInt64 count;
+    readIntBinary(count, rbuf);
+    for (UInt64 i = 0; i < count; ++i)
+    {
+        ColId col_id;
+        size_t bytes;
+        readIntBinary(col_id, rbuf);
+        readIntBinary(bytes, rbuf);
+        if (auto itr = column_stats.find(col_id); itr != column_stats.end())
+            itr->second.bloom_filter_bytes = bytes;
+    }
+}
+
+void DMFile::parseColumnCodec(std::string_view buffer)
+{
+    dtpb::ColumnCodecs codecs;
+    if (unlikely(!codecs.ParseFromArray(buffer.data(), buffer.size())))
+        throw Exception(ErrorCodes::INCORRECT_DATA, "Failed to parse column codecs of {}", path());
+    for (const auto & codec : codecs.codec())
+    {
+        if (auto itr = column_stats.find(codec.col_id()); itr != column_stats.end())
+        {
+            itr->second.compression_method = static_cast<CompressionMethod>(codec.compression_method());
+            itr->second.compression_data_type = static_cast<CompressionDataType>(codec.data_type());
+        }
+    }
+}
+
 void DMFile::parsePackProperty(std::string_view buffer)
 {
     const auto * pp = reinterpret_cast<const PackProperty *>(buffer.data());
@@ -1093,6 +1233,10 @@ void DMFile::listFilesOfColumn(ColId col_id, const ColumnStat & stat, std::funct
     {
         handle(colIndexFileName(name_base), stat.index_bytes);
     }
+    if (stat.bloom_filter_bytes > 0)
+    {
+        handle(colBloomFilterFileName(name_base), stat.bloom_filter_bytes);
+    }
     if (stat.type->isNullable())
     {
         auto null_name_base = getFileNameBase(col_id, {IDataType::Substream::NullMap});
@@ -1198,6 +1342,10 @@ UInt64 DMFile::getFileSize(ColId col_id, const String & filename) const
     {
         return itr->second.index_bytes;
     }
+    else if (endsWith(filename, details::BLOOM_FILTER_FILE_SUFFIX))
+    {
+        return itr->second.bloom_filter_bytes;
+    }
     else if (endsWith(filename, ".null.dat"))
     {
         return itr->second.nullmap_data_bytes;
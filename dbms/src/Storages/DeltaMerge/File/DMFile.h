@@ -174,6 +174,10 @@ public:
         PackProperty,
         ColumnStat,
         MergedSubFilePos,
+        // Only written when some columns have bloom filter index
+        ColumnBloomFilter,
+        // Only written when some columns use lightweight compression
+        ColumnCodec,
     };
     struct MetaBlockHandle
     {
@@ -373,22 +377,28 @@ public:
     using FileNameBase = String;
     size_t colIndexSizeByName(const FileNameBase & file_name_base) const { return Poco::File(colIndexPath(file_name_base)).getSize(); }
     size_t colDataSizeByName(const FileNameBase & file_name_base) const { return Poco::File(colDataPath(file_name_base)).getSize(); }
+    size_t colBloomFilterSizeByName(const FileNameBase & file_name_base) const { return Poco::File(colBloomFilterPath(file_name_base)).getSize(); }
     size_t colIndexSize(ColId id);
+    size_t colBloomFilterSize(ColId id);
     size_t colDataSize(ColId id, bool is_null_map);
 
     String colDataPath(const FileNameBase & file_name_base) const { return subFilePath(colDataFileName(file_name_base)); }
     String colIndexPath(const FileNameBase & file_name_base) const { return subFilePath(colIndexFileName(file_name_base)); }
     String colMarkPath(const FileNameBase & file_name_base) const { return subFilePath(colMarkFileName(file_name_base)); }
+    String colBloomFilterPath(const FileNameBase & file_name_base) const { return subFilePath(colBloomFilterFileName(file_name_base)); }
 
     String colIndexCacheKey(const FileNameBase & file_name_base) const;
     String colMarkCacheKey(const FileNameBase & file_name_base) const;
+    String colBloomFilterCacheKey(const FileNameBase & file_name_base) const;
 
     bool isColIndexExist(const ColId & col_id) const;
+    bool isColBloomFilterExist(const ColId & col_id) const;
 
     String encryptionBasePath() const;
     EncryptionPath encryptionDataPath(const FileNameBase & file_name_base) const;
     EncryptionPath encryptionIndexPath(const FileNameBase & file_name_base) const;
     EncryptionPath encryptionMarkPath(const FileNameBase & file_name_base) const;
+    EncryptionPath encryptionBloomFilterPath(const FileNameBase & file_name_base) const;
     EncryptionPath encryptionMetaPath() const;
     EncryptionPath encryptionPackStatPath() const;
     EncryptionPath encryptionPackPropertyPath() const;
@@ -410,6 +420,7 @@ public:
     static String colDataFileName(const FileNameBase & file_name_base);
     static String colIndexFileName(const FileNameBase & file_name_base);
     static String colMarkFileName(const FileNameBase & file_name_base);
+    static String colBloomFilterFileName(const FileNameBase & file_name_base);
 
     using OffsetAndSize = std::tuple<size_t, size_t>;
     OffsetAndSize writeMetaToBuffer(WriteBuffer & buffer);
@@ -456,10 +467,14 @@ public:
     MetaBlockHandle writeSLPackPropertyToBuffer(WriteBuffer & buffer);
     MetaBlockHandle writeColumnStatToBuffer(WriteBuffer & buffer);
     MetaBlockHandle writeMergedSubFilePosotionsToBuffer(WriteBuffer & buffer);
+    MetaBlockHandle writeColumnBloomFilterToBuffer(WriteBuffer & buffer);
+    MetaBlockHandle writeColumnCodecToBuffer(WriteBuffer & buffer);
     std::vector<char> readMetaV2(const FileProviderPtr & file_provider);
     void parseMetaV2(std::string_view buffer);
     void parseColumnStat(std::string_view buffer);
     void parseMergedSubFilePos(std::string_view buffer);
+    void parseColumnBloomFilter(std::string_view buffer);
+    void parseColumnCodec(std::string_view buffer);
     void parsePackProperty(std::string_view buffer);
     void parsePackStat(std::string_view buffer);
     void finalizeDirName();
@@ -483,6 +498,7 @@ public:
     PackProperties pack_properties;
     ColumnStats column_stats;
     std::unordered_set<ColId> column_indices;
+    std::unordered_set<ColId> column_bloom_filters;
 
     Status status;
     DMConfigurationOpt configuration; // configuration
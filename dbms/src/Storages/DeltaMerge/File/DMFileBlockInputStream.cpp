@@ -24,7 +24,7 @@ DMFileBlockInputStreamBuilder::DMFileBlockInputStreamBuilder(const Context & con
 {
     // init from global context
     const auto & global_context = context.getGlobalContext();
-    setCaches(global_context.getMarkCache(), global_context.getMinMaxIndexCache());
+    setCaches(global_context.getMarkCache(), global_context.getMinMaxIndexCache(), global_context.getBloomFilterIndexCache());
     // init from settings
     setFromSettings(context.getSettingsRef());
 }
@@ -43,6 +43,7 @@ DMFileBlockInputStreamPtr DMFileBlockInputStreamBuilder::build(const DMFilePtr &
     DMFilePackFilter pack_filter = DMFilePackFilter::loadFrom(
         dmfile,
         index_cache,
+        equal_index_cache,
         /*set_cache_if_miss*/ true,
         rowkey_ranges,
         rs_filter,
@@ -72,10 +73,16 @@ DMFileBlockInputStreamPtr DMFileBlockInputStreamBuilder::build(const DMFilePtr &
         read_limiter,
         rows_threshold_per_read,
         read_one_pack_every_time,
+        prefetch_packs,
         tracing_id,
         enable_read_thread,
+        enable_low_cardinality,
         scan_context);
 
+    // Packs are shared by `DMFileReaderPool`, which only works with read threads.
+    if (enable_scan_sharing && enable_read_thread && !read_one_pack_every_time)
+        reader.startCircularScan(DMFileReaderPool::instance().getScanningPackId(reader.path()));
+
     return std::make_shared<DMFileBlockInputStream>(std::move(reader), enable_read_thread);
 }
 } // namespace DB::DM
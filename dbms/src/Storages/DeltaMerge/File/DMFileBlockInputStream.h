@@ -153,6 +153,24 @@ public:
         return *this;
     }
 
+    // Try to return low-cardinality string columns as ColumnLowCardinality.
+    // Only enable it when all the consumers of the stream can handle ColumnLowCardinality,
+    // e.g. the columns are only filtered and then aggregated.
+    DMFileBlockInputStreamBuilder & enableLowCardinality(bool enable_low_cardinality_)
+    {
+        enable_low_cardinality = enable_low_cardinality_;
+        return *this;
+    }
+
+    // Start reading from the position of other readers which are scanning the same DMFile and then wrap around,
+    // so that the decoded packs can be shared with them. Only enable it when the consumers of the stream do not
+    // depend on the order of blocks, and the stream is not read by `skipNextBlock` or `readWithFilter`.
+    DMFileBlockInputStreamBuilder & enableScanSharing(bool enable_scan_sharing_)
+    {
+        enable_scan_sharing = enable_scan_sharing_;
+        return *this;
+    }
+
 private:
     // These methods are called by the ctor
 
@@ -162,12 +180,14 @@ private:
         aio_threshold = settings.min_bytes_to_use_direct_io;
         max_read_buffer_size = settings.max_read_buffer_size;
         enable_read_thread = settings.dt_enable_read_thread;
+        prefetch_packs = settings.dt_read_prefetch_packs;
         return *this;
     }
-    DMFileBlockInputStreamBuilder & setCaches(const MarkCachePtr & mark_cache_, const MinMaxIndexCachePtr & index_cache_)
+    DMFileBlockInputStreamBuilder & setCaches(const MarkCachePtr & mark_cache_, const MinMaxIndexCachePtr & index_cache_, const BloomFilterIndexCachePtr & equal_index_cache_)
     {
         mark_cache = mark_cache_;
         index_cache = index_cache_;
+        equal_index_cache = equal_index_cache_;
         return *this;
     }
 
@@ -186,6 +206,7 @@ private:
     IdSetPtr read_packs{};
     MarkCachePtr mark_cache;
     MinMaxIndexCachePtr index_cache;
+    BloomFilterIndexCachePtr equal_index_cache;
     // column cache
     bool enable_column_cache = false;
     ColumnCachePtr column_cache;
@@ -194,7 +215,10 @@ private:
     size_t max_read_buffer_size{};
     size_t rows_threshold_per_read = DMFILE_READ_ROWS_THRESHOLD;
     bool read_one_pack_every_time = false;
+    size_t prefetch_packs = 0;
     bool enable_read_thread = false;
+    bool enable_low_cardinality = false;
+    bool enable_scan_sharing = false;
     String tracing_id;
 };
 
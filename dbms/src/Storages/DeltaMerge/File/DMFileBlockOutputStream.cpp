@@ -28,7 +28,8 @@ DMFileBlockOutputStream::DMFileBlockOutputStream(const Context & context,
         DMFileWriter::Options{
             CompressionSettings(context.getSettingsRef().dt_compression_method, context.getSettingsRef().dt_compression_level),
             context.getSettingsRef().min_compress_block_size,
-            context.getSettingsRef().max_compress_block_size})
+            context.getSettingsRef().max_compress_block_size,
+            context.getSettingsRef().dt_enable_bloom_filter_index})
 {
 }
 
@@ -47,6 +47,7 @@ public:
     static DMFilePackFilter loadFrom(
         const DMFilePtr & dmfile,
         const MinMaxIndexCachePtr & index_cache,
+        const BloomFilterIndexCachePtr & equal_index_cache,
         bool set_cache_if_miss,
         const RowKeyRanges & rowkey_ranges,
         const RSOperatorPtr & filter,
@@ -56,11 +57,27 @@ public:
         const ScanContextPtr & scan_context,
         const String & tracing_id)
     {
-        auto pack_filter = DMFilePackFilter(dmfile, index_cache, set_cache_if_miss, rowkey_ranges, filter, read_packs, file_provider, read_limiter, scan_context, tracing_id);
+        auto pack_filter = DMFilePackFilter(dmfile, index_cache, equal_index_cache, set_cache_if_miss, rowkey_ranges, filter, read_packs, file_provider, read_limiter, scan_context, tracing_id);
         pack_filter.init();
         return pack_filter;
     }
 
+    /// Load the indexes of all columns of the DMFile into the caches, used to warm up the caches in background.
+    static void loadIndexesToCache(
+        const DMFilePtr & dmfile,
+        const MinMaxIndexCachePtr & index_cache,
+        const BloomFilterIndexCachePtr & equal_index_cache,
+        const FileProviderPtr & file_provider,
+        const ReadLimiterPtr & read_limiter)
+    {
+        ColumnIndexes indexes;
+        for (const auto & cd : dmfile->getColumnDefines())
+        {
+            if (dmfile->isColIndexExist(cd.id) || dmfile->isColBloomFilterExist(cd.id))
+                loadIndex(indexes, dmfile, file_provider, index_cache, equal_index_cache, /*set_cache_if_miss*/ true, cd.id, read_limiter);
+        }
+    }
+
     inline const std::vector<RSResult> & getHandleRes() const { return handle_res; }
     inline const std::vector<UInt8> & getUsePacksConst() const { return use_packs; }
     inline std::vector<UInt8> & getUsePacks() { return use_packs; }
@@ -109,6 +126,7 @@ public:
 private:
     DMFilePackFilter(const DMFilePtr & dmfile_,
                      const MinMaxIndexCachePtr & index_cache_,
+                     const BloomFilterIndexCachePtr & equal_index_cache_,
                      bool set_cache_if_miss_,
                      const RowKeyRanges & rowkey_ranges_, // filter by handle range
                      const RSOperatorPtr & filter_, // filter by push down where clause
@@ -119,6 +137,7 @@ private:
                      const String & tracing_id)
         : dmfile(dmfile_)
         , index_cache(index_cache_)
+        , equal_index_cache(equal_index_cache_)
         , set_cache_if_miss(set_cache_if_miss_)
         , rowkey_ranges(rowkey_ranges_)
         , filter(filter_)
@@ -224,10 +243,62 @@ private:
                   pack_count);
     }
 
+    // Open the index file and read it by `read_func(buf, bytes_limit)`.
+    template <typename ReadFunc>
+    static auto readIndexFile(const DMFilePtr & dmfile,
+                              const FileProviderPtr & file_provider,
+                              const String & path,
+                              const EncryptionPath & encryption_path,
+                              size_t file_size,
+                              const ReadLimiterPtr & read_limiter,
+                              ReadFunc && read_func)
+    {
+        if (!dmfile->configuration)
+        {
+            auto index_buf = ReadBufferFromFileProvider(
+                file_provider,
+                path,
+                encryption_path,
+                std::min(static_cast<size_t>(DBMS_DEFAULT_BUFFER_SIZE), file_size),
+                read_limiter);
+            return read_func(index_buf, file_size);
+        }
+        else
+        {
+            auto index_buf = createReadBufferFromFileBaseByFileProvider(file_provider,
+                                                                        path,
+                                                                        encryption_path,
+                                                                        file_size,
+                                                                        read_limiter,
+                                                                        dmfile->configuration->getChecksumAlgorithm(),
+                                                                        dmfile->configuration->getChecksumFrameLength());
+            auto header_size = dmfile->configuration->getChecksumHeaderLength();
+            auto frame_total_size = dmfile->configuration->getChecksumFrameLength() + header_size;
+            auto frame_count = file_size / frame_total_size + (file_size % frame_total_size != 0);
+            return read_func(*index_buf, file_size - header_size * frame_count);
+        }
+    }
+
+    template <typename Cache, typename LoadFunc>
+    static auto getOrLoad(const Cache & cache, bool set_cache_if_miss, const String & key, LoadFunc && load)
+    {
+        if (cache && set_cache_if_miss)
+            return cache->getOrSet(key, load);
+
+        // try load from the cache first
+        typename Cache::element_type::MappedPtr index;
+        if (cache)
+            index = cache->get(key);
+        if (index == nullptr)
+            index = load();
+        return index;
+    }
+
     static void loadIndex(ColumnIndexes & indexes,
                           const DMFilePtr & dmfile,
                           const FileProviderPtr & file_provider,
                           const MinMaxIndexCachePtr & index_cache,
+                          const BloomFilterIndexCachePtr & equal_index_cache,
                           bool set_cache_if_miss,
                           ColId col_id,
                           const ReadLimiterPtr & read_limiter)
@@ -235,50 +306,45 @@ private:
         const auto & type = dmfile->getColumnStat(col_id).type;
         const auto file_name_base = DMFile::getFileNameBase(col_id);
 
-        auto load = [&]() {
-            auto index_file_size = dmfile->colIndexSize(col_id);
-            if (index_file_size == 0)
-                return std::make_shared<MinMaxIndex>(*type);
-            auto index_guard = S3::S3RandomAccessFile::setReadFileInfo(dmfile->getReadFileInfo(col_id, dmfile->colIndexFileName(file_name_base)));
-            if (!dmfile->configuration)
-            {
-                auto index_buf = ReadBufferFromFileProvider(
+        MinMaxIndexPtr minmax_index;
+        if (dmfile->isColIndexExist(col_id))
+        {
+            auto load = [&]() {
+                auto index_file_size = dmfile->colIndexSize(col_id);
+                if (index_file_size == 0)
+                    return std::make_shared<MinMaxIndex>(*type);
+                auto index_guard = S3::S3RandomAccessFile::setReadFileInfo(dmfile->getReadFileInfo(col_id, dmfile->colIndexFileName(file_name_base)));
+                return readIndexFile(
+                    dmfile,
                     file_provider,
                     dmfile->colIndexPath(file_name_base),
                     dmfile->encryptionIndexPath(file_name_base),
-                    std::min(static_cast<size_t>(DBMS_DEFAULT_BUFFER_SIZE), index_file_size),
-                    read_limiter);
-                return MinMaxIndex::read(*type, index_buf, index_file_size);
-            }
-            else
-            {
-                auto index_buf = createReadBufferFromFileBaseByFileProvider(file_provider,
-                                                                            dmfile->colIndexPath(file_name_base),
-                                                                            dmfile->encryptionIndexPath(file_name_base),
-                                                                            index_file_size,
-                                                                            read_limiter,
-                                                                            dmfile->configuration->getChecksumAlgorithm(),
-                                                                            dmfile->configuration->getChecksumFrameLength());
-                auto header_size = dmfile->configuration->getChecksumHeaderLength();
-                auto frame_total_size = dmfile->configuration->getChecksumFrameLength() + header_size;
-                auto frame_count = index_file_size / frame_total_size + (index_file_size % frame_total_size != 0);
-                return MinMaxIndex::read(*type, *index_buf, index_file_size - header_size * frame_count);
-            }
-        };
-        MinMaxIndexPtr minmax_index;
-        if (index_cache && set_cache_if_miss)
-        {
-            minmax_index = index_cache->getOrSet(dmfile->colIndexCacheKey(file_name_base), load);
+                    index_file_size,
+                    read_limiter,
+                    [&](ReadBuffer & buf, size_t bytes_limit) { return MinMaxIndex::read(*type, buf, bytes_limit); });
+            };
+            minmax_index = getOrLoad(index_cache, set_cache_if_miss, dmfile->colIndexCacheKey(file_name_base), load);
         }
-        else
+
+        BloomFilterIndexPtr bloom_filter;
+        if (dmfile->isColBloomFilterExist(col_id))
         {
-            // try load from the cache first
-            if (index_cache)
-                minmax_index = index_cache->get(dmfile->colIndexCacheKey(file_name_base));
-            if (minmax_index == nullptr)
-                minmax_index = load();
+            auto load = [&]() {
+                auto bf_file_size = dmfile->colBloomFilterSize(col_id);
+                auto bf_guard = S3::S3RandomAccessFile::setReadFileInfo(dmfile->getReadFileInfo(col_id, dmfile->colBloomFilterFileName(file_name_base)));
+                return readIndexFile(
+                    dmfile,
+                    file_provider,
+                    dmfile->colBloomFilterPath(file_name_base),
+                    dmfile->encryptionBloomFilterPath(file_name_base),
+                    bf_file_size,
+                    read_limiter,
+                    [](ReadBuffer & buf, size_t bytes_limit) { return BloomFilterIndex::read(buf, bytes_limit); });
+            };
+            bloom_filter = getOrLoad(equal_index_cache, set_cache_if_miss, dmfile->colBloomFilterCacheKey(file_name_base), load);
         }
-        indexes.emplace(col_id, RSIndex(type, minmax_index));
+
+        indexes.emplace(col_id, RSIndex(type, minmax_index, bloom_filter));
     }
 
     void tryLoadIndex(const ColId col_id)
@@ -286,11 +352,11 @@ private:
         if (param.indexes.count(col_id))
             return;
 
-        if (!dmfile->isColIndexExist(col_id))
+        if (!dmfile->isColIndexExist(col_id) && !dmfile->isColBloomFilterExist(col_id))
             return;
 
         Stopwatch watch;
-        loadIndex(param.indexes, dmfile, file_provider, index_cache, set_cache_if_miss, col_id, read_limiter);
+        loadIndex(param.indexes, dmfile, file_provider, index_cache, equal_index_cache, set_cache_if_miss, col_id, read_limiter);
 
         scan_context->total_dmfile_rough_set_index_load_time_ns += watch.elapsed();
     }
@@ -298,6 +364,7 @@ private:
 private:
     DMFilePtr dmfile;
     MinMaxIndexCachePtr index_cache;
+    BloomFilterIndexCachePtr equal_index_cache;
     bool set_cache_if_miss;
     RowKeyRanges rowkey_ranges;
     RSOperatorPtr filter;
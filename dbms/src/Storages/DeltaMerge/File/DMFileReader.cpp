@@ -12,10 +12,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/ColumnLowCardinality.h>
+#include <Columns/ColumnNullable.h>
 #include <Columns/ColumnsCommon.h>
 #include <Common/CurrentMetrics.h>
+#include <Common/IOUring.h>
 #include <Common/Stopwatch.h>
+#include <Common/TiFlashMetrics.h>
 #include <Common/escapeForFileName.h>
+#include <Common/typeid_cast.h>
+#include <DataTypes/DataTypeNullable.h>
 #include <DataTypes/IDataType.h>
 #include <Encryption/FileProvider.h>
 #include <Encryption/createReadBufferFromFileBaseByFileProvider.h>
@@ -94,7 +100,7 @@ DMFileReader::Stream::Stream(
         marks = mark_load();
 
     auto is_null_map = endsWith(file_name_base, ".null");
-    size_t data_file_size = reader.dmfile->colDataSize(col_id, is_null_map);
+    data_file_size = reader.dmfile->colDataSize(col_id, is_null_map);
     size_t packs = reader.dmfile->getPacks();
     size_t buffer_size = 0;
     size_t estimated_size = 0;
@@ -173,6 +179,11 @@ DMFileReader::Stream::Stream(
     }
 }
 
+inline bool isExtraColumn(const ColumnDefine & cd)
+{
+    return cd.id == EXTRA_HANDLE_COLUMN_ID || cd.id == VERSION_COLUMN_ID || cd.id == TAG_COLUMN_ID;
+}
+
 DMFileReader::DMFileReader(
     const DMFilePtr & dmfile_,
     const ColumnDefines & read_columns_,
@@ -194,8 +205,10 @@ DMFileReader::DMFileReader(
     const ReadLimiterPtr & read_limiter,
     size_t rows_threshold_per_read_,
     bool read_one_pack_every_time_,
+    size_t prefetch_packs_,
     const String & tracing_id_,
     bool enable_col_sharing_cache,
+    bool enable_low_cardinality,
     const ScanContextPtr & scan_context_)
     : dmfile(dmfile_)
     , read_columns(read_columns_)
@@ -212,6 +225,8 @@ DMFileReader::DMFileReader(
     , column_cache(column_cache_)
     , scan_context(scan_context_)
     , rows_threshold_per_read(rows_threshold_per_read_)
+    , scan_end_pack_id(pack_filter.getUsePacksConst().size())
+    , prefetch_packs(prefetch_packs_)
     , file_provider(file_provider_)
     , log(Logger::get(tracing_id_))
 {
@@ -245,27 +260,79 @@ DMFileReader::DMFileReader(
             last_read_from_cache[cd.id] = false;
         }
     }
+    low_cardinality_states.resize(read_columns.size(), LowCardinalityState::Disabled);
+    if (enable_low_cardinality)
+    {
+        for (size_t i = 0; i < read_columns.size(); ++i)
+        {
+            const auto & cd = read_columns[i];
+            if (!isExtraColumn(cd) && removeNullable(cd.type)->isString())
+                low_cardinality_states[i] = LowCardinalityState::Undecided;
+        }
+    }
 }
 
 bool DMFileReader::shouldSeek(size_t pack_id) const
 {
+    // The first pack of each round of a circular scan does not follow the last read pack.
+    if (circular_start_pack_id != 0 && (pack_id == 0 || pack_id == circular_start_pack_id))
+        return true;
     // If current pack is the first one, or we just finished reading the last pack, then no need to seek.
     return pack_id != 0 && !pack_filter.getUsePacksConst()[pack_id - 1];
 }
 
+void DMFileReader::startCircularScan(size_t start_pack_id)
+{
+    RUNTIME_CHECK(next_pack_id == 0 && next_row_offset == 0, next_pack_id, next_row_offset);
+    if (start_pack_id == 0 || start_pack_id >= scan_end_pack_id)
+        return;
+
+    const auto & pack_stats = dmfile->getPackStats();
+    for (size_t i = 0; i < start_pack_id; ++i)
+        next_row_offset += pack_stats[i].rows;
+    next_pack_id = start_pack_id;
+    circular_start_pack_id = start_pack_id;
+    prefetched_pack_id = start_pack_id;
+    GET_METRIC(tiflash_storage_read_thread_counter, type_scan_sharing_attach).Increment();
+    LOG_DEBUG(log, "Start circular scan from pack {}, total packs {}, dmfile={}", start_pack_id, scan_end_pack_id, path());
+}
+
+bool DMFileReader::wrapCircularScan()
+{
+    if (circular_start_pack_id == 0 || scan_end_pack_id == circular_start_pack_id)
+        return false;
+
+    // The packs after `circular_start_pack_id` are all read, stop at `circular_start_pack_id` this round.
+    // The packs put into `col_data_cache` before are all consumed or deleted since `next_pack_id` reaches the end.
+    scan_end_pack_id = circular_start_pack_id;
+    next_pack_id = 0;
+    next_row_offset = 0;
+    prefetched_pack_id = 0;
+    return true;
+}
+
+std::optional<size_t> DMFileReader::getScanningPackId() const
+{
+    if (next_pack_id < scan_end_pack_id)
+        return next_pack_id;
+    return std::nullopt;
+}
+
 bool DMFileReader::getSkippedRows(size_t & skip_rows)
 {
     skip_rows = 0;
     const auto & use_packs = pack_filter.getUsePacksConst();
     const auto & pack_stats = dmfile->getPackStats();
-    for (; next_pack_id < use_packs.size() && !use_packs[next_pack_id]; ++next_pack_id)
+    for (; next_pack_id < scan_end_pack_id && !use_packs[next_pack_id]; ++next_pack_id)
     {
         skip_rows += pack_stats[next_pack_id].rows;
         scan_context->total_dmfile_skipped_packs += 1;
         scan_context->total_dmfile_skipped_rows += pack_stats[next_pack_id].rows;
     }
     next_row_offset += skip_rows;
-    return next_pack_id < use_packs.size();
+    if (next_pack_id >= scan_end_pack_id && wrapCircularScan())
+        return getSkippedRows(skip_rows);
+    return next_pack_id < scan_end_pack_id;
 }
 
 size_t DMFileReader::skipNextBlock()
@@ -286,7 +353,8 @@ size_t DMFileReader::skipNextBlock()
     size_t start_pack_id = next_pack_id;
     const auto & pack_stats = dmfile->getPackStats();
     size_t read_rows = 0;
-    for (; next_pack_id < use_packs.size() && use_packs[next_pack_id] && read_rows < rows_threshold_per_read; ++next_pack_id)
+    // Like `read`, stop at the end of current round of a circular scan.
+    for (; next_pack_id < scan_end_pack_id && use_packs[next_pack_id] && read_rows < rows_threshold_per_read; ++next_pack_id)
     {
         if (read_pack_limit != 0 && next_pack_id - start_pack_id >= read_pack_limit)
             break;
@@ -411,14 +479,56 @@ Block DMFileReader::readWithFilter(const IColumn::Filter & filter)
     return res;
 }
 
-inline bool isExtraColumn(const ColumnDefine & cd)
+inline bool isCacheableColumn(const ColumnDefine & cd)
 {
-    return cd.id == EXTRA_HANDLE_COLUMN_ID || cd.id == VERSION_COLUMN_ID || cd.id == TAG_COLUMN_ID;
+    return cd.id == EXTRA_HANDLE_COLUMN_ID || cd.id == VERSION_COLUMN_ID;
 }
 
-inline bool isCacheableColumn(const ColumnDefine & cd)
+void DMFileReader::prefetchPacks(size_t start_pack_id, size_t end_pack_id)
 {
-    return cd.id == EXTRA_HANDLE_COLUMN_ID || cd.id == VERSION_COLUMN_ID;
+    // Only prefetch when the packs to read are not prefetched, so that the prefetches are submitted in batches.
+    if (prefetch_packs == 0 || end_pack_id <= prefetched_pack_id || !IOUring::isEnabled())
+        return;
+
+    const auto & use_packs = pack_filter.getUsePacksConst();
+    const size_t packs = use_packs.size();
+    const size_t begin = std::max(start_pack_id, prefetched_pack_id);
+    const size_t end = std::min(scan_end_pack_id, end_pack_id + prefetch_packs);
+    prefetched_pack_id = end;
+
+    std::vector<IOUring::PrefetchRequest> requests;
+    for (const auto & [stream_name, stream] : column_streams)
+    {
+        for (size_t i = begin; i < end;)
+        {
+            if (!use_packs[i])
+            {
+                ++i;
+                continue;
+            }
+            size_t range_end = i + 1;
+            while (range_end < end && use_packs[range_end])
+                ++range_end;
+
+            // The last pack may end inside the compressed block of the next pack, read the block too.
+            size_t block_end = range_end;
+            if (block_end < packs && stream->getOffsetInDecompressedBlock(block_end) > 0)
+            {
+                const size_t last_offset_in_file = stream->getOffsetInFile(block_end);
+                while (block_end < packs && stream->getOffsetInFile(block_end) == last_offset_in_file)
+                    ++block_end;
+            }
+            const size_t end_offset_in_file = block_end == packs ? stream->data_file_size : stream->getOffsetInFile(block_end);
+
+            auto request = stream->buf->getPrefetchRequest(stream->getOffsetInFile(i), end_offset_in_file);
+            // Not a local file
+            if (request.fd < 0)
+                return;
+            requests.push_back(request);
+            i = range_end;
+        }
+    }
+    IOUring::prefetchBatch(requests);
 }
 
 Block DMFileReader::read()
@@ -433,7 +543,7 @@ Block DMFileReader::read()
     getSkippedRows(skip_rows);
 
     const auto & use_packs = pack_filter.getUsePacksConst();
-    if (next_pack_id >= use_packs.size())
+    if (next_pack_id >= scan_end_pack_id)
         return {};
     // Find max continuing rows we can read.
     size_t start_pack_id = next_pack_id;
@@ -452,7 +562,7 @@ Block DMFileReader::read()
 
     const std::vector<RSResult> & handle_res = pack_filter.getHandleRes(); // alias of handle_res in pack_filter
     RSResult expected_handle_res = handle_res[next_pack_id];
-    for (; next_pack_id < use_packs.size() && use_packs[next_pack_id] && read_rows < rows_threshold_per_read; ++next_pack_id)
+    for (; next_pack_id < scan_end_pack_id && use_packs[next_pack_id] && read_rows < rows_threshold_per_read; ++next_pack_id)
     {
         if (read_pack_limit != 0 && next_pack_id - start_pack_id >= read_pack_limit)
             break;
@@ -486,6 +596,8 @@ Block DMFileReader::read()
     scan_context->total_dmfile_scanned_packs += read_packs;
     scan_context->total_dmfile_scanned_rows += read_rows;
 
+    prefetchPacks(start_pack_id, next_pack_id);
+
     // TODO: this will need better algorithm: we should separate those packs which can and can not do clean read.
     bool do_clean_read_on_normal_mode = enable_handle_clean_read && expected_handle_res == All && not_clean_rows == 0 && (!is_fast_scan);
 
@@ -623,6 +735,8 @@ Block DMFileReader::read()
                         ColumnPtr column;
                         readColumn(cd, column, start_pack_id, read_packs, read_rows, skip_packs_by_column[i]);
                         auto converted_column = convertColumnByColumnDefineIfNeed(data_type, std::move(column), cd);
+                        if (low_cardinality_states[i] != LowCardinalityState::Disabled)
+                            converted_column = tryEncodeLowCardinality(i, std::move(converted_column));
 
                         res.insert(ColumnWithTypeAndName{std::move(converted_column), cd.type, cd.name, cd.id});
                         skip_packs_by_column[i] = 0;
@@ -654,6 +768,42 @@ Block DMFileReader::read()
     return res;
 }
 
+ColumnPtr DMFileReader::tryEncodeLowCardinality(size_t column_index, ColumnPtr && column)
+{
+    // A dictionary only pays off when each distinct value is repeated several times in the block.
+    static constexpr size_t MIN_ROWS_TO_ENCODE = 64;
+    static constexpr size_t MIN_ROWS_PER_DISTINCT_VALUE = 8;
+
+    // The decision is made by the first block of the column and then kept for the whole reader,
+    // so that all the blocks returned by this reader have the same column structure. Otherwise
+    // stacking the blocks (e.g. in `readWithFilter`) would mix ColumnString and ColumnLowCardinality.
+    auto & state = low_cardinality_states[column_index];
+    const size_t rows = column->size();
+    const auto [nested_column, null_map] = removeNullable(column.get());
+    const auto * string_column = typeid_cast<const ColumnString *>(nested_column);
+    if (state == LowCardinalityState::Undecided && (rows < MIN_ROWS_TO_ENCODE || !string_column))
+    {
+        state = LowCardinalityState::Disabled;
+        return std::move(column);
+    }
+    RUNTIME_CHECK_MSG(string_column, "Expect ColumnString to encode, column={} dmfile={}", read_columns[column_index].name, path());
+
+    // Once encoding is chosen, the following blocks are always encoded whatever their cardinality is.
+    const size_t max_dictionary_size = state == LowCardinalityState::Undecided ? rows / MIN_ROWS_PER_DISTINCT_VALUE : rows;
+    auto encoded = ColumnLowCardinality::tryEncode(*string_column, max_dictionary_size);
+    if (!encoded)
+    {
+        LOG_TRACE(log, "Do not encode column {} to low cardinality, dmfile={}", read_columns[column_index].name, path());
+        state = LowCardinalityState::Disabled;
+        return std::move(column);
+    }
+    state = LowCardinalityState::Encode;
+
+    if (null_map)
+        return ColumnNullable::create(std::move(encoded), static_cast<const ColumnNullable &>(*column).getNullMapColumnPtr());
+    return encoded;
+}
+
 void DMFileReader::readFromDisk(
     ColumnDefine & column_define,
     MutableColumnPtr & column,
@@ -723,7 +873,8 @@ void DMFileReader::addCachedPacks(ColId col_id, size_t start_pack_id, size_t pac
     {
         return;
     }
-    if (next_pack_id >= start_pack_id + pack_count)
+    // The packs are read already, or will not be read after the circular scan wraps around.
+    if (next_pack_id >= start_pack_id + pack_count || start_pack_id >= scan_end_pack_id)
     {
         col_data_cache->addStale();
     }
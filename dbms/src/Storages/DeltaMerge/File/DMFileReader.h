@@ -27,6 +27,8 @@
 #include <Storages/DeltaMerge/ScanContext.h>
 #include <Storages/MarkCache.h>
 
+#include <optional>
+
 namespace DB
 {
 namespace DM
@@ -52,6 +54,7 @@ public:
 
         double avg_size_hint;
         MarksInCompressedFilePtr marks;
+        size_t data_file_size;
 
         size_t getOffsetInFile(size_t i) const
         {
@@ -93,8 +96,12 @@ public:
         const ReadLimiterPtr & read_limiter,
         size_t rows_threshold_per_read_,
         bool read_one_pack_every_time_,
+        // Prefetch the data of the next packs in batches, 0 means no prefetch
+        size_t prefetch_packs_,
         const String & tracing_id_,
         bool enable_col_sharing_cache,
+        // Try to encode low-cardinality string columns into ColumnLowCardinality
+        bool enable_low_cardinality,
         const ScanContextPtr & scan_context_);
 
     Block getHeader() const { return toEmptyBlock(read_columns); }
@@ -120,7 +127,17 @@ public:
     }
     void addCachedPacks(ColId col_id, size_t start_pack_id, size_t pack_count, ColumnPtr & col) const;
 
+    /// Start reading from `start_pack_id` to the end of file, and then wrap around to read the packs before it.
+    /// So that it can share the decoded packs with the other readers which are scanning the same file.
+    /// Only call it before reading and when the caller does not depend on the order of packs, e.g. in fast scan.
+    void startCircularScan(size_t start_pack_id);
+    /// Returns the next pack to read if the reader is still scanning, otherwise returns std::nullopt.
+    std::optional<size_t> getScanningPackId() const;
+
 private:
+    /// Returns true if the circular scan wraps around to read the packs before `circular_start_pack_id`.
+    bool wrapCircularScan();
+
     bool shouldSeek(size_t pack_id) const;
 
     void readFromDisk(ColumnDefine & column_define,
@@ -136,6 +153,10 @@ private:
                     size_t read_rows,
                     size_t skip_packs);
     bool getCachedPacks(ColId col_id, size_t start_pack_id, size_t pack_count, size_t read_rows, ColumnPtr & col) const;
+    /// Prefetch the data of all columns in [start_pack_id, end_pack_id + prefetch_packs) that are not prefetched yet.
+    void prefetchPacks(size_t start_pack_id, size_t end_pack_id);
+    /// Returns a ColumnLowCardinality (or Nullable of it) if the column is worth dictionary encoding, otherwise returns `column`.
+    ColumnPtr tryEncodeLowCardinality(size_t column_index, ColumnPtr && column);
 
     DMFilePtr dmfile;
     ColumnDefines read_columns;
@@ -179,6 +200,14 @@ private:
 
     size_t next_pack_id = 0;
     size_t next_row_offset = 0;
+    // Stop reading at this pack. It is the number of packs, or `circular_start_pack_id` after a circular scan wraps around.
+    size_t scan_end_pack_id;
+    // The pack that a circular scan starts from, 0 means not a circular scan.
+    size_t circular_start_pack_id = 0;
+
+    const size_t prefetch_packs;
+    // The packs before it have been prefetched.
+    size_t prefetched_pack_id = 0;
 
     FileProviderPtr file_provider;
 
@@ -186,6 +215,16 @@ private:
 
     std::unique_ptr<ColumnSharingCacheMap> col_data_cache{};
     std::unordered_map<ColId, bool> last_read_from_cache{};
+
+    // Whether to dictionary encode each column of `read_columns`. It is decided by the first block
+    // of the column, and all the blocks of the column returned by this reader are encoded or not.
+    enum class LowCardinalityState : UInt8
+    {
+        Disabled,
+        Undecided,
+        Encode,
+    };
+    std::vector<LowCardinalityState> low_cardinality_states;
 };
 
 } // namespace DM
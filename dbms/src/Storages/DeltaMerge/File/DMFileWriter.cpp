@@ -48,8 +48,16 @@ DMFileWriter::DMFileWriter(const DMFilePtr & dmfile_,
         /// for handle column always generate index
         auto type = removeNullable(cd.type);
         bool do_index = cd.id == EXTRA_HANDLE_COLUMN_ID || type->isInteger() || type->isDateOrDateTime();
-        addStreams(cd.id, cd.type, do_index);
-        dmfile->column_stats.emplace(cd.id, ColumnStat{cd.id, cd.type, /*avg_size=*/0});
+        // The handle/version/tag columns are well pruned by minmax index, so skip bloom filter for them.
+        bool do_bloom_filter = options.enable_bloom_filter_index
+            && cd.id != EXTRA_HANDLE_COLUMN_ID && cd.id != VERSION_COLUMN_ID && cd.id != TAG_COLUMN_ID
+            && BloomFilterIndex::isSupportType(cd.type);
+        addStreams(cd.id, cd.type, do_index, do_bloom_filter);
+        ColumnStat stat{cd.id, cd.type, /*avg_size=*/0};
+        stat.compression_method = options.compression_settings.method;
+        if (stat.compression_method == CompressionMethod::Lightweight)
+            stat.compression_data_type = getCompressionDataType(cd.type, {});
+        dmfile->column_stats.emplace(cd.id, std::move(stat));
     }
 }
 
@@ -97,19 +105,52 @@ DMFileWriter::WriteBufferFromFileBasePtr DMFileWriter::createPackStatsFile()
                                      options.max_compress_block_size);
 }
 
-void DMFileWriter::addStreams(ColId col_id, DataTypePtr type, bool do_index)
+CompressionDataType DMFileWriter::getCompressionDataType(const DataTypePtr & type, const IDataType::SubstreamPath & substream_path)
+{
+    if (IDataType::isNullMap(substream_path))
+        return CompressionDataType::Int8;
+
+    auto nested_type = removeNullable(type);
+    if (nested_type->isString())
+        return CompressionDataType::String;
+    if (nested_type->isValueRepresentedByInteger())
+    {
+        switch (nested_type->getSizeOfValueInMemory())
+        {
+        case 1:
+            return CompressionDataType::Int8;
+        case 2:
+            return CompressionDataType::Int16;
+        case 4:
+            return CompressionDataType::Int32;
+        case 8:
+            return CompressionDataType::Int64;
+        default:
+            break;
+        }
+    }
+    return CompressionDataType::Unknown;
+}
+
+void DMFileWriter::addStreams(ColId col_id, DataTypePtr type, bool do_index, bool do_bloom_filter)
 {
     auto callback = [&](const IDataType::SubstreamPath & substream_path) {
         const auto stream_name = DMFile::getFileNameBase(col_id, substream_path);
+        // Lightweight compression chooses the encodings of each block by the values in it,
+        // so it needs to know how to interpret the data of the substream.
+        auto compression_settings = options.compression_settings;
+        if (compression_settings.method == CompressionMethod::Lightweight)
+            compression_settings.data_type = getCompressionDataType(type, substream_path);
         auto stream = std::make_unique<Stream>(
             dmfile,
             stream_name,
             type,
-            options.compression_settings,
+            compression_settings,
             options.max_compress_block_size,
             file_provider,
             write_limiter,
-            IDataType::isNullMap(substream_path) ? false : do_index);
+            IDataType::isNullMap(substream_path) ? false : do_index,
+            IDataType::isNullMap(substream_path) ? false : do_bloom_filter);
         column_streams.emplace(stream_name, std::move(stream));
     };
 
@@ -205,6 +246,10 @@ void DMFileWriter::writeColumn(ColId col_id, const IDataType & type, const IColu
                 // For TAG Column, we also ignore del_mark when add minmax index.
                 stream->minmaxes->addPack(column, (col_id == EXTRA_HANDLE_COLUMN_ID || col_id == TAG_COLUMN_ID) ? nullptr : del_mark);
             }
+            if (stream->bloom_filter)
+            {
+                stream->bloom_filter->addPack(column, del_mark);
+            }
 
             /// There could already be enough data to compress into the new block.
             if (stream->compressed_buf->offset() >= options.min_compress_block_size)
@@ -249,6 +294,7 @@ void DMFileWriter::finalizeColumn(ColId col_id, DataTypePtr type)
     size_t nullmap_data_bytes = 0;
     size_t nullmap_mark_bytes = 0;
     size_t index_bytes = 0;
+    size_t bloom_filter_bytes = 0;
 #ifndef NDEBUG
     auto examine_buffer_size = [](auto & buf, auto & fp) {
         if (!fp.isEncryptionEnabled())
@@ -330,6 +376,27 @@ void DMFileWriter::finalizeColumn(ColId col_id, DataTypePtr type)
 #endif
             }
         }
+        // Don't write the bloom filter for empty dmfile, it is useless.
+        if (stream->bloom_filter && !is_empty_file)
+        {
+            auto buf = WriteBufferByFileProviderBuilder(
+                           dmfile->configuration.has_value(),
+                           file_provider,
+                           dmfile->colBloomFilterPath(stream_name),
+                           dmfile->encryptionBloomFilterPath(stream_name),
+                           false,
+                           write_limiter)
+                           .with_checksum_algorithm(detail::getAlgorithmOrNone(*dmfile))
+                           .with_checksum_frame_size(detail::getFrameSizeOrDefault(*dmfile))
+                           .build();
+            stream->bloom_filter->write(*buf);
+            buf->sync();
+            bloom_filter_bytes = buf->getMaterializedBytes();
+            bytes_written += bloom_filter_bytes;
+#ifndef NDEBUG
+            examine_buffer_size(*buf, *this->file_provider);
+#endif
+        }
     };
     type->enumerateStreams(callback, {});
 
@@ -341,6 +408,7 @@ void DMFileWriter::finalizeColumn(ColId col_id, DataTypePtr type)
     col_stat.nullmap_data_bytes = nullmap_data_bytes;
     col_stat.nullmap_mark_bytes = nullmap_mark_bytes;
     col_stat.index_bytes = index_bytes;
+    col_stat.bloom_filter_bytes = bloom_filter_bytes;
 }
 
 } // namespace DM
@@ -22,6 +22,7 @@
 #include <IO/WriteBufferFromOStream.h>
 #include <Storages/DeltaMerge/DMChecksumConfig.h>
 #include <Storages/DeltaMerge/File/DMFile.h>
+#include <Storages/DeltaMerge/Index/BloomFilterIndex.h>
 #include <Storages/DeltaMerge/Index/MinMaxIndex.h>
 
 namespace DB
@@ -53,7 +54,8 @@ public:
                size_t max_compress_block_size,
                FileProviderPtr & file_provider,
                const WriteLimiterPtr & write_limiter_,
-               bool do_index)
+               bool do_index,
+               bool do_bloom_filter)
             : plain_file(
                 WriteBufferByFileProviderBuilder(
                     dmfile->configuration.has_value(),
@@ -70,6 +72,7 @@ public:
                                  ? std::unique_ptr<WriteBuffer>(new CompressedWriteBuffer<false>(*plain_file, compression_settings))
                                  : std::unique_ptr<WriteBuffer>(new CompressedWriteBuffer<true>(*plain_file, compression_settings)))
             , minmaxes(do_index ? std::make_shared<MinMaxIndex>(*type) : nullptr)
+            , bloom_filter(do_bloom_filter ? std::make_shared<BloomFilterIndex>() : nullptr)
             , mark_file(WriteBufferByFileProviderBuilder(
                             dmfile->configuration.has_value(),
                             file_provider,
@@ -94,8 +97,8 @@ public:
         }
 
         // Get written bytes of `plain_file` && `mark_file`. Should be called after `flush`.
-        // Note that this class don't take responsible for serializing `minmaxes`,
-        // bytes of `minmaxes` won't be counted in this method.
+        // Note that this class don't take responsible for serializing `minmaxes` and `bloom_filter`,
+        // bytes of them won't be counted in this method.
         size_t getWrittenBytes() const { return plain_file->getMaterializedBytes() + mark_file->getMaterializedBytes(); }
 
         // compressed_buf -> plain_file
@@ -103,6 +106,7 @@ public:
         WriteBufferPtr compressed_buf;
 
         MinMaxIndexPtr minmaxes;
+        BloomFilterIndexPtr bloom_filter;
         WriteBufferFromFileBasePtr mark_file;
     };
     using StreamPtr = std::unique_ptr<Stream>;
@@ -121,13 +125,16 @@ public:
         CompressionSettings compression_settings;
         size_t min_compress_block_size{};
         size_t max_compress_block_size{};
+        // Whether to build bloom filter index for the columns other than handle/version/tag.
+        bool enable_bloom_filter_index = false;
 
         Options() = default;
 
-        Options(CompressionSettings compression_settings_, size_t min_compress_block_size_, size_t max_compress_block_size_)
+        Options(CompressionSettings compression_settings_, size_t min_compress_block_size_, size_t max_compress_block_size_, bool enable_bloom_filter_index_ = false)
             : compression_settings(compression_settings_)
             , min_compress_block_size(min_compress_block_size_)
             , max_compress_block_size(max_compress_block_size_)
+            , enable_bloom_filter_index(enable_bloom_filter_index_)
         {
         }
 
@@ -157,7 +164,10 @@ private:
     /// Add streams with specified column id. Since a single column may have more than one Stream,
     /// for example Nullable column has a NullMap column, we would track them with a mapping
     /// FileNameBase -> Stream.
-    void addStreams(ColId col_id, DataTypePtr type, bool do_index);
+    void addStreams(ColId col_id, DataTypePtr type, bool do_index, bool do_bloom_filter);
+
+    /// The data type hint for lightweight compression of the substream.
+    static CompressionDataType getCompressionDataType(const DataTypePtr & type, const IDataType::SubstreamPath & substream_path);
 
     WriteBufferFromFileBasePtr createMetaFile();
     WriteBufferFromFileBasePtr createMetaV2File();
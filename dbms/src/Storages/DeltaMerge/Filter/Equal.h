@@ -31,8 +31,12 @@ public:
 
     RSResult roughCheck(size_t pack_id, const RSCheckParam & param) override
     {
-        GET_RSINDEX_FROM_PARAM_NOT_FOUND_RETURN_SOME(param, attr, rsindex);
-        return rsindex.minmax->checkEqual(pack_id, value, rsindex.type);
+        GET_RSINDEX_FROM_PARAM_NOT_FOUND_RETURN_SOME_ALLOW_NO_MINMAX(param, attr, rsindex);
+        RSResult res = rsindex.minmax ? rsindex.minmax->checkEqual(pack_id, value, rsindex.type) : Some;
+        // The equal index can only tell whether the value is definitely not in the pack.
+        if (res != None && rsindex.equal && rsindex.equal->checkEqual(pack_id, value, rsindex.type) == None)
+            res = None;
+        return res;
     }
 };
 
@@ -50,11 +50,18 @@ public:
 
     RSResult roughCheck(size_t pack_id, const RSCheckParam & param) override
     {
-        GET_RSINDEX_FROM_PARAM_NOT_FOUND_RETURN_SOME(param, attr, rsindex);
-        // TODO optimize for IN
-        RSResult res = rsindex.minmax->checkEqual(pack_id, values[0], rsindex.type);
-        for (size_t i = 1; i < values.size(); ++i)
-            res = res || rsindex.minmax->checkEqual(pack_id, values[i], rsindex.type);
+        GET_RSINDEX_FROM_PARAM_NOT_FOUND_RETURN_SOME_ALLOW_NO_MINMAX(param, attr, rsindex);
+        RSResult res = Some;
+        if (rsindex.minmax)
+        {
+            // TODO optimize for IN
+            res = rsindex.minmax->checkEqual(pack_id, values[0], rsindex.type);
+            for (size_t i = 1; i < values.size(); ++i)
+                res = res || rsindex.minmax->checkEqual(pack_id, values[i], rsindex.type);
+        }
+        // The equal index can only tell whether none of the values are in the pack.
+        if (res != None && rsindex.equal && rsindex.equal->checkIn(pack_id, values, rsindex.type) == None)
+            res = None;
         return res;
     }
 };
@@ -116,12 +116,17 @@ public:
     }
 };
 
-#define GET_RSINDEX_FROM_PARAM_NOT_FOUND_RETURN_SOME(param, attr, rsindex) \
-    auto it = param.indexes.find(attr.col_id);                             \
-    if (it == param.indexes.end())                                         \
-        return Some;                                                       \
-    auto rsindex = it->second;                                             \
-    if (!rsindex.type->equals(*attr.type))                                 \
+#define GET_RSINDEX_FROM_PARAM_NOT_FOUND_RETURN_SOME_ALLOW_NO_MINMAX(param, attr, rsindex) \
+    auto it = param.indexes.find(attr.col_id);                                             \
+    if (it == param.indexes.end())                                                         \
+        return Some;                                                                       \
+    auto rsindex = it->second;                                                             \
+    if (!rsindex.type->equals(*attr.type))                                                 \
+        return Some;
+
+#define GET_RSINDEX_FROM_PARAM_NOT_FOUND_RETURN_SOME(param, attr, rsindex)             \
+    GET_RSINDEX_FROM_PARAM_NOT_FOUND_RETURN_SOME_ALLOW_NO_MINMAX(param, attr, rsindex) \
+    if (!rsindex.minmax)                                                               \
         return Some;
 
 
@@ -80,6 +80,26 @@ inline bool isRoughSetFilterSupportType(const Int32 field_type)
     return false;
 }
 
+// String columns can be filtered by `Equal` and `In` through the bloom filter index, which hashes
+// the binary content of strings. So only binary collations (without padding) are supported.
+// The collation of the comparison is carried by the filter expression, it may differ from the
+// collation of the column, e.g. `col = 'a' collate utf8mb4_general_ci`.
+inline bool isBloomFilterSupportStringType(const tipb::Expr & filter_expr, const tipb::FieldType & column_type)
+{
+    switch (column_type.tp())
+    {
+    case TiDB::TypeVarchar:
+    case TiDB::TypeVarString:
+    case TiDB::TypeString:
+    {
+        auto collator = getCollatorFromExpr(filter_expr);
+        return collator == nullptr || collator->isBinary();
+    }
+    default:
+        return false;
+    }
+}
+
 ColumnID getColumnIDForColumnExpr(const tipb::Expr & expr, const ColumnDefines & columns_to_read)
 {
     assert(isColumnExpr(expr));
@@ -148,7 +168,9 @@ inline RSOperatorPtr parseTiCompareExpr( //
                 return createUnsupported(expr.ShortDebugString(), "ColumnRef with no field type is not supported", false);
 
             auto field_type = child.field_type().tp();
-            if (!isRoughSetFilterSupportType(field_type))
+            bool is_supported = isRoughSetFilterSupportType(field_type)
+                || (filter_type == FilterParser::RSFilterType::Equal && isBloomFilterSupportStringType(expr, child.field_type()));
+            if (!is_supported)
                 return createUnsupported(
                     expr.ShortDebugString(),
                     "ColumnRef with field type(" + DB::toString(field_type) + ") is not supported",
@@ -256,6 +278,48 @@ inline RSOperatorPtr parseTiCompareExpr( //
     return op;
 }
 
+/// Only support `column` in (`literal`, ...) now.
+inline RSOperatorPtr parseTiInExpr( //
+    const tipb::Expr & expr,
+    const ColumnDefines & columns_to_read,
+    const FilterParser::AttrCreatorByColumnID & creator)
+{
+    if (unlikely(expr.children_size() < 2))
+        return createUnsupported(expr.ShortDebugString(),
+                                 tipb::ScalarFuncSig_Name(expr.sig()) + " with " + DB::toString(expr.children_size())
+                                     + " children is not supported",
+                                 false);
+
+    const auto & column_expr = expr.children(0);
+    if (!isColumnExpr(column_expr))
+        return createUnsupported(expr.ShortDebugString(), "first child of in is not column", false);
+    if (unlikely(!column_expr.has_field_type()))
+        return createUnsupported(expr.ShortDebugString(), "ColumnRef with no field type is not supported", false);
+
+    // The literal of timestamp need to be converted by the time zone, not supported for now.
+    auto field_type = column_expr.field_type().tp();
+    bool is_supported = (isRoughSetFilterSupportType(field_type) && field_type != TiDB::TypeTimestamp)
+        || isBloomFilterSupportStringType(expr, column_expr.field_type());
+    if (!is_supported)
+        return createUnsupported(
+            expr.ShortDebugString(),
+            "ColumnRef with field type(" + DB::toString(field_type) + ") is not supported",
+            false);
+
+    Fields values;
+    values.reserve(expr.children_size() - 1);
+    for (Int32 i = 1; i < expr.children_size(); ++i)
+    {
+        const auto & child = expr.children(i);
+        if (!isLiteralExpr(child))
+            return createUnsupported(expr.ShortDebugString(), "child of in is not literal", false);
+        values.emplace_back(decodeLiteral(child));
+    }
+
+    Attr attr = creator(getColumnIDForColumnExpr(column_expr, columns_to_read));
+    return createIn(attr, values);
+}
+
 RSOperatorPtr parseTiExpr(const tipb::Expr & expr,
                           const ColumnDefines & columns_to_read,
                           const FilterParser::AttrCreatorByColumnID & creator,
@@ -369,6 +433,9 @@ RSOperatorPtr parseTiExpr(const tipb::Expr & expr,
         break;
 
         case FilterParser::RSFilterType::In:
+            op = parseTiInExpr(expr, columns_to_read, creator);
+            break;
+
         case FilterParser::RSFilterType::NotIn:
         case FilterParser::RSFilterType::Like:
         case FilterParser::RSFilterType::NotLike:
@@ -462,6 +529,27 @@ RSOperatorPtr FilterParser::parseRFInExpr(const tipb::RuntimeFilterType rf_type,
     return createUnsupported(target_expr.ShortDebugString(), "function params should be in predicate", false);
 }
 
+RSOperatorPtr FilterParser::parseRFMinMaxExpr(const tipb::RuntimeFilterType rf_type, const tipb::Expr & target_expr, const ColumnDefines & columns_to_read, const Field & min_value, const Field & max_value)
+{
+    if (rf_type != tipb::MIN_MAX)
+        return createUnsupported(target_expr.ShortDebugString(), "rf type should be min max", false);
+    if (!isColumnExpr(target_expr))
+        return createUnsupported(target_expr.ShortDebugString(), "rf target expr is not column expr", false);
+    if (min_value.isNull() || max_value.isNull())
+        return createUnsupported(target_expr.ShortDebugString(), "rf min max values are empty", false);
+
+    auto column_define = cop::getColumnDefineForColumnExpr(target_expr, columns_to_read);
+    Attr attr{.col_name = column_define.name, .col_id = column_define.id, .type = column_define.type};
+    return createAnd({createGreaterEqual(attr, min_value, -1), createLessEqual(attr, max_value, -1)});
+}
+
+std::optional<ColumnDefine> FilterParser::getRFTargetColumnDefine(const tipb::Expr & target_expr, const ColumnDefines & columns_to_read)
+{
+    if (!isColumnExpr(target_expr))
+        return std::nullopt;
+    return cop::getColumnDefineForColumnExpr(target_expr, columns_to_read);
+}
+
 bool FilterParser::isRSFilterSupportType(const Int32 field_type)
 {
     return cop::isRoughSetFilterSupportType(field_type);
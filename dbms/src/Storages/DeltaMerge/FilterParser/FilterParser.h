@@ -22,6 +22,7 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 
 namespace Poco
@@ -55,6 +56,12 @@ public:
     // only for runtime filter in predicate
     static RSOperatorPtr parseRFInExpr(const tipb::RuntimeFilterType rf_type, const tipb::Expr & target_expr, const ColumnDefines & columns_to_read, const std::set<Field> & setElements);
 
+    // only for runtime filter min max, `min_value` and `max_value` are null if the build side is empty
+    static RSOperatorPtr parseRFMinMaxExpr(const tipb::RuntimeFilterType rf_type, const tipb::Expr & target_expr, const ColumnDefines & columns_to_read, const Field & min_value, const Field & max_value);
+
+    // Return the column define of runtime filter target expr, or nullopt if it is not a column expr
+    static std::optional<ColumnDefine> getRFTargetColumnDefine(const tipb::Expr & target_expr, const ColumnDefines & columns_to_read);
+
     static bool isRSFilterSupportType(const Int32 field_type);
 
     /// Some helper structure
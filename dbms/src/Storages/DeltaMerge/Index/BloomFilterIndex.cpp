@@ -0,0 +1,325 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
+#include <Common/HashTable/Hash.h>
+#include <Common/TiFlashException.h>
+#include <Common/typeid_cast.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <IO/ReadHelpers.h>
+#include <IO/WriteHelpers.h>
+#include <Storages/DeltaMerge/Index/BloomFilterIndex.h>
+#include <city.h>
+
+#include <algorithm>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int LOGICAL_ERROR;
+} // namespace ErrorCodes
+
+namespace DM
+{
+RSResult EqualIndex::checkIn(size_t pack_index, const std::vector<Field> & values, const DataTypePtr & type) const
+{
+    for (const auto & value : values)
+    {
+        if (checkEqual(pack_index, value, type) != RSResult::None)
+            return RSResult::Some;
+    }
+    return RSResult::None;
+}
+
+namespace details
+{
+// Salts of split block bloom filter, the same as the one used by Parquet.
+static constexpr UInt32 BLOOM_SALT[BloomFilterIndex::WORDS_PER_BLOCK]
+    = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+inline UInt64 hashInteger(UInt64 x)
+{
+    return intHash64(x);
+}
+
+inline UInt64 hashString(const StringRef & s)
+{
+    return CityHash_v1_0_2::CityHash64(s.data, s.size);
+}
+
+/// Call `f(row, hash)` for each row of `column`, returns false if the type of `column` is not supported.
+template <typename T, typename F>
+bool forEachIntegerHash(const IColumn & column, F && f)
+{
+    const auto * col = typeid_cast<const ColumnVector<T> *>(&column);
+    if (!col)
+        return false;
+    const auto & data = col->getData();
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        // Signed integers are sign-extended, so that the hash is the same as the one of `Field::Types::Int64`.
+        f(i, hashInteger(static_cast<UInt64>(data[i])));
+    }
+    return true;
+}
+
+template <typename F>
+bool forEachStringHash(const IColumn & column, F && f)
+{
+    const auto * col = typeid_cast<const ColumnString *>(&column);
+    if (!col)
+        return false;
+    for (size_t i = 0; i < col->size(); ++i)
+        f(i, hashString(col->getDataAt(i)));
+    return true;
+}
+
+template <typename F>
+void forEachHash(const IColumn & column, F && f)
+{
+    bool visited = forEachIntegerHash<Int8>(column, f)
+        || forEachIntegerHash<Int16>(column, f)
+        || forEachIntegerHash<Int32>(column, f)
+        || forEachIntegerHash<Int64>(column, f)
+        || forEachIntegerHash<UInt8>(column, f)
+        || forEachIntegerHash<UInt16>(column, f)
+        || forEachIntegerHash<UInt32>(column, f)
+        || forEachIntegerHash<UInt64>(column, f)
+        || forEachStringHash(column, f);
+    if (unlikely(!visited))
+        throw Exception(fmt::format("Bloom filter index is not supported for column {}", column.getName()), ErrorCodes::LOGICAL_ERROR);
+}
+
+inline std::pair<const IColumn *, const NullMap *> splitNullable(const IColumn & column)
+{
+    if (column.isColumnNullable())
+    {
+        const auto & nullable_column = static_cast<const ColumnNullable &>(column);
+        return {&nullable_column.getNestedColumn(), &nullable_column.getNullMapData()};
+    }
+    return {&column, nullptr};
+}
+
+enum class KeyState
+{
+    // The value can be represented by the column type, `hash` is valid.
+    Valid,
+    // The value can never be equal to any value of the column type.
+    Impossible,
+    // Don't know how to compare the value with the column type.
+    Unknown,
+};
+
+template <typename T>
+inline bool isInRange(T v, bool is_signed, size_t value_size)
+{
+    if (value_size >= sizeof(UInt64))
+        return true;
+    const auto bits = value_size * 8;
+    if (is_signed)
+    {
+        const Int64 max = (static_cast<Int64>(1) << (bits - 1)) - 1;
+        const Int64 min = -max - 1;
+        if constexpr (std::is_signed_v<T>)
+            return v >= min && v <= max;
+        else
+            return v <= static_cast<UInt64>(max);
+    }
+    else
+    {
+        const UInt64 max = (static_cast<UInt64>(1) << bits) - 1;
+        if constexpr (std::is_signed_v<T>)
+            return v >= 0 && static_cast<UInt64>(v) <= max;
+        else
+            return v <= max;
+    }
+}
+
+KeyState hashField(const Field & value, const IDataType & type, UInt64 & hash)
+{
+    if (type.isString())
+    {
+        if (value.getType() != Field::Types::String)
+            return KeyState::Unknown;
+        const auto & s = value.get<String>();
+        hash = hashString(StringRef(s.data(), s.size()));
+        return KeyState::Valid;
+    }
+
+    // Only Date/DateTime/MyDate/MyDateTime and unsigned integers are represented by unsigned integers.
+    const bool is_signed = type.isInteger() && !type.isUnsignedInteger();
+    const size_t value_size = type.getSizeOfValueInMemory();
+    switch (value.getType())
+    {
+    case Field::Types::UInt64:
+    {
+        auto v = value.get<UInt64>();
+        if (!isInRange(v, is_signed, value_size))
+            return KeyState::Impossible;
+        hash = hashInteger(v);
+        return KeyState::Valid;
+    }
+    case Field::Types::Int64:
+    {
+        auto v = value.get<Int64>();
+        if (!isInRange(v, is_signed, value_size))
+            return KeyState::Impossible;
+        hash = hashInteger(static_cast<UInt64>(v));
+        return KeyState::Valid;
+    }
+    default:
+        return KeyState::Unknown;
+    }
+}
+} // namespace details
+
+bool BloomFilterIndex::isSupportType(const DataTypePtr & type)
+{
+    const auto nested_type = removeNullable(type);
+    return nested_type->isInteger() || nested_type->isDateOrDateTime() || nested_type->isString();
+}
+
+void BloomFilterIndex::collectHashes(const IColumn & column, const ColumnVector<UInt8> * del_mark, std::vector<UInt64> & hashes)
+{
+    auto [nested_column, null_map] = details::splitNullable(column);
+    hashes.reserve(hashes.size() + column.size());
+    details::forEachHash(*nested_column, [&](size_t i, UInt64 hash) {
+        if ((!del_mark || !del_mark->getData()[i]) && (!null_map || !(*null_map)[i]))
+            hashes.push_back(hash);
+    });
+}
+
+void BloomFilterIndex::addPack(const IColumn & column, const ColumnVector<UInt8> * del_mark)
+{
+    std::vector<UInt64> hashes;
+    collectHashes(column, del_mark, hashes);
+    addPack(hashes);
+}
+
+void BloomFilterIndex::addPack(std::vector<UInt64> & hashes)
+{
+    // Size the filter by the number of distinct keys, so that low-cardinality packs stay small.
+    std::sort(hashes.begin(), hashes.end());
+    hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+
+    const size_t bits_per_block = WORDS_PER_BLOCK * sizeof(UInt32) * 8;
+    const size_t num_blocks = hashes.empty() ? 0 : (hashes.size() * BITS_PER_KEY + bits_per_block - 1) / bits_per_block;
+
+    const size_t begin_block = pack_block_offsets.back();
+    words.resize_fill(words.size() + num_blocks * WORDS_PER_BLOCK, 0);
+    pack_block_offsets.push_back(begin_block + num_blocks);
+
+    for (auto hash : hashes)
+    {
+        const UInt64 block = begin_block + (((hash >> 32) * num_blocks) >> 32);
+        const auto key = static_cast<UInt32>(hash);
+        UInt32 * block_words = &words[block * WORDS_PER_BLOCK];
+        for (size_t i = 0; i < WORDS_PER_BLOCK; ++i)
+            block_words[i] |= 1U << ((key * details::BLOOM_SALT[i]) >> 27);
+    }
+}
+
+void BloomFilterIndex::checkRows(size_t pack_index, const IColumn & column, IColumn::Filter & filter) const
+{
+    // The column may be dictionary-encoded when it is read from the stable layer.
+    auto full_column = column.convertToFullColumnIfLowCardinality();
+    auto [nested_column, null_map] = details::splitNullable(*full_column);
+    filter.resize(column.size());
+    details::forEachHash(*nested_column, [&](size_t i, UInt64 hash) {
+        // Null never equals to anything
+        filter[i] = (!null_map || !(*null_map)[i]) && mayContain(pack_index, hash);
+    });
+}
+
+bool BloomFilterIndex::mayContain(size_t pack_index, UInt64 hash) const
+{
+    const size_t begin_block = pack_block_offsets[pack_index];
+    const size_t num_blocks = pack_block_offsets[pack_index + 1] - begin_block;
+    // No valid rows in this pack
+    if (num_blocks == 0)
+        return false;
+
+    const UInt64 block = begin_block + (((hash >> 32) * num_blocks) >> 32);
+    const auto key = static_cast<UInt32>(hash);
+    const UInt32 * block_words = &words[block * WORDS_PER_BLOCK];
+    for (size_t i = 0; i < WORDS_PER_BLOCK; ++i)
+    {
+        if (!(block_words[i] & (1U << ((key * details::BLOOM_SALT[i]) >> 27))))
+            return false;
+    }
+    return true;
+}
+
+RSResult BloomFilterIndex::checkEqual(size_t pack_index, const Field & value, const DataTypePtr & type) const
+{
+    // Everything comparison with null will return null.
+    if (value.isNull())
+        return RSResult::None;
+
+    UInt64 hash = 0;
+    switch (details::hashField(value, *removeNullable(type), hash))
+    {
+    case details::KeyState::Impossible:
+        return RSResult::None;
+    case details::KeyState::Unknown:
+        return RSResult::Some;
+    case details::KeyState::Valid:
+        return mayContain(pack_index, hash) ? RSResult::Some : RSResult::None;
+    }
+    return RSResult::Some;
+}
+
+void BloomFilterIndex::write(WriteBuffer & buf) const
+{
+    writeIntBinary(FORMAT_V1, buf);
+    UInt64 pack_count = packCount();
+    writeIntBinary(pack_count, buf);
+    buf.write(reinterpret_cast<const char *>(pack_block_offsets.data()), sizeof(UInt32) * pack_block_offsets.size());
+    buf.write(reinterpret_cast<const char *>(words.data()), sizeof(UInt32) * words.size());
+}
+
+BloomFilterIndexPtr BloomFilterIndex::read(ReadBuffer & buf, size_t bytes_limit)
+{
+    size_t buf_pos = buf.count();
+
+    UInt8 format_version = 0;
+    readIntBinary(format_version, buf);
+    if (unlikely(format_version != FORMAT_V1))
+        throw DB::TiFlashException("Bad file format: unknown bloom filter index version " + std::to_string(format_version),
+                                   Errors::DeltaTree::Internal);
+
+    UInt64 pack_count = 0;
+    readIntBinary(pack_count, buf);
+
+    auto index = std::make_shared<BloomFilterIndex>();
+    index->pack_block_offsets.resize(pack_count + 1);
+    buf.readStrict(reinterpret_cast<char *>(index->pack_block_offsets.data()), sizeof(UInt32) * (pack_count + 1));
+    index->words.resize(static_cast<size_t>(index->pack_block_offsets.back()) * WORDS_PER_BLOCK);
+    buf.readStrict(reinterpret_cast<char *>(index->words.data()), sizeof(UInt32) * index->words.size());
+
+    size_t bytes_read = buf.count() - buf_pos;
+    if (unlikely(bytes_read != bytes_limit))
+    {
+        throw DB::TiFlashException("Bad file format: expected read bloom filter index content size: " + std::to_string(bytes_limit)
+                                       + " vs. actual: " + std::to_string(bytes_read),
+                                   Errors::DeltaTree::Internal);
+    }
+    return index;
+}
+
+} // namespace DM
+
+} // namespace DB
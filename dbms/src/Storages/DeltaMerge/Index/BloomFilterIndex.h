@@ -0,0 +1,134 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Columns/ColumnVector.h>
+#include <Common/LRUCache.h>
+#include <Common/PODArray.h>
+#include <Core/Field.h>
+#include <DataTypes/IDataType.h>
+#include <IO/ReadBuffer.h>
+#include <IO/WriteBuffer.h>
+#include <Storages/DeltaMerge/Index/RSResult.h>
+
+namespace DB
+{
+namespace DM
+{
+class EqualIndex;
+using EqualIndexPtr = std::shared_ptr<EqualIndex>;
+
+/// A membership index which can only answer whether a value is *definitely not* in a pack.
+/// It is used to prune packs for `Equal` / `In` when the min/max range of the packs is too
+/// wide to help, e.g. high-cardinality string or UUID columns.
+class EqualIndex
+{
+public:
+    virtual ~EqualIndex() = default;
+
+    virtual size_t byteSize() const = 0;
+
+    /// Returns `None` if no row in the pack can be equal to `value`, otherwise returns `Some`.
+    virtual RSResult checkEqual(size_t pack_index, const Field & value, const DataTypePtr & type) const = 0;
+    virtual RSResult checkIn(size_t pack_index, const std::vector<Field> & values, const DataTypePtr & type) const;
+};
+
+class BloomFilterIndex;
+using BloomFilterIndexPtr = std::shared_ptr<BloomFilterIndex>;
+
+/// A split block bloom filter for each pack.
+/// Every key is mapped into one 256-bit block and sets one bit in each of the 8 words
+/// of that block, so checking a key only touches a single cache line.
+/// The number of blocks of a pack is decided by the number of distinct keys in the pack.
+///
+/// Integers (including Date/DateTime/MyDate/MyDateTime) are hashed by their value widened
+/// to 64 bits, and Strings are hashed by their binary content. So checking a string value is
+/// only correct under binary collation, the caller must ensure that.
+class BloomFilterIndex : public EqualIndex
+{
+public:
+    static constexpr size_t WORDS_PER_BLOCK = 8;
+    static constexpr size_t BITS_PER_KEY = 10; // about 1% false positive rate
+
+    BloomFilterIndex() = default;
+
+    static bool isSupportType(const DataTypePtr & type);
+
+    size_t byteSize() const override
+    {
+        return sizeof(UInt32) * pack_block_offsets.size() + sizeof(UInt32) * words.size();
+    }
+
+    size_t packCount() const { return pack_block_offsets.empty() ? 0 : pack_block_offsets.size() - 1; }
+
+    /// Append the hashes of the non-deleted and non-null rows of `column` to `hashes`.
+    static void collectHashes(const IColumn & column, const ColumnVector<UInt8> * del_mark, std::vector<UInt64> & hashes);
+
+    void addPack(const IColumn & column, const ColumnVector<UInt8> * del_mark);
+    /// Add a pack by the hashes collected by `collectHashes`, note `hashes` will be sorted and deduplicated.
+    void addPack(std::vector<UInt64> & hashes);
+
+    /// Set `filter[i]` to 0 if row i of `column` can not be found in the pack, otherwise 1.
+    void checkRows(size_t pack_index, const IColumn & column, IColumn::Filter & filter) const;
+
+    void write(WriteBuffer & buf) const;
+
+    static BloomFilterIndexPtr read(ReadBuffer & buf, size_t bytes_limit);
+
+    RSResult checkEqual(size_t pack_index, const Field & value, const DataTypePtr & type) const override;
+
+#ifndef DBMS_PUBLIC_GTEST
+private:
+#endif
+    bool mayContain(size_t pack_index, UInt64 hash) const;
+
+private:
+    static constexpr UInt8 FORMAT_V1 = 1;
+
+    // Pack i owns the blocks in [pack_block_offsets[i], pack_block_offsets[i + 1])
+    PaddedPODArray<UInt32> pack_block_offsets{0};
+    PaddedPODArray<UInt32> words;
+};
+
+
+struct BloomFilterIndexWeightFunction
+{
+    size_t operator()(const BloomFilterIndex & index) const { return index.byteSize(); }
+};
+
+
+class BloomFilterIndexCache : public LRUCache<String, BloomFilterIndex, std::hash<String>, BloomFilterIndexWeightFunction>
+{
+private:
+    using Base = LRUCache<String, BloomFilterIndex, std::hash<String>, BloomFilterIndexWeightFunction>;
+
+public:
+    explicit BloomFilterIndexCache(size_t max_size_in_bytes)
+        : Base(max_size_in_bytes)
+    {}
+
+    template <typename LoadFunc>
+    MappedPtr getOrSet(const Key & key, LoadFunc && load)
+    {
+        auto result = Base::getOrSet(key, load);
+        return result.first;
+    }
+};
+
+using BloomFilterIndexCachePtr = std::shared_ptr<BloomFilterIndexCache>;
+
+} // namespace DM
+
+} // namespace DB
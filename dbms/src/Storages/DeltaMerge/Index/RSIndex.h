@@ -14,25 +14,17 @@
 
 #pragma once
 
+#include <Storages/DeltaMerge/Index/BloomFilterIndex.h>
 #include <Storages/DeltaMerge/Index/MinMaxIndex.h>
 
 namespace DB
 {
 namespace DM
 {
-class EqualIndex;
-using EqualIndexPtr = std::shared_ptr<EqualIndex>;
-
-
-class EqualIndex
-{
-public:
-    virtual ~EqualIndex() = default;
-};
-
 struct RSIndex
 {
     DataTypePtr type;
+    // Could be nullptr if the column only has equal index, e.g. String columns.
     MinMaxIndexPtr minmax;
     EqualIndexPtr equal;
 
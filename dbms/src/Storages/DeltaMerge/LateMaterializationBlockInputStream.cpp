@@ -28,12 +28,14 @@ LateMaterializationBlockInputStream::LateMaterializationBlockInputStream(
     BlockInputStreamPtr filter_column_stream_,
     SkippableBlockInputStreamPtr rest_column_stream_,
     const BitmapFilterPtr & bitmap_filter_,
+    const ScanContextPtr & scan_context_,
     const String & req_id_)
     : header(toEmptyBlock(columns_to_read))
     , filter_column_name(filter_column_name_)
     , filter_column_stream(filter_column_stream_)
     , rest_column_stream(rest_column_stream_)
     , bitmap_filter(bitmap_filter_)
+    , scan_context(scan_context_)
     , log(Logger::get(NAME, req_id_))
 {}
 
@@ -52,9 +54,12 @@ Block LateMaterializationBlockInputStream::readImpl()
         if (!filter_column_block)
             return filter_column_block;
 
+        scan_context->total_late_materialization_filter_rows += filter_column_block.rows();
+
         // If filter is nullptr, it means that these push down filters are always true.
         if (!filter)
         {
+            scan_context->total_late_materialization_passed_rows += filter_column_block.rows();
             IColumn::Filter col_filter;
             col_filter.resize(filter_column_block.rows());
             Block rest_column_block;
@@ -82,7 +87,9 @@ Block LateMaterializationBlockInputStream::readImpl()
         // bitmap_filter[start_offset, start_offset + rows] & filter -> filter
         bitmap_filter->rangeAnd(*filter, filter_column_block.startOffset(), rows);
 
-        if (size_t passed_count = countBytesInFilter(*filter); passed_count == 0)
+        size_t passed_count = countBytesInFilter(*filter);
+        scan_context->total_late_materialization_passed_rows += passed_count;
+        if (passed_count == 0)
         {
             // if all rows are filtered, skip the next block of rest_column_stream
             if (size_t skipped_rows = rest_column_stream->skipNextBlock(); skipped_rows == 0)
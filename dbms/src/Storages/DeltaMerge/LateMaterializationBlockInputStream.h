@@ -17,6 +17,7 @@
 #include <DataStreams/IProfilingBlockInputStream.h>
 #include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
+#include <Storages/DeltaMerge/ScanContext.h>
 #include <Storages/DeltaMerge/SkippableBlockInputStream.h>
 
 namespace DB::DM
@@ -27,6 +28,8 @@ namespace DB::DM
   * 2. Run pushed down filter on the block, return block and filter.
   * 3. Read one block of the rest columns, join the two block by columns, and assign the filter to the returned block before return.
   * 4. Repeat 1-3 until the filter column stream is empty.
+  * The number of rows read and passed are recorded in the scan context, which decides whether
+  * the following segments of the same table scan still use late materialization.
   */
 class LateMaterializationBlockInputStream : public IProfilingBlockInputStream
 {
@@ -39,6 +42,7 @@ public:
         BlockInputStreamPtr filter_column_stream_,
         SkippableBlockInputStreamPtr rest_column_stream_,
         const BitmapFilterPtr & bitmap_filter_,
+        const ScanContextPtr & scan_context_,
         const String & req_id_);
 
     String getName() const override { return NAME; }
@@ -59,6 +63,8 @@ private:
     SkippableBlockInputStreamPtr rest_column_stream;
     // The MVCC-bitmap.
     BitmapFilterPtr bitmap_filter;
+    // Used to record the selectivity of the filter.
+    const ScanContextPtr scan_context;
 
     const LoggerPtr log;
 };
@@ -61,6 +61,26 @@ void DMFileReaderPool::set(DMFileReader & from_reader, int64_t col_id, size_t st
     }
 }
 
+size_t DMFileReaderPool::getScanningPackId(const std::string & name)
+{
+    std::lock_guard lock(mtx);
+    auto itr = readers.find(name);
+    if (itr == readers.end())
+    {
+        return 0;
+    }
+    std::optional<size_t> min_pack_id;
+    for (auto * r : itr->second)
+    {
+        auto pack_id = r->getScanningPackId();
+        if (pack_id && (!min_pack_id || *pack_id < *min_pack_id))
+        {
+            min_pack_id = pack_id;
+        }
+    }
+    return min_pack_id.value_or(0);
+}
+
 DMFileReader * DMFileReaderPool::get(const std::string & name)
 {
     std::lock_guard lock(mtx);
@@ -224,6 +224,9 @@ public:
     void add(DMFileReader & reader);
     void del(DMFileReader & reader);
     void set(DMFileReader & from_reader, int64_t col_id, size_t start, size_t count, ColumnPtr & col);
+    // Returns the smallest next pack id of the readers that are scanning the DMFile, or 0 if there is no one.
+    // A new reader can start a circular scan from it, so that the packs read by these readers can be shared.
+    size_t getScanningPackId(const std::string & name);
     // `get` is just for test.
     DMFileReader * get(const std::string & name);
 
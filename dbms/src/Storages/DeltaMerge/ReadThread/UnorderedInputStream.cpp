@@ -43,8 +43,26 @@ void UnorderedInputStream::pushDownReadyRFList(std::vector<RuntimeFilterPtr> rea
 {
     for (const RuntimeFilterPtr & rf : readyRFList)
     {
+        // Other rfs are applied row by row after reading, see `filterByRuntimeFilter`
+        if (!rf->isPackLevelFilter())
+            continue;
         auto rs_operator = rf->parseToRSOperator(task_pool->getColumnToRead());
         task_pool->appendRSOperator(rs_operator);
     }
 }
+
+bool UnorderedInputStream::filterByRuntimeFilter(Block & block)
+{
+    bool filtered = false;
+    for (const RuntimeFilterPtr & rf : runtime_filter_list)
+    {
+        // The rf may be ready later than the task pool is scheduled, it is still useful to filter the remaining blocks.
+        if (rf->isPackLevelFilter() || !rf->isReady())
+            continue;
+        filtered |= rf->filterBlock(block, task_pool->getColumnToRead());
+        if (block.rows() == 0)
+            break;
+    }
+    return filtered;
+}
 } // namespace DB::DM
@@ -94,6 +94,7 @@ protected:
             task_pool->popBlock(res);
             if (res)
             {
+                filterByRuntimeFilter(res);
                 if (res.rows() > 0)
                 {
                     total_rows += res.rows();
@@ -134,6 +135,9 @@ private:
 
     void pushDownReadyRFList(std::vector<RuntimeFilterPtr> readyRFList);
 
+    // Filter the rows of `block` by the ready runtime filters which can not be pushed down to packs.
+    bool filterByRuntimeFilter(Block & block);
+
     SegmentReadTaskPoolPtr task_pool;
     Block header;
 
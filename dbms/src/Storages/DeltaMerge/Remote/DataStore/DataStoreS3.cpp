@@ -20,6 +20,7 @@
 #include <Storages/DeltaMerge/Remote/DataStore/DataStoreS3.h>
 #include <Storages/S3/S3Common.h>
 #include <Storages/S3/S3Filename.h>
+#include <Storages/S3/S3WritableFile.h>
 #include <Storages/Transaction/Types.h>
 #include <aws/core/utils/DateTime.h>
 #include <common/logger_useful.h>
@@ -44,6 +45,7 @@ void DataStoreS3::putDMFile(DMFilePtr local_dmfile, const S3::DMFileOID & oid, b
     LOG_DEBUG(log, "Start upload DMFile, local_dir={} remote_dir={} local_files={}", local_dir, remote_dir, local_files);
 
     auto s3_client = S3::ClientFactory::instance().sharedTiFlashClient();
+    const auto write_settings = S3::WriteSettings::fromConfig(S3::ClientFactory::instance().getConfigCopy());
 
     std::vector<std::future<void>> upload_results;
     for (const auto & [fname, fsize] : local_files)
@@ -58,7 +60,7 @@ void DataStoreS3::putDMFile(DMFilePtr local_dmfile, const S3::DMFileOID & oid, b
         auto remote_fname = fmt::format("{}/{}", remote_dir, fname);
         auto task = std::make_shared<std::packaged_task<void()>>(
             [&, local_fname = std::move(local_fname), remote_fname = std::move(remote_fname)]() {
-                S3::uploadFile(*s3_client, local_fname, remote_fname);
+                S3::uploadFileByS3WritableFile(s3_client, local_fname, remote_fname, write_settings);
             });
         upload_results.push_back(task->get_future());
         DataStoreS3Pool::get().scheduleOrThrowOnError([task]() { (*task)(); });
@@ -83,6 +85,7 @@ void DataStoreS3::putDMFile(DMFilePtr local_dmfile, const S3::DMFileOID & oid, b
 bool DataStoreS3::putCheckpointFiles(const PS::V3::LocalCheckpointFiles & local_files, StoreID store_id, UInt64 upload_seq)
 {
     auto s3_client = S3::ClientFactory::instance().sharedTiFlashClient();
+    const auto write_settings = S3::WriteSettings::fromConfig(S3::ClientFactory::instance().getConfigCopy());
 
     /// First upload all CheckpointData files and their locks,
     /// then upload the CheckpointManifest to make the files within
@@ -96,7 +99,8 @@ bool DataStoreS3::putCheckpointFiles(const PS::V3::LocalCheckpointFiles & local_
             const auto & local_datafile = local_files.data_files[idx];
             auto s3key = S3::S3Filename::newCheckpointData(store_id, upload_seq, idx);
             auto lock_key = s3key.toView().getLockKey(store_id, upload_seq);
-            S3::uploadFile(*s3_client, local_datafile, s3key.toFullKey());
+            // The CheckpointData files may be large, upload their parts concurrently.
+            S3::uploadFileByS3WritableFile(s3_client, local_datafile, s3key.toFullKey(), write_settings);
             S3::uploadEmptyFile(*s3_client, lock_key);
         });
         upload_results.push_back(task->get_future());
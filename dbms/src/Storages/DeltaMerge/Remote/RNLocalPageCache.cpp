@@ -35,7 +35,7 @@ RNLocalPageCache::RNLocalPageCache(const RNLocalPageCacheOptions & options)
     : log(Logger::get())
     , storage(options.underlying_storage)
     , max_size(options.max_size_bytes)
-    , evictable_keys(max_size)
+    , evictable_keys(max_size, options.policy)
 {
     RUNTIME_CHECK(storage != nullptr);
 
@@ -370,16 +370,30 @@ bool RNLocalPageCacheLRU::put(const UniversalPageId & key, size_t size)
     auto & item = place_result.first->second;
     bool inserted = place_result.second;
 
+    if (sketch)
+        sketch->increment(std::hash<UniversalPageId>{}(key));
+
     if (inserted)
     {
         item.size = size;
-        item.queue_iter = queue.insert(queue.end(), key);
         current_total_size += size;
+        if (sketch)
+            sketch->ensureCapacity(index.size());
+        if (sketch && removed_keys.erase(key) > 0)
+        {
+            // It is put back after being used.
+            item.queue_iter = queue.insert(queue.end(), key);
+            touch(item);
+        }
+        else
+        {
+            item.queue_iter = queue.insert(protected_begin, key);
+        }
     }
     else
     {
         RUNTIME_CHECK_MSG(size == item.size, "Put an item with different size, new_size={} old_size={}", size, item.size);
-        queue.splice(queue.end(), queue, item.queue_iter);
+        touch(item);
     }
 
     LOG_TRACE(log, "LRU put {} size={} lru={}", key, size, statistics());
@@ -395,8 +409,10 @@ bool RNLocalPageCacheLRU::remove(const UniversalPageId & key)
         return false;
 
     current_total_size -= it->second.size;
-    queue.erase(it->second.queue_iter);
+    unlink(it->second);
     index.erase(it);
+    if (sketch)
+        removed_keys.insert(key);
     CurrentMetrics::set(CurrentMetrics::PageCacheUsed, current_total_size);
 
     return true;
@@ -411,18 +427,30 @@ std::vector<UniversalPageId> RNLocalPageCacheLRU::evict()
     size_t evicted_bytes = 0;
     while (current_total_size > max_size && queue.size() > 1)
     {
-        const auto & key = queue.front();
+        auto victim_iter = queue.begin();
+        if (sketch && protected_begin != queue.begin())
+        {
+            // The newest key of the probation segment is not admitted if it is accessed less frequently than the oldest one.
+            auto candidate_iter = std::prev(protected_begin);
+            if (candidate_iter != victim_iter
+                && sketch->estimate(std::hash<UniversalPageId>{}(*candidate_iter)) <= sketch->estimate(std::hash<UniversalPageId>{}(*victim_iter)))
+            {
+                victim_iter = candidate_iter;
+                GET_METRIC(tiflash_storage_remote_cache, type_page_admission_reject).Increment();
+            }
+        }
+        const auto key = *victim_iter;
 
         auto it = index.find(key);
         RUNTIME_CHECK(it != index.end());
 
-        evicted.emplace_back(key);
         LOG_TRACE(log, "LRU evict, key={} size={}", key, it->second.size);
 
         current_total_size -= it->second.size;
         evicted_bytes += it->second.size;
-        queue.pop_front();
+        unlink(it->second);
         index.erase(it);
+        evicted.emplace_back(key);
     }
     GET_METRIC(tiflash_storage_remote_cache, type_page_evict).Increment(evicted.size());
     GET_METRIC(tiflash_storage_remote_cache_bytes, type_page_evict_bytes).Increment(evicted_bytes);
@@ -444,10 +472,53 @@ std::vector<UniversalPageId> RNLocalPageCacheLRU::evict()
             total_size += it->second.size;
         }
         RUNTIME_CHECK(total_size == current_total_size, total_size, current_total_size);
+
+        size_t total_protected_size = 0;
+        for (auto iter = protected_begin; iter != queue.end(); ++iter)
+        {
+            const auto & item = index.find(*iter)->second;
+            RUNTIME_CHECK(item.is_protected);
+            total_protected_size += item.size;
+        }
+        RUNTIME_CHECK(total_protected_size == protected_size, total_protected_size, protected_size);
     }
 #endif
 
     return evicted;
 }
 
+void RNLocalPageCacheLRU::touch(Item & item)
+{
+    if (item.queue_iter == protected_begin)
+        ++protected_begin;
+    queue.splice(queue.end(), queue, item.queue_iter);
+    if (policy == CachePolicy::LRU)
+        return;
+
+    if (protected_begin == queue.end())
+        protected_begin = item.queue_iter;
+    if (!item.is_protected)
+    {
+        item.is_protected = true;
+        protected_size += item.size;
+    }
+    // Keep the protected segment within 80% of max_size, the oldest protected keys become the newest probation keys.
+    while (protected_size * 5 > max_size * 4 && protected_begin != item.queue_iter)
+    {
+        auto & demoted = index.find(*protected_begin)->second;
+        demoted.is_protected = false;
+        protected_size -= demoted.size;
+        ++protected_begin;
+    }
+}
+
+void RNLocalPageCacheLRU::unlink(Item & item)
+{
+    if (item.queue_iter == protected_begin)
+        ++protected_begin;
+    if (item.is_protected)
+        protected_size -= item.size;
+    queue.erase(item.queue_iter);
+}
+
 } // namespace DB::DM::Remote
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <Common/CachePolicy.h>
 #include <Common/Logger.h>
 #include <Interpreters/Context_fwd.h>
 #include <Storages/DeltaMerge/Remote/ObjectId.h>
@@ -24,6 +25,7 @@
 #include <Storages/Transaction/Types.h>
 
 #include <boost/noncopyable.hpp>
+#include <unordered_set>
 
 namespace DB
 {
@@ -38,7 +40,7 @@ namespace DB::DM::Remote
 {
 
 /**
- * A standard LRU. Its max_size is changeable.
+ * A standard LRU or a segmented LRU with TinyLFU admission (see `CachePolicy`). Its max_size is changeable.
  *
  * It supports the following operations:
  * - Put:    Put a key into LRU's management.
@@ -49,6 +51,12 @@ namespace DB::DM::Remote
  *           occur any more in the evicted list.
  *
  * Eviction only happens when you manually call `evict()`..
+ *
+ * For TinyLFU, `[queue.begin(), protected_begin)` is the probation segment and `[protected_begin, queue.end())`
+ * is the protected segment. Because a key is removed when it is in use and put back after that, a put is
+ * regarded as an access. A key is put into the protected segment if it is put back after being removed,
+ * i.e. it was hit, otherwise into the probation segment. When evicting, the newest key of the probation
+ * segment competes with the oldest one, and the less frequently accessed one is evicted first.
  */
 class RNLocalPageCacheLRU
     : private boost::noncopyable
@@ -61,13 +69,20 @@ private:
     {
         size_t size;
         QueueIter queue_iter;
+        bool is_protected = false;
     };
 
 public:
-    explicit RNLocalPageCacheLRU(size_t max_size_)
+    explicit RNLocalPageCacheLRU(size_t max_size_, CachePolicy policy_ = CachePolicy::LRU)
         : log(Logger::get())
         , max_size(max_size_)
+        , policy(policy_)
     {
+        if (policy == CachePolicy::TinyLFU)
+        {
+            // The sketch grows with the number of keys.
+            sketch = std::make_unique<FrequencySketch>(1024);
+        }
     }
 
     void setMaxSize(size_t max_size_)
@@ -78,9 +93,10 @@ public:
     String statistics() const
     {
         return fmt::format(
-            "<total_n={} total_size={} max_size={}>",
+            "<total_n={} total_size={} protected_size={} max_size={}>",
             index.size(),
             current_total_size,
+            protected_size,
             max_size);
     }
 
@@ -95,13 +111,26 @@ public:
 #ifndef DBMS_PUBLIC_GTEST
 private:
 #endif
+    // Move the item to the tail of the protected segment, or the tail of the queue for LRU.
+    void touch(Item & item);
+    // Unlink the item from the queue and the segments.
+    void unlink(Item & item);
+
     LoggerPtr log;
 
     size_t max_size;
     size_t current_total_size = 0;
 
+    const CachePolicy policy;
+    std::unique_ptr<FrequencySketch> sketch;
+
     Queue queue;
     std::unordered_map<UniversalPageId, Item> index;
+    // The keys removed when they are in the LRU, only for TinyLFU.
+    std::unordered_set<UniversalPageId> removed_keys;
+    // Always `queue.end()` for LRU.
+    QueueIter protected_begin = queue.end();
+    size_t protected_size = 0;
 };
 
 
@@ -157,6 +186,7 @@ public:
         // TODO: May be better to manage the underlying storage by this module itself?
         UniversalPageStoragePtr underlying_storage;
         size_t max_size_bytes = 0; // 0 means unlimited.
+        CachePolicy policy = CachePolicy::LRU;
     };
 
     explicit RNLocalPageCache(const RNLocalPageCacheOptions & options);
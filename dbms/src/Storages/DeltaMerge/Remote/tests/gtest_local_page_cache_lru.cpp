@@ -144,4 +144,72 @@ TEST_F(LocalPageCacheLRUTest, PutDifferentSize)
                  DB::Exception);
 }
 
+TEST_F(LocalPageCacheLRUTest, ScanResistance)
+{
+    auto run_scan = [](CachePolicy policy) {
+        RNLocalPageCacheLRU lru(10, policy);
+        for (const auto & key : {"hot_1", "hot_2"})
+        {
+            lru.put(key, 1);
+            // The pages are removed when they are in use, and put back after that.
+            lru.remove(key);
+            lru.put(key, 1);
+        }
+
+        // A scan over the pages that are accessed only once.
+        for (size_t i = 0; i < 20; ++i)
+        {
+            lru.put(fmt::format("cold_{}", i), 1);
+            EXPECT_LE(lru.evict().size(), 1);
+            EXPECT_LE(lru.current_total_size, 10);
+            EXPECT_EQ(lru.index.size(), lru.queue.size());
+        }
+        return lru.index.count("hot_1") + lru.index.count("hot_2");
+    };
+
+    ASSERT_EQ(run_scan(CachePolicy::TinyLFU), 2);
+    // The hot pages are flushed by the scan.
+    ASSERT_EQ(run_scan(CachePolicy::LRU), 0);
+}
+
+TEST_F(LocalPageCacheLRUTest, TinyLFUSegments)
+{
+    RNLocalPageCacheLRU lru(10, CachePolicy::TinyLFU);
+    lru.put("key_1", 3);
+    lru.put("key_2", 3);
+    ASSERT_EQ(lru.protected_size, 0);
+
+    // Put again, it is moved to the protected segment.
+    lru.put("key_1", 3);
+    ASSERT_EQ(lru.protected_size, 3);
+    ASSERT_EQ("key_1", *lru.protected_begin);
+
+    // Accessed before, it is put into the protected segment directly.
+    ASSERT_TRUE(lru.remove("key_2"));
+    lru.put("key_2", 3);
+    ASSERT_EQ(lru.protected_size, 6);
+    ASSERT_EQ(lru.protected_begin, lru.queue.begin());
+
+    // The protected segment is limited to 80% of max_size, the oldest one is demoted.
+    lru.put("key_3", 3);
+    lru.put("key_3", 3);
+    ASSERT_EQ(lru.protected_size, 6);
+    ASSERT_EQ("key_1", *lru.queue.begin());
+    ASSERT_EQ("key_2", *lru.protected_begin);
+
+    // key_4 is newer than key_1 but accessed less frequently, so it is not admitted.
+    lru.put("key_4", 2);
+    auto evicted = lru.evict();
+    ASSERT_EQ(evicted.size(), 1);
+    ASSERT_EQ("key_4", evicted[0]);
+    ASSERT_EQ(lru.current_total_size, 9);
+
+    ASSERT_TRUE(lru.remove("key_2"));
+    ASSERT_EQ("key_3", *lru.protected_begin);
+    ASSERT_EQ(lru.protected_size, 3);
+    ASSERT_TRUE(lru.remove("key_3"));
+    ASSERT_EQ(lru.protected_begin, lru.queue.end());
+    ASSERT_EQ(lru.protected_size, 0);
+}
+
 } // namespace DB::DM::Remote::tests
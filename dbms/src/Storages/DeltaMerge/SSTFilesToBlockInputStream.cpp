@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/Stopwatch.h>
+#include <Common/ThreadManager.h>
+#include <Common/TiFlashMetrics.h>
 #include <Interpreters/Context.h>
 #include <Poco/File.h>
 #include <RaftStoreProxyFFI/ColumnFamily.h>
@@ -29,6 +32,8 @@
 #include <Storages/Transaction/TMTContext.h>
 #include <common/logger_useful.h>
 
+#include <ext/scope_guard.h>
+
 namespace DB
 {
 namespace ErrorCodes
@@ -106,6 +111,8 @@ void SSTFilesToBlockInputStream::readPrefix()
     process_keys.default_cf = 0;
     process_keys.write_cf = 0;
     process_keys.lock_cf = 0;
+
+    parallel_load_cf = tmt.getContext().getSettingsRef().dt_sst_to_dtfile_pipeline_queue_size > 0;
 }
 
 void SSTFilesToBlockInputStream::readSuffix()
@@ -119,10 +126,20 @@ void SSTFilesToBlockInputStream::readSuffix()
     write_cf_reader.reset();
     default_cf_reader.reset();
     lock_cf_reader.reset();
+
+    GET_METRIC(tiflash_raft_sst2dt_stage_bytes, type_read_sst).Increment(read_sst_bytes.load());
+    GET_METRIC(tiflash_raft_sst2dt_stage_seconds, type_read_sst).Increment(read_sst_ns / 1'000'000'000.0);
+    GET_METRIC(tiflash_raft_sst2dt_stage_bytes, type_decode).Increment(decode_bytes);
+    GET_METRIC(tiflash_raft_sst2dt_stage_seconds, type_decode).Increment(decode_ns / 1'000'000'000.0);
 }
 
 Block SSTFilesToBlockInputStream::read()
 {
+    // The time of reading SST files is the time of this function excluding decoding.
+    Stopwatch watch;
+    const size_t decode_ns_before = decode_ns;
+    SCOPE_EXIT({ read_sst_ns += watch.elapsed() - (decode_ns - decode_ns_before); });
+
     std::string loaded_write_cf_key;
     while (write_cf_reader && write_cf_reader->remained())
     {
@@ -137,6 +154,7 @@ Block SSTFilesToBlockInputStream::read()
             BaseBuffView key = write_cf_reader->keyView();
             BaseBuffView value = write_cf_reader->valueView();
             region->insert(ColumnFamilyType::Write, TiKVKey(key.data, key.len), TiKVValue(value.data, value.len));
+            read_sst_bytes += key.len + value.len;
             ++process_keys.write_cf;
             if (process_keys.write_cf % expected_size == 0)
             {
@@ -150,8 +168,7 @@ Block SSTFilesToBlockInputStream::read()
             const DecodedTiKVKey rowkey = RecordKVFormat::decodeTiKVKey(TiKVKey(std::move(loaded_write_cf_key)));
             loaded_write_cf_key.clear();
             // Batch the loading from other CFs until we need to decode data
-            loadCFDataFromSST(ColumnFamilyType::Default, &rowkey);
-            loadCFDataFromSST(ColumnFamilyType::Lock, &rowkey);
+            loadCFsDataFromSST(&rowkey);
 
             auto block = readCommitedBlock();
             if (block.rows() != 0)
@@ -160,13 +177,45 @@ Block SSTFilesToBlockInputStream::read()
         }
     }
     // Load all key-value pairs from other CFs
-    loadCFDataFromSST(ColumnFamilyType::Default, nullptr);
-    loadCFDataFromSST(ColumnFamilyType::Lock, nullptr);
+    loadCFsDataFromSST(nullptr);
 
     // All uncommitted data are saved in `region`, decode the last committed rows.
     return readCommitedBlock();
 }
 
+void SSTFilesToBlockInputStream::loadCFsDataFromSST(const DecodedTiKVKey * const rowkey_to_be_included)
+{
+    if (!parallel_load_cf || !default_cf_reader || !lock_cf_reader)
+    {
+        loadCFDataFromSST(ColumnFamilyType::Default, rowkey_to_be_included);
+        loadCFDataFromSST(ColumnFamilyType::Lock, rowkey_to_be_included);
+        return;
+    }
+
+    // The key-values of different CFs are inserted into different maps of the region, so
+    // reading the SST files of the default and lock CF can be done concurrently.
+    auto thread_manager = newThreadManager();
+    thread_manager->schedule(true, "SSTLoadLockCF", [&] { loadCFDataFromSST(ColumnFamilyType::Lock, rowkey_to_be_included); });
+    try
+    {
+        loadCFDataFromSST(ColumnFamilyType::Default, rowkey_to_be_included);
+    }
+    catch (...)
+    {
+        // Make sure the task is finished before unwinding
+        try
+        {
+            thread_manager->wait();
+        }
+        catch (...)
+        {
+            tryLogCurrentException(log, "Error while loading lock CF");
+        }
+        throw;
+    }
+    thread_manager->wait();
+}
+
 void SSTFilesToBlockInputStream::loadCFDataFromSST(ColumnFamilyType cf, const DecodedTiKVKey * const rowkey_to_be_included)
 {
     SSTReader * reader;
@@ -196,6 +245,7 @@ void SSTFilesToBlockInputStream::loadCFDataFromSST(ColumnFamilyType cf, const De
             BaseBuffView value = reader->valueView();
             // TODO: use doInsert to avoid locking
             region->insert(cf, TiKVKey(key.data, key.len), TiKVValue(value.data, value.len), DupCheck::AllowSame);
+            read_sst_bytes += key.len + value.len;
             reader->next();
             (*p_process_keys) += 1;
         }
@@ -229,6 +279,7 @@ void SSTFilesToBlockInputStream::loadCFDataFromSST(ColumnFamilyType cf, const De
                 BaseBuffView value = reader->valueView();
                 // TODO: use doInsert to avoid locking
                 region->insert(cf, TiKVKey(key.data, key.len), TiKVValue(value.data, value.len));
+                read_sst_bytes += key.len + value.len;
                 (*p_process_keys) += 1;
                 if (*p_process_keys == process_keys_offset_end)
                 {
@@ -250,11 +301,15 @@ Block SSTFilesToBlockInputStream::readCommitedBlock()
     if (is_decode_cancelled)
         return {};
 
+    Stopwatch watch;
+    SCOPE_EXIT({ decode_ns += watch.elapsed(); });
     try
     {
         // Read block from `region`. If the schema has been updated, it will
         // throw an exception with code `ErrorCodes::REGION_DATA_SCHEMA_UPDATED`
-        return GenRegionBlockDataWithSchema(region, schema_snap, gc_safepoint, force_decode, tmt);
+        auto block = GenRegionBlockDataWithSchema(region, schema_snap, gc_safepoint, force_decode, tmt);
+        decode_bytes += block.bytes();
+        return block;
     }
     catch (DB::Exception & e)
     {
@@ -19,6 +19,7 @@
 #include <Storages/DeltaMerge/DMVersionFilterBlockInputStream.h>
 #include <Storages/Transaction/PartitionStreams.h>
 
+#include <atomic>
 #include <memory>
 #include <string_view>
 
@@ -86,6 +87,8 @@ public:
 
 private:
     void loadCFDataFromSST(ColumnFamilyType cf, const DecodedTiKVKey * rowkey_to_be_included);
+    /// Load the key-values from the default and lock CF.
+    void loadCFsDataFromSST(const DecodedTiKVKey * rowkey_to_be_included);
 
     Block readCommitedBlock();
 
@@ -111,8 +114,16 @@ private:
 
     const bool force_decode;
     bool is_decode_cancelled = false;
+    // Load the default and lock CF in different threads.
+    bool parallel_load_cf = false;
 
     ProcessKeys process_keys;
+
+    // The statistics of reading SST files and decoding rows, reported to metrics in `readSuffix`.
+    std::atomic<size_t> read_sst_bytes = 0;
+    size_t read_sst_ns = 0;
+    size_t decode_bytes = 0;
+    size_t decode_ns = 0;
 };
 
 // Bound the blocks read from SSTFilesToBlockInputStream by column `_tidb_rowid` and
@@ -12,8 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/MPMCQueue.h>
 #include <Common/ProfileEvents.h>
 #include <Common/Stopwatch.h>
+#include <Common/ThreadManager.h>
 #include <Common/TiFlashMetrics.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/SharedContexts/Disagg.h>
@@ -53,6 +55,7 @@ SSTFilesToDTFilesOutputStream<ChildStream>::SSTFilesToDTFilesOutputStream( //
     , job_type(job_type_)
     , split_after_rows(split_after_rows_)
     , split_after_size(split_after_size_)
+    , pipeline_queue_size(context_.getSettingsRef().dt_sst_to_dtfile_pipeline_queue_size)
     , context(context_)
     , log(Logger::get(log_prefix_))
 {
@@ -67,6 +70,8 @@ void SSTFilesToDTFilesOutputStream<ChildStream>::writePrefix()
     child->readPrefix();
     total_committed_rows = 0;
     total_committed_bytes = 0;
+    last_mvcc_stats = {};
+    write_dtfile_ns = 0;
     watch.start();
 }
 
@@ -77,6 +82,9 @@ void SSTFilesToDTFilesOutputStream<ChildStream>::writeSuffix()
 
     finalizeDTFileStream();
 
+    GET_METRIC(tiflash_raft_sst2dt_stage_bytes, type_write_dtfile).Increment(total_committed_bytes);
+    GET_METRIC(tiflash_raft_sst2dt_stage_seconds, type_write_dtfile).Increment(write_dtfile_ns / 1'000'000'000.0);
+
     const auto process_keys = child->getProcessKeys();
     switch (job_type)
     {
@@ -185,7 +193,9 @@ bool SSTFilesToDTFilesOutputStream<ChildStream>::finalizeDTFileStream()
         return false;
     }
 
+    Stopwatch write_watch;
     dt_stream->writeSuffix();
+    write_dtfile_ns += write_watch.elapsed();
     auto dt_file = dt_stream->getFile();
     assert(!dt_file->canGC()); // The DTFile should not be able to gc until it is ingested.
     const auto bytes_written = dt_file->getBytesOnDisk();
@@ -213,82 +223,147 @@ bool SSTFilesToDTFilesOutputStream<ChildStream>::finalizeDTFileStream()
 template <typename ChildStream>
 void SSTFilesToDTFilesOutputStream<ChildStream>::write()
 {
-    size_t last_effective_num_rows = 0;
-    size_t last_not_clean_rows = 0;
-    size_t last_deleted_rows = 0;
-    size_t cur_effective_num_rows = 0;
-    size_t cur_not_clean_rows = 0;
-    size_t cur_deleted_rows = 0;
+    if (pipeline_queue_size > 0)
+    {
+        writeInPipeline();
+        return;
+    }
+
     while (true)
     {
         Block block = child->read();
         if (!block)
             break;
-        if (unlikely(block.rows() == 0))
-            continue;
+        if (!writeBlock(std::move(block), child->getMvccStatistics()))
+            break;
+    }
+}
 
-        if (dt_stream == nullptr)
+template <typename ChildStream>
+void SSTFilesToDTFilesOutputStream<ChildStream>::writeInPipeline()
+{
+    // Read SST files and decode blocks in another thread, while writing the decoded blocks to DTFiles in this thread.
+    // The mvcc statistics of a block must be got right after it is read from the child.
+    MPMCQueue<std::pair<Block, MvccStatistics>> decoded_blocks(pipeline_queue_size);
+    auto thread_manager = newThreadManager();
+    thread_manager->schedule(true, "SSTDecode", [&] {
+        try
         {
-            // If can not create DTFile stream (the storage may be dropped / shutdown),
-            // break the writing loop.
-            if (bool ok = newDTFileStream(); !ok)
-                break;
+            while (true)
+            {
+                Block block = child->read();
+                if (!block)
+                    break;
+                auto mvcc_stats = child->getMvccStatistics();
+                // Cancelled by the writer
+                if (decoded_blocks.push(std::make_pair(std::move(block), mvcc_stats)) != MPMCQueueResult::OK)
+                    return;
+            }
+            decoded_blocks.finish();
+        }
+        catch (...)
+        {
+            decoded_blocks.cancel();
+            throw;
         }
+    });
 
+    try
+    {
+        std::pair<Block, MvccStatistics> decoded;
+        while (decoded_blocks.pop(decoded) == MPMCQueueResult::OK)
         {
-            // Check whether rows are sorted by handle & version in ascending order.
-            SortDescription sort;
-            sort.emplace_back(MutableSupport::tidb_pk_column_name, 1, 0);
-            sort.emplace_back(MutableSupport::version_column_name, 1, 0);
+            if (!writeBlock(std::move(decoded.first), decoded.second))
+                break;
+        }
+    }
+    catch (...)
+    {
+        decoded_blocks.cancel();
+        try
+        {
+            thread_manager->wait();
+        }
+        catch (...)
+        {
+            tryLogCurrentException(log, "Error while decoding SST files");
+        }
+        throw;
+    }
+    // Stop the decoding thread if the writing is stopped early. The exception thrown
+    // by the decoding thread is rethrown here.
+    decoded_blocks.cancel();
+    thread_manager->wait();
+}
+
+template <typename ChildStream>
+bool SSTFilesToDTFilesOutputStream<ChildStream>::writeBlock(Block && block, const MvccStatistics & mvcc_stats)
+{
+    if (unlikely(block.rows() == 0))
+        return true;
+
+    if (dt_stream == nullptr)
+    {
+        // If can not create DTFile stream (the storage may be dropped / shutdown),
+        // stop writing.
+        if (bool ok = newDTFileStream(); !ok)
+            return false;
+    }
+
+    {
+        // Check whether rows are sorted by handle & version in ascending order.
+        SortDescription sort;
+        sort.emplace_back(MutableSupport::tidb_pk_column_name, 1, 0);
+        sort.emplace_back(MutableSupport::version_column_name, 1, 0);
 
-            if (unlikely(block.rows() > 1 && !isAlreadySorted(block, sort)))
+        if (unlikely(block.rows() > 1 && !isAlreadySorted(block, sort)))
+        {
+            const String error_msg
+                = fmt::format("The block decoded from SSTFile is not sorted by primary key and version {}", child->getRegion()->toString(true));
+            LOG_ERROR(log, error_msg);
+            FieldVisitorToString visitor;
+            const size_t nrows = block.rows();
+            for (size_t i = 0; i < nrows; ++i)
             {
-                const String error_msg
-                    = fmt::format("The block decoded from SSTFile is not sorted by primary key and version {}", child->getRegion()->toString(true));
-                LOG_ERROR(log, error_msg);
-                FieldVisitorToString visitor;
-                const size_t nrows = block.rows();
-                for (size_t i = 0; i < nrows; ++i)
-                {
-                    const auto & pk_col = block.getByName(MutableSupport::tidb_pk_column_name);
-                    const auto & ver_col = block.getByName(MutableSupport::version_column_name);
-                    LOG_ERROR(
-                        log,
-                        "[Row={}/{}] [pk={}] [ver={}]",
-                        i,
-                        nrows,
-                        applyVisitor(visitor, (*pk_col.column)[i]),
-                        applyVisitor(visitor, (*ver_col.column)[i]));
-                }
-                throw Exception(error_msg);
+                const auto & pk_col = block.getByName(MutableSupport::tidb_pk_column_name);
+                const auto & ver_col = block.getByName(MutableSupport::version_column_name);
+                LOG_ERROR(
+                    log,
+                    "[Row={}/{}] [pk={}] [ver={}]",
+                    i,
+                    nrows,
+                    applyVisitor(visitor, (*pk_col.column)[i]),
+                    applyVisitor(visitor, (*ver_col.column)[i]));
             }
+            throw Exception(error_msg);
         }
-
-        updateRangeFromNonEmptyBlock(block); // We have checked block is not empty previously.
-
-        // Write block to the output stream
-        DMFileBlockOutputStream::BlockProperty property;
-        std::tie(cur_effective_num_rows, cur_not_clean_rows, cur_deleted_rows, property.gc_hint_version) //
-            = child->getMvccStatistics();
-        property.effective_num_rows = cur_effective_num_rows - last_effective_num_rows;
-        property.not_clean_rows = cur_not_clean_rows - last_not_clean_rows;
-        property.deleted_rows = cur_deleted_rows - last_deleted_rows;
-        last_effective_num_rows = cur_effective_num_rows;
-        last_not_clean_rows = cur_not_clean_rows;
-        last_deleted_rows = cur_deleted_rows;
-        dt_stream->write(block, property);
-
-        auto rows = block.rows();
-        auto bytes = block.bytes();
-        total_committed_rows += rows;
-        total_committed_bytes += bytes;
-        committed_rows_this_dt_file += rows;
-        committed_bytes_this_dt_file += bytes;
-        auto should_split_dt_file = ((split_after_rows > 0 && committed_rows_this_dt_file >= split_after_rows) || //
-                                     (split_after_size > 0 && committed_bytes_this_dt_file >= split_after_size));
-        if (should_split_dt_file)
-            finalizeDTFileStream();
     }
+
+    updateRangeFromNonEmptyBlock(block); // We have checked block is not empty previously.
+
+    // Write block to the output stream
+    DMFileBlockOutputStream::BlockProperty property;
+    const auto & [cur_effective_num_rows, cur_not_clean_rows, cur_deleted_rows, gc_hint_version] = mvcc_stats;
+    property.effective_num_rows = cur_effective_num_rows - std::get<0>(last_mvcc_stats);
+    property.not_clean_rows = cur_not_clean_rows - std::get<1>(last_mvcc_stats);
+    property.deleted_rows = cur_deleted_rows - std::get<2>(last_mvcc_stats);
+    property.gc_hint_version = gc_hint_version;
+    last_mvcc_stats = mvcc_stats;
+    Stopwatch write_watch;
+    dt_stream->write(block, property);
+    write_dtfile_ns += write_watch.elapsed();
+
+    auto rows = block.rows();
+    auto bytes = block.bytes();
+    total_committed_rows += rows;
+    total_committed_bytes += bytes;
+    committed_rows_this_dt_file += rows;
+    committed_bytes_this_dt_file += bytes;
+    auto should_split_dt_file = ((split_after_rows > 0 && committed_rows_this_dt_file >= split_after_rows) || //
+                                 (split_after_size > 0 && committed_bytes_this_dt_file >= split_after_size));
+    if (should_split_dt_file)
+        finalizeDTFileStream();
+    return true;
 }
 
 template <typename ChildStream>
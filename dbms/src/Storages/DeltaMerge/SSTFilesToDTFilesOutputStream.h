@@ -82,6 +82,8 @@ public:
 
     void writePrefix();
     void writeSuffix();
+    /// Read blocks from the child and write them to DTFiles. If `dt_sst_to_dtfile_pipeline_queue_size` is not 0,
+    /// the child is read in another thread, and at most that number of blocks are buffered for writing.
     void write();
 
     /**
@@ -93,6 +95,16 @@ public:
     void cancel();
 
 private:
+    // (effective rows, not clean rows, is delete rows, gc hint version) returned by `child->getMvccStatistics()`
+    using MvccStatistics = std::tuple<size_t, size_t, size_t, UInt64>;
+
+    void writeInPipeline();
+
+    /**
+     * Write a block read from the child. Returns false if the DTFile can not be created.
+     */
+    bool writeBlock(Block && block, const MvccStatistics & mvcc_stats);
+
     /**
      * Generate a DMFilePtr and its DMFileBlockOutputStream.
      */
@@ -114,6 +126,7 @@ private:
     const FileConvertJobType job_type;
     const UInt64 split_after_rows;
     const UInt64 split_after_size;
+    const size_t pipeline_queue_size;
     Context & context;
     LoggerPtr log;
 
@@ -134,6 +147,10 @@ private:
     size_t total_committed_rows = 0;
     size_t total_committed_bytes = 0;
 
+    MvccStatistics last_mvcc_stats{};
+
+    size_t write_dtfile_ns = 0;
+
     Stopwatch watch;
 };
 
@@ -50,6 +50,12 @@ public:
 
     std::atomic<uint64_t> total_user_read_bytes{0};
 
+    /// sum of rows read by the filter columns in late materialization among this query
+    std::atomic<uint64_t> total_late_materialization_filter_rows{0};
+
+    /// sum of rows passed the pushed down filter and MVCC in late materialization among this query
+    std::atomic<uint64_t> total_late_materialization_passed_rows{0};
+
     ScanContext() = default;
 
     void deserialize(const tipb::TiFlashScanContext & tiflash_scan_context_pb)
@@ -94,6 +100,8 @@ public:
         total_local_region_num += other.total_local_region_num;
         total_remote_region_num += other.total_remote_region_num;
         total_user_read_bytes += other.total_user_read_bytes;
+        total_late_materialization_filter_rows += other.total_late_materialization_filter_rows;
+        total_late_materialization_passed_rows += other.total_late_materialization_passed_rows;
     }
 
     void merge(const tipb::TiFlashScanContext & other)
@@ -110,6 +118,20 @@ public:
         total_user_read_bytes += other.total_user_read_bytes();
     }
 
+    /// Late materialization only pays off when the pushed down filter filters out enough rows.
+    /// Returns false if more than `max_passed_ratio` of the rows read by late materialization passed
+    /// the filter, after at least `sample_rows` rows have been read.
+    /// Note this is a query level heuristic: the rows are counted over all the segments read by this
+    /// query so far, and the result is applied to the segments that are not read yet.
+    bool isLateMaterializationWorthInQuery(size_t sample_rows, double max_passed_ratio) const
+    {
+        uint64_t filter_rows = total_late_materialization_filter_rows.load(std::memory_order_relaxed);
+        if (filter_rows < sample_rows)
+            return true;
+        uint64_t passed_rows = total_late_materialization_passed_rows.load(std::memory_order_relaxed);
+        return static_cast<double>(passed_rows) <= static_cast<double>(filter_rows) * max_passed_ratio;
+    }
+
     // Reference: https://docs.pingcap.com/tidb/dev/tidb-resource-control
     // For Read I/O, 1/64 RU per KB.
     double getReadRU() const
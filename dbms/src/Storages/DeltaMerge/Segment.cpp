@@ -117,6 +117,8 @@ extern const int UNKNOWN_FORMAT_VERSION;
 namespace DM
 {
 const static size_t SEGMENT_BUFFER_SIZE = 128; // More than enough.
+// The number of rows read by late materialization in a query before deciding whether it is worth for the rest segments.
+const static size_t LATE_MATERIALIZATION_SAMPLE_ROWS = DEFAULT_MERGE_BLOCK_SIZE * 8;
 
 DMFilePtr writeIntoNewDMFile(DMContext & dm_context, //
                              const ColumnDefinesPtr & schema_snap,
@@ -914,7 +916,11 @@ BlockInputStreamPtr Segment::getInputStreamModeFast(
         expected_block_size,
         /* enable_handle_clean_read */ enable_handle_clean_read,
         /* is_fast_scan */ true,
-        /* enable_del_clean_read */ enable_del_clean_read);
+        /* enable_del_clean_read */ enable_del_clean_read,
+        /* read_packs */ {},
+        /* need_row_id */ false,
+        // The blocks of stable are only filtered, their order does not matter.
+        /* enable_scan_sharing */ true);
 
     BlockInputStreamPtr delta_stream = std::make_shared<DeltaValueInputStream>(dm_context, segment_snap->delta, new_columns_to_read, this->rowkey_range);
 
@@ -2033,6 +2039,10 @@ void Segment::placeDeltaIndex(DMContext & dm_context) const
     if (!segment_snap)
         return;
     placeDeltaIndex(dm_context, segment_snap);
+
+    // The snapshot for update blocks the other structure updates of the delta, it is safe to persist the index now.
+    if (dm_context.persist_delta_index_min_rows > 0)
+        delta->persistDeltaIndex(dm_context, segment_snap->stable->getDMFiles());
 }
 
 void Segment::placeDeltaIndex(DMContext & dm_context, const SegmentSnapshotPtr & segment_snap) const
@@ -2226,6 +2236,17 @@ std::pair<DeltaIndexPtr, bool> Segment::ensurePlace(const DMContext & dm_context
                                                     UInt64 max_version) const
 {
     auto delta_snap = delta_reader->getDeltaSnap();
+    // The shared delta index is empty after restart or being evicted by DeltaIndexManager.
+    // Try to load the persisted one, so that only the column files appended after it need to be placed.
+    if (auto [shared_placed_rows, shared_placed_deletes] = delta_snap->getSharedDeltaIndex()->getPlacedStatus();
+        shared_placed_rows == 0 && shared_placed_deletes == 0)
+    {
+        if (auto persisted_index = delta_snap->loadPersistedDeltaIndex(dm_context, stable_snap->getDMFiles()); persisted_index)
+        {
+            delta_snap->getSharedDeltaIndex()->updateIfAdvanced(*persisted_index);
+            LOG_DEBUG(log, "Loaded persisted delta index, delta_index={}", persisted_index->toString());
+        }
+    }
     // Clone a new delta index.
     auto my_delta_index = delta_snap->getSharedDeltaIndex()->tryClone(delta_snap->getRows(), delta_snap->getDeletes());
     auto my_delta_tree = my_delta_index->getDeltaTree();
@@ -2471,14 +2492,110 @@ BitmapFilterPtr Segment::buildBitmapFilter(const DMContext & dm_context,
 {
     RUNTIME_CHECK_MSG(!dm_context.read_delta_only, "Read delta only is unsupported");
 
-    if (dm_context.read_stable_only || (segment_snap->delta->getRows() == 0 && segment_snap->delta->getDeletes() == 0))
+    auto build = [&](const RSOperatorPtr & rs_filter) {
+        if (dm_context.read_stable_only || (segment_snap->delta->getRows() == 0 && segment_snap->delta->getDeletes() == 0))
+        {
+            return buildBitmapFilterStableOnly(dm_context, segment_snap, read_ranges, rs_filter, max_version, expected_block_size);
+        }
+        else
+        {
+            return buildBitmapFilterNormal(dm_context, segment_snap, read_ranges, rs_filter, max_version, expected_block_size);
+        }
+    };
+
+    // Only the bitmap filters of the whole segment are cached, the reads of part of a segment are rarely repeated.
+    // Under disagg mode, the segments on the compute node are built from the remote segments of different stores
+    // with epoch 0, so the cache key below can not identify the data, the cache is only used under non-disagg mode.
+    auto cache = dm_context.db_context.getGlobalContext().getBitmapFilterCache();
+    if (!cache || !dm_context.db_context.getSharedContextDisagg()->notDisaggregatedMode())
+        return build(filter);
+    if (read_ranges.size() != 1 || !(read_ranges[0] == rowkey_range))
+        return build(filter);
+
+    // The stable of a segment never changes in the same epoch, and the delta is append only,
+    // the column files are only flushed or compacted without changing the order of rows.
+    // So the number of rows and deletes of the delta identifies the data of the snapshot.
+    auto key = fmt::format(
+        "{}_{}_{}_{}_{}_{}_{}",
+        dm_context.keyspace_id,
+        dm_context.physical_table_id,
+        segment_id,
+        epoch,
+        segment_snap->delta->getRows(),
+        segment_snap->delta->getDeletes(),
+        dm_context.read_stable_only);
+    if (auto entry = cache->get(key); entry && entry->max_data_version <= max_version)
+        return entry->bitmap_filter;
+
+    // All the rows are visible to the read TSOs not less than the max data version, so the bitmap filter is the
+    // same for all of them. The rough set filter is not applied to the cached bitmap filter, it only skips packs
+    // that are also skipped by the data streams, so the bitmap filter can be shared by the reads with any filter.
+    auto max_data_version = getMaxDataVersion(dm_context, segment_snap);
+    if (max_version < max_data_version)
+        return build(filter);
+    auto entry = std::make_shared<BitmapFilterCacheEntry>();
+    entry->bitmap_filter = build(EMPTY_RS_OPERATOR);
+    entry->max_data_version = max_data_version;
+    cache->set(key, entry);
+    return entry->bitmap_filter;
+}
+
+UInt64 Segment::getMaxDataVersion(const DMContext & dm_context, const SegmentSnapshotPtr & segment_snap) const
+{
+    const auto delta_rows = segment_snap->delta->getRows();
+    const auto delta_deletes = segment_snap->delta->getDeletes();
     {
-        return buildBitmapFilterStableOnly(dm_context, segment_snap, read_ranges, filter, max_version, expected_block_size);
+        std::lock_guard lock(max_data_version_mutex);
+        if (max_data_version_cache && max_data_version_cache->delta_rows == delta_rows && max_data_version_cache->delta_deletes == delta_deletes)
+            return max_data_version_cache->max_data_version;
     }
-    else
+
+    UInt64 max_data_version = 0;
+    for (const auto & dmfile : segment_snap->stable->getDMFiles())
     {
-        return buildBitmapFilterNormal(dm_context, segment_snap, read_ranges, filter, max_version, expected_block_size);
+        if (dmfile->getPacks() == 0)
+            continue;
+        if (!dmfile->isColIndexExist(VERSION_COLUMN_ID))
+            return std::numeric_limits<UInt64>::max();
+        // The max versions of packs are read from the MinMax index, which is usually cached.
+        auto pack_filter = DMFilePackFilter::loadFrom(
+            dmfile,
+            dm_context.db_context.getMinMaxIndexCache(),
+            dm_context.db_context.getBloomFilterIndexCache(),
+            /*set_cache_if_miss*/ true,
+            {rowkey_range},
+            EMPTY_RS_OPERATOR,
+            /*read_pack*/ {},
+            dm_context.db_context.getFileProvider(),
+            dm_context.db_context.getReadLimiter(),
+            dm_context.scan_context,
+            dm_context.tracing_id);
+        const auto & use_packs = pack_filter.getUsePacksConst();
+        for (size_t pack_id = 0; pack_id < use_packs.size(); ++pack_id)
+        {
+            if (use_packs[pack_id])
+                max_data_version = std::max(max_data_version, pack_filter.getMaxVersion(pack_id));
+        }
+    }
+
+    if (delta_rows > 0)
+    {
+        auto columns = std::make_shared<ColumnDefines>(ColumnDefines{getVersionColumnDefine()});
+        DeltaValueInputStream stream(dm_context, segment_snap->delta, columns, rowkey_range);
+        while (Block block = stream.read())
+        {
+            for (auto version : toColumnVectorData<UInt64>(block.getByPosition(0).column))
+                max_data_version = std::max(max_data_version, version);
+        }
     }
+
+    std::lock_guard lock(max_data_version_mutex);
+    max_data_version_cache = MaxDataVersionCache{
+        .delta_rows = delta_rows,
+        .delta_deletes = delta_deletes,
+        .max_data_version = max_data_version,
+    };
+    return max_data_version;
 }
 
 BitmapFilterPtr Segment::buildBitmapFilterNormal(const DMContext & dm_context,
@@ -2550,6 +2667,7 @@ std::pair<std::vector<Range>, std::vector<IdSetPtr>> parseDMFilePackInfo(const D
         DMFilePackFilter pack_filter = DMFilePackFilter::loadFrom(
             dmfile,
             dm_context.db_context.getMinMaxIndexCache(),
+            dm_context.db_context.getBloomFilterIndexCache(),
             /*set_cache_if_miss*/ true,
             read_ranges,
             filter,
@@ -2700,7 +2818,11 @@ BlockInputStreamPtr Segment::getBitmapFilterInputStream(BitmapFilterPtr && bitma
         expected_block_size,
         enable_handle_clean_read,
         is_fast_scan,
-        enable_del_clean_read);
+        enable_del_clean_read,
+        /*read_packs*/ {},
+        /*need_row_id*/ false,
+        // The bitmap filter is applied by the start offset of blocks, their order does not matter.
+        /*enable_scan_sharing*/ true);
 
     auto columns_to_read_ptr = std::make_shared<ColumnDefines>(columns_to_read);
     SkippableBlockInputStreamPtr delta_stream = std::make_shared<DeltaValueInputStream>(
@@ -2822,9 +2944,41 @@ BlockInputStreamPtr Segment::getLateMaterializationStream(BitmapFilterPtr && bit
         dm_context.tracing_id);
 
     // construct late materialization stream
-    return std::make_shared<LateMaterializationBlockInputStream>(columns_to_read, filter->filter_column_name, filter_column_stream, rest_column_stream, bitmap_filter, dm_context.tracing_id);
+    return std::make_shared<LateMaterializationBlockInputStream>(columns_to_read, filter->filter_column_name, filter_column_stream, rest_column_stream, bitmap_filter, dm_context.scan_context, dm_context.tracing_id);
 }
 
+namespace
+{
+// `extra_cast` only outputs the casted filter columns. Build the actions that also keep the rest columns
+// in the order of `columns_to_read`, which are used when all the columns are read by one stream.
+ExpressionActionsPtr buildExtraCastWithRestColumns(const ExpressionActions & extra_cast, const ColumnDefines & columns_to_read)
+{
+    NamesAndTypes input_columns;
+    input_columns.reserve(columns_to_read.size());
+    for (const auto & cd : columns_to_read)
+        input_columns.emplace_back(cd.name, cd.type);
+    auto actions = std::make_shared<ExpressionActions>(input_columns);
+    for (auto action : extra_cast.getActions())
+    {
+        if (action.type == ExpressionAction::PROJECT)
+        {
+            NamesWithAliases projections;
+            projections.reserve(columns_to_read.size());
+            for (const auto & cd : columns_to_read)
+            {
+                auto iter = std::find_if(action.projections.begin(), action.projections.end(), [&](const NameWithAlias & p) {
+                    return (p.second.empty() ? p.first : p.second) == cd.name;
+                });
+                projections.emplace_back(iter != action.projections.end() ? *iter : NameWithAlias{cd.name, ""});
+            }
+            action.projections = std::move(projections);
+        }
+        actions->add(action);
+    }
+    return actions;
+}
+} // namespace
+
 RowKeyRanges Segment::shrinkRowKeyRanges(const RowKeyRanges & read_ranges)
 {
     RowKeyRanges real_ranges;
@@ -2860,6 +3014,33 @@ BlockInputStreamPtr Segment::getBitmapFilterInputStream(const DMContext & dm_con
 
     if (filter && filter->before_where)
     {
+        // If the pushed down filter only filters out a few rows in the segments already read by this query, reading
+        // the filter columns and the rest columns separately just merges the delta and stable twice. So read all the
+        // columns together and then filter them. The selectivity is collected by the scan context of the whole query
+        // rather than this segment, since a segment is read only once in a query.
+        if (!dm_context.scan_context->isLateMaterializationWorthInQuery(LATE_MATERIALIZATION_SAMPLE_ROWS, dm_context.late_materialization_max_passed_ratio))
+        {
+            BlockInputStreamPtr stream = getBitmapFilterInputStream(
+                std::move(bitmap_filter),
+                segment_snap,
+                dm_context,
+                columns_to_read,
+                real_ranges,
+                filter->rs_operator,
+                max_version,
+                expected_block_size);
+            if (filter->extra_cast)
+            {
+                stream = std::make_shared<ExpressionBlockInputStream>(stream, buildExtraCastWithRestColumns(*filter->extra_cast, columns_to_read), dm_context.tracing_id);
+                stream->setExtraInfo("cast after tableScan");
+            }
+            stream = std::make_shared<FilterBlockInputStream>(stream, filter->before_where, filter->filter_column_name, dm_context.tracing_id);
+            stream->setExtraInfo("push down filter");
+            stream = std::make_shared<ExpressionBlockInputStream>(stream, filter->project_after_where, dm_context.tracing_id);
+            stream->setExtraInfo("project after where");
+            return stream;
+        }
+
         // if has filter conditions pushed down, use late materialization
         return getLateMaterializationStream(
             std::move(bitmap_filter),
@@ -30,6 +30,9 @@
 #include <Storages/Page/PageDefinesBase.h>
 #include <Storages/Transaction/CheckpointInfo.h>
 
+#include <mutex>
+#include <optional>
+
 namespace DB::DM
 {
 class Segment;
@@ -562,10 +565,21 @@ public:
         const RowKeyRange & check_range,
         bool is_exact);
 
+    /// The max version of the rows in the snapshot. The reads whose read TSO is not less than it see all the rows.
+    /// The stable part is read from the MinMax index of the version column, and the delta part is scanned.
+    /// The result is cached for the latest number of delta rows and deletes, so the delta is only scanned again after it changes.
+    UInt64 getMaxDataVersion(const DMContext & dm_context, const SegmentSnapshotPtr & segment_snap) const;
+
     DB::Timestamp getLastCheckGCSafePoint() { return last_check_gc_safe_point.load(std::memory_order_relaxed); }
 
     void setLastCheckGCSafePoint(DB::Timestamp gc_safe_point) { last_check_gc_safe_point.store(gc_safe_point, std::memory_order_relaxed); }
 
+    /// The read hotness is the number of recent reads on this segment. It is decayed periodically, and inherited by the
+    /// new segments when this segment is replaced, so that the hot segments can be warmed up in background.
+    UInt64 getReadHotness() const { return read_hotness.load(std::memory_order_relaxed); }
+    void addReadHotness(UInt64 n) { read_hotness.fetch_add(n, std::memory_order_relaxed); }
+    void decayReadHotness() { read_hotness.store(read_hotness.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed); }
+
 #ifndef DBMS_PUBLIC_GTEST
 private:
 #else
@@ -690,6 +704,18 @@ private:
 
     std::atomic<DB::Timestamp> last_check_gc_safe_point = 0;
 
+    std::atomic<UInt64> read_hotness = 0;
+
+    // The max data version of the snapshot with the number of delta rows and deletes, see `getMaxDataVersion`.
+    struct MaxDataVersionCache
+    {
+        size_t delta_rows;
+        size_t delta_deletes;
+        UInt64 max_data_version;
+    };
+    mutable std::mutex max_data_version_mutex;
+    mutable std::optional<MaxDataVersionCache> max_data_version_cache;
+
     const DeltaValueSpacePtr delta;
     const StableValueSpacePtr stable;
 
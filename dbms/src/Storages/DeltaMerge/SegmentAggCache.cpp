@@ -0,0 +1,173 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/ProfileEvents.h>
+#include <DataStreams/IProfilingBlockInputStream.h>
+#include <Interpreters/Context.h>
+#include <Storages/DeltaMerge/DMContext.h>
+#include <Storages/DeltaMerge/Delta/DeltaValueSpace.h>
+#include <Storages/DeltaMerge/Segment.h>
+#include <Storages/DeltaMerge/SegmentAggCache.h>
+#include <Storages/DeltaMerge/SegmentReadTaskPool.h>
+
+namespace ProfileEvents
+{
+extern const Event DMSegmentAggCacheHit;
+extern const Event DMSegmentAggCacheMiss;
+} // namespace ProfileEvents
+
+namespace DB::DM
+{
+namespace
+{
+class SegmentAggResultInputStream : public IProfilingBlockInputStream
+{
+    static constexpr auto NAME = "SegmentAggResult";
+
+public:
+    SegmentAggResultInputStream(const SegmentAggResultPtr & result_, const Block & header_)
+        : result(result_)
+        , header(header_)
+    {}
+
+    String getName() const override { return NAME; }
+
+    Block getHeader() const override { return header; }
+
+protected:
+    Block readImpl() override
+    {
+        if (next_block == result->blocks.size())
+            return {};
+        return result->blocks[next_block++];
+    }
+
+private:
+    const SegmentAggResultPtr result;
+    const Block header;
+    size_t next_block = 0;
+};
+
+/// Compute the partial aggregation result of a segment, and put it into the cache after all blocks are read.
+class SegmentAggCachingInputStream : public IProfilingBlockInputStream
+{
+    static constexpr auto NAME = "SegmentAggCaching";
+
+public:
+    SegmentAggCachingInputStream(
+        const BlockInputStreamPtr & input,
+        const SegmentAggCachePtr & cache_,
+        const String & key_,
+        const DMContextPtr & dm_context_,
+        const SegmentReadTaskPtr & task_,
+        UInt64 max_version_)
+        : cache(cache_)
+        , key(key_)
+        , dm_context(dm_context_)
+        , task(task_)
+        , max_version(max_version_)
+        , result(std::make_shared<SegmentAggResult>())
+    {
+        children.push_back(input);
+    }
+
+    String getName() const override { return NAME; }
+
+    Block getHeader() const override { return children.back()->getHeader(); }
+
+protected:
+    Block readImpl() override
+    {
+        Block block = children.back()->read();
+        if (block)
+        {
+            result->bytes += block.allocatedBytes();
+            result->blocks.push_back(block);
+            return block;
+        }
+
+        if (!isCancelled())
+        {
+            // Only cache the result if all the rows are visible, so that it can be reused by the later reads.
+            result->max_data_version = task->segment->getMaxDataVersion(*dm_context, task->read_snapshot);
+            if (result->max_data_version <= max_version)
+                cache->set(key, result);
+        }
+        return block;
+    }
+
+private:
+    const SegmentAggCachePtr cache;
+    const String key;
+    const DMContextPtr dm_context;
+    const SegmentReadTaskPtr task;
+    const UInt64 max_version;
+    SegmentAggResultPtr result;
+};
+} // namespace
+
+void SegmentAggregation::init(const String & fingerprint_, const Block & header_, Transform transform_)
+{
+    RUNTIME_CHECK(!initialized);
+    fingerprint = fingerprint_;
+    header = header_;
+    transform = std::move(transform_);
+    initialized = true;
+}
+
+String SegmentAggregation::genKey(const DMContext & dm_context, const SegmentReadTask & task) const
+{
+    // Like the key of BitmapFilterCache, the stable of a segment never changes in the same epoch, and
+    // the delta is append only. So the number of rows and deletes of the delta identifies the data.
+    return fmt::format(
+        "{}_{}_{}_{}_{}_{}_{}_{}",
+        dm_context.keyspace_id,
+        dm_context.physical_table_id,
+        task.segment->segmentId(),
+        task.segment->segmentEpoch(),
+        task.read_snapshot->delta->getRows(),
+        task.read_snapshot->delta->getDeletes(),
+        DB::DM::toDebugString(task.ranges),
+        fingerprint);
+}
+
+BlockInputStreamPtr SegmentAggregation::getInputStream(
+    const DMContextPtr & dm_context,
+    const SegmentReadTaskPtr & task,
+    UInt64 max_version,
+    const SegmentStreamBuilder & build_segment_stream) const
+{
+    RUNTIME_CHECK(initialized);
+    auto cache = dm_context->db_context.getGlobalContext().getSegmentAggCache();
+    if (!cache)
+        return transform(build_segment_stream());
+
+    auto key = genKey(*dm_context, *task);
+    if (auto result = cache->get(key); result && result->max_data_version <= max_version)
+    {
+        ProfileEvents::increment(ProfileEvents::DMSegmentAggCacheHit);
+        return std::make_shared<SegmentAggResultInputStream>(result, header);
+    }
+
+    ProfileEvents::increment(ProfileEvents::DMSegmentAggCacheMiss);
+    return std::make_shared<SegmentAggCachingInputStream>(
+        transform(build_segment_stream()),
+        cache,
+        key,
+        dm_context,
+        task,
+        max_version);
+}
+
+} // namespace DB::DM
@@ -0,0 +1,104 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/LRUCache.h>
+#include <Core/Block.h>
+#include <DataStreams/IBlockInputStream.h>
+#include <Storages/DeltaMerge/DeltaMergeDefines.h>
+
+#include <functional>
+
+namespace DB::DM
+{
+struct DMContext;
+using DMContextPtr = std::shared_ptr<DMContext>;
+struct SegmentReadTask;
+using SegmentReadTaskPtr = std::shared_ptr<SegmentReadTask>;
+
+/// The partial aggregation result of a segment.
+struct SegmentAggResult
+{
+    Blocks blocks;
+    /// The max version of the rows in the segment snapshot. The result can be reused by the reads
+    /// whose read TSO is not less than it, because all the rows are visible to them.
+    UInt64 max_data_version = 0;
+    size_t bytes = 0;
+};
+
+using SegmentAggResultPtr = std::shared_ptr<SegmentAggResult>;
+
+struct SegmentAggResultWeightFunction
+{
+    size_t operator()(const SegmentAggResult & result) const { return result.bytes; }
+};
+
+/// Cache of the partial aggregation results of segments. The repeated aggregations on the same
+/// data only recompute the segments whose data changed since the last time.
+/// The key is built by `SegmentAggregation::genKey`.
+class SegmentAggCache : public LRUCache<String, SegmentAggResult, std::hash<String>, SegmentAggResultWeightFunction>
+{
+private:
+    using Base = LRUCache<String, SegmentAggResult, std::hash<String>, SegmentAggResultWeightFunction>;
+
+public:
+    explicit SegmentAggCache(size_t max_size_in_bytes)
+        : Base(max_size_in_bytes)
+    {}
+};
+
+using SegmentAggCachePtr = std::shared_ptr<SegmentAggCache>;
+
+/// The aggregation pushed down to the segments. Every segment read task computes the partial
+/// aggregation of its own rows, and the results of all segments are merged by the caller.
+/// The result of a segment is looked up in the SegmentAggCache before reading the segment.
+///
+/// It is passed to the storage before the aggregation is analyzed, and initialized by the caller after
+/// the streams are built and before they are read. If it is never initialized, the segments are read as usual.
+class SegmentAggregation
+{
+public:
+    /// Build the partial aggregation on top of the stream of a segment.
+    using Transform = std::function<BlockInputStreamPtr(const BlockInputStreamPtr &)>;
+    using SegmentStreamBuilder = std::function<BlockInputStreamPtr()>;
+
+    /// `fingerprint` identifies the DAG executed by `transform`, the results are shared by the aggregations with the same fingerprint.
+    void init(const String & fingerprint_, const Block & header_, Transform transform_);
+
+    bool isInitialized() const { return initialized; }
+
+    /// The header of the partial aggregation results.
+    const Block & getHeader() const { return header; }
+
+    /// Return the partial aggregation result of the segment read task. Read from the cache if it is cached,
+    /// otherwise compute it from the stream built by `build_segment_stream` and put it into the cache.
+    BlockInputStreamPtr getInputStream(
+        const DMContextPtr & dm_context,
+        const SegmentReadTaskPtr & task,
+        UInt64 max_version,
+        const SegmentStreamBuilder & build_segment_stream) const;
+
+private:
+    String genKey(const DMContext & dm_context, const SegmentReadTask & task) const;
+
+    bool initialized = false;
+    String fingerprint;
+    Block header;
+    Transform transform;
+};
+
+using SegmentAggregationPtr = std::shared_ptr<SegmentAggregation>;
+
+} // namespace DB::DM
@@ -59,6 +59,7 @@ void StableValueSpace::setFiles(const DMFiles & files_, const RowKeyRange & rang
             auto pack_filter = DMFilePackFilter::loadFrom(
                 file,
                 index_cache,
+                dm_context->db_context.getGlobalContext().getBloomFilterIndexCache(),
                 /*set_cache_if_miss*/ true,
                 {range},
                 EMPTY_RS_OPERATOR,
@@ -347,6 +348,7 @@ void StableValueSpace::calculateStableProperty(const DMContext & context, const
         auto pack_filter = DMFilePackFilter::loadFrom(
             file,
             context.db_context.getGlobalContext().getMinMaxIndexCache(),
+            context.db_context.getGlobalContext().getBloomFilterIndexCache(),
             /*set_cache_if_miss*/ false,
             {rowkey_range},
             EMPTY_RS_OPERATOR,
@@ -431,7 +433,8 @@ StableValueSpace::Snapshot::getInputStream(
     bool is_fast_scan,
     bool enable_del_clean_read,
     const std::vector<IdSetPtr> & read_packs,
-    bool need_row_id)
+    bool need_row_id,
+    bool enable_scan_sharing)
 {
     LOG_DEBUG(log, "max_data_version: {}, enable_handle_clean_read: {}, is_fast_mode: {}, enable_del_clean_read: {}", max_data_version, enable_handle_clean_read, is_fast_scan, enable_del_clean_read);
     SkippableBlockInputStreams streams;
@@ -447,6 +450,9 @@ StableValueSpace::Snapshot::getInputStream(
             .setColumnCache(column_caches[i])
             .setTracingID(context.tracing_id)
             .setRowsThreshold(expected_block_size)
+            // Blocks are only filtered, not merged with delta, in fast scan
+            .enableLowCardinality(is_fast_scan && context.enable_low_cardinality_string)
+            .enableScanSharing(enable_scan_sharing && context.db_context.getSettingsRef().dt_enable_scan_sharing)
             .setReadPacks(read_packs.size() > i ? read_packs[i] : nullptr);
         streams.push_back(builder.build(stable->files[i], read_columns, rowkey_ranges, context.scan_context));
         rows.push_back(stable->files[i]->getRows());
@@ -478,6 +484,7 @@ RowsAndBytes StableValueSpace::Snapshot::getApproxRowsAndBytes(const DMContext &
         auto filter = DMFilePackFilter::loadFrom(
             f,
             context.db_context.getGlobalContext().getMinMaxIndexCache(),
+            context.db_context.getGlobalContext().getBloomFilterIndexCache(),
             /*set_cache_if_miss*/ false,
             {range},
             RSOperatorPtr{},
@@ -523,6 +530,7 @@ StableValueSpace::Snapshot::getAtLeastRowsAndBytes(const DMContext & context, co
         auto filter = DMFilePackFilter::loadFrom(
             file,
             context.db_context.getGlobalContext().getMinMaxIndexCache(),
+            context.db_context.getGlobalContext().getBloomFilterIndexCache(),
             /*set_cache_if_miss*/ false,
             {range},
             RSOperatorPtr{},
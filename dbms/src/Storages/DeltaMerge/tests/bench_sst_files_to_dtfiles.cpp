@@ -0,0 +1,147 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <DataStreams/IProfilingBlockInputStream.h>
+#include <Interpreters/Context.h>
+#include <Storages/DeltaMerge/SSTFilesToDTFilesOutputStream.h>
+#include <Storages/DeltaMerge/tests/DMTestEnv.h>
+#include <Storages/StorageDeltaMerge.h>
+#include <Storages/Transaction/TMTContext.h>
+#include <Storages/Transaction/tests/region_helper.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <benchmark/benchmark.h>
+
+namespace DB
+{
+namespace DM
+{
+namespace tests
+{
+namespace
+{
+constexpr TableID bench_table_id = 100;
+constexpr size_t bench_block_rows = 8192;
+
+/// Generate the blocks when reading, to simulate the cost of decoding SST files.
+class GeneratedBlockInputStream : public IProfilingBlockInputStream
+{
+public:
+    GeneratedBlockInputStream(size_t num_blocks_, DMTestEnv::PkType pk_type_)
+        : num_blocks(num_blocks_)
+        , pk_type(pk_type_)
+    {}
+
+    String getName() const override { return "GeneratedBlocks"; }
+    Block getHeader() const override { return {}; }
+
+protected:
+    Block readImpl() override
+    {
+        if (generated == num_blocks)
+            return {};
+        auto start = static_cast<Int64>(generated * bench_block_rows);
+        ++generated;
+        return DMTestEnv::prepareSimpleWriteBlock(start, start + static_cast<Int64>(bench_block_rows), false, pk_type, 2);
+    }
+
+private:
+    const size_t num_blocks;
+    const DMTestEnv::PkType pk_type;
+    size_t generated = 0;
+};
+} // namespace
+
+class SSTFilesToDTFilesBench : public benchmark::Fixture
+{
+public:
+    void SetUp(const benchmark::State &) override
+    {
+        context = DB::tests::TiFlashTestEnv::getContext();
+        region = makeRegion(1, RecordKVFormat::genKey(bench_table_id, 0), RecordKVFormat::genKey(bench_table_id, std::numeric_limits<Int64>::max()));
+
+        auto columns = DMTestEnv::getDefaultTableColumns(pk_type);
+        auto table_info = DMTestEnv::getMinimalTableInfo(bench_table_id, pk_type);
+        auto astptr = DMTestEnv::getPrimaryKeyExpr("bench_table", pk_type);
+        storage = StorageDeltaMerge::create("TiFlash",
+                                            "default" /* db_name */,
+                                            "bench_table" /* table_name */,
+                                            table_info,
+                                            ColumnsDescription{columns},
+                                            astptr,
+                                            0,
+                                            context->getGlobalContext());
+        storage->startup();
+    }
+
+    void TearDown(const benchmark::State &) override
+    {
+        context->getSettingsRef().dt_sst_to_dtfile_pipeline_queue_size = 0;
+        storage->drop();
+        context->getTMTContext().getStorages().remove(NullspaceID, bench_table_id);
+    }
+
+    void convert(size_t num_blocks)
+    {
+        auto table_lock = storage->lockStructureForShare("bench_query_id");
+        auto [schema_snapshot, unused] = storage->getSchemaSnapshotAndBlockForDecoding(table_lock, false);
+        auto child = std::make_shared<MockSSTFilesToDTFilesOutputStreamChild>(
+            std::make_shared<GeneratedBlockInputStream>(num_blocks, pk_type),
+            region);
+        SSTFilesToDTFilesOutputStream<MockSSTFilesToDTFilesOutputStreamChildPtr> stream(
+            /* log_prefix */ "",
+            child,
+            storage,
+            schema_snapshot,
+            FileConvertJobType::ApplySnapshot,
+            /* split_after_rows */ 0,
+            /* split_after_size */ 0,
+            *context);
+        stream.writePrefix();
+        stream.write();
+        stream.writeSuffix();
+        // Let the generated DTFiles be removed
+        stream.cancel();
+    }
+
+protected:
+    ContextPtr context;
+    RegionPtr region;
+    StorageDeltaMergePtr storage;
+    DMTestEnv::PkType pk_type = DMTestEnv::PkType::HiddenTiDBRowID;
+};
+
+BENCHMARK_DEFINE_F(SSTFilesToDTFilesBench, Convert)
+(benchmark::State & state)
+try
+{
+    context->getSettingsRef().dt_sst_to_dtfile_pipeline_queue_size = static_cast<UInt64>(state.range(0));
+    const auto num_blocks = static_cast<size_t>(state.range(1));
+    for (auto _ : state)
+    {
+        convert(num_blocks);
+    }
+    state.SetItemsProcessed(static_cast<Int64>(state.iterations() * num_blocks * bench_block_rows));
+}
+CATCH
+
+BENCHMARK_REGISTER_F(SSTFilesToDTFilesBench, Convert)
+    ->Unit(benchmark::kMillisecond)
+    ->Args({0, 16})
+    ->Args({4, 16})
+    ->Args({0, 128})
+    ->Args({4, 128});
+
+} // namespace tests
+} // namespace DM
+} // namespace DB
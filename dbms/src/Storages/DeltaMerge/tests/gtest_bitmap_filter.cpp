@@ -0,0 +1,94 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <random>
+
+namespace DB::DM::tests
+{
+TEST(BitmapFilterTest, AcrossWords)
+try
+{
+    constexpr UInt32 rows = 1000;
+    std::mt19937 rng(7);
+    std::vector<UInt8> expected(rows, 0);
+    BitmapFilter filter(rows, false);
+
+    // Ranges start and end in the middle of words and cover whole words.
+    for (auto [start, limit] : std::vector<std::pair<UInt32, UInt32>>{{3, 50}, {60, 200}, {511, 1}, {700, 300}})
+    {
+        filter.set(start, limit);
+        std::fill(expected.begin() + start, expected.begin() + start + limit, 1);
+    }
+    std::vector<UInt32> row_ids;
+    for (UInt32 i = 0; i < 100; ++i)
+        row_ids.push_back(rng() % rows);
+    filter.set(row_ids.data(), row_ids.size(), nullptr);
+    for (auto id : row_ids)
+        expected[id] = 1;
+    filter.runOptimize();
+
+    ASSERT_EQ(filter.count(), std::count(expected.begin(), expected.end(), 1));
+    for (UInt32 start : {0, 1, 63, 64, 65, 127, 700, 999})
+    {
+        for (UInt32 limit : {1, 63, 64, 65, 200})
+        {
+            limit = std::min(limit, rows - start);
+            IColumn::Filter f(limit, 1);
+            if (!filter.get(f, start, limit))
+            {
+                for (UInt32 i = 0; i < limit; ++i)
+                    ASSERT_EQ(f[i], expected[start + i]) << start << " " << i;
+            }
+            else
+            {
+                for (UInt32 i = 0; i < limit; ++i)
+                    ASSERT_EQ(expected[start + i], 1) << start << " " << i;
+            }
+
+            IColumn::Filter and_f(limit);
+            for (auto & v : and_f)
+                v = rng() % 2;
+            auto origin = and_f;
+            filter.rangeAnd(and_f, start, limit);
+            for (UInt32 i = 0; i < limit; ++i)
+                ASSERT_EQ(and_f[i], origin[i] && expected[start + i]) << start << " " << i;
+        }
+    }
+}
+CATCH
+
+TEST(BitmapFilterTest, AllMatch)
+try
+{
+    BitmapFilter filter(130, true);
+    filter.runOptimize();
+    IColumn::Filter f(130, 0);
+    ASSERT_TRUE(filter.get(f, 0, 130));
+    ASSERT_EQ(filter.count(), 130);
+
+    std::vector<UInt32> row_ids{64};
+    IColumn::Filter deleted(1, 0);
+    filter.set(row_ids.data(), row_ids.size(), &deleted);
+    filter.runOptimize();
+    ASSERT_FALSE(filter.get(f, 60, 10));
+    ASSERT_EQ(f[4], 0);
+    ASSERT_EQ(f[3], 1);
+    ASSERT_EQ(filter.count(), 129);
+}
+CATCH
+
+} // namespace DB::DM::tests
@@ -0,0 +1,131 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/typeid_cast.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <IO/ReadBufferFromString.h>
+#include <IO/WriteBufferFromString.h>
+#include <Storages/DeltaMerge/Index/BloomFilterIndex.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+namespace DB
+{
+namespace DM
+{
+namespace tests
+{
+using namespace DB::tests;
+
+TEST(BloomFilterIndexTest, Integer)
+try
+{
+    auto type = std::make_shared<DataTypeInt32>();
+    BloomFilterIndex index;
+    index.addPack(*createColumn<Int32>({1, 2, 3, -100}).column, nullptr);
+    index.addPack(*createColumn<Int32>({1000, 2000}).column, nullptr);
+    ASSERT_EQ(index.packCount(), 2);
+
+    // No false negative
+    ASSERT_EQ(index.checkEqual(0, Field(static_cast<Int64>(1)), type), RSResult::Some);
+    ASSERT_EQ(index.checkEqual(0, Field(static_cast<Int64>(-100)), type), RSResult::Some);
+    ASSERT_EQ(index.checkEqual(0, Field(static_cast<UInt64>(3)), type), RSResult::Some);
+    ASSERT_EQ(index.checkEqual(1, Field(static_cast<Int64>(2000)), type), RSResult::Some);
+
+    // Values that can not be represented by Int32
+    ASSERT_EQ(index.checkEqual(0, Field(static_cast<Int64>(1) << 40), type), RSResult::None);
+    ASSERT_EQ(index.checkEqual(0, Field(std::numeric_limits<UInt64>::max()), type), RSResult::None);
+    // Null never equals to anything
+    ASSERT_EQ(index.checkEqual(0, Field(), type), RSResult::None);
+    // Unknown field type
+    ASSERT_EQ(index.checkEqual(0, Field(1.0), type), RSResult::Some);
+
+    // The false positive rate should be low
+    size_t false_positive = 0;
+    for (Int64 v = 10000; v < 20000; ++v)
+        false_positive += index.checkEqual(1, Field(v), type) == RSResult::Some;
+    ASSERT_LT(false_positive, 1000);
+
+    ASSERT_EQ(index.checkIn(1, {Field(static_cast<Int64>(5)), Field(static_cast<Int64>(1000))}, type), RSResult::Some);
+}
+CATCH
+
+TEST(BloomFilterIndexTest, NullableAndDeleted)
+try
+{
+    auto type = makeNullable(std::make_shared<DataTypeUInt64>());
+    auto del_mark = createColumn<UInt8>({0, 1, 0}).column;
+
+    BloomFilterIndex index;
+    index.addPack(*createColumn<Nullable<UInt64>>({1, 2, {}}).column, typeid_cast<const ColumnVector<UInt8> *>(del_mark.get()));
+    // A pack with only null values
+    index.addPack(*createColumn<Nullable<UInt64>>({{}, {}}).column, nullptr);
+
+    ASSERT_EQ(index.checkEqual(0, Field(static_cast<UInt64>(1)), type), RSResult::Some);
+    ASSERT_EQ(index.checkEqual(0, Field(static_cast<Int64>(-1)), type), RSResult::None);
+    ASSERT_EQ(index.checkEqual(1, Field(static_cast<UInt64>(1)), type), RSResult::None);
+}
+CATCH
+
+TEST(BloomFilterIndexTest, StringAndSerialize)
+try
+{
+    auto type = std::make_shared<DataTypeString>();
+    BloomFilterIndex index;
+    index.addPack(*createColumn<String>({"hello", "world", "", "TiFlash"}).column, nullptr);
+    index.addPack(*createColumn<String>({"Storage"}).column, nullptr);
+
+    WriteBufferFromOwnString write_buf;
+    index.write(write_buf);
+    auto data = write_buf.releaseStr();
+
+    ReadBufferFromString read_buf(data);
+    auto loaded = BloomFilterIndex::read(read_buf, data.size());
+    ASSERT_EQ(loaded->packCount(), 2);
+    ASSERT_EQ(loaded->byteSize(), index.byteSize());
+
+    ASSERT_EQ(loaded->checkEqual(0, Field(String("hello")), type), RSResult::Some);
+    ASSERT_EQ(loaded->checkEqual(0, Field(String("")), type), RSResult::Some);
+    ASSERT_EQ(loaded->checkEqual(1, Field(String("Storage")), type), RSResult::Some);
+    ASSERT_EQ(loaded->checkEqual(0, Field(static_cast<Int64>(1)), type), RSResult::Some);
+
+    ReadBufferFromString bad_buf(data);
+    ASSERT_THROW(BloomFilterIndex::read(bad_buf, data.size() + 1), DB::TiFlashException);
+}
+CATCH
+
+TEST(BloomFilterIndexTest, CheckRows)
+try
+{
+    // Hashes are collected from Int32 and checked against Int64, the same as runtime filter from join build side.
+    std::vector<UInt64> hashes;
+    BloomFilterIndex::collectHashes(*createColumn<Nullable<Int32>>({2, 3, {}, -4}).column, nullptr, hashes);
+    BloomFilterIndex index;
+    index.addPack(hashes);
+
+    IColumn::Filter filter;
+    index.checkRows(0, *createColumn<Nullable<Int64>>({1, 2, {}, 3, -4}).column, filter);
+    ASSERT_EQ(filter.size(), 5);
+    ASSERT_EQ(filter[1], 1);
+    ASSERT_EQ(filter[2], 0);
+    ASSERT_EQ(filter[3], 1);
+    ASSERT_EQ(filter[4], 1);
+}
+CATCH
+
+} // namespace tests
+} // namespace DM
+} // namespace DB
@@ -36,6 +36,7 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <ext/scope_guard.h>
 #include <future>
 #include <iterator>
 #include <random>
@@ -2712,6 +2713,75 @@ try
 }
 CATCH
 
+TEST_F(DeltaMergeStoreTest, SegmentAggregationCache)
+try
+{
+    auto & global_context = db_context->getGlobalContext();
+    if (!global_context.getSegmentAggCache())
+        global_context.setSegmentAggCache(64 * 1024 * 1024);
+    SCOPE_EXIT({ global_context.dropSegmentAggCache(); });
+
+    const auto & columns = store->getTableColumns();
+    size_t num_transforms = 0;
+    auto read_rows = [&](UInt64 max_version) {
+        // Use an identity transform, so the cached "partial results" are the rows of the segment.
+        auto segment_aggregation = std::make_shared<SegmentAggregation>();
+        auto ins = store->read(*db_context,
+                               db_context->getSettingsRef(),
+                               columns,
+                               {RowKeyRange::newAll(store->isCommonHandle(), store->getRowKeyColumnSize())},
+                               /* num_streams= */ 1,
+                               max_version,
+                               EMPTY_FILTER,
+                               std::vector<RuntimeFilterPtr>{},
+                               0,
+                               TRACING_NAME,
+                               /* keep_order= */ false,
+                               /* is_fast_scan= */ false,
+                               /* expected_block_size= */ 1024,
+                               /* read_segments */ {},
+                               /* extra_table_id_index */ InvalidColumnID,
+                               /* scan_context */ nullptr,
+                               /* enable_low_cardinality_string */ false,
+                               segment_aggregation);
+        segment_aggregation->init("identity", toEmptyBlock(columns), [&](const BlockInputStreamPtr & stream) {
+            ++num_transforms;
+            return stream;
+        });
+        size_t rows = 0;
+        for (auto & in : ins)
+        {
+            in->readPrefix();
+            while (Block block = in->read())
+                rows += block.rows();
+            in->readSuffix();
+        }
+        return rows;
+    };
+
+    store->write(*db_context, db_context->getSettingsRef(), DMTestEnv::prepareSimpleWriteBlock(0, 100, false, /*tso*/ 2));
+    ASSERT_EQ(read_rows(std::numeric_limits<UInt64>::max()), 100);
+    ASSERT_EQ(num_transforms, 1);
+
+    // Read from the cache
+    ASSERT_EQ(read_rows(std::numeric_limits<UInt64>::max()), 100);
+    ASSERT_EQ(num_transforms, 1);
+
+    // The cached result is not visible to the reads with smaller version, and the result is not cached
+    ASSERT_EQ(read_rows(1), 0);
+    ASSERT_EQ(num_transforms, 2);
+    ASSERT_EQ(read_rows(std::numeric_limits<UInt64>::max()), 100);
+    ASSERT_EQ(num_transforms, 2);
+
+    // The segment is changed
+    store->write(*db_context, db_context->getSettingsRef(), DMTestEnv::prepareSimpleWriteBlock(100, 150, false, /*tso*/ 3));
+    ASSERT_EQ(read_rows(std::numeric_limits<UInt64>::max()), 150);
+    ASSERT_EQ(num_transforms, 3);
+    ASSERT_EQ(read_rows(std::numeric_limits<UInt64>::max()), 150);
+    ASSERT_EQ(num_transforms, 3);
+}
+CATCH
+
 TEST_P(DeltaMergeStoreRWTest, SimpleWriteReadCommonHandle)
 try
 {
@@ -12,11 +12,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <IO/ReadBufferFromString.h>
+#include <IO/WriteBufferFromString.h>
+#include <Storages/DeltaMerge/DeltaIndex.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
 #include <Storages/DeltaMerge/DeltaTree.h>
 #include <Storages/DeltaMerge/Tuple.h>
 #include <gtest/gtest.h>
 
+#include <random>
+
 namespace DB
 {
 namespace DM
@@ -316,6 +321,88 @@ TEST_F(DeltaTree_test, InsertSkipDelete)
     checkCopy(tree);
 }
 
+namespace
+{
+struct DeltaEntry
+{
+    UInt64 sid;
+    bool is_insert;
+    UInt32 count;
+    UInt64 value;
+
+    bool operator==(const DeltaEntry & other) const
+    {
+        return sid == other.sid && is_insert == other.is_insert && count == other.count && value == other.value;
+    }
+};
+
+/// The adjacent delete entries may be merged into one after replaying, which means the same.
+std::vector<DeltaEntry> getEntries(const DefaultDeltaTree & tree)
+{
+    std::vector<DeltaEntry> entries;
+    for (auto it = tree.begin(), end = tree.end(); it != end; ++it)
+    {
+        DeltaEntry entry{it.getSid(), it.isInsert(), it.getCount(), it.getValue()};
+        if (!entries.empty() && !entry.is_insert && !entries.back().is_insert
+            && entries.back().sid + entries.back().count == entry.sid)
+            entries.back().count += entry.count;
+        else
+            entries.push_back(entry);
+    }
+    return entries;
+}
+} // namespace
+
+TEST(DeltaIndexTest, SerializeAndDeserialize)
+{
+    std::mt19937_64 rng(2023);
+    for (size_t round = 0; round < 50; ++round)
+    {
+        auto tree = std::make_shared<DefaultDeltaTree>();
+        size_t rows = 1000;
+        size_t inserts = 0;
+        for (size_t i = 0; i < 2000; ++i)
+        {
+            if (rows == 0 || rng() % 3 != 0)
+            {
+                tree->addInsert(rng() % (rows + 1), inserts++);
+                ++rows;
+            }
+            else
+            {
+                tree->addDelete(rng() % rows);
+                --rows;
+            }
+        }
+        if (round % 2)
+        {
+            inserts = rng() % (inserts + 1);
+            tree->removeInsertsStartFrom(inserts);
+        }
+
+        DeltaIndex index(tree, inserts, round);
+        WriteBufferFromOwnString write_buf;
+        index.serialize(write_buf);
+        ReadBufferFromString read_buf(write_buf.str());
+        auto restored = DeltaIndex::deserialize(read_buf);
+
+        ASSERT_EQ(restored->getPlacedStatus(), std::make_pair(inserts, round));
+        auto restored_tree = restored->getDeltaTree();
+        ASSERT_EQ(restored_tree->numInserts(), tree->numInserts());
+        ASSERT_EQ(restored_tree->numDeletes(), tree->numDeletes());
+        ASSERT_EQ(getEntries(*restored_tree), getEntries(*tree));
+    }
+
+    // An empty index
+    DeltaIndex index;
+    WriteBufferFromOwnString write_buf;
+    index.serialize(write_buf);
+    ReadBufferFromString read_buf(write_buf.str());
+    auto restored = DeltaIndex::deserialize(read_buf);
+    ASSERT_EQ(restored->getPlacedStatus(), std::make_pair(0UL, 0UL));
+    ASSERT_EQ(restored->getDeltaTree()->numEntries(), 0);
+}
+
 } // namespace tests
 } // namespace DM
 } // namespace DB
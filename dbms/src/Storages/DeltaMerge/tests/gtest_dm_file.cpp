@@ -22,6 +22,7 @@
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
 #include <Storages/DeltaMerge/File/DMFileBlockInputStream.h>
 #include <Storages/DeltaMerge/File/DMFileBlockOutputStream.h>
+#include <Storages/DeltaMerge/File/DMFilePackFilter.h>
 #include <Storages/DeltaMerge/File/DMFileWriter.h>
 #include <Storages/DeltaMerge/RowKeyRange.h>
 #include <Storages/DeltaMerge/StoragePool.h>
@@ -35,6 +36,7 @@
 #include <common/types.h>
 
 #include <algorithm>
+#include <ext/scope_guard.h>
 #include <magic_enum.hpp>
 #include <vector>
 namespace DB
@@ -1107,6 +1109,108 @@ try
 }
 CATCH
 
+TEST_P(DMFileTest, ReadFilteredByBloomFilterIndex)
+try
+{
+    // The bloom filter index is recorded in the meta of MetaV2 only.
+    if (GetParam() != DMFileMode::DirectoryMetaV2)
+        return;
+
+    auto cols = DMTestEnv::getDefaultColumns();
+    ColumnDefine i64_cd(2, "i64", typeFromString("Int64"));
+    ColumnDefine str_cd(3, "str", typeFromString("String"));
+    cols->push_back(i64_cd);
+    cols->push_back(str_cd);
+    reload(cols);
+
+    dbContext().getSettingsRef().dt_enable_bloom_filter_index = true;
+    SCOPE_EXIT({ dbContext().getSettingsRef().dt_enable_bloom_filter_index = false; });
+
+    const size_t nparts = 5;
+    const size_t rows_per_pack = 200;
+    {
+        // The values of pack `i` are `i, i + nparts, i + 2 * nparts, ...`, so the min-max ranges of all packs
+        // overlap and can not skip any pack for equal filters, only the bloom filter index can.
+        auto stream = std::make_shared<DMFileBlockOutputStream>(dbContext(), dm_file, *cols);
+        DMFileBlockOutputStream::BlockProperty block_property;
+        stream->writePrefix();
+        for (size_t i = 0; i < nparts; ++i)
+        {
+            const size_t pk_beg = i * rows_per_pack;
+            Block block = DMTestEnv::prepareSimpleWriteBlock(pk_beg, pk_beg + rows_per_pack, false);
+            std::vector<Int64> ints;
+            std::vector<String> strs;
+            for (size_t r = 0; r < rows_per_pack; ++r)
+            {
+                ints.push_back(r * nparts + i);
+                strs.push_back(fmt::format("s{}", r * nparts + i));
+            }
+            block.insert(createColumn<Int64>(ints, i64_cd.name, i64_cd.id));
+            block.insert(createColumn<String>(strs, str_cd.name, str_cd.id));
+            stream->write(block, block_property);
+        }
+        stream->writeSuffix();
+    }
+
+    auto test_read_filter = [&](const RSOperatorPtr & filter) {
+        auto pack_filter = DMFilePackFilter::loadFrom(
+            dm_file,
+            dbContext().getMinMaxIndexCache(),
+            dbContext().getBloomFilterIndexCache(),
+            /*set_cache_if_miss*/ true,
+            {RowKeyRange::newAll(false, 1)},
+            filter,
+            /*read_packs*/ {},
+            dbContext().getFileProvider(),
+            /*read_limiter*/ nullptr,
+            std::make_shared<ScanContext>(),
+            "");
+        const auto & use_packs = pack_filter.getUsePacksConst();
+        ASSERT_EQ(use_packs.size(), nparts);
+        // 7 is in pack 2 only, the other packs may be kept by the false positive of the bloom filter,
+        // but it is rare enough that not all of them are kept.
+        ASSERT_TRUE(use_packs[2]);
+        const size_t kept_packs = std::count(use_packs.begin(), use_packs.end(), 1);
+        ASSERT_LT(kept_packs, nparts);
+
+        // Only the rows of the kept packs are read.
+        DMFileBlockInputStreamBuilder builder(dbContext());
+        auto stream = builder
+                          .setColumnCache(column_cache)
+                          .setRSOperator(filter)
+                          .build(dm_file, *cols, RowKeyRanges{RowKeyRange::newAll(false, 1)}, std::make_shared<ScanContext>());
+        size_t read_rows = 0;
+        stream->readPrefix();
+        while (Block block = stream->read())
+            read_rows += block.rows();
+        stream->readSuffix();
+        ASSERT_EQ(read_rows, kept_packs * rows_per_pack);
+    };
+
+    const Attr i64_attr{i64_cd.name, i64_cd.id, i64_cd.type};
+    const Attr str_attr{str_cd.name, str_cd.id, str_cd.type};
+    const RSOperators filters{
+        createEqual(i64_attr, Field(static_cast<Int64>(7))),
+        createIn(i64_attr, {Field(static_cast<Int64>(7)), Field(static_cast<Int64>(10000))}),
+        createEqual(str_attr, Field(String("s7"))),
+        createIn(str_attr, {Field(String("s7")), Field(String("not_exist"))}),
+    };
+    for (const auto & filter : filters)
+    {
+        SCOPED_TRACE("Test reading with filter:" + filter->toDebugString());
+        test_read_filter(filter);
+    }
+
+    // Restore file from disk and read again
+    dm_file = restoreDMFile();
+    for (const auto & filter : filters)
+    {
+        SCOPED_TRACE("Test reading with filter:" + filter->toDebugString() + " after restoring DTFile");
+        test_read_filter(filter);
+    }
+}
+CATCH
+
 TEST_P(DMFileTest, ReadFilteredByPackIndices)
 try
 {
@@ -1188,6 +1292,107 @@ try
 }
 CATCH
 
+TEST_P(DMFileTest, CircularScan)
+try
+{
+    auto cols = DMTestEnv::getDefaultColumns();
+
+    const Int64 num_rows_write = 1024;
+    const Int64 nparts = 5;
+    const Int64 span_per_part = num_rows_write / nparts;
+
+    {
+        // Prepare some packs in DMFile
+        auto stream = std::make_shared<DMFileBlockOutputStream>(dbContext(), dm_file, *cols);
+
+        DMFileBlockOutputStream::BlockProperty block_property;
+        stream->writePrefix();
+        size_t pk_beg = 0;
+        for (size_t i = 0; i < nparts; ++i)
+        {
+            auto pk_end = (i == nparts - 1) ? num_rows_write : (pk_beg + num_rows_write / nparts);
+            Block block = DMTestEnv::prepareSimpleWriteBlock(pk_beg, pk_end, false);
+            stream->write(block, block_property);
+            pk_beg += num_rows_write / nparts;
+        }
+        stream->writeSuffix();
+    }
+
+    auto build_stream = [&](bool read_one_pack_every_time) {
+        DMFileBlockInputStreamBuilder builder(dbContext());
+        if (read_one_pack_every_time)
+            builder.onlyReadOnePackEveryTime();
+        return builder
+            .setColumnCache(column_cache)
+            .build(dm_file, *cols, RowKeyRanges{RowKeyRange::newAll(false, 1)}, std::make_shared<ScanContext>());
+    };
+
+    for (size_t start_pack_id : {0, 1, 3, 4, 5})
+    {
+        for (bool read_one_pack_every_time : {false, true})
+        {
+            SCOPED_TRACE(fmt::format("start_pack_id={} read_one_pack_every_time={}", start_pack_id, read_one_pack_every_time));
+            auto stream = build_stream(read_one_pack_every_time);
+            stream->reader.startCircularScan(start_pack_id);
+
+            // Reads from `start_pack_id` and then wraps around, the start offsets are the same as reading in order.
+            const Int64 expect_first_pk = start_pack_id < nparts ? start_pack_id * span_per_part : 0;
+            size_t read_rows = 0;
+            while (Block block = stream->read())
+            {
+                const auto & pk = block.getByName(DMTestEnv::pk_name).column;
+                if (read_rows == 0)
+                    ASSERT_EQ(pk->getInt(0), expect_first_pk);
+                for (size_t i = 0; i < block.rows(); ++i)
+                    ASSERT_EQ(pk->getInt(i), static_cast<Int64>(block.startOffset() + i));
+                read_rows += block.rows();
+            }
+            ASSERT_EQ(read_rows, num_rows_write);
+        }
+    }
+
+    for (size_t start_pack_id : {1, 3})
+    {
+        for (bool skip_first : {false, true})
+        {
+            // Skipping also stops at the end of the current round, so every row is read or skipped exactly once.
+            SCOPED_TRACE(fmt::format("start_pack_id={} skip_first={}", start_pack_id, skip_first));
+            auto stream = build_stream(false);
+            stream->reader.startCircularScan(start_pack_id);
+            size_t total_rows = 0;
+            for (bool skip = skip_first;; skip = !skip)
+            {
+                size_t rows = skip ? stream->skipNextBlock() : stream->read().rows();
+                if (rows == 0)
+                    break;
+                total_rows += rows;
+            }
+            ASSERT_EQ(total_rows, num_rows_write);
+        }
+    }
+
+    {
+        // A new reader starts from the smallest pack of the readers which are scanning the DMFile.
+        auto stream1 = build_stream(true);
+        auto stream2 = build_stream(true);
+        const auto path = stream1->reader.path();
+        ASSERT_EQ(DMFileReaderPool::instance().getScanningPackId(path), 0);
+        DMFileReaderPool::instance().add(stream1->reader);
+        DMFileReaderPool::instance().add(stream2->reader);
+        ASSERT_EQ(stream1->read().rows(), span_per_part);
+        ASSERT_EQ(stream1->read().rows(), span_per_part);
+        ASSERT_EQ(stream2->read().rows(), span_per_part);
+        ASSERT_EQ(DMFileReaderPool::instance().getScanningPackId(path), 1);
+        // The finished reader is ignored.
+        while (stream2->read()) {}
+        ASSERT_EQ(DMFileReaderPool::instance().getScanningPackId(path), 2);
+        DMFileReaderPool::instance().del(stream1->reader);
+        DMFileReaderPool::instance().del(stream2->reader);
+        ASSERT_EQ(DMFileReaderPool::instance().getScanningPackId(path), 0);
+    }
+}
+CATCH
+
 /// Test reading different column types
 
 TEST_P(DMFileTest, NumberTypes)
@@ -1286,6 +1491,75 @@ try
 }
 CATCH
 
+TEST_P(DMFileTest, ReadWithFilterMixedLowCardinality)
+try
+{
+    auto cols = DMTestEnv::getDefaultColumns();
+    ColumnDefine str_cd(2, "str", typeFromString("String"));
+    cols->push_back(str_cd);
+    reload(cols);
+
+    const size_t nparts = 5;
+    const size_t rows_per_pack = 200;
+    // Whether the strings of each pack are worth dictionary encoding. The pack 2 is skipped by the filter,
+    // so that `readWithFilter` reads the packs by two `read()` and stacks the blocks.
+    auto test_read_with_filter = [&](UInt64 file_id, const std::vector<bool> & low_cardinality_packs, bool expect_encoded) {
+        dm_file = DMFile::create(file_id, parent_path, createConfiguration(GetParam()), modeToVersion(GetParam()));
+        Strings all_strs;
+        {
+            auto stream = std::make_shared<DMFileBlockOutputStream>(dbContext(), dm_file, *cols);
+            DMFileBlockOutputStream::BlockProperty block_property;
+            stream->writePrefix();
+            for (size_t i = 0; i < nparts; ++i)
+            {
+                const size_t pk_beg = i * rows_per_pack;
+                Block block = DMTestEnv::prepareSimpleWriteBlock(pk_beg, pk_beg + rows_per_pack, false);
+                Strings strs;
+                for (size_t r = 0; r < rows_per_pack; ++r)
+                    strs.push_back(low_cardinality_packs[i] ? fmt::format("v{}", r % 4) : fmt::format("p{}_{}", i, r));
+                all_strs.insert(all_strs.end(), strs.begin(), strs.end());
+                block.insert(createColumn<String>(strs, str_cd.name, str_cd.id));
+                stream->write(block, block_property);
+            }
+            stream->writeSuffix();
+        }
+
+        // Keep the even rows of all packs except pack 2.
+        IColumn::Filter filter(nparts * rows_per_pack, 0);
+        std::vector<Int64> expected_pks;
+        Strings expected_strs;
+        for (size_t i = 0; i < nparts; ++i)
+        {
+            for (size_t r = 0; i != 2 && r < rows_per_pack; r += 2)
+            {
+                const size_t row = i * rows_per_pack + r;
+                filter[row] = 1;
+                expected_pks.push_back(row);
+                expected_strs.push_back(all_strs[row]);
+            }
+        }
+
+        DMFileBlockInputStreamBuilder builder(dbContext());
+        auto stream = builder
+                          .setColumnCache(column_cache)
+                          .enableLowCardinality(true)
+                          .build(dm_file, *cols, RowKeyRanges{RowKeyRange::newAll(false, 1)}, std::make_shared<ScanContext>());
+        Block block = stream->readWithFilter(filter);
+        ASSERT_EQ(block.rows(), expected_pks.size());
+        ASSERT_COLUMN_EQ(createColumn<Int64>(expected_pks).column, block.getByName(DMTestEnv::pk_name).column);
+        const auto & str_column = block.getByName(str_cd.name).column;
+        // The encoding is decided by the first block read from the DMFile, i.e. the packs 0 and 1.
+        ASSERT_EQ(str_column->isColumnLowCardinality(), expect_encoded);
+        ASSERT_COLUMN_EQ(createColumn<String>(expected_strs).column, str_column->convertToFullColumnIfLowCardinality());
+        ASSERT_FALSE(stream->read());
+    };
+
+    test_read_with_filter(2, {true, true, true, false, false}, true);
+    test_read_with_filter(3, {false, false, true, true, true}, false);
+    test_read_with_filter(4, {true, false, false, true, true}, false);
+}
+CATCH
+
 TEST_P(DMFileTest, NullableType)
 try
 {
@@ -27,6 +27,7 @@ namespace DB
 namespace FailPoints
 {
 extern const char skip_check_segment_update[];
+extern const char skip_background_segment_warm_up[];
 } // namespace FailPoints
 
 namespace DM
@@ -474,6 +475,102 @@ try
 }
 CATCH
 
+class DeltaMergeStoreWarmUpTest : public DeltaMergeStoreGCTest
+{
+public:
+    void SetUp() override
+    {
+        FailPointHelper::enableFailPoint(FailPoints::skip_background_segment_warm_up);
+        DeltaMergeStoreGCTest::SetUp();
+    }
+
+    void TearDown() override
+    {
+        DeltaMergeStoreGCTest::TearDown();
+        FailPointHelper::disableFailPoint(FailPoints::skip_background_segment_warm_up);
+    }
+};
+
+TEST_F(DeltaMergeStoreWarmUpTest, WarmUpHotSegments)
+try
+{
+    db_context->getSettingsRef().dt_segment_warm_up_read_threshold = 2;
+
+    ensureSegmentBreakpoints({100});
+    fill(0, 200);
+    flush();
+
+    // Only the segment [-inf, 100) is hot.
+    ASSERT_EQ(getRowsN(0, 50), 50);
+    ASSERT_EQ(getRowsN(0, 50), 50);
+    ASSERT_EQ(getSegmentAt(0)->getReadHotness(), 2);
+    ASSERT_EQ(getSegmentAt(150)->getReadHotness(), 0);
+
+    mergeDelta();
+    ASSERT_EQ(store->warm_up_tasks.length(), 1);
+    auto hot_segment = getSegmentAt(0);
+    ASSERT_EQ(hot_segment->getReadHotness(), 2);
+
+    fill(10, 20);
+    flush();
+    ASSERT_EQ(hot_segment->getDelta()->getPlacedDeltaRows(), 0);
+
+    auto index_cache = db_context->getGlobalContext().getMinMaxIndexCache();
+    index_cache->reset();
+    ASSERT_TRUE(store->warmUpNextSegment(*dm_context));
+    ASSERT_EQ(store->warm_up_tasks.length(), 0);
+    ASSERT_EQ(hot_segment->getDelta()->getPlacedDeltaRows(), 10);
+    ASSERT_GT(index_cache->count(), 0);
+
+    // Nothing to warm up
+    ASSERT_FALSE(store->warmUpNextSegment(*dm_context));
+}
+CATCH
+
+TEST_F(DeltaMergeStoreWarmUpTest, Disabled)
+try
+{
+    db_context->getSettingsRef().dt_segment_warm_up_read_threshold = 0;
+    dm_context = store->newDMContext(*db_context, db_context->getSettingsRef());
+
+    fill(0, 100);
+    flush();
+    // The read hotness is not recorded.
+    ASSERT_EQ(getRowsN(), 100);
+    ASSERT_EQ(getRowsN(), 100);
+    ASSERT_EQ(getSegmentAt(0)->getReadHotness(), 0);
+
+    mergeDelta();
+    ASSERT_EQ(getSegmentAt(0)->getReadHotness(), 0);
+    ASSERT_EQ(store->warm_up_tasks.length(), 0);
+}
+CATCH
+
+TEST_F(DeltaMergeStoreWarmUpTest, SplitAndMergeInheritReadHotness)
+try
+{
+    db_context->getSettingsRef().dt_segment_warm_up_read_threshold = 3;
+    dm_context = store->newDMContext(*db_context, db_context->getSettingsRef());
+
+    fill(0, 100);
+    flush();
+    ASSERT_EQ(getRowsN(), 100);
+    ASSERT_EQ(getRowsN(), 100);
+    ensureSegmentBreakpoints({50});
+    // Both the new segments inherit the read hotness, but they are not hot enough.
+    ASSERT_EQ(getSegmentAt(0)->getReadHotness(), 2);
+    ASSERT_EQ(getSegmentAt(50)->getReadHotness(), 2);
+    ASSERT_EQ(store->warm_up_tasks.length(), 0);
+
+    // The merged segment sums up the read hotness.
+    ASSERT_TRUE(merge(0, 100));
+    ASSERT_EQ(getSegmentAt(0)->getReadHotness(), 4);
+    ASSERT_EQ(store->warm_up_tasks.length(), 1);
+
+    getSegmentAt(0)->decayReadHotness();
+    ASSERT_EQ(getSegmentAt(0)->getReadHotness(), 2);
+}
+CATCH
 
 } // namespace tests
 } // namespace DM
@@ -32,6 +32,7 @@ namespace ProfileEvents
 {
 extern const Event DMSegmentIsEmptyFastPath;
 extern const Event DMSegmentIsEmptySlowPath;
+extern const Event DMPlace;
 } // namespace ProfileEvents
 
 namespace CurrentMetrics
@@ -1094,6 +1095,53 @@ try
 }
 CATCH
 
+TEST_F(SegmentOperationTest, PersistDeltaIndex)
+try
+{
+    reloadWithOptions({.db_settings = {.dt_persist_delta_index_min_rows = 1}});
+
+    writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 100, /* at */ 0);
+    mergeSegmentDelta(DELTA_MERGE_FIRST_SEGMENT_ID);
+    writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 50, /* at */ 20);
+    writeSegmentWithDeleteRange(DELTA_MERGE_FIRST_SEGMENT_ID, 0, 10);
+    writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 30, /* at */ 200);
+    flushSegmentCache(DELTA_MERGE_FIRST_SEGMENT_ID);
+
+    auto segment = segments[DELTA_MERGE_FIRST_SEGMENT_ID];
+    segment->placeDeltaIndex(*dm_context);
+    auto page_id = segment->getDelta()->getPersistedFileSet()->getDeltaIndexPageId();
+    ASSERT_NE(page_id, 0);
+    auto placed_rows = segment->getDelta()->getPlacedDeltaRows();
+    auto placed_deletes = segment->getDelta()->getPlacedDeltaDeletes();
+    ASSERT_EQ(placed_rows, 80);
+    ASSERT_EQ(placed_deletes, 1);
+    auto expected_rows = getSegmentRowNum(DELTA_MERGE_FIRST_SEGMENT_ID);
+
+    // Restore the segment like after restart, the persisted delta index is loaded instead of placing the delta again.
+    auto restored = Segment::restoreSegment(Logger::get(), *dm_context, DELTA_MERGE_FIRST_SEGMENT_ID);
+    ASSERT_EQ(restored->getDelta()->getPersistedFileSet()->getDeltaIndexPageId(), page_id);
+    ASSERT_EQ(restored->getDelta()->getPlacedDeltaRows(), 0);
+    segments[DELTA_MERGE_FIRST_SEGMENT_ID] = restored;
+    ASSERT_PROFILE_EVENT(ProfileEvents::DMPlace, +0, {
+        ASSERT_EQ(getSegmentRowNum(DELTA_MERGE_FIRST_SEGMENT_ID), expected_rows);
+    });
+    ASSERT_EQ(restored->getDelta()->getPlacedDeltaRows(), placed_rows);
+    ASSERT_EQ(restored->getDelta()->getPlacedDeltaDeletes(), placed_deletes);
+
+    // Only the newly appended column files are placed and persisted.
+    writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 10, /* at */ 300);
+    flushSegmentCache(DELTA_MERGE_FIRST_SEGMENT_ID);
+    restored->placeDeltaIndex(*dm_context);
+    ASSERT_EQ(restored->getDelta()->getPersistedFileSet()->getDeltaIndexPageId(), page_id);
+    ASSERT_EQ(restored->getDelta()->getPlacedDeltaRows(), placed_rows + 10);
+
+    // The persisted delta index is removed along with the delta.
+    mergeSegmentDelta(DELTA_MERGE_FIRST_SEGMENT_ID);
+    ASSERT_EQ(segments[DELTA_MERGE_FIRST_SEGMENT_ID]->getDelta()->getPersistedFileSet()->getDeltaIndexPageId(), 0);
+    ASSERT_EQ(getSegmentRowNum(DELTA_MERGE_FIRST_SEGMENT_ID), expected_rows + 10);
+}
+CATCH
+
 
 class IsEmptyTest : public SegmentTestBasic
 {
@@ -14,7 +14,14 @@
 
 #include <Common/Logger.h>
 #include <DataStreams/OneBlockInputStream.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Functions/FunctionFactory.h>
+#include <Functions/registerFunctions.h>
+#include <Interpreters/Context.h>
+#include <Interpreters/ExpressionActions.h>
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
+#include <Storages/DeltaMerge/Filter/PushDownFilter.h>
+#include <Storages/DeltaMerge/LateMaterializationBlockInputStream.h>
 #include <Storages/DeltaMerge/tests/gtest_segment_test_basic.h>
 #include <Storages/DeltaMerge/tests/gtest_segment_util.h>
 #include <TestUtils/FunctionTestUtils.h>
@@ -506,4 +513,257 @@ try
 }
 CATCH
 
+
+TEST_F(SegmentBitmapFilterTest, LateMaterializationDecision)
+try
+{
+    try
+    {
+        registerFunctions();
+    }
+    catch (DB::Exception &)
+    {
+        // Maybe another test has already registered, ignore exception here.
+    }
+
+    writeSegment("s:[0, 1000)|d_tiny:[1000, 1500)|d_mem:[1500, 2000)");
+    auto [seg, snap] = getSegmentForRead(SEG_ID);
+
+    const auto & handle_define = getExtraHandleColumnDefine(options.is_common_handle);
+    const auto & version_define = getVersionColumnDefine();
+    const ColumnDefines columns_to_read{handle_define, version_define};
+
+    // Push down `handle < 500`.
+    auto before_where = std::make_shared<ExpressionActions>(NamesAndTypes{{handle_define.name, handle_define.type}});
+    auto int64_type = std::make_shared<DataTypeInt64>();
+    before_where->add(ExpressionAction::addColumn({int64_type->createColumnConst(1, Field(static_cast<Int64>(500))), int64_type, "500"}));
+    before_where->add(ExpressionAction::applyFunction(FunctionFactory::instance().get("less", *db_context), {handle_define.name, "500"}, "filter"));
+    auto project_after_where = std::make_shared<ExpressionActions>(NamesAndTypes{
+        {handle_define.name, handle_define.type},
+        {version_define.name, version_define.type}});
+    project_after_where->add(ExpressionAction::project(Names{handle_define.name, version_define.name}));
+    auto filter_columns = std::make_shared<ColumnDefines>(ColumnDefines{handle_define});
+
+    // An extra cast which renames the handle column and then renames it back by the projection, like the casts of
+    // the timestamp columns.
+    auto extra_cast = std::make_shared<ExpressionActions>(NamesAndTypes{{handle_define.name, handle_define.type}});
+    extra_cast->add(ExpressionAction::copyColumn(handle_define.name, "casted_handle"));
+    extra_cast->add(ExpressionAction::project(NamesWithAliases{{"casted_handle", handle_define.name}}));
+
+    auto read_and_check = [&](const PushDownFilterPtr & filter, bool expect_late_materialization) {
+        auto stream = seg->getInputStream(
+            ReadMode::Bitmap,
+            *dm_context,
+            columns_to_read,
+            snap,
+            {seg->getRowKeyRange()},
+            filter,
+            std::numeric_limits<UInt64>::max(),
+            DEFAULT_BLOCK_SIZE);
+        ASSERT_EQ(stream->getName() == LateMaterializationBlockInputStream::NAME, expect_late_materialization) << stream->getName();
+
+        std::vector<Int64> handles;
+        size_t version_rows = 0;
+        stream->readPrefix();
+        while (Block block = stream->read())
+        {
+            const auto & handle_column = block.getByName(handle_define.name).column;
+            for (size_t i = 0; i < handle_column->size(); ++i)
+                handles.push_back(handle_column->getInt(i));
+            version_rows += block.getByName(version_define.name).column->size();
+        }
+        stream->readSuffix();
+        ASSERT_EQ(handles, genSequence<Int64>("[0, 500)"));
+        ASSERT_EQ(version_rows, 500);
+    };
+
+    for (const auto & cast : {ExpressionActionsPtr{}, extra_cast})
+    {
+        auto filter = std::make_shared<PushDownFilter>(EMPTY_RS_OPERATOR, before_where, project_after_where, filter_columns, "filter", cast, nullptr);
+        auto & scan_context = *dm_context->scan_context;
+        scan_context.total_late_materialization_filter_rows = 0;
+        scan_context.total_late_materialization_passed_rows = 0;
+
+        // Nothing is sampled in this query yet, so late materialization is used and the selectivity is recorded.
+        read_and_check(filter, true);
+        ASSERT_EQ(scan_context.total_late_materialization_filter_rows.load(), 2000);
+        ASSERT_EQ(scan_context.total_late_materialization_passed_rows.load(), 500);
+
+        // The filter is selective enough in the segments read before by this query.
+        scan_context.total_late_materialization_filter_rows = 1000000;
+        scan_context.total_late_materialization_passed_rows = 100000;
+        read_and_check(filter, true);
+
+        // Most of the rows read before by this query passed the filter, so all the columns are read together.
+        scan_context.total_late_materialization_filter_rows = 1000000;
+        scan_context.total_late_materialization_passed_rows = 900000;
+        read_and_check(filter, false);
+        ASSERT_EQ(scan_context.total_late_materialization_filter_rows.load(), 1000000);
+        ASSERT_EQ(scan_context.total_late_materialization_passed_rows.load(), 900000);
+    }
+}
+CATCH
+
+TEST_F(SegmentBitmapFilterTest, MaxDataVersion)
+try
+{
+    writeSegment("s:[0, 1000)|d_tiny:[500, 1500)|d_mem:[1200, 1300)");
+    auto [seg, snap] = getSegmentForRead(SEG_ID);
+    ASSERT_EQ(seg->getMaxDataVersion(*dm_context, snap), version);
+    // Read from the cache.
+    ASSERT_EQ(seg->getMaxDataVersion(*dm_context, snap), version);
+    auto old_version = version;
+
+    // The delta is changed, so the new snapshot has a larger max data version.
+    writeSegment("d_mem:[0, 10)");
+    auto [new_seg, new_snap] = getSegmentForRead(SEG_ID);
+    ASSERT_EQ(new_seg, seg);
+    ASSERT_EQ(seg->getMaxDataVersion(*dm_context, new_snap), version);
+    ASSERT_GT(version, old_version);
+    ASSERT_EQ(seg->getMaxDataVersion(*dm_context, snap), old_version);
+
+    // Only the stable.
+    mergeSegmentDelta(SEG_ID);
+    auto [stable_seg, stable_snap] = getSegmentForRead(SEG_ID);
+    ASSERT_EQ(stable_seg->getMaxDataVersion(*dm_context, stable_snap), version);
+}
+CATCH
+
+class SegmentBitmapFilterCacheTest : public SegmentBitmapFilterTest
+{
+protected:
+    void SetUp() override
+    {
+        SegmentBitmapFilterTest::SetUp();
+        auto & global_context = db_context->getGlobalContext();
+        if (!global_context.getBitmapFilterCache())
+            global_context.setBitmapFilterCache(64 * 1024 * 1024);
+        cache = global_context.getBitmapFilterCache();
+        cache->reset();
+    }
+
+    void TearDown() override
+    {
+        cache->reset();
+        SegmentBitmapFilterTest::TearDown();
+    }
+
+    // Build the bitmap filter of the segment through the cache, and check that it is the same as the one built without the cache.
+    BitmapFilterPtr buildBitmapFilter(PageIdU64 segment_id, UInt64 max_version, const RowKeyRanges & ranges = {})
+    {
+        auto [seg, snap] = getSegmentForRead(segment_id);
+        auto ranges_to_read = ranges.empty() ? RowKeyRanges{seg->getRowKeyRange()} : ranges;
+        auto bitmap_filter = seg->buildBitmapFilter(*dm_context, snap, ranges_to_read, EMPTY_RS_OPERATOR, max_version, DEFAULT_BLOCK_SIZE);
+        auto expected = seg->buildBitmapFilterNormal(*dm_context, snap, ranges_to_read, EMPTY_RS_OPERATOR, max_version, DEFAULT_BLOCK_SIZE);
+        EXPECT_EQ(bitmap_filter->toDebugString(), expected->toDebugString());
+        return bitmap_filter;
+    }
+
+    static constexpr auto MAX_VERSION = std::numeric_limits<UInt64>::max();
+    BitmapFilterCachePtr cache;
+};
+
+TEST_F(SegmentBitmapFilterCacheTest, SameSnapshot)
+try
+{
+    writeSegment("s:[0, 1000)|d_tiny:[500, 1500)|d_mem:[1200, 1300)");
+    cache->reset();
+
+    auto bitmap_filter = buildBitmapFilter(SEG_ID, MAX_VERSION);
+    ASSERT_EQ(cache->count(), 1);
+    // Hit the cache by any read TSO not less than the max data version.
+    ASSERT_EQ(buildBitmapFilter(SEG_ID, MAX_VERSION), bitmap_filter);
+    ASSERT_EQ(buildBitmapFilter(SEG_ID, version), bitmap_filter);
+    ASSERT_EQ(cache->count(), 1);
+}
+CATCH
+
+TEST_F(SegmentBitmapFilterCacheTest, ReadTSOLessThanMaxDataVersion)
+try
+{
+    writeSegment("s:[0, 1000)|d_tiny:[500, 1500)|d_mem:[1200, 1300)");
+    cache->reset();
+
+    // Some rows are invisible, the bitmap filter is built but not stored.
+    auto bitmap_filter = buildBitmapFilter(SEG_ID, version - 1);
+    ASSERT_EQ(cache->count(), 0);
+    ASSERT_NE(buildBitmapFilter(SEG_ID, version - 1), bitmap_filter);
+    ASSERT_EQ(cache->count(), 0);
+
+    // The cached bitmap filter is not used either.
+    auto cached = buildBitmapFilter(SEG_ID, MAX_VERSION);
+    ASSERT_EQ(cache->count(), 1);
+    ASSERT_NE(buildBitmapFilter(SEG_ID, version - 1), cached);
+    ASSERT_EQ(buildBitmapFilter(SEG_ID, MAX_VERSION), cached);
+}
+CATCH
+
+TEST_F(SegmentBitmapFilterCacheTest, DeltaChanged)
+try
+{
+    writeSegment("s:[0, 1000)|d_tiny:[500, 1500)");
+    auto bitmap_filter = buildBitmapFilter(SEG_ID, MAX_VERSION);
+    ASSERT_EQ(buildBitmapFilter(SEG_ID, MAX_VERSION), bitmap_filter);
+
+    // New rows in the delta.
+    SegmentTestBasic::writeSegment(SEG_ID, 100, 1200);
+    auto after_write = buildBitmapFilter(SEG_ID, MAX_VERSION);
+    ASSERT_NE(after_write, bitmap_filter);
+    ASSERT_EQ(buildBitmapFilter(SEG_ID, MAX_VERSION), after_write);
+
+    // A new delete range in the delta.
+    SegmentTestBasic::writeSegmentWithDeleteRange(SEG_ID, 0, 100);
+    auto after_delete_range = buildBitmapFilter(SEG_ID, MAX_VERSION);
+    ASSERT_NE(after_delete_range, after_write);
+    ASSERT_EQ(buildBitmapFilter(SEG_ID, MAX_VERSION), after_delete_range);
+}
+CATCH
+
+TEST_F(SegmentBitmapFilterCacheTest, NewEpoch)
+try
+{
+    writeSegment("s:[0, 1000)|d_tiny:[500, 1500)|d_mem:[1200, 1300)");
+    auto bitmap_filter = buildBitmapFilter(SEG_ID, MAX_VERSION);
+
+    // The delta is merged into the stable.
+    mergeSegmentDelta(SEG_ID);
+    auto after_merge_delta = buildBitmapFilter(SEG_ID, MAX_VERSION);
+    ASSERT_NE(after_merge_delta, bitmap_filter);
+    ASSERT_EQ(buildBitmapFilter(SEG_ID, MAX_VERSION), after_merge_delta);
+
+    // The snapshots of both epochs only have the stable, with the same number of delta rows and deletes.
+    mergeSegmentDelta(SEG_ID);
+    auto after_merge_empty_delta = buildBitmapFilter(SEG_ID, MAX_VERSION);
+    ASSERT_NE(after_merge_empty_delta, after_merge_delta);
+
+    auto new_seg_id = splitSegmentAt(SEG_ID, 800);
+    ASSERT_TRUE(new_seg_id.has_value());
+    auto left = buildBitmapFilter(SEG_ID, MAX_VERSION);
+    ASSERT_NE(left, after_merge_empty_delta);
+    ASSERT_EQ(buildBitmapFilter(SEG_ID, MAX_VERSION), left);
+    auto right = buildBitmapFilter(*new_seg_id, MAX_VERSION);
+    ASSERT_NE(right, left);
+    ASSERT_EQ(buildBitmapFilter(*new_seg_id, MAX_VERSION), right);
+}
+CATCH
+
+TEST_F(SegmentBitmapFilterCacheTest, PartialRange)
+try
+{
+    writeSegment("s:[0, 1000)|d_tiny:[500, 1500)|d_mem:[1200, 1300)");
+    cache->reset();
+
+    auto bitmap_filter = buildBitmapFilter(SEG_ID, MAX_VERSION, {buildRowKeyRange(100, 600)});
+    ASSERT_EQ(cache->count(), 0);
+    ASSERT_NE(buildBitmapFilter(SEG_ID, MAX_VERSION, {buildRowKeyRange(100, 600)}), bitmap_filter);
+    ASSERT_EQ(cache->count(), 0);
+
+    // The partial range read does not use the cached bitmap filter of the whole segment.
+    auto cached = buildBitmapFilter(SEG_ID, MAX_VERSION);
+    ASSERT_EQ(cache->count(), 1);
+    ASSERT_NE(buildBitmapFilter(SEG_ID, MAX_VERSION, {buildRowKeyRange(100, 600)}), cached);
+    ASSERT_EQ(cache->count(), 1);
+}
+CATCH
+
 } // namespace DB::DM::tests
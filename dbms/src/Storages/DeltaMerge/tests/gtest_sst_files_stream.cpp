@@ -23,6 +23,7 @@
 #include <TestUtils/TiFlashStorageTestBasic.h>
 #include <TestUtils/TiFlashTestBasic.h>
 
+#include <ext/scope_guard.h>
 #include <magic_enum.hpp>
 
 namespace DB
@@ -421,6 +422,77 @@ try
 CATCH
 
 
+TEST_F(SSTFilesToDTFilesOutputStreamTest, OutputMultipleDTFileInPipeline)
+try
+{
+    db_context->getSettingsRef().dt_sst_to_dtfile_pipeline_queue_size = 2;
+    SCOPE_EXIT({ db_context->getSettingsRef().dt_sst_to_dtfile_pipeline_queue_size = 0; });
+
+    auto table_lock = storage->lockStructureForShare("foo_query_id");
+    auto [schema_snapshot, unused] = storage->getSchemaSnapshotAndBlockForDecoding(table_lock, false);
+
+    auto mock_stream = makeMockChild(prepareBlocks(50, 100, /*block_size=*/1));
+    auto stream = std::make_shared<DM::SSTFilesToDTFilesOutputStream<DM::MockSSTFilesToDTFilesOutputStreamChildPtr>>(
+        /* log_prefix */ "",
+        mock_stream,
+        storage,
+        schema_snapshot,
+        FileConvertJobType::ApplySnapshot,
+        /* split_after_rows */ 10,
+        /* split_after_size */ 0,
+        *db_context);
+
+    stream->writePrefix();
+    stream->write();
+    stream->writeSuffix();
+    auto files = stream->outputFiles();
+    ASSERT_EQ(5, files.size());
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        ASSERT_EQ(files[i].range.getStart().int_value, static_cast<Int64>(50 + 10 * i));
+        ASSERT_EQ(files[i].range.getEnd().int_value, static_cast<Int64>(60 + 10 * i));
+    }
+}
+CATCH
+
+
+TEST_F(SSTFilesToDTFilesOutputStreamTest, BrokenChildInPipeline)
+try
+{
+    db_context->getSettingsRef().dt_sst_to_dtfile_pipeline_queue_size = 1;
+    SCOPE_EXIT({ db_context->getSettingsRef().dt_sst_to_dtfile_pipeline_queue_size = 0; });
+
+    auto table_lock = storage->lockStructureForShare("foo_query_id");
+    auto [schema_snapshot, unused] = storage->getSchemaSnapshotAndBlockForDecoding(table_lock, false);
+
+    // The writer throws while the decoding thread is blocked by the full queue
+    auto blocks1 = prepareBlocks(50, 100, /*block_size=*/5);
+    auto blocks2 = prepareBlocks(0, 100, /*block_size=*/5);
+    blocks1.insert(blocks1.end(), blocks2.begin(), blocks2.end());
+    auto mock_stream = makeMockChild(blocks1);
+
+    auto stream = std::make_shared<DM::SSTFilesToDTFilesOutputStream<DM::MockSSTFilesToDTFilesOutputStreamChildPtr>>(
+        /* log_prefix */ "",
+        mock_stream,
+        storage,
+        schema_snapshot,
+        FileConvertJobType::ApplySnapshot,
+        /* split_after_rows */ 20,
+        /* split_after_size */ 0,
+        *db_context);
+
+    EXPECT_THROW({
+        stream->writePrefix();
+        stream->write();
+        stream->writeSuffix();
+    },
+                 DB::Exception);
+
+    stream->cancel();
+}
+CATCH
+
+
 } // namespace tests
 } // namespace DM
 } // namespace DB
@@ -96,8 +96,100 @@ BlockInputStreamPtr getVersionFilterInputStreamWithRowKeyFilterStream(const Bloc
         is_common_handle);
 }
 
+/// A block with multiple versions of `num_handles` handles, which is larger than the unrolled batch of the version filter.
+/// The handle `h` has the versions [1, `h % 5 + 1`], and the last version is deleted if `h % 3 == 0`.
+Block prepareMultiVersionBlock(Int64 num_handles, bool is_common_handle)
+{
+    std::vector<Int64> handles;
+    Strings common_handles;
+    std::vector<UInt64> versions;
+    std::vector<UInt64> tags;
+    Strings values;
+    for (Int64 h = 0; h < num_handles; ++h)
+    {
+        const UInt64 max_version = h % 5 + 1;
+        for (UInt64 v = 1; v <= max_version; ++v)
+        {
+            handles.push_back(h);
+            common_handles.push_back(genMockCommonHandle(h, 1));
+            versions.push_back(v);
+            tags.push_back(h % 3 == 0 && v == max_version);
+            values.push_back(fmt::format("{}_{}", h, v));
+        }
+    }
+
+    Block block;
+    if (is_common_handle)
+        block.insert(createColumn<String>(std::move(common_handles), DMTestEnv::pk_name, EXTRA_HANDLE_COLUMN_ID));
+    else
+        block.insert(createColumn<Int64>(std::move(handles), DMTestEnv::pk_name, EXTRA_HANDLE_COLUMN_ID));
+    block.insert(createColumn<UInt64>(std::move(versions), VERSION_COLUMN_NAME, VERSION_COLUMN_ID));
+    block.insert(createColumn<UInt8>(std::move(tags), TAG_COLUMN_NAME, TAG_COLUMN_ID));
+    block.insert(createColumn<String>(std::move(values), str_col_name, DebugBlockInputStream::extra_column_id));
+    return block;
+}
+
 } // namespace
 
+TEST(VersionFilterTest, MVCCMultiVersionBlock)
+try
+{
+    constexpr Int64 num_handles = 100;
+    for (UInt64 version_limit : {0, 1, 3, 5, 10})
+    {
+        Strings expected;
+        for (Int64 h = 0; h < num_handles; ++h)
+        {
+            const UInt64 max_version = h % 5 + 1;
+            const UInt64 visible_version = std::min(max_version, version_limit);
+            const bool deleted = h % 3 == 0 && visible_version == max_version;
+            if (visible_version > 0 && !deleted)
+                expected.push_back(fmt::format("{}_{}", h, visible_version));
+        }
+
+        for (bool is_common_handle : {false, true})
+        {
+            BlocksList blocks{prepareMultiVersionBlock(num_handles, is_common_handle)};
+            ColumnDefines columns = getColumnDefinesFromBlock(blocks.back());
+            auto in = getVersionFilterInputStream<DM_VERSION_FILTER_MODE_MVCC>(blocks, columns, version_limit, is_common_handle);
+            ASSERT_INPUTSTREAM_COLS_UR(in, Strings({str_col_name}), createColumns({createColumn<String>(expected)}));
+        }
+    }
+}
+CATCH
+
+TEST(VersionFilterTest, CompactMultiVersionBlock)
+try
+{
+    constexpr Int64 num_handles = 100;
+    for (UInt64 version_limit : {0, 1, 3, 5, 10})
+    {
+        // The Int64 handle and the common handle must get the same result
+        std::vector<std::tuple<size_t, size_t, size_t, UInt64, size_t>> results;
+        for (bool is_common_handle : {false, true})
+        {
+            BlocksList blocks{prepareMultiVersionBlock(num_handles, is_common_handle)};
+            ColumnDefines columns = getColumnDefinesFromBlock(blocks.back());
+            auto in = getVersionFilterInputStream<DM_VERSION_FILTER_MODE_COMPACT>(blocks, columns, version_limit, is_common_handle);
+            const auto * compact_stream = typeid_cast<const DMVersionFilterBlockInputStream<DM_VERSION_FILTER_MODE_COMPACT> *>(in.get());
+            ASSERT_NE(compact_stream, nullptr);
+            size_t num_rows = 0;
+            in->readPrefix();
+            while (Block block = in->read())
+                num_rows += block.rows();
+            in->readSuffix();
+            results.emplace_back(
+                compact_stream->getEffectiveNumRows(),
+                compact_stream->getNotCleanRows(),
+                compact_stream->getDeletedRows(),
+                compact_stream->getGCHintVersion(),
+                num_rows);
+        }
+        ASSERT_EQ(results[0], results[1]) << "version_limit=" << version_limit;
+    }
+}
+CATCH
+
 TEST(VersionFilterTest, MVCC)
 {
     BlocksList blocks;
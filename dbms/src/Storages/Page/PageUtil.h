@@ -17,6 +17,7 @@
 #include <Common/CurrentMetrics.h>
 #include <Common/Exception.h>
 #include <Common/FailPoint.h>
+#include <Common/IOUring.h>
 #include <Common/ProfileEvents.h>
 #include <Common/StringUtils/StringUtils.h>
 #include <Common/TiFlashException.h>
@@ -286,6 +287,58 @@ void readFile(T & file,
                                    Errors::PageStorage::FileSizeNotMatch);
 }
 
+template <typename T>
+struct FileReadRequest
+{
+    T file;
+    off_t offset;
+    char * buf;
+    size_t size;
+};
+
+/// Read the ranges of multiple files, submitted in one batch by io_uring if it is enabled.
+template <typename T>
+void readFileBatch(const std::vector<FileReadRequest<T>> & requests,
+                   const ReadLimiterPtr & read_limiter = nullptr,
+                   const bool background = false)
+{
+    std::vector<IOUring::ReadRequest> io_requests;
+    io_requests.reserve(requests.size());
+    size_t expected_bytes = 0;
+    for (const auto & req : requests)
+    {
+        if (req.size == 0)
+            continue;
+        io_requests.push_back({req.file->getFd(), req.buf, req.size, req.offset});
+        expected_bytes += req.size;
+    }
+    if (unlikely(expected_bytes == 0))
+        return;
+
+    if (read_limiter != nullptr)
+    {
+        read_limiter->request(expected_bytes);
+    }
+    try
+    {
+        IOUring::readBatch(io_requests);
+    }
+    catch (...)
+    {
+        ProfileEvents::increment(ProfileEvents::PSMReadFailed);
+        throw;
+    }
+    for (const auto & req : requests)
+        req.file->afterReadFromFd(req.buf, req.size, req.offset);
+
+    ProfileEvents::increment(ProfileEvents::PSMReadIOCalls);
+    ProfileEvents::increment(ProfileEvents::PSMReadBytes, expected_bytes);
+    if (background)
+    {
+        ProfileEvents::increment(ProfileEvents::PSMBackgroundReadBytes, expected_bytes);
+    }
+}
+
 /// Write and advance sizeof(T) bytes.
 template <typename T>
 inline void put(char *& pos, const T & v)
@@ -19,6 +19,7 @@
 #include <Encryption/WriteReadableFile.h>
 #include <Poco/Logger.h>
 #include <Storages/FormatVersion.h>
+#include <Storages/Page/PageUtil.h>
 #include <Storages/Page/V3/PageDefines.h>
 #include <Storages/PathPool_fwd.h>
 
@@ -49,6 +50,12 @@ public:
 
     void read(char * buffer, size_t offset, size_t size, const ReadLimiterPtr & read_limiter, bool background = false);
 
+    // Returns the request to read [offset, offset + size) in a batch with other files, see `PageUtil::readFileBatch`.
+    PageUtil::FileReadRequest<WriteReadableFilePtr> getReadRequest(char * buffer, size_t offset, size_t size) const
+    {
+        return {wrfile, static_cast<off_t>(offset), buffer, size};
+    }
+
     void write(char * buffer, size_t offset, size_t size, const WriteLimiterPtr & write_limiter, bool background = false);
 
     void truncate(size_t size);
@@ -15,6 +15,7 @@
 #include <Common/Checksum.h>
 #include <Common/Exception.h>
 #include <Common/FailPoint.h>
+#include <Common/IOUring.h>
 #include <Common/Logger.h>
 #include <Common/ProfileEvents.h>
 #include <Common/Stopwatch.h>
@@ -922,11 +923,38 @@ BlobStore<Trait>::read(PageIdAndEntries & entries, const ReadLimiterPtr & read_l
         free(p, buf_size);
     });
 
+    // Submit the reads of all pages in one batch if io_uring is enabled, otherwise read them one by one.
+    const bool batch_read = IOUring::isEnabled();
+    std::vector<BlobFilePtr> blob_files;
+    if (batch_read)
+    {
+        std::vector<PageUtil::FileReadRequest<WriteReadableFilePtr>> requests;
+        requests.reserve(entries.size());
+        blob_files.reserve(entries.size());
+        char * req_pos = data_buf;
+        for (const auto & [page_id_v3, entry] : entries)
+        {
+            blob_files.emplace_back(getBlobFile(entry.file_id));
+            requests.emplace_back(blob_files.back()->getReadRequest(req_pos, entry.offset, entry.size));
+            req_pos += entry.size;
+        }
+        try
+        {
+            PageUtil::readFileBatch(requests, read_limiter);
+        }
+        catch (DB::Exception & e)
+        {
+            e.addMessage(fmt::format("(error while reading pages in batch [num_pages={}])", entries.size()));
+            e.rethrow();
+        }
+    }
+
     char * pos = data_buf;
     PageMap page_map;
-    for (const auto & [page_id_v3, entry] : entries)
+    for (size_t i = 0; i < entries.size(); ++i)
     {
-        auto blob_file = read(page_id_v3, entry.file_id, entry.offset, pos, entry.size, read_limiter);
+        const auto & [page_id_v3, entry] = entries[i];
+        auto blob_file = batch_read ? blob_files[i] : read(page_id_v3, entry.file_id, entry.offset, pos, entry.size, read_limiter);
 
         if constexpr (BLOBSTORE_CHECKSUM_ON_READ)
         {
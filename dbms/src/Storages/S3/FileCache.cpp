@@ -18,6 +18,7 @@
 #include <Common/Stopwatch.h>
 #include <Common/TiFlashMetrics.h>
 #include <Common/escapeForFileName.h>
+#include <Common/setThreadName.h>
 #include <Encryption/PosixRandomAccessFile.h>
 #include <IO/IOThreadPools.h>
 #include <Server/StorageConfigParser.h>
@@ -61,15 +62,49 @@ FileCache::FileCache(PathCapacityMetricsPtr capacity_metrics_, const StorageRemo
     , cache_capacity(config_.getDTFileCapacity())
     , cache_level(config_.dtfile_level)
     , cache_used(0)
+    , chunk_size(config_.dtfile_chunk_size)
     , log(Logger::get("FileCache"))
 {
     CurrentMetrics::set(CurrentMetrics::DTFileCacheCapacity, cache_capacity);
+    for (auto & shard : shards)
+    {
+        for (auto & table : shard.tables)
+            table.setPolicy(config_.dtfile_cache_policy);
+    }
+    LOG_INFO(log, "Initialize FileCache, policy={}", magic_enum::enum_name(config_.dtfile_cache_policy));
     prepareDir(cache_dir);
     restore();
+    bg_thread = std::thread(&FileCache::bgWork, this);
+}
+
+FileCache::~FileCache()
+{
+    {
+        std::lock_guard lock(bg_mtx);
+        bg_shutdown = true;
+    }
+    bg_cv.notify_all();
+    // The pending disk files are removed before the thread exits.
+    bg_thread.join();
+}
+
+FileCache::Shard & FileCache::getShard(const String & s3_key)
+{
+    return shards[std::hash<String>{}(s3_key) % shard_count];
 }
 
 RandomAccessFilePtr FileCache::getRandomAccessFile(const S3::S3FilenameView & s3_fname, const std::optional<UInt64> & filesize)
 {
+    // The chunks can only be located when the file size is known.
+    if (chunk_size > 0 && filesize)
+    {
+        auto s3_key = s3_fname.toFullKey();
+        auto file_type = getFileType(s3_key);
+        if (file_type == FileType::Unknow || static_cast<UInt64>(file_type) > cache_level)
+            return nullptr;
+        return std::make_shared<ChunkedCacheRandomAccessFile>(*this, s3_key, *filesize);
+    }
+
     auto file_seg = get(s3_fname, filesize);
     if (file_seg == nullptr)
     {
@@ -103,53 +138,192 @@ FileSegmentPtr FileCache::get(const S3::S3FilenameView & s3_fname, const std::op
 {
     auto s3_key = s3_fname.toFullKey();
     auto file_type = getFileType(s3_key);
-    auto & table = tables[static_cast<UInt64>(file_type)];
-
-    std::lock_guard lock(mtx);
+    auto & shard = getShard(s3_key);
+    auto & table = shard.tables[static_cast<UInt64>(file_type)];
+    // We don't know the exact size of a object/file, but we need reserve space to save the object/file.
+    // A certain amount of space is reserved for each file type.
+    auto estimzted_size = filesize ? *filesize : getEstimatedSizeOfFileType(file_type);
 
-    auto f = table.get(s3_key);
-    if (f != nullptr)
     {
-        f->setLastAccessTime(std::chrono::system_clock::now());
-        if (f->isReadyToRead())
+        std::lock_guard lock(shard.mtx);
+
+        auto f = table.get(s3_key);
+        if (f != nullptr)
         {
-            GET_METRIC(tiflash_storage_remote_cache, type_dtfile_hit).Increment();
-            return f;
+            f->setLastAccessTime(std::chrono::system_clock::now());
+            if (f->isReadyToRead())
+            {
+                GET_METRIC(tiflash_storage_remote_cache, type_dtfile_hit).Increment();
+                return f;
+            }
+            else
+            {
+                GET_METRIC(tiflash_storage_remote_cache, type_dtfile_miss).Increment();
+                return nullptr;
+            }
         }
-        else
+
+        GET_METRIC(tiflash_storage_remote_cache, type_dtfile_miss).Increment();
+        if (!canCache(file_type) || shard.removing_keys.count(s3_key) > 0)
         {
-            GET_METRIC(tiflash_storage_remote_cache, type_dtfile_miss).Increment();
+            // Don't cache this file type or too many downloading task, or the old file is being removed.
             return nullptr;
         }
-    }
-
-    GET_METRIC(tiflash_storage_remote_cache, type_dtfile_miss).Increment();
-    if (!canCache(file_type))
-    {
-        // Don't cache this file type or too many downloading task.
-        return nullptr;
+        if (!admitLocked(table, s3_key, estimzted_size))
+            return nullptr;
     }
 
     // File not exists, try to download and cache it in backgroud.
-
-    // We don't know the exact size of a object/file, but we need reserve space to save the object/file.
-    // A certain amount of space is reserved for each file type.
-    auto estimzted_size = filesize ? *filesize : getEstimatedSizeOfFileType(file_type);
-    if (!reserveSpaceImpl(file_type, estimzted_size, /*try_evict*/ true))
+    // The space is reserved without holding the lock of shard, because it may evict the files of other shards.
+    if (!reserveSpace(file_type, estimzted_size, /*try_evict*/ true))
     {
         // Space not enough.
         GET_METRIC(tiflash_storage_remote_cache, type_dtfile_full).Increment();
-        LOG_DEBUG(log, "s3_key={} space not enough(capacity={} used={} estimzted_size={}), skip cache", s3_key, cache_capacity, cache_used, estimzted_size);
+        LOG_DEBUG(log, "s3_key={} space not enough(capacity={} used={} estimzted_size={}), skip cache", s3_key, cache_capacity, cache_used.load(std::memory_order_relaxed), estimzted_size);
         return nullptr;
     }
 
     auto file_seg = std::make_shared<FileSegment>(toLocalFilename(s3_key), FileSegment::Status::Empty, estimzted_size, file_type);
-    table.set(s3_key, file_seg);
+    {
+        std::lock_guard lock(shard.mtx);
+        if (table.get(s3_key, /*update_lru*/ false) != nullptr || shard.removing_keys.count(s3_key) > 0)
+        {
+            // Cached by another thread concurrently.
+            releaseSpace(estimzted_size);
+            return nullptr;
+        }
+        table.set(s3_key, file_seg);
+    }
     bgDownload(s3_key, file_seg);
 
     return nullptr;
 }
 
+String FileCache::toChunkKey(const String & s3_key, UInt64 chunk_index)
+{
+    return fmt::format("{}.{}.chunk", s3_key, chunk_index);
+}
+
+FileSegmentPtr FileCache::getChunk(const String & chunk_key, FileType file_type, UInt64 chunk_bytes, FileSegmentPtr & reserved)
+{
+    auto & shard = getShard(chunk_key);
+    auto & table = shard.tables[static_cast<UInt64>(file_type)];
+
+    {
+        std::lock_guard lock(shard.mtx);
+
+        auto f = table.get(chunk_key);
+        if (f != nullptr)
+        {
+            f->setLastAccessTime(std::chrono::system_clock::now());
+            if (f->isReadyToRead())
+            {
+                GET_METRIC(tiflash_storage_remote_cache, type_dtfile_hit).Increment();
+                return f;
+            }
+            // It is being downloaded by another thread.
+            GET_METRIC(tiflash_storage_remote_cache, type_dtfile_miss).Increment();
+            return nullptr;
+        }
+
+        GET_METRIC(tiflash_storage_remote_cache, type_dtfile_miss).Increment();
+        if (shard.removing_keys.count(chunk_key) > 0 || !admitLocked(table, chunk_key, chunk_bytes))
+            return nullptr;
+    }
+
+    if (!reserveSpace(file_type, chunk_bytes, /*try_evict*/ true))
+    {
+        GET_METRIC(tiflash_storage_remote_cache, type_dtfile_full).Increment();
+        LOG_DEBUG(log, "chunk_key={} space not enough(capacity={} used={} size={}), skip cache", chunk_key, cache_capacity, cache_used.load(std::memory_order_relaxed), chunk_bytes);
+        return nullptr;
+    }
+    auto file_seg = std::make_shared<FileSegment>(toLocalFilename(chunk_key), FileSegment::Status::Empty, chunk_bytes, file_type);
+    std::lock_guard lock(shard.mtx);
+    if (table.get(chunk_key, /*update_lru*/ false) != nullptr || shard.removing_keys.count(chunk_key) > 0)
+    {
+        releaseSpace(chunk_bytes);
+        return nullptr;
+    }
+    table.set(chunk_key, file_seg);
+    reserved = std::move(file_seg);
+    return nullptr;
+}
+
+String FileCache::downloadChunk(const String & s3_key, UInt64 offset, UInt64 size, const String & chunk_key, FileSegmentPtr & file_seg)
+{
+    Stopwatch sw;
+    String data;
+    try
+    {
+        auto client = S3::ClientFactory::instance().sharedTiFlashClient();
+        Aws::S3::Model::GetObjectRequest req;
+        client->setBucketAndKeyWithRoot(req, s3_key);
+        req.SetRange(fmt::format("bytes={}-{}", offset, offset + size - 1));
+        ProfileEvents::increment(ProfileEvents::S3GetObject);
+        auto outcome = client->GetObject(req);
+        if (!outcome.IsSuccess())
+        {
+            throw S3::fromS3Error(outcome.GetError(), "s3_key={} offset={} size={}", s3_key, offset, size);
+        }
+        auto & result = outcome.GetResult();
+        RUNTIME_CHECK(result.GetContentLength() == static_cast<Int64>(size), s3_key, offset, size, result.GetContentLength());
+        data.resize(size);
+        auto & istr = result.GetBody();
+        istr.read(data.data(), size);
+        RUNTIME_CHECK_MSG(static_cast<UInt64>(istr.gcount()) == size, "Read s3_key={} offset={} size={} failed, gcount={}", s3_key, offset, size, istr.gcount());
+        ProfileEvents::increment(ProfileEvents::S3ReadBytes, size);
+        GET_METRIC(tiflash_storage_s3_request_seconds, type_get_object).Observe(sw.elapsedSeconds());
+    }
+    catch (...)
+    {
+        if (file_seg != nullptr)
+        {
+            file_seg.reset();
+            remove(chunk_key);
+        }
+        throw;
+    }
+
+    if (file_seg != nullptr)
+    {
+        try
+        {
+            GET_METRIC(tiflash_storage_remote_cache, type_dtfile_download).Increment();
+            writeChunk(file_seg, data);
+        }
+        catch (...)
+        {
+            tryLogCurrentException(log, fmt::format("Write chunk_key={} failed", chunk_key));
+        }
+        if (!file_seg->isReadyToRead())
+        {
+            GET_METRIC(tiflash_storage_remote_cache, type_dtfile_download_failed).Increment();
+            file_seg.reset();
+            remove(chunk_key);
+        }
+    }
+    LOG_TRACE(log, "Download chunk_key={} size={} cost={}ms", chunk_key, size, sw.elapsedMilliseconds());
+    return data;
+}
+
+void FileCache::writeChunk(const FileSegmentPtr & file_seg, const String & data)
+{
+    const auto & local_fname = file_seg->getLocalFileName();
+    prepareParentDir(local_fname);
+    auto temp_fname = toTemporaryFilename(local_fname);
+    {
+        std::ofstream ostr(temp_fname, std::ios_base::out | std::ios_base::binary);
+        RUNTIME_CHECK_MSG(ostr.is_open(), "Open {} failed: {}", temp_fname, strerror(errno));
+        ostr.write(data.data(), data.size());
+        ostr.flush();
+        RUNTIME_CHECK_MSG(ostr.good(), "Write {} size {} failed: {}", temp_fname, data.size(), strerror(errno));
+    }
+    std::filesystem::rename(temp_fname, local_fname);
+    capacity_metrics->addUsedSize(local_fname, data.size());
+    GET_METRIC(tiflash_storage_remote_cache_bytes, type_dtfile_download_bytes).Increment(data.size());
+    file_seg->setStatus(FileSegment::Status::Complete);
+}
+
 // Remove `local_fname` from disk and remove parent directory if parent directory is empty.
 void FileCache::removeDiskFile(const String & local_fname)
 {
@@ -192,18 +366,19 @@ void FileCache::removeDiskFile(const String & local_fname)
 void FileCache::remove(const String & s3_key, bool force)
 {
     auto file_type = getFileType(s3_key);
-    auto & table = tables[static_cast<UInt64>(file_type)];
+    auto & shard = getShard(s3_key);
+    auto & table = shard.tables[static_cast<UInt64>(file_type)];
 
-    std::lock_guard lock(mtx);
+    std::lock_guard lock(shard.mtx);
     auto f = table.get(s3_key, /*update_lru*/ false);
     if (f == nullptr)
     {
         return;
     }
-    std::ignore = removeImpl(table, s3_key, f, force);
+    std::ignore = removeImpl(shard, table, s3_key, f, force);
 }
 
-std::pair<Int64, std::list<String>::iterator> FileCache::removeImpl(LRUFileTable & table, const String & s3_key, FileSegmentPtr & f, bool force)
+std::pair<Int64, std::list<String>::iterator> FileCache::removeImpl(Shard & shard, LRUFileTable & table, const String & s3_key, FileSegmentPtr & f, bool force)
 {
     // Except currenly thread and the FileTable,
     // there are other threads hold this FileSegment object.
@@ -211,32 +386,39 @@ std::pair<Int64, std::list<String>::iterator> FileCache::removeImpl(LRUFileTable
     {
         return {-1, {}};
     }
-    const auto & local_fname = f->getLocalFileName();
-    removeDiskFile(local_fname);
-    auto temp_fname = toTemporaryFilename(local_fname);
-    removeDiskFile(temp_fname);
+    // Removing the disk files is slow, let the background thread do it without holding the lock of shard.
+    shard.removing_keys.insert(s3_key);
+    {
+        std::lock_guard lock(bg_mtx);
+        removing_files.emplace_back(s3_key, f->getLocalFileName());
+    }
+    bg_cv.notify_one();
 
     auto release_size = f->getSize();
     GET_METRIC(tiflash_storage_remote_cache, type_dtfile_evict).Increment();
     GET_METRIC(tiflash_storage_remote_cache_bytes, type_dtfile_evict_bytes).Increment(release_size);
-    releaseSpaceImpl(release_size);
+    releaseSpace(release_size);
     return {release_size, table.remove(s3_key)};
 }
 
-bool FileCache::reserveSpaceImpl(FileType reserve_for, UInt64 size, bool try_evict)
+bool FileCache::reserveSpace(FileType reserve_for, UInt64 size, bool try_evict)
 {
-    if (cache_used + size <= cache_capacity)
+    auto used = cache_used.load(std::memory_order_relaxed);
+    while (used + size <= cache_capacity)
     {
-        cache_used += size;
-        CurrentMetrics::set(CurrentMetrics::DTFileCacheUsed, cache_used);
-        return true;
+        if (cache_used.compare_exchange_weak(used, used + size, std::memory_order_relaxed))
+        {
+            CurrentMetrics::set(CurrentMetrics::DTFileCacheUsed, used + size);
+            notifyBgEvictIfNeeded(used + size);
+            return true;
+        }
     }
     if (try_evict)
     {
-        UInt64 min_evict_size = size - (cache_capacity - cache_used);
+        UInt64 min_evict_size = size - (cache_capacity - std::min(used, cache_capacity));
         LOG_DEBUG(log, "tryEvictFile for {} min_evict_size={}", magic_enum::enum_name(reserve_for), min_evict_size);
         tryEvictFile(reserve_for, min_evict_size);
-        return reserveSpaceImpl(reserve_for, size, /*try_evict*/ false);
+        return reserveSpace(reserve_for, size, /*try_evict*/ false);
     }
     return false;
 }
@@ -263,7 +445,14 @@ void FileCache::tryEvictFile(FileType evict_for, UInt64 size)
     auto file_types = getEvictFileTypes(evict_for);
     for (auto evict_from : file_types)
     {
-        auto evicted_size = tryEvictFrom(evict_for, size, evict_from);
+        UInt64 evicted_size = 0;
+        const auto start = evict_shard_cursor.fetch_add(1, std::memory_order_relaxed);
+        for (size_t i = 0; i < shard_count && evicted_size < size; ++i)
+        {
+            auto & shard = shards[(start + i) % shard_count];
+            std::lock_guard lock(shard.mtx);
+            evicted_size += tryEvictFrom(shard, evict_for, size - evicted_size, evict_from);
+        }
         LOG_DEBUG(log, "tryEvictFrom {} required_size={} evicted_size={}", magic_enum::enum_name(evict_from), size, evicted_size);
         if (size > evicted_size)
         {
@@ -276,9 +465,9 @@ void FileCache::tryEvictFile(FileType evict_for, UInt64 size)
     }
 }
 
-UInt64 FileCache::tryEvictFrom(FileType evict_for, UInt64 size, FileType evict_from)
+UInt64 FileCache::tryEvictFrom(Shard & shard, FileType evict_for, UInt64 size, FileType evict_from)
 {
-    auto & table = tables[static_cast<UInt64>(evict_from)];
+    auto & table = shard.tables[static_cast<UInt64>(evict_from)];
     UInt64 total_released_size = 0;
     constexpr UInt32 max_try_evict_count = 10;
     // File type that we evict for does not have higher priority,
@@ -292,7 +481,7 @@ UInt64 FileCache::tryEvictFrom(FileType evict_for, UInt64 size, FileType evict_f
         auto f = table.get(s3_key, /*update_lru*/ false);
         if (!check_last_access_time || !f->isRecentlyAccess(std::chrono::seconds(cache_min_age_seconds.load(std::memory_order_relaxed))))
         {
-            auto [released_size, next_itr] = removeImpl(table, s3_key, f);
+            auto [released_size, next_itr] = removeImpl(shard, table, s3_key, f);
             LOG_DEBUG(log, "tryRemoveFile {} size={}", s3_key, released_size);
             if (released_size < 0) // not remove
             {
@@ -316,22 +505,119 @@ UInt64 FileCache::tryEvictFrom(FileType evict_for, UInt64 size, FileType evict_f
     return total_released_size;
 }
 
-bool FileCache::reserveSpace(FileType reserve_for, UInt64 size, bool try_evict)
+void FileCache::releaseSpace(UInt64 size)
 {
-    std::lock_guard lock(mtx);
-    return reserveSpaceImpl(reserve_for, size, try_evict);
+    auto used = cache_used.fetch_sub(size, std::memory_order_relaxed) - size;
+    CurrentMetrics::set(CurrentMetrics::DTFileCacheUsed, used);
 }
 
-void FileCache::releaseSpaceImpl(UInt64 size)
+void FileCache::notifyBgEvictIfNeeded(UInt64 used)
 {
-    cache_used -= size;
-    CurrentMetrics::set(CurrentMetrics::DTFileCacheUsed, cache_used);
+    if (used <= cache_capacity * evict_high_watermark.load(std::memory_order_relaxed))
+        return;
+    {
+        std::lock_guard lock(bg_mtx);
+        bg_need_evict = true;
+    }
+    bg_cv.notify_one();
 }
 
-void FileCache::releaseSpace(UInt64 size)
+void FileCache::bgWork()
 {
-    std::lock_guard lock(mtx);
-    releaseSpaceImpl(size);
+    setThreadName("FileCacheBg");
+    while (true)
+    {
+        std::vector<std::pair<String, String>> files;
+        bool need_evict = false;
+        {
+            std::unique_lock lock(bg_mtx);
+            bg_cv.wait(lock, [this] { return bg_shutdown || bg_need_evict || !removing_files.empty(); });
+            if (bg_shutdown && removing_files.empty())
+                return;
+            files.swap(removing_files);
+            need_evict = bg_need_evict && !bg_shutdown;
+            bg_need_evict = false;
+        }
+
+        if (need_evict)
+        {
+            try
+            {
+                // The evicted files are removed from disk in the next round.
+                evictToLowWatermark();
+            }
+            catch (...)
+            {
+                tryLogCurrentException(log, "evictToLowWatermark");
+            }
+        }
+
+        for (const auto & [s3_key, local_fname] : files)
+        {
+            removeDiskFile(local_fname);
+            removeDiskFile(toTemporaryFilename(local_fname));
+            auto & shard = getShard(s3_key);
+            std::lock_guard lock(shard.mtx);
+            shard.removing_keys.erase(s3_key);
+        }
+    }
+}
+
+void FileCache::evictToLowWatermark()
+{
+    const auto used = cache_used.load(std::memory_order_relaxed);
+    if (used <= cache_capacity * evict_high_watermark.load(std::memory_order_relaxed))
+        return;
+    const auto target = static_cast<UInt64>(cache_capacity * evict_low_watermark.load(std::memory_order_relaxed));
+    Stopwatch sw;
+    // Like `tryEvictFile`, the lower priority file types are evicted first.
+    constexpr auto all_file_types = magic_enum::enum_values<FileType>();
+    for (auto itr = std::rbegin(all_file_types); itr != std::rend(all_file_types); ++itr)
+    {
+        // Evict from all shards evenly, until no file can be evicted from this file type.
+        for (bool evicted = true; evicted;)
+        {
+            evicted = false;
+            for (auto & shard : shards)
+            {
+                auto cur_used = cache_used.load(std::memory_order_relaxed);
+                if (cur_used <= target)
+                {
+                    LOG_DEBUG(log, "evictToLowWatermark done, used={}=>{} capacity={} cost={}ms", used, cur_used, cache_capacity, sw.elapsedMilliseconds());
+                    return;
+                }
+                std::lock_guard lock(shard.mtx);
+                evicted |= evictColdFiles(shard, *itr, (cur_used - target) / shard_count + 1) > 0;
+            }
+        }
+    }
+    LOG_TRACE(log, "evictToLowWatermark not enough, used={}=>{} capacity={} cost={}ms", used, cache_used.load(std::memory_order_relaxed), cache_capacity, sw.elapsedMilliseconds());
+}
+
+UInt64 FileCache::evictColdFiles(Shard & shard, FileType evict_from, UInt64 size)
+{
+    auto & table = shard.tables[static_cast<UInt64>(evict_from)];
+    const auto min_age = std::chrono::seconds(cache_min_age_seconds.load(std::memory_order_relaxed));
+    UInt64 total_released_size = 0;
+    for (auto itr = table.begin(); itr != table.end() && total_released_size < size;)
+    {
+        auto s3_key = *itr;
+        auto f = table.get(s3_key, /*update_lru*/ false);
+        // The files are in the order of access time, the rest files are accessed more recently.
+        if (f->isRecentlyAccess(min_age))
+            break;
+        auto [released_size, next_itr] = removeImpl(shard, table, s3_key, f);
+        if (released_size < 0) // not remove
+        {
+            ++itr;
+        }
+        else
+        {
+            itr = next_itr;
+            total_released_size += released_size;
+        }
+    }
+    return total_released_size;
 }
 
 bool FileCache::canCache(FileType file_type) const
@@ -341,6 +627,15 @@ bool FileCache::canCache(FileType file_type) const
         && bg_downloading_count.load(std::memory_order_relaxed) < S3FileCachePool::get().getMaxThreads() * max_downloading_count_scale.load(std::memory_order_relaxed);
 }
 
+bool FileCache::admitLocked(const LRUFileTable & table, const String & s3_key, UInt64 size) const
+{
+    if (cache_used.load(std::memory_order_relaxed) + size <= cache_capacity || table.admit(s3_key))
+        return true;
+    GET_METRIC(tiflash_storage_remote_cache, type_dtfile_admission_reject).Increment();
+    LOG_TRACE(log, "s3_key={} is colder than the files to be evicted, skip cache", s3_key);
+    return false;
+}
+
 FileType FileCache::getFileTypeOfColData(const std::filesystem::path & p)
 {
     if (p.extension() == ".null")
@@ -376,11 +671,16 @@ FileType FileCache::getFileType(const String & fname)
     {
         return p.stem() == DM::DMFile::metav2FileName() ? FileType::Meta : FileType::Unknow;
     }
+    else if (ext == ".chunk")
+    {
+        // "{s3_key}.{chunk_index}.chunk", see `toChunkKey`.
+        return getFileType(std::filesystem::path(p.stem()).stem().string());
+    }
     else if (ext == ".merged")
     {
         return FileType::Merged;
     }
-    else if (ext == ".idx")
+    else if (ext == ".idx" || ext == ".bf")
     {
         return FileType::Index;
     }
@@ -558,15 +858,18 @@ void FileCache::restore()
     }
 
     size_t total_count = 0;
-    for (const auto & t : tables)
+    for (const auto & shard : shards)
     {
-        total_count += t.size();
+        for (const auto & t : shard.tables)
+        {
+            total_count += t.size();
+        }
     }
     LOG_INFO(
         log,
         "restore: cost={:.3f}s used={} capacity={} total_count={}",
         sw.elapsedSeconds(),
-        cache_used,
+        cache_used.load(std::memory_order_relaxed),
         cache_capacity,
         total_count);
 }
@@ -606,14 +909,14 @@ void FileCache::restoreDMFile(const std::filesystem::directory_entry & dmfile_en
         else
         {
             auto file_type = getFileType(fname);
-            auto & table = tables[static_cast<UInt64>(file_type)];
+            auto s3_key = toS3Key(fname);
+            auto & table = getShard(s3_key).tables[static_cast<UInt64>(file_type)];
             auto size = file_entry.file_size();
-            if (canCache(file_type) && cache_capacity - cache_used >= size)
+            // It is called in the constructor, no other threads access the cache now.
+            if (canCache(file_type) && reserveSpace(file_type, size, /*try_evict*/ false))
             {
-                table.set(toS3Key(fname), std::make_shared<FileSegment>(fname, FileSegment::Status::Complete, size, file_type));
+                table.set(s3_key, std::make_shared<FileSegment>(fname, FileSegment::Status::Complete, size, file_type));
                 capacity_metrics->addUsedSize(fname, size);
-                cache_used += size;
-                CurrentMetrics::set(CurrentMetrics::DTFileCacheUsed, cache_used);
             }
             else
             {
@@ -625,12 +928,15 @@ void FileCache::restoreDMFile(const std::filesystem::directory_entry & dmfile_en
 
 std::vector<FileSegmentPtr> FileCache::getAll()
 {
-    std::lock_guard lock(mtx);
     std::vector<FileSegmentPtr> file_segs;
-    for (const auto & table : tables)
+    for (auto & shard : shards)
     {
-        auto values = table.getAllFiles();
-        file_segs.insert(file_segs.end(), values.begin(), values.end());
+        std::lock_guard lock(shard.mtx);
+        for (const auto & table : shard.tables)
+        {
+            auto values = table.getAllFiles();
+            file_segs.insert(file_segs.end(), values.begin(), values.end());
+        }
     }
     return file_segs;
 }
@@ -650,6 +956,128 @@ void FileCache::updateConfig(const Settings & settings)
         LOG_INFO(log, "cache_min_age_seconds {} => {}", cache_min_age_seconds.load(std::memory_order_relaxed), cache_min_age);
         cache_min_age_seconds.store(cache_min_age, std::memory_order_relaxed);
     }
+
+    double high_watermark = settings.dt_filecache_evict_high_watermark;
+    double low_watermark = settings.dt_filecache_evict_low_watermark;
+    low_watermark = std::min(low_watermark, high_watermark);
+    if (std::fabs(high_watermark - evict_high_watermark.load(std::memory_order_relaxed)) > 0.001
+        || std::fabs(low_watermark - evict_low_watermark.load(std::memory_order_relaxed)) > 0.001)
+    {
+        LOG_INFO(
+            log,
+            "evict_watermark high={}=>{} low={}=>{}",
+            evict_high_watermark.load(std::memory_order_relaxed),
+            high_watermark,
+            evict_low_watermark.load(std::memory_order_relaxed),
+            low_watermark);
+        evict_high_watermark.store(high_watermark, std::memory_order_relaxed);
+        evict_low_watermark.store(low_watermark, std::memory_order_relaxed);
+    }
+}
+
+ChunkedCacheRandomAccessFile::ChunkedCacheRandomAccessFile(FileCache & file_cache_, const String & s3_key_, UInt64 file_size_)
+    : file_cache(file_cache_)
+    , s3_key(s3_key_)
+    , file_type(FileCache::getFileType(s3_key))
+    , file_size(file_size_)
+    , chunk_size(file_cache.chunk_size)
+{
+    RUNTIME_CHECK(chunk_size > 0, s3_key);
+}
+
+off_t ChunkedCacheRandomAccessFile::seek(off_t offset, int whence)
+{
+    RUNTIME_CHECK(whence == SEEK_SET, whence);
+    RUNTIME_CHECK(offset >= 0 && static_cast<UInt64>(offset) <= file_size, offset, file_size);
+    cur_offset = offset;
+    return cur_offset;
+}
+
+ssize_t ChunkedCacheRandomAccessFile::read(char * buf, size_t size)
+{
+    auto n = pread(buf, size, cur_offset);
+    cur_offset += n;
+    return n;
+}
+
+ssize_t ChunkedCacheRandomAccessFile::pread(char * buf, size_t size, off_t offset) const
+{
+    RUNTIME_CHECK(offset >= 0, offset);
+    if (static_cast<UInt64>(offset) >= file_size)
+        return 0;
+    size = std::min(size, file_size - static_cast<UInt64>(offset));
+    size_t read_bytes = 0;
+    while (read_bytes < size)
+    {
+        UInt64 pos = offset + read_bytes;
+        UInt64 chunk_index = pos / chunk_size;
+        UInt64 offset_in_chunk = pos % chunk_size;
+        auto n = std::min(size - read_bytes, getChunkBytes(chunk_index) - offset_in_chunk);
+        readChunk(chunk_index, offset_in_chunk, buf + read_bytes, n);
+        read_bytes += n;
+    }
+    return read_bytes;
+}
+
+UInt64 ChunkedCacheRandomAccessFile::getChunkBytes(UInt64 chunk_index) const
+{
+    return std::min(chunk_size, file_size - chunk_index * chunk_size);
+}
+
+void ChunkedCacheRandomAccessFile::readChunk(UInt64 chunk_index, UInt64 offset_in_chunk, char * buf, size_t size) const
+{
+    {
+        std::lock_guard lock(mtx);
+        if (opened_chunk != nullptr && opened_chunk_index == chunk_index)
+        {
+            auto n = opened_chunk->pread(buf, size, offset_in_chunk);
+            RUNTIME_CHECK(n == static_cast<ssize_t>(size), s3_key, chunk_index, offset_in_chunk, size, n);
+            return;
+        }
+        if (!opened_chunk_data.empty() && opened_chunk_index == chunk_index)
+        {
+            memcpy(buf, opened_chunk_data.data() + offset_in_chunk, size);
+            return;
+        }
+    }
+
+    auto chunk_key = FileCache::toChunkKey(s3_key, chunk_index);
+    auto chunk_bytes = getChunkBytes(chunk_index);
+    FileSegmentPtr reserved;
+    if (auto file_seg = file_cache.getChunk(chunk_key, file_type, chunk_bytes, reserved); file_seg != nullptr)
+    {
+        try
+        {
+            // PosixRandomAccessFile holds the `file_seg` to prevent the chunk from being evicted.
+            auto chunk = std::make_shared<PosixRandomAccessFile>(file_seg->getLocalFileName(), /*flags*/ -1, /*read_limiter*/ nullptr, file_seg);
+            auto n = chunk->pread(buf, size, offset_in_chunk);
+            RUNTIME_CHECK(n == static_cast<ssize_t>(size), s3_key, chunk_index, offset_in_chunk, size, n);
+            std::lock_guard lock(mtx);
+            opened_chunk_index = chunk_index;
+            opened_chunk = std::move(chunk);
+            String().swap(opened_chunk_data);
+            return;
+        }
+        catch (const DB::Exception & e)
+        {
+            if (e.code() != ErrorCodes::FILE_DOESNT_EXIST)
+                throw;
+            // The cache file is removed manually, remove it from FileCache and read from S3.
+            file_cache.remove(chunk_key, /*force*/ true);
+        }
+    }
+
+    auto data = file_cache.downloadChunk(s3_key, chunk_index * chunk_size, chunk_bytes, chunk_key, reserved);
+    memcpy(buf, data.data() + offset_in_chunk, size);
+    // If the chunk is cached, it is opened from FileCache by the next read. Otherwise keep the downloaded
+    // data, so that the following reads of the chunk do not download it again.
+    if (reserved == nullptr)
+    {
+        std::lock_guard lock(mtx);
+        opened_chunk_index = chunk_index;
+        opened_chunk.reset();
+        opened_chunk_data = std::move(data);
+    }
 }
 
 } // namespace DB
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <Common/CachePolicy.h>
+#include <Common/Exception.h>
 #include <Common/Logger.h>
 #include <Common/nocopyable.h>
 #include <Encryption/RandomAccessFile.h>
@@ -26,10 +28,13 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <filesystem>
 #include <magic_enum.hpp>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace DB
 {
@@ -130,38 +135,79 @@ private:
 
 using FileSegmentPtr = std::shared_ptr<FileSegment>;
 
+/// The files are evicted from `begin()` to `end()`.
+/// With `CachePolicy::LRU`, the queue is a plain LRU.
+/// With `CachePolicy::TinyLFU`, the queue is a segmented LRU: `[begin(), protected_begin)` is the probation
+/// segment and `[protected_begin, end())` is the protected segment. New files are put at the tail of the
+/// probation segment, and moved to the protected segment when they are accessed again. So the files accessed
+/// only once, e.g. by a large scan, are evicted before the files that are accessed repeatedly.
 class LRUFileTable
 {
 public:
+    LRUFileTable() = default;
+
+    DISALLOW_COPY_AND_MOVE(LRUFileTable);
+
+    void setPolicy(CachePolicy policy_)
+    {
+        RUNTIME_CHECK(table.empty());
+        policy = policy_;
+        sketch = policy == CachePolicy::TinyLFU ? std::make_unique<FrequencySketch>(sketch_width) : nullptr;
+    }
+
+    CachePolicy getPolicy() const { return policy; }
+
     FileSegmentPtr get(const String & key, bool update_lru = true)
     {
+        if (update_lru && sketch != nullptr)
+        {
+            // Record the misses too, so a file is admitted after it is accessed repeatedly.
+            sketch->increment(std::hash<String>{}(key));
+        }
         auto itr = table.find(key);
         if (itr == table.end())
         {
             return nullptr;
         }
-        auto & [file_seg, lru_itr] = itr->second;
+        auto & entry = itr->second;
         if (update_lru)
         {
-            // Move the key to the end of the queue. The iterator remains valid.
-            lru_queue.splice(lru_queue.end(), lru_queue, lru_itr);
+            touch(entry);
         }
-        return file_seg;
+        return entry.file_seg;
     }
 
     void set(const String & key, const FileSegmentPtr & value)
     {
-        auto [itr, inserted] = table.emplace(key, std::pair{value, std::list<String>::iterator{}});
+        auto [itr, inserted] = table.emplace(key, Entry{.file_seg = value, .lru_itr = {}, .is_protected = false});
         if (inserted)
         {
-            itr->second.second = lru_queue.insert(lru_queue.end(), key);
+            // `protected_begin` is always `end()` for LRU.
+            itr->second.lru_itr = lru_queue.insert(protected_begin, key);
+            if (sketch != nullptr)
+            {
+                sketch->ensureCapacity(table.size());
+            }
         }
         else
         {
-            lru_queue.splice(lru_queue.end(), lru_queue, itr->second.second);
+            touch(itr->second);
         }
     }
 
+    // Whether to cache `key` if some files must be evicted for it. For TinyLFU, it is admitted only
+    // if it is accessed more frequently than the head of the LRU queue of this table, i.e. the same
+    // shard and file type. Note that it is not the file actually evicted by `FileCache::tryEvictFile`,
+    // which visits the shards round-robin and may evict the other file types first.
+    bool admit(const String & key) const
+    {
+        if (sketch == nullptr || lru_queue.empty())
+        {
+            return true;
+        }
+        return sketch->estimate(std::hash<String>{}(key)) > sketch->estimate(std::hash<String>{}(lru_queue.front()));
+    }
+
     std::list<String>::iterator begin()
     {
         return lru_queue.begin();
@@ -179,7 +225,16 @@ public:
         {
             return end();
         }
-        auto next_itr = lru_queue.erase(itr->second.second);
+        auto & entry = itr->second;
+        if (entry.lru_itr == protected_begin)
+        {
+            ++protected_begin;
+        }
+        if (entry.is_protected)
+        {
+            --protected_count;
+        }
+        auto next_itr = lru_queue.erase(entry.lru_itr);
         table.erase(itr);
         return next_itr;
     }
@@ -189,7 +244,7 @@ public:
         std::vector<FileSegmentPtr> files;
         for (const auto & pa : table)
         {
-            files.push_back(pa.second.first);
+            files.push_back(pa.second.file_seg);
         }
         return files;
     }
@@ -200,8 +255,55 @@ public:
     }
 
 private:
+    struct Entry
+    {
+        FileSegmentPtr file_seg;
+        std::list<String>::iterator lru_itr;
+        bool is_protected;
+    };
+
+    void touch(Entry & entry)
+    {
+        // Move the key to the end of the queue. The iterator remains valid.
+        if (entry.lru_itr == protected_begin)
+        {
+            ++protected_begin;
+        }
+        lru_queue.splice(lru_queue.end(), lru_queue, entry.lru_itr);
+        if (policy == CachePolicy::LRU)
+        {
+            return;
+        }
+
+        if (protected_begin == lru_queue.end())
+        {
+            protected_begin = entry.lru_itr;
+        }
+        if (!entry.is_protected)
+        {
+            entry.is_protected = true;
+            ++protected_count;
+        }
+        // Keep the protected segment within 80% of the files, the least recently used
+        // protected files become the most recently used files of the probation segment.
+        while (protected_count * 5 > table.size() * 4)
+        {
+            table.find(*protected_begin)->second.is_protected = false;
+            --protected_count;
+            ++protected_begin;
+        }
+    }
+
+    // The sketch grows with the number of files, and keeps the frequencies when growing.
+    static constexpr size_t sketch_width = 64;
+
+    CachePolicy policy = CachePolicy::LRU;
+    std::unique_ptr<FrequencySketch> sketch;
+
     std::list<String> lru_queue;
-    std::unordered_map<String, std::pair<FileSegmentPtr, std::list<String>::iterator>> table;
+    std::unordered_map<String, Entry> table;
+    std::list<String>::iterator protected_begin = lru_queue.end();
+    size_t protected_count = 0;
 };
 
 class FileCache
@@ -227,6 +329,8 @@ public:
 
     FileCache(PathCapacityMetricsPtr capacity_metrics_, const StorageRemoteCacheConfig & config_);
 
+    ~FileCache();
+
     RandomAccessFilePtr getRandomAccessFile(const S3::S3FilenameView & s3_fname, const std::optional<UInt64> & filesize);
 
     void updateConfig(const Settings & settings);
@@ -248,6 +352,16 @@ public:
     void download(const String & s3_key, FileSegmentPtr & file_seg);
     void downloadImpl(const String & s3_key, FileSegmentPtr & file_seg);
 
+    friend class ChunkedCacheRandomAccessFile;
+    static String toChunkKey(const String & s3_key, UInt64 chunk_index);
+    // Return the chunk if it is cached, otherwise return nullptr.
+    // If the chunk is not cached and the space is reserved for it, an empty FileSegment is added
+    // and returned by `reserved`, the caller should fill it by `downloadChunk`.
+    FileSegmentPtr getChunk(const String & chunk_key, FileSegment::FileType file_type, UInt64 chunk_bytes, FileSegmentPtr & reserved);
+    // Read [offset, offset + size) of `s3_key` by a ranged GET. The data is also written to `file_seg` if it is not null.
+    String downloadChunk(const String & s3_key, UInt64 offset, UInt64 size, const String & chunk_key, FileSegmentPtr & file_seg);
+    void writeChunk(const FileSegmentPtr & file_seg, const String & data);
+
     static String toTemporaryFilename(const String & fname);
     static bool isTemporaryFilename(const String & fname);
     static void prepareDir(const String & dir_name);
@@ -261,8 +375,22 @@ public:
     void restoreTable(const std::filesystem::directory_entry & table_entry);
     void restoreDMFile(const std::filesystem::directory_entry & dmfile_entry);
 
+    // The files are sharded by the hash of keys, each shard has its own lock and LRU tables,
+    // so that the concurrent reads of different files do not contend the same lock.
+    struct Shard
+    {
+        std::mutex mtx;
+        std::array<LRUFileTable, magic_enum::enum_count<FileSegment::FileType>()> tables;
+        // The keys whose files are being removed from disk by the background thread.
+        // They can not be cached again until the files are removed.
+        std::unordered_set<String> removing_keys;
+    };
+    static constexpr size_t shard_count = 32;
+    Shard & getShard(const String & s3_key);
+
     void remove(const String & s3_key, bool force = false);
-    std::pair<Int64, std::list<String>::iterator> removeImpl(LRUFileTable & table, const String & s3_key, FileSegmentPtr & f, bool force = false);
+    // Remove the file from `table` of `shard`, and the disk file is removed in background. The lock of `shard` must be held.
+    std::pair<Int64, std::list<String>::iterator> removeImpl(Shard & shard, LRUFileTable & table, const String & s3_key, FileSegmentPtr & f, bool force = false);
     void removeDiskFile(const String & local_fname);
 
     // Estimated size is an empirical value.
@@ -288,27 +416,51 @@ public:
     static FileSegment::FileType getFileType(const String & fname);
     static FileSegment::FileType getFileTypeOfColData(const std::filesystem::path & p);
     bool canCache(FileSegment::FileType file_type) const;
-    bool reserveSpaceImpl(FileSegment::FileType reserve_for, UInt64 size, bool try_evict);
-    void releaseSpaceImpl(UInt64 size);
+    // Whether to cache `s3_key` of `table` when it is missed. It is rejected if the space is not enough and
+    // the table does not admit it, see `LRUFileTable::admit`. The lock of the shard of `table` must be held.
+    bool admitLocked(const LRUFileTable & table, const String & s3_key, UInt64 size) const;
+    // The space is accounted globally by atomics, no lock is required.
     void releaseSpace(UInt64 size);
     bool reserveSpace(FileSegment::FileType reserve_for, UInt64 size, bool try_evict);
     bool finalizeReservedSize(FileSegment::FileType reserve_for, UInt64 reserved_size, UInt64 content_length);
     static std::vector<FileSegment::FileType> getEvictFileTypes(FileSegment::FileType evict_for);
     void tryEvictFile(FileSegment::FileType evict_for, UInt64 size);
-    UInt64 tryEvictFrom(FileSegment::FileType evict_for, UInt64 size, FileSegment::FileType evict_from);
+    // The lock of `shard` must be held.
+    UInt64 tryEvictFrom(Shard & shard, FileSegment::FileType evict_for, UInt64 size, FileSegment::FileType evict_from);
+
+    // The background thread removes the disk files of the evicted files, and evicts the files that
+    // are not accessed recently when the used space exceeds `evict_high_watermark`.
+    void bgWork();
+    void notifyBgEvictIfNeeded(UInt64 used);
+    void evictToLowWatermark();
+    // The lock of `shard` must be held.
+    UInt64 evictColdFiles(Shard & shard, FileSegment::FileType evict_from, UInt64 size);
 
     // This function is used for test.
     std::vector<FileSegmentPtr> getAll();
 
-    std::mutex mtx;
     PathCapacityMetricsPtr capacity_metrics;
     String cache_dir;
     UInt64 cache_capacity;
     UInt64 cache_level;
-    UInt64 cache_used;
+    std::atomic<UInt64> cache_used;
+    // 0 means caching the whole files.
+    const UInt64 chunk_size;
     std::atomic<UInt64> cache_min_age_seconds = 1800;
     std::atomic<double> max_downloading_count_scale = 1.0;
-    std::array<LRUFileTable, magic_enum::enum_count<FileSegment::FileType>()> tables;
+    std::atomic<double> evict_high_watermark = 0.95;
+    std::atomic<double> evict_low_watermark = 0.9;
+    std::array<Shard, shard_count> shards;
+    // The shard to start the next eviction from, so that the concurrent evictions start from different shards.
+    std::atomic<size_t> evict_shard_cursor = 0;
+
+    std::mutex bg_mtx;
+    std::condition_variable bg_cv;
+    bool bg_shutdown = false;
+    bool bg_need_evict = false;
+    // The keys and local filenames of the files to be removed from disk.
+    std::vector<std::pair<String, String>> removing_files;
+    std::thread bg_thread;
 
     // Currently, these variables are just use for testing.
     std::atomic<UInt64> bg_downloading_count = 0;
@@ -317,6 +469,47 @@ public:
 
     DB::LoggerPtr log;
 };
+
+/// Read an S3 object by the chunks in FileCache. The chunks that are not cached are downloaded by ranged GETs
+/// in the reading thread, so only the ranges that are really read are downloaded and cached.
+class ChunkedCacheRandomAccessFile final : public RandomAccessFile
+{
+public:
+    ChunkedCacheRandomAccessFile(FileCache & file_cache_, const String & s3_key_, UInt64 file_size_);
+
+    off_t seek(off_t offset, int whence) override;
+
+    ssize_t read(char * buf, size_t size) override;
+
+    ssize_t pread(char * buf, size_t size, off_t offset) const override;
+
+    std::string getFileName() const override { return s3_key; }
+
+    int getFd() const override { return -1; }
+
+    bool isClosed() const override { return is_closed; }
+
+    void close() override { is_closed = true; }
+
+private:
+    UInt64 getChunkBytes(UInt64 chunk_index) const;
+    void readChunk(UInt64 chunk_index, UInt64 offset_in_chunk, char * buf, size_t size) const;
+
+    FileCache & file_cache;
+    const String s3_key;
+    const FileSegment::FileType file_type;
+    const UInt64 file_size;
+    const UInt64 chunk_size;
+    off_t cur_offset = 0;
+    bool is_closed = false;
+
+    // The last read chunk is kept open, because the reads are usually sequential.
+    // If it can not be cached by FileCache, for example there is no space, its data is kept in memory instead.
+    mutable std::mutex mtx;
+    mutable UInt64 opened_chunk_index = 0;
+    mutable RandomAccessFilePtr opened_chunk;
+    mutable String opened_chunk_data;
+};
 } // namespace DB
 
 // Make std::filesystem::path formattable.
@@ -26,6 +26,7 @@
 #include <aws/s3/S3Errors.h>
 #include <aws/s3/S3ServiceClientModel.h>
 #include <aws/s3/model/CommonPrefix.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
 #include <aws/s3/model/CompleteMultipartUploadRequest.h>
 #include <aws/s3/model/CopyObjectRequest.h>
 #include <aws/s3/model/CreateBucketRequest.h>
@@ -294,6 +295,13 @@ Model::CompleteMultipartUploadOutcome MockS3Client::CompleteMultipartUpload(cons
     return Model::CompleteMultipartUploadResult{};
 }
 
+Model::AbortMultipartUploadOutcome MockS3Client::AbortMultipartUpload(const Model::AbortMultipartUploadRequest & request) const
+{
+    std::lock_guard lock(mtx);
+    upload_parts.erase(request.GetUploadId());
+    return Model::AbortMultipartUploadResult{};
+}
+
 Model::CreateBucketOutcome MockS3Client::CreateBucket(const Model::CreateBucketRequest & request) const
 {
     std::lock_guard lock(mtx);
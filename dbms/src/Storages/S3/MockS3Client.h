@@ -37,6 +37,7 @@ public:
     Model::CreateMultipartUploadOutcome CreateMultipartUpload(const Model::CreateMultipartUploadRequest & request) const override;
     Model::UploadPartOutcome UploadPart(const Model::UploadPartRequest & request) const override;
     Model::CompleteMultipartUploadOutcome CompleteMultipartUpload(const Model::CompleteMultipartUploadRequest & request) const override;
+    Model::AbortMultipartUploadOutcome AbortMultipartUpload(const Model::AbortMultipartUploadRequest & request) const override;
     Model::CreateBucketOutcome CreateBucket(const Model::CreateBucketRequest & request) const override;
     Model::DeleteBucketOutcome DeleteBucket(const Model::DeleteBucketRequest & request) const override;
     Model::DeleteObjectOutcome DeleteObject(const Model::DeleteObjectRequest & request) const override;
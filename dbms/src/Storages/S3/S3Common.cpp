@@ -28,6 +28,7 @@
 #include <Storages/S3/PocoHTTPClientFactory.h>
 #include <Storages/S3/S3Common.h>
 #include <Storages/S3/S3Filename.h>
+#include <Storages/S3/S3WritableFile.h>
 #include <aws/core/auth/AWSCredentials.h>
 #include <aws/core/auth/STSCredentialsProvider.h>
 #include <aws/core/auth/signer/AWSAuthV4Signer.h>
@@ -627,6 +628,49 @@ void uploadFile(const TiFlashS3Client & client, const String & local_fname, cons
     retryWrapper(doUploadFile, client, local_fname, remote_fname, max_retry_times);
 }
 
+void uploadFileByS3WritableFile(std::shared_ptr<TiFlashS3Client> client, const String & local_fname, const String & remote_fname, const WriteSettings & write_settings, int max_retry_times)
+{
+    const auto file_size = std::filesystem::file_size(local_fname);
+    if (file_size <= write_settings.max_single_part_upload_size)
+    {
+        uploadFile(*client, local_fname, remote_fname, max_retry_times);
+        return;
+    }
+
+    Stopwatch sw;
+    auto is_dmfile = S3FilenameView::fromKey(remote_fname).isDMFile();
+    for (int retry = 0;; ++retry)
+    {
+        // The requests of the multipart upload are counted by S3WritableFile, only count the DMFile uploads here
+        // like `uploadFile`.
+        if (is_dmfile)
+        {
+            ProfileEvents::increment(ProfileEvents::S3PutDMFile);
+            if (retry > 0)
+                ProfileEvents::increment(ProfileEvents::S3PutDMFileRetry);
+        }
+        try
+        {
+            // The multipart upload is aborted if the file is destroyed before `fsync` succeeds.
+            S3WritableFile file(client, remote_fname, write_settings);
+            file.writeLocalFile(local_fname, file_size);
+            file.fsync();
+            break;
+        }
+        catch (...)
+        {
+            if (retry + 1 >= max_retry_times)
+                throw;
+            LOG_WARNING(client->log, "uploadFile failed and need retry, local_fname={} key={} retry={} error={}", local_fname, remote_fname, retry, getCurrentExceptionMessage(false));
+        }
+    }
+    ProfileEvents::increment(is_dmfile ? ProfileEvents::S3WriteDMFileBytes : ProfileEvents::S3WriteBytes, file_size);
+    auto elapsed_seconds = sw.elapsedSeconds();
+    if (is_dmfile)
+        GET_METRIC(tiflash_storage_s3_request_seconds, type_put_dmfile).Observe(elapsed_seconds);
+    LOG_DEBUG(client->log, "uploadFile local_fname={}, key={}, write_bytes={} cost={:.3f}s", local_fname, remote_fname, file_size, elapsed_seconds);
+}
+
 void downloadFile(const TiFlashS3Client & client, const String & local_fname, const String & remote_fname)
 {
     Stopwatch sw;
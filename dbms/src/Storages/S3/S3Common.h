@@ -157,6 +157,11 @@ bool objectExists(const TiFlashS3Client & client, const String & key);
 
 void uploadFile(const TiFlashS3Client & client, const String & local_fname, const String & remote_fname, int max_retry_times = 3);
 
+struct WriteSettings;
+/// Upload the large file by the multipart upload of S3WritableFile, the parts are uploaded concurrently and
+/// every part is read from the local file by its request. The small file is uploaded by `uploadFile`.
+void uploadFileByS3WritableFile(std::shared_ptr<TiFlashS3Client> client, const String & local_fname, const String & remote_fname, const WriteSettings & write_settings, int max_retry_times = 3);
+
 constexpr std::string_view TaggingObjectIsDeleted = "tiflash_deleted=true";
 bool ensureLifecycleRuleExist(const TiFlashS3Client & client, Int32 expire_days);
 
@@ -18,6 +18,8 @@
 #include <Common/StringUtils/StringUtils.h>
 #include <Common/TiFlashMetrics.h>
 #include <Encryption/RandomAccessFile.h>
+#include <IO/IOThreadPools.h>
+#include <Server/StorageConfigParser.h>
 #include <Storages/S3/FileCache.h>
 #include <Storages/S3/MemoryRandomAccessFile.h>
 #include <Storages/S3/S3Common.h>
@@ -36,19 +38,97 @@ extern const Event S3ReadBytes;
 extern const Event S3GetObjectRetry;
 } // namespace ProfileEvents
 
+namespace DB::ErrorCodes
+{
+extern const int S3_ERROR;
+} // namespace DB::ErrorCodes
+
 namespace DB::S3
 {
+namespace
+{
+// The initial size of the ranges read ahead.
+constexpr UInt64 min_read_ahead_bytes = 256 * 1024;
+constexpr Int32 max_read_range_retry = 3;
+
+/// Read [start, start + size) of the S3 object into `buf` by a ranged GET.
+bool readObjectRange(const TiFlashS3Client & client, const String & key, UInt64 start, UInt64 size, char * buf, const LoggerPtr & log)
+{
+    Stopwatch sw;
+    Aws::S3::Model::GetObjectRequest req;
+    req.SetRange(fmt::format("bytes={}-{}", start, start + size - 1));
+    client.setBucketAndKeyWithRoot(req, key);
+    for (Int32 retry = 1; retry <= max_read_range_retry; ++retry)
+    {
+        ProfileEvents::increment(ProfileEvents::S3GetObject);
+        if (retry > 1)
+        {
+            ProfileEvents::increment(ProfileEvents::S3GetObjectRetry);
+        }
+        auto outcome = client.GetObject(req);
+        if (!outcome.IsSuccess())
+        {
+            LOG_ERROR(log, "S3 GetObject failed: {}, start={} size={} retry={}", S3::S3ErrorMessage(outcome.GetError()), start, size, retry);
+            continue;
+        }
+        auto & istr = outcome.GetResult().GetBody();
+        istr.read(buf, size);
+        if (static_cast<UInt64>(istr.gcount()) != size)
+        {
+            LOG_ERROR(log, "Cannot read from istream, start={} size={} gcount={} retry={} errmsg={}", start, size, istr.gcount(), retry, strerror(errno));
+            continue;
+        }
+        ProfileEvents::increment(ProfileEvents::S3ReadBytes, size);
+        GET_METRIC(tiflash_storage_s3_request_seconds, type_get_object).Observe(sw.elapsedSeconds());
+        return true;
+    }
+    return false;
+}
+} // namespace
+
+S3ReadOptions S3ReadOptions::fromConfig(const StorageS3Config & config)
+{
+    return S3ReadOptions{
+        .coalesce_gap_bytes = config.read_coalesce_gap_bytes,
+        .read_ahead_max_bytes = config.read_ahead_max_bytes,
+        .read_ahead_concurrency = std::max<UInt64>(1, config.read_ahead_concurrency),
+    };
+}
+
 S3RandomAccessFile::S3RandomAccessFile(
     std::shared_ptr<TiFlashS3Client> client_ptr_,
     const String & remote_fname_,
-    std::optional<std::pair<UInt64, UInt64>> offset_and_size_in_object_)
+    std::optional<std::pair<UInt64, UInt64>> offset_and_size_in_object_,
+    const S3ReadOptions & read_options_,
+    std::optional<UInt64> file_size_)
     : client_ptr(std::move(client_ptr_))
     , remote_fname(remote_fname_)
     , offset_and_size_in_object(offset_and_size_in_object_)
     , cur_offset(0)
+    , read_options(read_options_)
     , log(Logger::get(remote_fname))
 {
-    RUNTIME_CHECK(initialize(), remote_fname);
+    if (!isReadAhead())
+    {
+        RUNTIME_CHECK(initialize(), remote_fname);
+        return;
+    }
+
+    // The ranges are read on demand, only the size of the file is required here.
+    if (offset_and_size_in_object)
+    {
+        content_length = offset_and_size_in_object->second;
+    }
+    else if (file_size_)
+    {
+        content_length = *file_size_;
+    }
+    else
+    {
+        auto outcome = headObject(*client_ptr, remote_fname);
+        RUNTIME_CHECK_MSG(outcome.IsSuccess(), "S3 HeadObject failed: {}, remote_fname={}", S3::S3ErrorMessage(outcome.GetError()), remote_fname);
+        content_length = outcome.GetResult().GetContentLength();
+    }
 }
 
 std::string S3RandomAccessFile::getFileName() const
@@ -63,6 +143,10 @@ bool isRetryableError(int e)
 
 ssize_t S3RandomAccessFile::read(char * buf, size_t size)
 {
+    if (isReadAhead())
+    {
+        return readWithReadAhead(buf, size);
+    }
     while (true)
     {
         auto n = readImpl(buf, size);
@@ -80,6 +164,11 @@ ssize_t S3RandomAccessFile::read(char * buf, size_t size)
 
 ssize_t S3RandomAccessFile::readImpl(char * buf, size_t size)
 {
+    // The GET stream is not reopened after seeking to the end of file, see `seekImpl`.
+    if (cur_offset == content_length)
+    {
+        return 0;
+    }
     Stopwatch sw;
     auto & istr = read_result.GetBody();
     istr.read(buf, size);
@@ -119,6 +208,19 @@ ssize_t S3RandomAccessFile::readImpl(char * buf, size_t size)
 
 off_t S3RandomAccessFile::seek(off_t offset_, int whence)
 {
+    if (isReadAhead())
+    {
+        RUNTIME_CHECK_MSG(whence == SEEK_SET, "Only SEEK_SET mode is allowed, but {} is received", whence);
+        RUNTIME_CHECK_MSG(
+            offset_ >= 0 && offset_ <= content_length,
+            "Seek position is out of bounds: offset={}, cur_offset={}, content_length={}",
+            offset_,
+            cur_offset,
+            content_length);
+        // The ranges read ahead are reused if they contain the new offset, see `readWithReadAhead`.
+        cur_offset = offset_;
+        return cur_offset;
+    }
     while (true)
     {
         auto off = seekImpl(offset_, whence);
@@ -138,7 +240,7 @@ off_t S3RandomAccessFile::seekImpl(off_t offset_, int whence)
 {
     RUNTIME_CHECK_MSG(whence == SEEK_SET, "Only SEEK_SET mode is allowed, but {} is received", whence);
     RUNTIME_CHECK_MSG(
-        offset_ >= cur_offset && offset_ <= content_length,
+        offset_ >= 0 && offset_ <= content_length,
         "Seek position is out of bounds: offset={}, cur_offset={}, content_length={}",
         offset_,
         cur_offset,
@@ -148,6 +250,19 @@ off_t S3RandomAccessFile::seekImpl(off_t offset_, int whence)
     {
         return cur_offset;
     }
+    if (offset_ < cur_offset || static_cast<UInt64>(offset_ - cur_offset) > read_options.coalesce_gap_bytes)
+    {
+        // Seeking backward, or the gap is too large to be read through. Send a new ranged GET from the new offset.
+        LOG_TRACE(log, "Reopen the GET stream, offset={} cur_offset={} content_length={}", offset_, cur_offset, content_length);
+        cur_offset = offset_;
+        if (cur_offset == content_length)
+        {
+            return cur_offset;
+        }
+        cur_retry = 0;
+        RUNTIME_CHECK_MSG(initialize(), "Reopen the GET stream failed, remote_fname={} offset={}", remote_fname, cur_offset);
+        return cur_offset;
+    }
     Stopwatch sw;
     auto & istr = read_result.GetBody();
     if (!istr.ignore(offset_ - cur_offset))
@@ -172,6 +287,106 @@ off_t S3RandomAccessFile::seekImpl(off_t offset_, int whence)
     return cur_offset;
 }
 
+ssize_t S3RandomAccessFile::pread(char * buf, size_t size, off_t offset) const
+{
+    RUNTIME_CHECK_MSG(
+        offset >= 0 && offset <= content_length,
+        "pread position is out of bounds: offset={}, content_length={}",
+        offset,
+        content_length);
+    size = std::min(size, static_cast<size_t>(content_length - offset));
+    if (size == 0)
+    {
+        return 0;
+    }
+    auto start = offset + (offset_and_size_in_object ? offset_and_size_in_object->first : 0);
+    if (!readObjectRange(*client_ptr, remote_fname, start, size, buf, log))
+    {
+        return -1;
+    }
+    return size;
+}
+
+ssize_t S3RandomAccessFile::readWithReadAhead(char * buf, size_t size)
+{
+    size = std::min(size, static_cast<size_t>(content_length - cur_offset));
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    // The ranges before the current offset are skipped by `seek`. It is cheaper than reopening a GET stream
+    // when the skipped bytes are already read ahead, so that the nearby reads are coalesced.
+    const auto offset = static_cast<UInt64>(cur_offset);
+    while (!read_ahead_ranges.empty() && read_ahead_ranges.front().offset + read_ahead_ranges.front().data->size() <= offset)
+    {
+        read_ahead_ranges.pop_front();
+    }
+    if (read_ahead_ranges.empty() || read_ahead_ranges.front().offset > offset)
+    {
+        // Reading randomly, restart from the current offset with a small window.
+        read_ahead_ranges.clear();
+        read_ahead_end = offset;
+        read_ahead_window = std::min(std::max(size, min_read_ahead_bytes), read_options.read_ahead_max_bytes);
+    }
+
+    size_t read_bytes = 0;
+    while (read_bytes < size)
+    {
+        scheduleReadAhead();
+        auto & range = read_ahead_ranges.front();
+        if (!range.done)
+        {
+            try
+            {
+                // Rethrow the exception of reading the range if any.
+                range.result.get();
+            }
+            catch (...)
+            {
+                // The future of the range is consumed. Drop all the ranges and rewind to the offset of this
+                // read, so that a retry on this file starts a fresh ranged read.
+                read_ahead_ranges.clear();
+                cur_offset = static_cast<off_t>(offset);
+                throw;
+            }
+            range.done = true;
+        }
+        auto pos = cur_offset - range.offset;
+        auto n = std::min(size - read_bytes, range.data->size() - pos);
+        std::memcpy(buf + read_bytes, range.data->data() + pos, n);
+        read_bytes += n;
+        cur_offset += n;
+        if (pos + n == range.data->size())
+        {
+            read_ahead_ranges.pop_front();
+        }
+    }
+    return read_bytes;
+}
+
+void S3RandomAccessFile::scheduleReadAhead()
+{
+    while (read_ahead_ranges.size() < read_options.read_ahead_concurrency && read_ahead_end < static_cast<UInt64>(content_length))
+    {
+        auto data = std::make_shared<String>();
+        data->resize(std::min(read_ahead_window, content_length - read_ahead_end));
+        auto start = read_ahead_end + (offset_and_size_in_object ? offset_and_size_in_object->first : 0);
+        auto task = std::make_shared<std::packaged_task<void()>>([client = client_ptr, key = remote_fname, start, data, log = log]() {
+            if (!readObjectRange(*client, key, start, data->size(), data->data(), log))
+                throw Exception(fmt::format("Read range of S3 object failed, key={} start={} size={}", key, start, data->size()), ErrorCodes::S3_ERROR);
+        });
+        read_ahead_ranges.push_back(ReadAheadRange{.offset = read_ahead_end, .data = data, .result = task->get_future()});
+        // If the pool is busy, read it in the current thread because it will be waited soon.
+        if (!S3ReadAheadPool::get().trySchedule([task]() { (*task)(); }))
+        {
+            (*task)();
+        }
+        read_ahead_end += data->size();
+        read_ahead_window = std::min(read_ahead_window * 2, read_options.read_ahead_max_bytes);
+    }
+}
+
 String S3RandomAccessFile::readRangeOfObject()
 {
     if (offset_and_size_in_object)
@@ -243,7 +458,12 @@ inline static RandomAccessFilePtr createFromNormalFile(const String & remote_fna
         return file;
     }
     auto & ins = S3::ClientFactory::instance();
-    return std::make_shared<S3RandomAccessFile>(ins.sharedTiFlashClient(), remote_fname);
+    return std::make_shared<S3RandomAccessFile>(
+        ins.sharedTiFlashClient(),
+        remote_fname,
+        std::nullopt,
+        S3ReadOptions::fromConfig(ins.getConfigCopy()),
+        filesize);
 }
 
 inline static String readMergedSubFilesFromS3(const S3RandomAccessFile::ReadFileInfo & read_file_info_)
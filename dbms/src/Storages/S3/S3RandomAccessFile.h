@@ -21,46 +21,60 @@
 #include <aws/s3/model/GetObjectResult.h>
 #include <common/types.h>
 
+#include <deque>
 #include <ext/scope_guard.h>
+#include <future>
 
 /// Remove the population of thread_local from Poco
 #ifdef thread_local
 #undef thread_local
 #endif
 
-namespace DB::S3
+namespace DB
 {
-class TiFlashS3Client;
+struct StorageS3Config;
 }
 
-namespace DB::ErrorCodes
+namespace DB::S3
 {
-extern const int NOT_IMPLEMENTED;
-}
+class TiFlashS3Client;
 
-namespace DB::S3
+struct S3ReadOptions
 {
+    // When seeking forward no more than this gap, skip the bytes in the current GET stream,
+    // so that the nearby packs are read by one ranged GET. Otherwise, send a new ranged GET.
+    UInt64 coalesce_gap_bytes = 1024 * 1024;
+    // If it is not 0, read the file by parallel ranged GETs, and the size of the ranges grows
+    // up to this value while the file is read sequentially.
+    UInt64 read_ahead_max_bytes = 0;
+    // The max number of ranges in flight when reading ahead.
+    UInt64 read_ahead_concurrency = 4;
+
+    static S3ReadOptions fromConfig(const StorageS3Config & config);
+};
+
 class S3RandomAccessFile final : public RandomAccessFile
 {
 public:
     static RandomAccessFilePtr create(const String & remote_fname);
 
+    // `file_size_` is the size of the whole object if known, so that reading ahead does not send a HeadObject
+    // request to get it. It is ignored if `offset_and_size_` is set.
     S3RandomAccessFile(
         std::shared_ptr<TiFlashS3Client> client_ptr_,
         const String & remote_fname_,
-        std::optional<std::pair<UInt64, UInt64>> offset_and_size_ = std::nullopt);
+        std::optional<std::pair<UInt64, UInt64>> offset_and_size_ = std::nullopt,
+        const S3ReadOptions & read_options_ = {},
+        std::optional<UInt64> file_size_ = std::nullopt);
 
-    // Can only seek forward.
     off_t seek(off_t offset, int whence) override;
 
     ssize_t read(char * buf, size_t size) override;
 
     std::string getFileName() const override;
 
-    ssize_t pread(char * /*buf*/, size_t /*size*/, off_t /*offset*/) const override
-    {
-        throw Exception("S3RandomAccessFile not support pread", ErrorCodes::NOT_IMPLEMENTED);
-    }
+    // Read by a ranged GET, it does not change the offset of `read` and `seek`.
+    ssize_t pread(char * buf, size_t size, off_t offset) const override;
 
     int getFd() const override
     {
@@ -99,6 +113,10 @@ private:
     ssize_t readImpl(char * buf, size_t size);
     String readRangeOfObject();
 
+    bool isReadAhead() const { return read_options.read_ahead_max_bytes > 0; }
+    ssize_t readWithReadAhead(char * buf, size_t size);
+    void scheduleReadAhead();
+
     // When reading, it is necessary to pass the extra information of file, such file size, the merged file information to S3RandomAccessFile::create.
     // It is troublesome to pass parameters layer by layer. So currently, use thread_local global variable to pass parameters.
     // TODO: refine these codes later.
@@ -114,6 +132,22 @@ private:
     Aws::S3::Model::GetObjectResult read_result;
     Int64 content_length = 0;
 
+    const S3ReadOptions read_options;
+
+    // The ranges read ahead by the IO thread pool, ordered by offset and continuous.
+    struct ReadAheadRange
+    {
+        UInt64 offset = 0; // The offset in the current file.
+        std::shared_ptr<String> data;
+        std::future<void> result;
+        bool done = false;
+    };
+    std::deque<ReadAheadRange> read_ahead_ranges;
+    // The end offset of `read_ahead_ranges`.
+    UInt64 read_ahead_end = 0;
+    // The size of the next range, it is doubled after each range is scheduled, and reset when reading randomly.
+    UInt64 read_ahead_window = 0;
+
     DB::LoggerPtr log;
     bool is_close = false;
 
@@ -12,18 +12,24 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/FailPoint.h>
 #include <Common/ProfileEvents.h>
 #include <Common/Stopwatch.h>
 #include <Common/TiFlashMetrics.h>
+#include <IO/IOThreadPools.h>
+#include <Server/StorageConfigParser.h>
 #include <Storages/S3/S3Common.h>
 #include <Storages/S3/S3WritableFile.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
 #include <aws/s3/model/CompleteMultipartUploadRequest.h>
 #include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
 #include <aws/s3/model/UploadPartRequest.h>
 
 #include <ext/scope_guard.h>
+#include <fstream>
 #include <magic_enum.hpp>
+#include <streambuf>
 
 namespace ProfileEvents
 {
@@ -31,19 +37,165 @@ extern const Event S3WriteBytes;
 extern const Event S3CreateMultipartUpload;
 extern const Event S3UploadPart;
 extern const Event S3CompleteMultipartUpload;
+extern const Event S3AbortMultipartUpload;
 extern const Event S3PutObject;
 } // namespace ProfileEvents
 
 namespace DB::ErrorCodes
 {
 extern const int CORRUPTED_DATA;
-}
+extern const int FAIL_POINT_ERROR;
+} // namespace DB::ErrorCodes
+
+namespace DB::FailPoints
+{
+extern const char exception_when_upload_s3_part[];
+} // namespace DB::FailPoints
 
 namespace DB::S3
 {
+namespace
+{
+/// The bytes of the part buffers being uploaded by all the S3WritableFile in the process, so that the memory
+/// is bounded by `max_inflight_bytes` no matter how many files are written concurrently.
+class InflightBytesBudget
+{
+public:
+    static InflightBytesBudget & instance()
+    {
+        static InflightBytesBudget budget;
+        return budget;
+    }
+
+    // One part is always allowed if there is nothing being uploaded, even if it is larger than `limit`.
+    void acquire(size_t bytes, size_t limit)
+    {
+        std::unique_lock lock(mtx);
+        cv.wait(lock, [&] { return inflight_bytes == 0 || inflight_bytes + bytes <= limit; });
+        inflight_bytes += bytes;
+    }
+
+    void release(size_t bytes)
+    {
+        std::lock_guard lock(mtx);
+        inflight_bytes -= bytes;
+        cv.notify_all();
+    }
+
+private:
+    std::mutex mtx;
+    std::condition_variable cv;
+    size_t inflight_bytes = 0;
+};
+
+/// A read-only stream of `[offset, offset + size)` of a local file. It is used as the body of a part, so
+/// the part is read from the file when it is sent instead of being copied into memory in advance.
+/// It supports seeking in the range, because the request may be signed or retried by reading the body again.
+class FileRangeStreamBuf : public std::streambuf
+{
+public:
+    FileRangeStreamBuf(const String & fname, UInt64 offset_, UInt64 size_)
+        : file(fname, std::ios_base::in | std::ios_base::binary)
+        , offset(offset_)
+        , size(size_)
+        , buffer(std::min(size_, buffer_size))
+    {
+        RUNTIME_CHECK_MSG(file.is_open(), "Open {} fail: {}", fname, strerror(errno));
+        setg(buffer.data(), buffer.data(), buffer.data());
+    }
+
+protected:
+    int_type underflow() override
+    {
+        if (gptr() < egptr())
+            return traits_type::to_int_type(*gptr());
+        const UInt64 pos = buffer_pos + (egptr() - eback());
+        if (pos >= size)
+            return traits_type::eof();
+        const auto n = std::min(size - pos, static_cast<UInt64>(buffer.size()));
+        file.seekg(offset + pos);
+        file.read(buffer.data(), n);
+        RUNTIME_CHECK_MSG(static_cast<UInt64>(file.gcount()) == n, "Read fail, offset={} size={} gcount={}", offset + pos, n, file.gcount());
+        buffer_pos = pos;
+        setg(buffer.data(), buffer.data(), buffer.data() + n);
+        return traits_type::to_int_type(*gptr());
+    }
+
+    std::streamsize showmanyc() override
+    {
+        return size - (buffer_pos + (gptr() - eback()));
+    }
+
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+    {
+        if (!(which & std::ios_base::in))
+            return pos_type(off_type(-1));
+        const Int64 cur = buffer_pos + (gptr() - eback());
+        Int64 target = off;
+        if (dir == std::ios_base::cur)
+            target += cur;
+        else if (dir == std::ios_base::end)
+            target += size;
+        if (target < 0 || static_cast<UInt64>(target) > size)
+            return pos_type(off_type(-1));
+        if (static_cast<UInt64>(target) >= buffer_pos && static_cast<UInt64>(target) <= buffer_pos + (egptr() - eback()))
+        {
+            setg(eback(), eback() + (target - buffer_pos), egptr());
+        }
+        else
+        {
+            // Read from `target` by the next `underflow`.
+            buffer_pos = target;
+            setg(buffer.data(), buffer.data(), buffer.data());
+        }
+        return pos_type(target);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+    {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+
+private:
+    static constexpr UInt64 buffer_size = 1024 * 1024;
+
+    std::ifstream file;
+    const UInt64 offset;
+    const UInt64 size;
+    std::vector<char> buffer;
+    // The position of `eback()` in the range.
+    UInt64 buffer_pos = 0;
+};
+
+class FileRangeStream : public Aws::IOStream
+{
+public:
+    FileRangeStream(const String & fname, UInt64 offset, UInt64 size)
+        : Aws::IOStream(nullptr)
+        , buf(fname, offset, size)
+    {
+        rdbuf(&buf);
+    }
+
+private:
+    FileRangeStreamBuf buf;
+};
+} // namespace
+
+WriteSettings WriteSettings::fromConfig(const StorageS3Config & config)
+{
+    WriteSettings settings;
+    settings.upload_part_size = config.upload_part_size;
+    settings.max_upload_part_size = std::max(settings.max_upload_part_size, config.upload_part_size);
+    settings.max_inflight_parts = config.upload_concurrency;
+    settings.max_inflight_bytes = config.upload_max_inflight_bytes;
+    return settings;
+}
+
 struct S3WritableFile::UploadPartTask
 {
     Aws::S3::Model::UploadPartRequest req;
+    size_t buffer_bytes = 0;
     bool is_finished = false;
     std::string tag;
     std::exception_ptr exception;
@@ -63,15 +215,32 @@ S3WritableFile::S3WritableFile(
     : remote_fname(remote_fname_)
     , client_ptr(std::move(client_ptr_))
     , write_settings(write_settings_)
+    , current_part_size(write_settings.upload_part_size)
     , log(Logger::get("S3WritableFile"))
 {
     allocateBuffer();
 }
 
-S3WritableFile::~S3WritableFile() = default;
+S3WritableFile::~S3WritableFile()
+{
+    // The parts being uploaded in background reference this object.
+    waitInflightParts();
+    try
+    {
+        // The uploaded parts are charged until the multipart upload is completed or aborted,
+        // so abort it if the file is not written successfully.
+        abortMultipartUpload();
+    }
+    catch (...)
+    {
+        tryLogCurrentException(log, fmt::format("Abort multipart upload failed, key={}", remote_fname));
+    }
+}
 
 ssize_t S3WritableFile::write(char * buf, size_t size)
 {
+    // Stop writing as soon as any part fails, the data written after that is useless.
+    rethrowIfUploadFailed();
     temporary_buffer->write(buf, size);
     if (!temporary_buffer->good())
     {
@@ -88,7 +257,7 @@ ssize_t S3WritableFile::write(char * buf, size_t size)
         createMultipartUpload();
     }
 
-    if (!multipart_upload_id.empty() && last_part_size > write_settings.upload_part_size)
+    if (!multipart_upload_id.empty() && last_part_size > current_part_size)
     {
         writePart();
         allocateBuffer();
@@ -107,13 +276,23 @@ int S3WritableFile::fsync()
     if (multipart_upload_id.empty())
     {
         makeSinglepartUpload();
+        finalize();
+        return 0;
     }
-    else
+
+    try
     {
         // Write rest of the data as last part.
         writePart();
+        waitInflightParts();
+        rethrowIfUploadFailed();
+        finalize();
+    }
+    catch (...)
+    {
+        abortMultipartUpload();
+        throw;
     }
-    finalize();
     return 0;
 }
 
@@ -158,14 +337,116 @@ void S3WritableFile::writePart()
         LOG_DEBUG(log, "Skipping writing part. Buffer is empty.");
         return;
     }
+    uploadPart(temporary_buffer, size, size);
+}
+
+void S3WritableFile::writeLocalFile(const String & local_fname, UInt64 file_size)
+{
+    RUNTIME_CHECK(total_write_bytes == 0 && multipart_upload_id.empty(), remote_fname, total_write_bytes);
+    createMultipartUpload();
+    for (UInt64 offset = 0; offset < file_size;)
+    {
+        rethrowIfUploadFailed();
+        const auto size = std::min(static_cast<UInt64>(current_part_size), file_size - offset);
+        // The part only holds a small read buffer, it is not limited by `max_inflight_bytes`.
+        uploadPart(std::make_shared<FileRangeStream>(local_fname, offset, size), size, /*buffer_bytes*/ 0);
+        offset += size;
+        total_write_bytes += size;
+    }
+}
+
+void S3WritableFile::uploadPart(const std::shared_ptr<Aws::IOStream> & body, size_t size, size_t buffer_bytes)
+{
+    auto task = std::make_shared<UploadPartTask>();
+    fillUploadRequest(task->req, body, size);
+    task->buffer_bytes = buffer_bytes;
+    if (write_settings.max_inflight_parts == 0)
+    {
+        processUploadRequest(*task);
+        part_tags.push_back(task->tag);
+    }
+    else
+    {
+        size_t part_index = 0;
+        {
+            std::unique_lock lock(bg_mtx);
+            bg_cv.wait(lock, [&] {
+                return bg_exception != nullptr || inflight_parts < write_settings.max_inflight_parts;
+            });
+            if (bg_exception)
+                std::rethrow_exception(bg_exception);
+            ++inflight_parts;
+            part_index = part_tags.size();
+            part_tags.emplace_back();
+        }
+        // Limit the memory of the buffers being uploaded by all the files. It is released by `uploadPartInBackground`.
+        if (task->buffer_bytes > 0)
+            InflightBytesBudget::instance().acquire(task->buffer_bytes, write_settings.max_inflight_bytes);
+        // If the pool is busy, upload it in the current thread.
+        if (!S3UploadPool::get().trySchedule([this, task, part_index]() { uploadPartInBackground(*task, part_index); }))
+        {
+            uploadPartInBackground(*task, part_index);
+        }
+    }
+
+    // S3 limits the number of parts to 10000, so increase the part size for the large objects.
+    if (write_settings.upload_part_size_multiply_parts_count_threshold > 0
+        && part_number % write_settings.upload_part_size_multiply_parts_count_threshold == 0)
+    {
+        current_part_size = std::min(current_part_size * write_settings.upload_part_size_multiply_factor, write_settings.max_upload_part_size);
+        current_part_size = std::max(current_part_size, write_settings.upload_part_size);
+    }
+}
+
+void S3WritableFile::uploadPartInBackground(UploadPartTask & task, size_t part_index)
+{
+    try
+    {
+        // Skip the remaining parts if any part has failed, the multipart upload will be aborted.
+        if (!bg_failed.load(std::memory_order_acquire))
+        {
+            processUploadRequest(task);
+            task.is_finished = true;
+        }
+    }
+    catch (...)
+    {
+        task.exception = std::current_exception();
+        LOG_WARNING(log, "Upload part failed, bucket={} root={} key={} upload_id={} part_number={} error={}", client_ptr->bucket(), client_ptr->root(), remote_fname, multipart_upload_id, task.req.GetPartNumber(), getCurrentExceptionMessage(false));
+    }
+
+    // Release the memory of the body before the other writers are woken up.
+    task.req.SetBody(nullptr);
+    if (task.buffer_bytes > 0)
+        InflightBytesBudget::instance().release(task.buffer_bytes);
+
+    std::lock_guard lock(bg_mtx);
+    if (task.exception && !bg_exception)
+    {
+        bg_exception = task.exception;
+        bg_failed.store(true, std::memory_order_release);
+    }
+    part_tags[part_index] = task.tag;
+    --inflight_parts;
+    // Notify under the lock, because the waiter may destroy this object right after it is woken up.
+    bg_cv.notify_all();
+}
 
-    UploadPartTask task;
-    fillUploadRequest(task.req);
-    processUploadRequest(task);
-    part_tags.push_back(task.tag);
+void S3WritableFile::waitInflightParts()
+{
+    std::unique_lock lock(bg_mtx);
+    bg_cv.wait(lock, [this] { return inflight_parts == 0; });
+}
+
+void S3WritableFile::rethrowIfUploadFailed()
+{
+    if (!bg_failed.load(std::memory_order_acquire))
+        return;
+    std::lock_guard lock(bg_mtx);
+    std::rethrow_exception(bg_exception);
 }
 
-void S3WritableFile::fillUploadRequest(Aws::S3::Model::UploadPartRequest & req)
+void S3WritableFile::fillUploadRequest(Aws::S3::Model::UploadPartRequest & req, const std::shared_ptr<Aws::IOStream> & body, size_t size)
 {
     // Increase part number.
     ++part_number;
@@ -173,8 +454,8 @@ void S3WritableFile::fillUploadRequest(Aws::S3::Model::UploadPartRequest & req)
     client_ptr->setBucketAndKeyWithRoot(req, remote_fname);
     req.SetPartNumber(static_cast<int>(part_number));
     req.SetUploadId(multipart_upload_id);
-    req.SetContentLength(temporary_buffer->tellp());
-    req.SetBody(temporary_buffer);
+    req.SetContentLength(size);
+    req.SetBody(body);
     req.SetContentType("binary/octet-stream");
 }
 
@@ -184,6 +465,7 @@ void S3WritableFile::processUploadRequest(UploadPartTask & task)
     SCOPE_EXIT({
         GET_METRIC(tiflash_storage_s3_request_seconds, type_upload_part).Observe(sw.elapsedSeconds());
     });
+    FAIL_POINT_TRIGGER_EXCEPTION(FailPoints::exception_when_upload_s3_part);
     ProfileEvents::increment(ProfileEvents::S3UploadPart);
     auto outcome = client_ptr->UploadPart(task.req);
     checkS3Outcome(outcome);
@@ -216,6 +498,7 @@ void S3WritableFile::completeMultipartUpload()
         auto outcome = client_ptr->CompleteMultipartUpload(req);
         if (outcome.IsSuccess())
         {
+            multipart_upload_finished = true;
             LOG_DEBUG(log, "Multipart upload has completed. bucket={} root={} key={} upload_id={} parts={}", client_ptr->bucket(), client_ptr->root(), remote_fname, multipart_upload_id, part_tags.size());
             break;
         }
@@ -248,6 +531,40 @@ void S3WritableFile::completeMultipartUpload()
     }
 }
 
+void S3WritableFile::abortMultipartUpload()
+{
+    if (multipart_upload_id.empty() || multipart_upload_finished)
+        return;
+    // The parts uploaded concurrently with the abort may be left, so wait for them first.
+    waitInflightParts();
+    multipart_upload_finished = true;
+
+    Aws::S3::Model::AbortMultipartUploadRequest req;
+    client_ptr->setBucketAndKeyWithRoot(req, remote_fname);
+    req.SetUploadId(multipart_upload_id);
+    ProfileEvents::increment(ProfileEvents::S3AbortMultipartUpload);
+    auto outcome = client_ptr->AbortMultipartUpload(req);
+    if (outcome.IsSuccess())
+    {
+        LOG_INFO(log, "Multipart upload has aborted. bucket={} root={} key={} upload_id={}", client_ptr->bucket(), client_ptr->root(), remote_fname, multipart_upload_id);
+    }
+    else
+    {
+        // The uploaded parts are left in the bucket, this is not fatal for the writer, so just log the error.
+        const auto & e = outcome.GetError();
+        LOG_WARNING(
+            log,
+            "Abort multipart upload failed: bucket={} root={} key={} upload_id={} error={} message={} request_id={}",
+            client_ptr->bucket(),
+            client_ptr->root(),
+            remote_fname,
+            multipart_upload_id,
+            magic_enum::enum_name(e.GetErrorType()),
+            e.GetMessage(),
+            e.GetRequestId());
+    }
+}
+
 void S3WritableFile::makeSinglepartUpload()
 {
     auto size = temporary_buffer->tellp();
@@ -309,6 +626,6 @@ std::shared_ptr<S3WritableFile> S3WritableFile::create(const String & remote_fna
     return std::make_shared<S3WritableFile>(
         S3::ClientFactory::instance().sharedTiFlashClient(),
         remote_fname_,
-        WriteSettings{});
+        WriteSettings::fromConfig(S3::ClientFactory::instance().getConfigCopy()));
 }
 } // namespace DB::S3
@@ -19,6 +19,10 @@
 #include <Storages/S3/S3Common.h>
 #include <common/types.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
 namespace Aws::S3
 {
 class S3Client;
@@ -30,21 +34,42 @@ class UploadPartRequest;
 class PutObjectRequest;
 } // namespace Aws::S3::Model
 
-namespace DB::ErrorCodes
+namespace DB
+{
+struct StorageS3Config;
+namespace ErrorCodes
 {
 extern const int NOT_IMPLEMENTED;
 }
+} // namespace DB
 
 namespace DB::S3
 {
 struct WriteSettings
 {
     size_t upload_part_size = 16 * 1024 * 1024;
+    // The part size is multiplied by `upload_part_size_multiply_factor` after every
+    // `upload_part_size_multiply_parts_count_threshold` parts, up to `max_upload_part_size`.
+    // So the small objects are uploaded by small parts, and the large objects do not exceed the limit of 10000 parts.
+    size_t upload_part_size_multiply_factor = 2;
+    size_t upload_part_size_multiply_parts_count_threshold = 500;
+    size_t max_upload_part_size = 256 * 1024 * 1024;
     size_t max_single_part_upload_size = 32 * 1024 * 1024;
+    // The max number of parts uploaded concurrently by S3UploadPool. If it is 0, the parts are
+    // uploaded synchronously by the writing thread.
+    size_t max_inflight_parts = 4;
+    // The writing thread is blocked if the buffers of the parts being uploaded by all the S3WritableFile
+    // in the process exceed this size. One part is always allowed if there is nothing being uploaded.
+    size_t max_inflight_bytes = 128 * 1024 * 1024;
     bool check_objects_after_upload = false;
     size_t max_unexpected_write_error_retries = 4;
+
+    static WriteSettings fromConfig(const StorageS3Config & config);
 };
 
+/// Write an S3 object. If the object is larger than `max_single_part_upload_size`, it is uploaded by a
+/// multipart upload, and the parts are uploaded in background while the following data is being written.
+/// If any part fails, the following `write` and `fsync` throw the error, and the multipart upload is aborted.
 class S3WritableFile final : public WritableFile
 {
 public:
@@ -62,6 +87,11 @@ public:
     // To ensure that the data is uploaded to S3, the caller must call fsync after all write is finished.
     int fsync() override;
 
+    // Upload the local file of `file_size` bytes by a multipart upload. Every part is read from the file by
+    // its request directly instead of being copied into the buffer. It must be called before any `write`,
+    // and `fsync` must be called after it. The written bytes are not recorded by ProfileEvents.
+    void writeLocalFile(const String & local_fname, UInt64 file_size);
+
     std::string getFileName() const override
     {
         return fmt::format("{}/{}", client_ptr->bucket(), remote_fname);
@@ -126,14 +156,22 @@ private:
     void createMultipartUpload();
     void writePart();
     void completeMultipartUpload();
+    void abortMultipartUpload();
 
     void makeSinglepartUpload();
 
     void finalize();
 
     struct UploadPartTask;
-    void fillUploadRequest(Aws::S3::Model::UploadPartRequest & req);
+    // Upload a part of `size` bytes read from `body`. `buffer_bytes` is the memory held by `body` until the
+    // part is uploaded, it is limited by `max_inflight_bytes`.
+    void uploadPart(const std::shared_ptr<Aws::IOStream> & body, size_t size, size_t buffer_bytes);
+    void fillUploadRequest(Aws::S3::Model::UploadPartRequest & req, const std::shared_ptr<Aws::IOStream> & body, size_t size);
     void processUploadRequest(UploadPartTask & task);
+    void uploadPartInBackground(UploadPartTask & task, size_t part_index);
+    void waitInflightParts();
+    // Rethrow the error of the parts uploaded in background if any of them failed.
+    void rethrowIfUploadFailed();
 
     struct PutObjectTask;
     void fillPutRequest(Aws::S3::Model::PutObjectRequest & req);
@@ -156,11 +194,23 @@ private:
     size_t last_part_size = 0;
     size_t part_number = 0;
     UInt64 total_write_bytes = 0;
+    // The size of the next part, it grows with the number of parts.
+    size_t current_part_size;
 
     // Upload in S3 is made in parts.
     String multipart_upload_id;
+    // Whether the multipart upload is completed or aborted.
+    bool multipart_upload_finished = false;
+    // The tags of the parts being uploaded in background are filled after they are finished, protected by `bg_mtx`.
     std::vector<String> part_tags;
 
+    // The states of the parts being uploaded in background.
+    std::mutex bg_mtx;
+    std::condition_variable bg_cv;
+    size_t inflight_parts = 0;
+    std::exception_ptr bg_exception;
+    std::atomic<bool> bg_failed = false;
+
     LoggerPtr log;
 
     bool is_close = false;
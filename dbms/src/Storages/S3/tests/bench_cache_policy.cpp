@@ -0,0 +1,173 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/CachePolicy.h>
+#include <Storages/DeltaMerge/Remote/RNLocalPageCache.h>
+#include <Storages/S3/FileCache.h>
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <random>
+
+/// Replay an access trace through the policies of FileCache and RNLocalPageCache, and report the hit ratios.
+///
+/// The trace is read from the file specified by the environment variable `TIFLASH_CACHE_TRACE`, every line
+/// is an access as "<key> <size>". If it is not specified, a synthetic trace is used: a hot working set
+/// accessed repeatedly, interleaved with large scans over the cold keys that are accessed only once.
+/// The capacity of the caches is the argument of the benchmarks, in the same unit as the sizes in the trace.
+namespace DB::tests
+{
+namespace
+{
+struct Access
+{
+    String key;
+    UInt64 size;
+};
+
+std::vector<Access> loadTrace()
+{
+    std::vector<Access> trace;
+    if (const char * path = std::getenv("TIFLASH_CACHE_TRACE"); path != nullptr)
+    {
+        std::ifstream ifs(path);
+        RUNTIME_CHECK_MSG(ifs.is_open(), "Open trace {} failed", path);
+        String key;
+        UInt64 size = 0;
+        while (ifs >> key >> size)
+            trace.push_back(Access{.key = key, .size = size});
+        return trace;
+    }
+
+    constexpr size_t hot_keys = 1000;
+    constexpr size_t rounds = 20;
+    constexpr size_t hot_accesses_per_round = 20000;
+    constexpr size_t scan_keys_per_round = 10000;
+    std::mt19937_64 rng(0);
+    // Skewed accesses over the hot keys.
+    std::geometric_distribution<size_t> hot_dist(0.005);
+    size_t cold_key = 0;
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        for (size_t i = 0; i < hot_accesses_per_round; ++i)
+            trace.push_back(Access{.key = fmt::format("hot_{}", hot_dist(rng) % hot_keys), .size = 1});
+        for (size_t i = 0; i < scan_keys_per_round; ++i)
+            trace.push_back(Access{.key = fmt::format("cold_{}", cold_key++), .size = 1});
+    }
+    return trace;
+}
+
+const std::vector<Access> & getTrace()
+{
+    static const std::vector<Access> trace = loadTrace();
+    return trace;
+}
+
+void reportCounters(benchmark::State & state, size_t hits, size_t rejects)
+{
+    const auto accesses = static_cast<double>(getTrace().size());
+    state.counters["hit_ratio"] = static_cast<double>(hits) / accesses;
+    state.counters["admission_reject"] = static_cast<double>(rejects);
+    state.SetItemsProcessed(static_cast<Int64>(state.iterations() * getTrace().size()));
+}
+
+/// Replay like FileCache::get: a missed key is cached if it is admitted, then the files are evicted from the head.
+void replayFileCache(benchmark::State & state, CachePolicy policy)
+{
+    const auto capacity = static_cast<UInt64>(state.range(0));
+    size_t hits = 0;
+    size_t rejects = 0;
+    for (auto _ : state)
+    {
+        hits = 0;
+        rejects = 0;
+        LRUFileTable table;
+        table.setPolicy(policy);
+        UInt64 used = 0;
+        for (const auto & access : getTrace())
+        {
+            if (table.get(access.key) != nullptr)
+            {
+                ++hits;
+                continue;
+            }
+            if (used + access.size > capacity && !table.admit(access.key))
+            {
+                ++rejects;
+                continue;
+            }
+            table.set(access.key, std::make_shared<FileSegment>(access.key, FileSegment::Status::Complete, access.size, FileSegment::FileType::Meta));
+            used += access.size;
+            for (auto itr = table.begin(); used > capacity && itr != table.end();)
+            {
+                used -= table.get(*itr, /*update_lru*/ false)->getSize();
+                itr = table.remove(*itr);
+            }
+        }
+    }
+    reportCounters(state, hits, rejects);
+}
+
+/// Replay like RNLocalPageCache: a cached key is removed when it is read and put back after that.
+void replayPageCache(benchmark::State & state, CachePolicy policy)
+{
+    const auto capacity = static_cast<UInt64>(state.range(0));
+    size_t hits = 0;
+    size_t rejects = 0;
+    for (auto _ : state)
+    {
+        hits = 0;
+        rejects = 0;
+        DM::Remote::RNLocalPageCacheLRU lru(capacity, policy);
+        for (const auto & access : getTrace())
+        {
+            if (lru.remove(access.key))
+                ++hits;
+            lru.put(access.key, access.size);
+            // The keys that are not admitted are evicted right after they are put.
+            for (const auto & key : lru.evict())
+                rejects += key == access.key;
+        }
+    }
+    reportCounters(state, hits, rejects);
+}
+} // namespace
+
+static void FileCacheLRU(benchmark::State & state)
+{
+    replayFileCache(state, CachePolicy::LRU);
+}
+
+static void FileCacheTinyLFU(benchmark::State & state)
+{
+    replayFileCache(state, CachePolicy::TinyLFU);
+}
+
+static void PageCacheLRU(benchmark::State & state)
+{
+    replayPageCache(state, CachePolicy::LRU);
+}
+
+static void PageCacheTinyLFU(benchmark::State & state)
+{
+    replayPageCache(state, CachePolicy::TinyLFU);
+}
+
+BENCHMARK(FileCacheLRU)->Unit(benchmark::kMillisecond)->Arg(500)->Arg(2000)->Iterations(1);
+BENCHMARK(FileCacheTinyLFU)->Unit(benchmark::kMillisecond)->Arg(500)->Arg(2000)->Iterations(1);
+BENCHMARK(PageCacheLRU)->Unit(benchmark::kMillisecond)->Arg(500)->Arg(2000)->Iterations(1);
+BENCHMARK(PageCacheTinyLFU)->Unit(benchmark::kMillisecond)->Arg(500)->Arg(2000)->Iterations(1);
+
+} // namespace DB::tests
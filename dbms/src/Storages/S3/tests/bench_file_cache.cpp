@@ -0,0 +1,145 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <IO/IOThreadPools.h>
+#include <Interpreters/Context.h>
+#include <Server/StorageConfigParser.h>
+#include <Storages/S3/FileCache.h>
+#include <Storages/S3/S3Filename.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace DB::tests::S3
+{
+using FileType = ::DB::FileSegment::FileType;
+
+/// Read the cached files from many threads concurrently, to measure the contention of FileCache.
+class FileCacheBench : public benchmark::Fixture
+{
+public:
+    void SetUp(const benchmark::State &) override
+    {
+        // `FileCache::canCache` depends on the thread pool.
+        static std::once_flag init_pool;
+        std::call_once(init_pool, [] { S3FileCachePool::initialize(/*max_threads*/ 20, /*max_free_threds*/ 10, /*queue_size*/ 1000); });
+
+        cache_dir = TiFlashTestEnv::getTemporaryPath("FileCacheBench");
+        std::filesystem::remove_all(cache_dir);
+        StorageRemoteCacheConfig cache_config{.dir = cache_dir, .capacity = 100UL * 1024 * 1024 * 1024, .dtfile_level = 100};
+
+        // Create the files in the cache directory, and they are restored by FileCache.
+        for (UInt64 file_id = 1; file_id <= dmfile_count; ++file_id)
+        {
+            auto dmfile_key = ::DB::S3::S3Filename::fromDMFileOID(::DB::S3::DMFileOID{.store_id = 1, .table_id = 1, .file_id = file_id}).toFullKey();
+            for (const auto & name : {"1.dat", "1.mrk", "2.dat", "2.mrk", "meta"})
+            {
+                auto key = fmt::format("{}/{}", dmfile_key, name);
+                auto local_fname = fmt::format("{}/{}", cache_config.getDTFileCacheDir(), key);
+                FileCache::prepareParentDir(local_fname);
+                std::ofstream ofs(local_fname);
+                ofs << key;
+                keys.push_back(key);
+            }
+        }
+        file_cache = std::make_unique<FileCache>(TiFlashTestEnv::getContext()->getPathCapacity(), cache_config);
+    }
+
+    void TearDown(const benchmark::State &) override
+    {
+        file_cache.reset();
+        keys.clear();
+        std::filesystem::remove_all(cache_dir);
+    }
+
+protected:
+    void runConcurrently(size_t thread_count, size_t ops, const std::function<void(size_t)> & op)
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            threads.emplace_back([&, seed = i] {
+                std::mt19937_64 rng(seed);
+                for (size_t n = 0; n < ops; ++n)
+                    op(rng());
+            });
+        }
+        for (auto & t : threads)
+            t.join();
+    }
+
+    static constexpr UInt64 dmfile_count = 2000;
+    static constexpr size_t ops_per_thread = 10000;
+
+    String cache_dir;
+    std::vector<String> keys;
+    std::unique_ptr<FileCache> file_cache;
+};
+
+BENCHMARK_DEFINE_F(FileCacheBench, Get)
+(benchmark::State & state)
+try
+{
+    const auto thread_count = static_cast<size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        runConcurrently(thread_count, ops_per_thread, [&](size_t r) {
+            auto file_seg = file_cache->get(::DB::S3::S3FilenameView::fromKey(keys[r % keys.size()]));
+            benchmark::DoNotOptimize(file_seg);
+        });
+    }
+    state.SetItemsProcessed(static_cast<Int64>(state.iterations() * thread_count * ops_per_thread));
+}
+CATCH
+
+// Reserve and release the space concurrently, the contention is on the global space accounting.
+BENCHMARK_DEFINE_F(FileCacheBench, ReserveSpace)
+(benchmark::State & state)
+try
+{
+    const auto thread_count = static_cast<size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        runConcurrently(thread_count, ops_per_thread, [&](size_t r) {
+            const UInt64 size = r % 4096 + 1;
+            if (file_cache->reserveSpace(FileType::ColData, size, /*try_evict*/ false))
+                file_cache->releaseSpace(size);
+        });
+    }
+    state.SetItemsProcessed(static_cast<Int64>(state.iterations() * thread_count * ops_per_thread));
+}
+CATCH
+
+BENCHMARK_REGISTER_F(FileCacheBench, Get)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(32)
+    ->Arg(64);
+
+BENCHMARK_REGISTER_F(FileCacheBench, ReserveSpace)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(32)
+    ->Arg(64);
+
+} // namespace DB::tests::S3
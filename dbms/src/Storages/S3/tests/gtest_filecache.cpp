@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Common/Logger.h>
+#include <Common/ProfileEvents.h>
 #include <Common/Stopwatch.h>
 #include <IO/IOThreadPools.h>
 #include <Interpreters/Context.h>
@@ -45,6 +46,11 @@ using DMFileOID = ::DB::S3::DMFileOID;
 using S3Filename = ::DB::S3::S3Filename;
 using FileType = ::DB::FileSegment::FileType;
 
+namespace ProfileEvents
+{
+extern const Event S3GetObject;
+} // namespace ProfileEvents
+
 namespace DB::ErrorCodes
 {
 extern const int FILE_DOESNT_EXIST;
@@ -683,6 +689,66 @@ TEST_F(FileCacheTest, LRUFileTable)
     }
 }
 
+TEST_F(FileCacheTest, LRUFileTableTinyLFU)
+{
+    LRUFileTable table;
+    table.setPolicy(CachePolicy::TinyLFU);
+
+    auto check_seqs = [&](const std::vector<String> & seqs) {
+        auto seqs_itr = seqs.begin();
+        for (auto itr = table.begin(); itr != table.end(); ++itr, ++seqs_itr)
+        {
+            ASSERT_NE(seqs_itr, seqs.end());
+            ASSERT_EQ(*itr, *seqs_itr);
+        }
+        ASSERT_EQ(seqs_itr, seqs.end());
+    };
+
+    auto file_seg = std::make_shared<FileSegment>("filename", FileSegment::Status::Complete, 1, FileType::Meta);
+    // Files are cached after they are missed, like FileCache::get.
+    for (const auto & key : {"aaa", "bbb", "ccc", "ddd", "eee"})
+    {
+        ASSERT_EQ(table.get(key), nullptr);
+        table.set(key, file_seg);
+    }
+    check_seqs({"aaa", "bbb", "ccc", "ddd", "eee"});
+
+    // The files accessed again are moved to the protected segment, they are evicted after the probation segment.
+    ASSERT_NE(table.get("aaa"), nullptr);
+    ASSERT_NE(table.get("ccc"), nullptr);
+    check_seqs({"bbb", "ddd", "eee", "aaa", "ccc"});
+
+    // New files are put at the tail of the probation segment.
+    ASSERT_EQ(table.get("fff"), nullptr);
+    table.set("fff", file_seg);
+    check_seqs({"bbb", "ddd", "eee", "fff", "aaa", "ccc"});
+
+    // A file accessed once is not admitted to evict "bbb" which is accessed once too.
+    ASSERT_EQ(table.get("ggg"), nullptr);
+    ASSERT_FALSE(table.admit("ggg"));
+    ASSERT_EQ(table.get("ggg"), nullptr);
+    ASSERT_TRUE(table.admit("ggg"));
+
+    // The protected segment is limited to 80% of the files.
+    for (const auto & key : {"bbb", "ddd", "eee", "fff"})
+        ASSERT_NE(table.get(key), nullptr);
+    check_seqs({"aaa", "ccc", "bbb", "ddd", "eee", "fff"});
+    table.set("ggg", file_seg);
+    check_seqs({"aaa", "ccc", "ggg", "bbb", "ddd", "eee", "fff"});
+
+    // Remove the first file of the protected segment.
+    ASSERT_EQ(*table.remove("ggg"), "bbb");
+    ASSERT_EQ(*table.remove("bbb"), "ddd");
+    table.set("hhh", file_seg);
+    check_seqs({"aaa", "ccc", "hhh", "ddd", "eee", "fff"});
+
+    for (auto itr = table.begin(); itr != table.end();)
+        itr = table.remove(*itr);
+    ASSERT_EQ(table.size(), 0);
+    table.set("aaa", file_seg);
+    check_seqs({"aaa"});
+}
+
 TEST_F(FileCacheTest, EvictEmptyFile)
 try
 {
@@ -766,6 +832,137 @@ try
 }
 CATCH
 
+TEST_F(FileCacheTest, Chunk)
+try
+{
+    constexpr UInt64 chunk_size = 1024 * 1024;
+    const UInt64 file_size = 3 * chunk_size + 1000;
+    auto key = fmt::format("{}/1.dat", S3Filename::fromDMFileOID(DMFileOID{.store_id = nextId(), .table_id = static_cast<Int64>(nextId()), .file_id = nextId()}).toFullKey());
+    String content(file_size, '\0');
+    for (UInt64 i = 0; i < file_size; ++i)
+        content[i] = static_cast<char>(i % 251);
+    {
+        S3WritableFile file(s3_client, key, WriteSettings{});
+        ASSERT_EQ(file.write(content.data(), content.size()), content.size());
+        ASSERT_EQ(file.fsync(), 0);
+    }
+
+    auto cache_dir = fmt::format("{}/chunk", tmp_dir);
+    StorageRemoteCacheConfig cache_config{.dir = cache_dir, .capacity = cache_capacity, .dtfile_level = 100, .dtfile_chunk_size = chunk_size};
+    auto check_read = [&](const RandomAccessFilePtr & file, UInt64 offset, UInt64 size) {
+        String buf(size, '\0');
+        auto n = file->pread(buf.data(), size, offset);
+        ASSERT_EQ(n, std::min(size, file_size - offset));
+        ASSERT_EQ(buf.substr(0, n), content.substr(offset, n));
+    };
+    {
+        FileCache file_cache(capacity_metrics, cache_config);
+        auto file = file_cache.getRandomAccessFile(S3FilenameView::fromKey(key), file_size);
+        ASSERT_NE(file, nullptr);
+
+        // Only the chunk that is read is cached.
+        check_read(file, chunk_size + 10, 100);
+        ASSERT_EQ(file_cache.getAll().size(), 1);
+        ASSERT_EQ(file_cache.cache_used, chunk_size);
+
+        // Read across the chunks, including the last partial chunk.
+        check_read(file, chunk_size - 10, 2 * chunk_size);
+        check_read(file, 3 * chunk_size - 10, 2000);
+        ASSERT_EQ(file_cache.getAll().size(), 4);
+        ASSERT_EQ(file_cache.cache_used, file_size);
+        for (const auto & file_seg : file_cache.getAll())
+            ASSERT_TRUE(file_seg->isReadyToRead());
+
+        // Sequential read
+        String buf(file_size, '\0');
+        ASSERT_EQ(file->seek(0, SEEK_SET), 0);
+        UInt64 read_bytes = 0;
+        while (auto n = file->read(buf.data() + read_bytes, 4096))
+            read_bytes += n;
+        ASSERT_EQ(read_bytes, file_size);
+        ASSERT_EQ(buf, content);
+    }
+    {
+        // The chunks are restored
+        FileCache file_cache(capacity_metrics, cache_config);
+        ASSERT_EQ(file_cache.getAll().size(), 4);
+        ASSERT_EQ(file_cache.cache_used, file_size);
+        auto file = file_cache.getRandomAccessFile(S3FilenameView::fromKey(key), file_size);
+        check_read(file, 0, file_size);
+    }
+    {
+        // The chunks can not be cached without enough space, the last downloaded chunk is kept in memory.
+        StorageRemoteCacheConfig small_cache_config{.dir = fmt::format("{}/chunk_small", tmp_dir), .capacity = chunk_size / 2, .dtfile_level = 100, .dtfile_chunk_size = chunk_size};
+        FileCache file_cache(capacity_metrics, small_cache_config);
+        auto file = file_cache.getRandomAccessFile(S3FilenameView::fromKey(key), file_size);
+        ASSERT_NE(file, nullptr);
+
+        const auto get_object_count = ProfileEvents::get(ProfileEvents::S3GetObject);
+        String buf(file_size, '\0');
+        UInt64 read_bytes = 0;
+        while (auto n = file->read(buf.data() + read_bytes, 4096))
+            read_bytes += n;
+        ASSERT_EQ(read_bytes, file_size);
+        ASSERT_EQ(buf, content);
+        ASSERT_EQ(file_cache.getAll().size(), 0);
+        // Every chunk is downloaded only once.
+        ASSERT_EQ(ProfileEvents::get(ProfileEvents::S3GetObject) - get_object_count, 4);
+    }
+}
+CATCH
+
+TEST_F(FileCacheTest, BackgroundEvict)
+try
+{
+    auto cache_dir = fmt::format("{}/bg_evict", tmp_dir);
+    StorageRemoteCacheConfig cache_config{.dir = cache_dir, .capacity = cache_capacity, .dtfile_level = 100};
+    FileCache file_cache(capacity_metrics, cache_config);
+    const UInt64 dt_cache_capacity = cache_config.getDTFileCapacity();
+    constexpr size_t cold_count = 100;
+    constexpr size_t hot_count = 10;
+    const UInt64 file_size = dt_cache_capacity / (cold_count + hot_count);
+    auto dmfile_key = S3Filename::fromDMFileOID(DMFileOID{.store_id = nextId(), .table_id = static_cast<Int64>(nextId()), .file_id = nextId()}).toFullKey();
+    std::vector<String> local_fnames;
+    for (size_t i = 0; i < cold_count + hot_count; ++i)
+    {
+        auto key = fmt::format("{}/{}.dat", dmfile_key, i);
+        auto local_fname = file_cache.toLocalFilename(key);
+        FileCache::prepareParentDir(local_fname);
+        std::ofstream ofs(local_fname);
+        auto file_seg = std::make_shared<FileSegment>(local_fname, FileSegment::Status::Complete, file_size, FileType::ColData);
+        if (i < cold_count)
+            file_seg->setLastAccessTime(std::chrono::system_clock::now() - std::chrono::hours(1));
+        auto & shard = file_cache.getShard(key);
+        std::lock_guard lock(shard.mtx);
+        shard.tables[static_cast<UInt64>(FileType::ColData)].set(key, file_seg);
+        local_fnames.push_back(local_fname);
+    }
+
+    // Exceed the high watermark, the cold files are evicted in background.
+    ASSERT_TRUE(file_cache.reserveSpace(FileType::ColData, file_size * (cold_count + hot_count), /*try_evict*/ false));
+    const auto low_watermark_size = static_cast<UInt64>(dt_cache_capacity * file_cache.evict_low_watermark);
+    for (int i = 0; i < 100 && file_cache.cache_used > low_watermark_size; ++i)
+        std::this_thread::sleep_for(100ms);
+    ASSERT_LE(file_cache.cache_used, low_watermark_size);
+    auto files = file_cache.getAll();
+    ASSERT_GE(files.size(), hot_count);
+    ASSERT_LT(files.size(), cold_count + hot_count);
+    ASSERT_EQ(file_cache.cache_used, files.size() * file_size);
+    // The hot files are not evicted.
+    for (size_t i = cold_count; i < cold_count + hot_count; ++i)
+    {
+        ASSERT_TRUE(std::any_of(files.begin(), files.end(), [&](const auto & f) { return f->getLocalFileName() == local_fnames[i]; }));
+    }
+    // The disk files of evicted files are removed in background.
+    auto count_disk_files = [&]() {
+        return std::count_if(local_fnames.begin(), local_fnames.end(), [](const auto & fname) { return std::filesystem::exists(fname); });
+    };
+    for (int i = 0; i < 100 && static_cast<size_t>(count_disk_files()) != files.size(); ++i)
+        std::this_thread::sleep_for(100ms);
+    ASSERT_EQ(count_disk_files(), files.size());
+}
+CATCH
+
 TEST_F(FileCacheTest, ManualDropCachedFiles)
 try
 {
@@ -14,6 +14,7 @@
 
 #include <Common/Exception.h>
 #include <Common/FailPoint.h>
+#include <Common/ProfileEvents.h>
 #include <Encryption/PosixWritableFile.h>
 #include <Interpreters/Context.h>
 #include <Poco/DigestStream.h>
@@ -51,9 +52,17 @@ using namespace DB::DM;
 using namespace DB::DM::tests;
 using namespace DB::S3;
 
+namespace ProfileEvents
+{
+extern const Event S3PutDMFile;
+extern const Event S3UploadPart;
+extern const Event S3HeadObject;
+} // namespace ProfileEvents
+
 namespace DB::FailPoints
 {
 extern const char force_set_mocked_s3_object_mtime[];
+extern const char exception_when_upload_s3_part[];
 } // namespace DB::FailPoints
 
 namespace DB::tests
@@ -224,6 +233,83 @@ try
 }
 CATCH
 
+TEST_F(S3FileTest, MultiPartConcurrently)
+try
+{
+    const auto size = 1024 * 1024 * 40; // 40MB
+    WriteSettings write_setting;
+    write_setting.max_single_part_upload_size = 1024 * 1024 * 6; // 6MB
+    write_setting.upload_part_size = 1024 * 1024 * 5; // 5MB
+    // The part size grows to 10MB after 2 parts, and 12MB after 4 parts.
+    write_setting.upload_part_size_multiply_parts_count_threshold = 2;
+    write_setting.max_upload_part_size = 1024 * 1024 * 12; // 12MB
+    write_setting.max_inflight_parts = 3;
+    write_setting.max_inflight_bytes = 1024 * 1024 * 16; // 16MB
+    const String key = "/a/b/c/multipart_concurrently";
+    writeFile(key, size, write_setting);
+    // 8 parts are required if the part size does not grow.
+    ASSERT_LT(last_upload_info.part_number, 8);
+    ASSERT_EQ(last_upload_info.part_tags.size(), last_upload_info.part_number);
+    for (const auto & tag : last_upload_info.part_tags)
+        ASSERT_FALSE(tag.empty());
+    ASSERT_EQ(last_upload_info.total_write_bytes, size);
+    verifyFile(key, size);
+}
+CATCH
+
+TEST_F(S3FileTest, MultiPartFailFast)
+try
+{
+    WriteSettings write_setting;
+    write_setting.max_single_part_upload_size = 1024 * 1024 * 6; // 6MB
+    write_setting.upload_part_size = 1024 * 1024 * 5; // 5MB
+    const String key = "/a/b/c/multipart_fail_fast";
+
+    FailPointHelper::enableFailPoint(FailPoints::exception_when_upload_s3_part);
+    SCOPE_EXIT({ FailPointHelper::disableFailPoint(FailPoints::exception_when_upload_s3_part); });
+    auto write = [&]() {
+        S3WritableFile file(s3_client, key, write_setting);
+        // The failure of the background parts is thrown by the following writes or `fsync`.
+        for (size_t write_size = 0; write_size < 1024 * 1024 * 20; write_size += buf_unit.size())
+            file.write(buf_unit.data(), buf_unit.size());
+        file.fsync();
+    };
+    ASSERT_THROW(write(), DB::Exception);
+    ASSERT_FALSE(S3::objectExists(*s3_client, key));
+}
+CATCH
+
+TEST_F(S3FileTest, UploadFileByS3WritableFile)
+try
+{
+    WriteSettings write_setting;
+    write_setting.max_single_part_upload_size = 1024 * 1024 * 6; // 6MB
+    write_setting.upload_part_size = 1024 * 1024 * 5; // 5MB
+    for (const size_t size : {1024 * 1024 * 1, 1024 * 1024 * 22})
+    {
+        const auto local_fname = fmt::format("{}/upload_file_{}", getTemporaryPath(), size);
+        const auto key = fmt::format("/a/b/c/upload_file_{}", size);
+        writeLocalFile(local_fname, size);
+        S3::uploadFileByS3WritableFile(s3_client, local_fname, key, write_setting);
+        verifyFile(key, size);
+    }
+
+    // The large DMFile is uploaded by the parts read from the local file, and counted as a DMFile upload.
+    {
+        const size_t size = 1024 * 1024 * 22;
+        const auto local_fname = fmt::format("{}/upload_dmfile", getTemporaryPath());
+        const auto key = fmt::format("{}/1.dat", S3Filename::fromDMFileOID(DMFileOID{.store_id = 1, .table_id = 2, .file_id = 3}).toFullKey());
+        writeLocalFile(local_fname, size);
+        const auto put_dmfile_count = ProfileEvents::get(ProfileEvents::S3PutDMFile);
+        const auto upload_part_count = ProfileEvents::get(ProfileEvents::S3UploadPart);
+        S3::uploadFileByS3WritableFile(s3_client, local_fname, key, write_setting);
+        verifyFile(key, size);
+        ASSERT_EQ(ProfileEvents::get(ProfileEvents::S3PutDMFile) - put_dmfile_count, 1);
+        ASSERT_EQ(ProfileEvents::get(ProfileEvents::S3UploadPart) - upload_part_count, 5);
+    }
+}
+CATCH
+
 TEST_F(S3FileTest, Seek)
 try
 {
@@ -252,6 +338,120 @@ try
 }
 CATCH
 
+TEST_F(S3FileTest, SeekBackwardAndPread)
+try
+{
+    const auto size = 1024 * 1024 * 10; // 10MB
+    WriteSettings write_setting;
+    const String key = "/a/b/c/seek_backward";
+    writeFile(key, size, write_setting);
+
+    auto check_read = [&](RandomAccessFile & file, off_t offset) {
+        ASSERT_EQ(file.seek(offset, SEEK_SET), offset);
+        std::vector<char> tmp_buf(256);
+        auto n = file.read(tmp_buf.data(), tmp_buf.size());
+        ASSERT_EQ(n, tmp_buf.size());
+        std::vector<char> expected(256);
+        std::iota(expected.begin(), expected.end(), offset % 256);
+        ASSERT_EQ(tmp_buf, expected);
+    };
+
+    for (auto read_ahead_max_bytes : {0, 1024 * 1024})
+    {
+        S3ReadOptions options{.coalesce_gap_bytes = 4096, .read_ahead_max_bytes = static_cast<UInt64>(read_ahead_max_bytes)};
+        S3RandomAccessFile file(s3_client, key, std::nullopt, options);
+        check_read(file, 1000); // skip the gap in the current stream
+        check_read(file, 3); // seek backward
+        check_read(file, 5 * 1024 * 1024 + 7); // seek forward with a large gap
+        check_read(file, 1024 * 1024 + 1);
+        ASSERT_EQ(file.seek(size, SEEK_SET), size);
+        std::vector<char> tmp_buf(256);
+        ASSERT_EQ(file.read(tmp_buf.data(), tmp_buf.size()), 0);
+        check_read(file, 0);
+
+        std::vector<char> expected(256);
+        std::iota(expected.begin(), expected.end(), 0x11);
+        ASSERT_EQ(file.pread(tmp_buf.data(), tmp_buf.size(), 0x11 + 256 * 100), tmp_buf.size());
+        ASSERT_EQ(tmp_buf, expected);
+        // pread does not change the offset of read
+        check_read(file, 256);
+        // pread is truncated at the end of file
+        ASSERT_EQ(file.pread(tmp_buf.data(), tmp_buf.size(), size - 10), 10);
+        ASSERT_EQ(file.pread(tmp_buf.data(), tmp_buf.size(), size), 0);
+    }
+}
+CATCH
+
+TEST_F(S3FileTest, ReadAhead)
+try
+{
+    const auto size = 1024 * 1024 * 3 + 100;
+    WriteSettings write_setting;
+    const String key = "/a/b/c/read_ahead";
+    writeFile(key, size, write_setting);
+
+    S3ReadOptions options{.read_ahead_max_bytes = 1024 * 1024, .read_ahead_concurrency = 3};
+    S3RandomAccessFile file(s3_client, key, std::nullopt, options);
+    std::vector<char> tmp_buf;
+    size_t read_size = 0;
+    while (read_size < size)
+    {
+        // Read across the boundaries of the ranges
+        tmp_buf.resize(256 * 1000);
+        auto n = file.read(tmp_buf.data(), tmp_buf.size());
+        ASSERT_GT(n, 0);
+        for (ssize_t i = 0; i < n; ++i)
+            ASSERT_EQ(static_cast<UInt8>(tmp_buf[i]), (read_size + i) % 256) << read_size + i;
+        read_size += n;
+    }
+    ASSERT_EQ(read_size, size);
+    ASSERT_EQ(file.read(tmp_buf.data(), tmp_buf.size()), 0);
+
+    // The size of the file is got by HeadObject only if it is unknown.
+    {
+        const auto head_object_count = ProfileEvents::get(ProfileEvents::S3HeadObject);
+        S3RandomAccessFile file_with_size(s3_client, key, std::nullopt, options, size);
+        ASSERT_EQ(ProfileEvents::get(ProfileEvents::S3HeadObject) - head_object_count, 0);
+        ASSERT_EQ(file_with_size.seek(size - 100, SEEK_SET), size - 100);
+        ASSERT_EQ(file_with_size.read(tmp_buf.data(), tmp_buf.size()), 100);
+        for (size_t i = 0; i < 100; ++i)
+            ASSERT_EQ(static_cast<UInt8>(tmp_buf[i]), (size - 100 + i) % 256) << i;
+        S3RandomAccessFile file_without_size(s3_client, key, std::nullopt, options);
+        ASSERT_EQ(ProfileEvents::get(ProfileEvents::S3HeadObject) - head_object_count, 1);
+    }
+}
+CATCH
+
+TEST_F(S3FileTest, ReadAheadFailed)
+try
+{
+    const auto size = 1024 * 1024 * 4 + 100;
+    WriteSettings write_setting;
+    const String key = "/a/b/c/read_ahead_failed";
+    writeFile(key, size, write_setting);
+
+    S3ReadOptions options{.read_ahead_max_bytes = 1024 * 1024, .read_ahead_concurrency = 3};
+    S3RandomAccessFile file(s3_client, key, std::nullopt, options);
+    std::vector<char> tmp_buf(1000);
+    ASSERT_EQ(file.read(tmp_buf.data(), tmp_buf.size()), static_cast<ssize_t>(tmp_buf.size()));
+
+    // The ranges read ahead end before `offset`, reading from it fails after the object is removed.
+    const off_t offset = 1024 * 1024 * 3;
+    S3::deleteObject(*s3_client, key);
+    ASSERT_EQ(file.seek(offset, SEEK_SET), offset);
+    ASSERT_THROW(file.read(tmp_buf.data(), tmp_buf.size()), DB::Exception);
+    // Retrying reports the S3 error again instead of reusing the consumed result.
+    ASSERT_THROW(file.read(tmp_buf.data(), tmp_buf.size()), DB::Exception);
+
+    // The retry starts a fresh ranged read at the same offset after the object is back.
+    writeFile(key, size, write_setting);
+    auto n = file.read(tmp_buf.data(), tmp_buf.size());
+    ASSERT_EQ(n, static_cast<ssize_t>(tmp_buf.size()));
+    for (ssize_t i = 0; i < n; ++i)
+        ASSERT_EQ(static_cast<UInt8>(tmp_buf[i]), (offset + i) % 256) << i;
+}
+CATCH
+
 TEST_F(S3FileTest, WriteRead)
 try
 {
@@ -31,6 +31,8 @@ SelectQueryInfo::SelectQueryInfo(const SelectQueryInfo & rhs)
     , req_id(rhs.req_id)
     , keep_order(rhs.keep_order)
     , is_fast_scan(rhs.is_fast_scan)
+    , enable_low_cardinality(rhs.enable_low_cardinality)
+    , segment_aggregation(rhs.segment_aggregation)
 {}
 
 SelectQueryInfo::SelectQueryInfo(SelectQueryInfo && rhs) noexcept
@@ -41,6 +43,8 @@ SelectQueryInfo::SelectQueryInfo(SelectQueryInfo && rhs) noexcept
     , req_id(std::move(rhs.req_id))
     , keep_order(rhs.keep_order)
     , is_fast_scan(rhs.is_fast_scan)
+    , enable_low_cardinality(rhs.enable_low_cardinality)
+    , segment_aggregation(std::move(rhs.segment_aggregation))
 {}
 
 } // namespace DB
@@ -33,6 +33,11 @@ using PreparedSets = std::unordered_map<IAST *, SetPtr>;
 struct MvccQueryInfo;
 struct DAGQueryInfo;
 
+namespace DM
+{
+class SegmentAggregation;
+} // namespace DM
+
 
 /** Query along with some additional data,
   *  that can be used during query processing
@@ -53,6 +58,10 @@ struct SelectQueryInfo
     std::string req_id;
     bool keep_order = true;
     bool is_fast_scan = false;
+    /// Whether the storage can return string columns as ColumnLowCardinality.
+    bool enable_low_cardinality = false;
+    /// The aggregation pushed down to the segments, nullptr if it is not pushed down.
+    std::shared_ptr<DM::SegmentAggregation> segment_aggregation;
 
     SelectQueryInfo();
     ~SelectQueryInfo();
@@ -931,7 +931,9 @@ BlockInputStreams StorageDeltaMerge::read(
         max_block_size,
         parseSegmentSet(select_query.segment_expression_list),
         extra_table_id_index,
-        scan_context);
+        scan_context,
+        query_info.enable_low_cardinality,
+        query_info.segment_aggregation);
 
     /// Ensure read_tso info after read.
     checkReadTso(mvcc_query_info.read_tso, context, query_info.req_id);
@@ -1002,7 +1004,8 @@ void StorageDeltaMerge::read(
         max_block_size,
         parseSegmentSet(select_query.segment_expression_list),
         extra_table_id_index,
-        scan_context);
+        scan_context,
+        query_info.enable_low_cardinality);
 
     /// Ensure read_tso info after read.
     checkReadTso(mvcc_query_info.read_tso, context, query_info.req_id);
@@ -450,6 +450,12 @@ size_t Region::writeCFCount() const
     return data.writeCF().getSize();
 }
 
+size_t Region::reservedDataMemory() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return data.reservedMemory();
+}
+
 std::string Region::dataInfo() const
 {
     std::shared_lock<std::shared_mutex> lock(mutex);
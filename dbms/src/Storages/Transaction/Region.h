@@ -104,6 +104,12 @@ public:
                 lock = std::unique_lock<std::shared_mutex>(store_->mutex);
         }
 
+        ~CommittedRemover()
+        {
+            // Release the memory of the flushed committed data if most of the reserved memory is not used.
+            store->data.tryReleaseMemory();
+        }
+
         void remove(const RegionWriteCFData::Key & key)
         {
             auto & write_cf_data = store->data.writeCF().getDataMut();
@@ -148,6 +154,8 @@ public:
 
     size_t dataSize() const;
     size_t writeCFCount() const;
+    /// The memory reserved by the write cf and default cf, including the freed nodes kept for reuse.
+    size_t reservedDataMemory() const;
     std::string dataInfo() const;
 
     void markCompactLog() const;
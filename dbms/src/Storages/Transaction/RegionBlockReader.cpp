@@ -162,6 +162,34 @@ bool RegionBlockReader::readImpl(Block & block, const RegionDataReadInfoList & d
         }
     }
 
+    /// For the table which is not common handle, the values do not affect how to decode the pk columns from keys.
+    /// So if all the rows are encoded in row v2, decode the values column by column in batch.
+    bool value_decoded = false;
+    if constexpr (pk_type != TMTPKType::STRING)
+    {
+        if (need_decode_value)
+        {
+            std::vector<const TiKVValue::Base *> raw_values;
+            raw_values.reserve(data_list.size());
+            for (const auto & data : data_list)
+            {
+                const auto & value_ptr = std::get<3>(data);
+                if (std::get<1>(data) == Region::DelFlag)
+                    raw_values.push_back(nullptr);
+                else if (isRowV2(*value_ptr))
+                    raw_values.push_back(value_ptr.get());
+                else
+                    break;
+            }
+            if (raw_values.size() == data_list.size())
+            {
+                if (!appendRowsV2ToBlock(raw_values, column_ids_iter, read_column_ids.end(), block, next_column_pos, schema_snapshot, force_decode))
+                    return false;
+                value_decoded = true;
+            }
+        }
+    }
+
     size_t index = 0;
     for (const auto & [pk, write_type, commit_ts, value_ptr] : data_list)
     {
@@ -169,7 +197,7 @@ bool RegionBlockReader::readImpl(Block & block, const RegionDataReadInfoList & d
         delmark_data.emplace_back(write_type == Region::DelFlag);
         version_data.emplace_back(commit_ts);
 
-        if (need_decode_value)
+        if (need_decode_value && !value_decoded)
         {
             if (write_type == Region::DelFlag)
             {
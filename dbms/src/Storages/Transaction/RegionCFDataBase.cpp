@@ -64,6 +64,14 @@ template <typename Trait>
 RegionDataRes RegionCFDataBase<Trait>::insert(std::pair<Key, Value> && kv_pair, DupCheck mode)
 {
     auto & map = data;
+    // The kvs of snapshots and persisted regions, and most kvs in a batch of raft cmds come in ascending order.
+    // Append them to the end without searching from the root, they can not be duplicated.
+    if (map.empty() || map.rbegin()->first < kv_pair.first)
+    {
+        auto it = map.emplace_hint(map.end(), std::move(kv_pair));
+        return calcTiKVKeyValueSize(it->second);
+    }
+
     TiKVValue prev_value;
     if (mode == DupCheck::AllowSame)
     {
@@ -238,6 +246,9 @@ size_t RegionCFDataBase<Trait>::splitInto(const RegionRange & range, RegionCFDat
                 ++it;
         }
     }
+    // The nodes moved to the new region are still reserved by the pools of the origin map.
+    if (size_changed)
+        rebuild();
     return size_changed;
 }
 
@@ -275,6 +286,47 @@ size_t RegionCFDataBase<Trait>::deserialize(ReadBuffer & buf, RegionCFDataBase &
     return cf_data_size;
 }
 
+template <typename Trait>
+void RegionCFDataBase<Trait>::tryReleaseMemory()
+{
+    // The freed nodes are kept in the pools of map for reuse, release them if most of them are not used.
+    const size_t reserved = reservedMemory();
+    if (reserved == 0)
+        return;
+    if (data.empty() || (reserved >= MIN_RELEASE_MEMORY && usedMemory() < reserved / 4))
+        rebuild();
+}
+
+template <typename Trait>
+void RegionCFDataBase<Trait>::rebuild()
+{
+    if constexpr (isPooled())
+    {
+        Data new_data;
+        for (auto & [key, value] : data)
+            new_data.emplace_hint(new_data.end(), key, std::move(value));
+        data = std::move(new_data);
+    }
+}
+
+template <typename Trait>
+size_t RegionCFDataBase<Trait>::usedMemory() const
+{
+    if constexpr (isPooled())
+        return data.get_allocator().getPools().usedBytes();
+    else
+        return 0;
+}
+
+template <typename Trait>
+size_t RegionCFDataBase<Trait>::reservedMemory() const
+{
+    if constexpr (isPooled())
+        return data.get_allocator().getPools().reservedBytes();
+    else
+        return 0;
+}
+
 template <typename Trait>
 const typename RegionCFDataBase<Trait>::Data & RegionCFDataBase<Trait>::getData() const
 {
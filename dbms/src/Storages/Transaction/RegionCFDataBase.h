@@ -14,10 +14,12 @@
 
 #pragma once
 
+#include <Common/SmallObjectPoolAllocator.h>
 #include <Storages/Transaction/RegionRangeKeys.h>
 #include <Storages/Transaction/TiKVKeyValue.h>
 
 #include <map>
+#include <type_traits>
 
 namespace DB
 {
@@ -75,7 +77,26 @@ struct RegionCFDataBase
 
     Data & getDataMut();
 
+    /// Release the memory kept by the map if it is empty or most of it is not used.
+    void tryReleaseMemory();
+
+    /// The memory reserved by the nodes of the map, including the freed nodes kept for reuse.
+    size_t reservedMemory() const;
+
 private:
+    /// Do not bother to rebuild a small map.
+    static constexpr size_t MIN_RELEASE_MEMORY = 64 * 1024;
+
+    static constexpr bool isPooled()
+    {
+        return std::is_same_v<typename Data::allocator_type, SmallObjectPoolAllocator<typename Data::value_type>>;
+    }
+
+    /// Move the data to a new map, then the pools of the old map are released.
+    void rebuild();
+
+    size_t usedMemory() const;
+
     static bool shouldIgnoreRemove(const Value & value);
     RegionDataRes insert(std::pair<Key, Value> && kv_pair, DupCheck mode = DupCheck::Deny);
 
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <Common/SmallObjectPoolAllocator.h>
 #include <Storages/Transaction/TiKVRecordFormat.h>
 
 #include <map>
@@ -31,12 +32,17 @@ struct CFKeyHasher
     }
 };
 
+/// The write and default cf of a region may hold a lot of kvs under heavy writes, allocate
+/// the nodes of their maps from the pools of each map to avoid allocating them one by one.
+template <typename Key, typename Value>
+using RegionCFDataMap = std::map<Key, Value, std::less<Key>, SmallObjectPoolAllocator<std::pair<const Key, Value>>>;
+
 struct RegionWriteCFDataTrait
 {
     using DecodedWriteCFValue = RecordKVFormat::InnerDecodedWriteCFValue;
     using Key = std::pair<RawTiDBPK, Timestamp>;
     using Value = std::tuple<std::shared_ptr<const TiKVKey>, std::shared_ptr<const TiKVValue>, DecodedWriteCFValue>;
-    using Map = std::map<Key, Value>;
+    using Map = RegionCFDataMap<Key, Value>;
 
     static std::optional<Map::value_type> genKVPair(TiKVKey && key, const DecodedTiKVKey & raw_key, TiKVValue && value)
     {
@@ -60,7 +66,7 @@ struct RegionDefaultCFDataTrait
 {
     using Key = std::pair<RawTiDBPK, Timestamp>;
     using Value = std::tuple<std::shared_ptr<const TiKVKey>, std::shared_ptr<const TiKVValue>>;
-    using Map = std::map<Key, Value>;
+    using Map = RegionCFDataMap<Key, Value>;
 
     static std::optional<Map::value_type> genKVPair(TiKVKey && key, const DecodedTiKVKey & raw_key, TiKVValue && value)
     {
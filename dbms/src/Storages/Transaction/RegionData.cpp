@@ -193,6 +193,17 @@ size_t RegionData::dataSize() const
     return cf_data_size;
 }
 
+void RegionData::tryReleaseMemory()
+{
+    write_cf.tryReleaseMemory();
+    default_cf.tryReleaseMemory();
+}
+
+size_t RegionData::reservedMemory() const
+{
+    return write_cf.reservedMemory() + default_cf.reservedMemory();
+}
+
 void RegionData::assignRegionData(RegionData && new_region_data)
 {
     default_cf = std::move(new_region_data.default_cf);
@@ -51,6 +51,11 @@ public:
 
     size_t dataSize() const;
 
+    // Release the memory kept by write cf and default cf if most of it is not used.
+    void tryReleaseMemory();
+
+    size_t reservedMemory() const;
+
     void assignRegionData(RegionData && new_region_data);
 
     size_t serialize(WriteBuffer & buf) const;
@@ -12,7 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnsNumber.h>
 #include <Columns/IColumn.h>
+#include <Common/typeid_cast.h>
 #include <IO/Endian.h>
 #include <IO/Operators.h>
 #include <Storages/Transaction/Datum.h>
@@ -519,6 +522,263 @@ bool appendRowV2ToBlockImpl(
 }
 
 using TiDB::DatumFlat;
+namespace
+{
+/// The location of a read column in an encoded row, parsed from the header of row v2.
+struct DatumRef
+{
+    enum State : UInt8
+    {
+        NotNull,
+        Null,
+        Missing,
+        Deleted,
+    };
+
+    UInt32 offset = 0;
+    UInt32 length = 0;
+    State state = Missing;
+};
+
+/// Parse the header of a row and fill the `DatumRef`s of it, which are column-major in `refs`.
+template <bool is_big>
+bool parseRowV2Header(
+    const TiKVValue::Base & raw_value,
+    const std::vector<ColumnID> & read_column_ids,
+    size_t row,
+    size_t rows,
+    std::vector<DatumRef> & refs,
+    bool force_decode)
+{
+    using ColumnIDType = typename RowV2::Types<is_big>::ColumnIDType;
+    using ValueOffsetType = typename RowV2::Types<is_big>::ValueOffsetType;
+
+    size_t cursor = 2; // Skip the initial codec ver and row flag.
+    const size_t num_not_null_columns = decodeUInt<UInt16>(cursor, raw_value);
+    const size_t num_null_columns = decodeUInt<UInt16>(cursor, raw_value);
+    const size_t not_null_ids_pos = cursor;
+    const size_t null_ids_pos = not_null_ids_pos + num_not_null_columns * sizeof(ColumnIDType);
+    const size_t offsets_pos = null_ids_pos + num_null_columns * sizeof(ColumnIDType);
+    const size_t values_start_pos = offsets_pos + num_not_null_columns * sizeof(ValueOffsetType);
+    auto column_id_at = [&](size_t ids_pos, size_t idx) -> ColumnID {
+        return readLittleEndian<ColumnIDType>(&raw_value[ids_pos + idx * sizeof(ColumnIDType)]);
+    };
+    auto value_offset_at = [&](size_t idx) -> size_t {
+        return readLittleEndian<ValueOffsetType>(&raw_value[offsets_pos + idx * sizeof(ValueOffsetType)]);
+    };
+
+    size_t idx_not_null = 0;
+    size_t idx_null = 0;
+    size_t idx_read = 0;
+    // Merge ordered not null/null columns with the read columns, the same as `appendRowV2ToBlockImpl`.
+    while (idx_not_null < num_not_null_columns || idx_null < num_null_columns)
+    {
+        if (idx_read == read_column_ids.size())
+        {
+            // extra column
+            return force_decode;
+        }
+
+        bool is_null;
+        if (idx_not_null < num_not_null_columns && idx_null < num_null_columns)
+            is_null = column_id_at(not_null_ids_pos, idx_not_null) > column_id_at(null_ids_pos, idx_null);
+        else
+            is_null = idx_null < num_null_columns;
+
+        const auto next_datum_column_id = is_null ? column_id_at(null_ids_pos, idx_null) : column_id_at(not_null_ids_pos, idx_not_null);
+        const auto next_column_id = read_column_ids[idx_read];
+        if (next_column_id > next_datum_column_id)
+        {
+            // The datum of extra column.
+            if (!force_decode)
+                return false;
+            if (is_null)
+                idx_null++;
+            else
+                idx_not_null++;
+            continue;
+        }
+
+        auto & ref = refs[idx_read * rows + row];
+        if (next_column_id < next_datum_column_id)
+        {
+            // The datum of missing column.
+            ref.state = DatumRef::Missing;
+        }
+        else if (is_null)
+        {
+            ref.state = DatumRef::Null;
+            idx_null++;
+        }
+        else
+        {
+            size_t start = idx_not_null ? value_offset_at(idx_not_null - 1) : 0;
+            ref.offset = static_cast<UInt32>(values_start_pos + start);
+            ref.length = static_cast<UInt32>(value_offset_at(idx_not_null) - start);
+            ref.state = DatumRef::NotNull;
+            idx_not_null++;
+        }
+        idx_read++;
+    }
+    for (; idx_read < read_column_ids.size(); ++idx_read)
+        refs[idx_read * rows + row].state = DatumRef::Missing;
+    return true;
+}
+
+/// Append the datums of a column for all rows. `NestedColumn` is the concrete type of the (nested) column,
+/// so that decoding a datum is not a virtual call and can be inlined into the loop.
+template <typename NestedColumn>
+bool appendDatumsToColumn(
+    const std::vector<const TiKVValue::Base *> & raw_values,
+    const DatumRef * refs,
+    IColumn & raw_column,
+    const ColumnInfo & column_info,
+    Block & block,
+    size_t block_column_pos,
+    bool ignore_pk_if_absent,
+    bool force_decode)
+{
+    NestedColumn * column = nullptr;
+    NullMap * null_map = nullptr;
+    if (raw_column.isColumnNullable())
+    {
+        auto & nullable_column = static_cast<ColumnNullable &>(raw_column);
+        column = static_cast<NestedColumn *>(&nullable_column.getNestedColumn());
+        null_map = &nullable_column.getNullMapData();
+    }
+    else
+    {
+        column = static_cast<NestedColumn *>(&raw_column);
+    }
+
+    for (size_t row = 0; row < raw_values.size(); ++row)
+    {
+        const auto & ref = refs[row];
+        switch (ref.state)
+        {
+        case DatumRef::NotNull:
+            if (!column->decodeTiDBRowV2Datum(ref.offset, *raw_values[row], ref.length, force_decode))
+                return false;
+            if (null_map)
+                null_map->push_back(0);
+            break;
+        case DatumRef::Null:
+            if (!null_map)
+            {
+                if (!force_decode)
+                    return false;
+                throw Exception("Detected invalid null when decoding data of column " + column_info.name + " with column type " + raw_column.getName(),
+                                ErrorCodes::LOGICAL_ERROR);
+            }
+            [[fallthrough]];
+        case DatumRef::Deleted:
+            column->insertDefault();
+            if (null_map)
+                null_map->push_back(1);
+            break;
+        case DatumRef::Missing:
+            if (!addDefaultValueToColumnIfPossible(column_info, block, block_column_pos, ignore_pk_if_absent, force_decode))
+                return false;
+            break;
+        }
+    }
+    return true;
+}
+
+template <typename T, typename... Ts>
+bool appendDatumsToVectorColumn(
+    const IColumn & nested_column,
+    const std::vector<const TiKVValue::Base *> & raw_values,
+    const DatumRef * refs,
+    IColumn & raw_column,
+    const ColumnInfo & column_info,
+    Block & block,
+    size_t block_column_pos,
+    bool ignore_pk_if_absent,
+    bool force_decode)
+{
+    if (typeid_cast<const ColumnVector<T> *>(&nested_column))
+        return appendDatumsToColumn<ColumnVector<T>>(raw_values, refs, raw_column, column_info, block, block_column_pos, ignore_pk_if_absent, force_decode);
+    if constexpr (sizeof...(Ts) > 0)
+        return appendDatumsToVectorColumn<Ts...>(nested_column, raw_values, refs, raw_column, column_info, block, block_column_pos, ignore_pk_if_absent, force_decode);
+    else
+        return appendDatumsToColumn<IColumn>(raw_values, refs, raw_column, column_info, block, block_column_pos, ignore_pk_if_absent, force_decode);
+}
+} // namespace
+
+bool isRowV2(const TiKVValue::Base & raw_value)
+{
+    return !raw_value.empty() && static_cast<UInt8>(raw_value[0]) == static_cast<UInt8>(RowCodecVer::ROW_V2);
+}
+
+bool appendRowsV2ToBlock(
+    const std::vector<const TiKVValue::Base *> & raw_values,
+    SortedColumnIDWithPosConstIter column_ids_iter,
+    SortedColumnIDWithPosConstIter column_ids_iter_end,
+    Block & block,
+    size_t block_column_pos,
+    const DecodingStorageSchemaSnapshotConstPtr & schema_snapshot,
+    bool force_decode)
+{
+    if (unlikely(schema_snapshot->is_common_handle))
+        throw Exception("Can not decode the rows of common handle table in batch", ErrorCodes::LOGICAL_ERROR);
+
+    const ColumnInfos & column_infos = schema_snapshot->column_infos;
+    // The pk column of pk_is_handle table is decoded from the encoded key, skip it like `appendRowToBlock`.
+    const ColumnID pk_handle_id = schema_snapshot->pk_is_handle ? schema_snapshot->pk_column_ids[0] : InvalidColumnID;
+    const bool ignore_pk_if_absent = schema_snapshot->pk_is_handle;
+
+    std::vector<ColumnID> read_column_ids;
+    std::vector<size_t> read_column_info_pos;
+    for (auto iter = column_ids_iter; iter != column_ids_iter_end; ++iter)
+    {
+        read_column_ids.push_back(iter->first);
+        read_column_info_pos.push_back(iter->second);
+    }
+
+    // Locate the datums of all rows first, then decode them column by column.
+    const size_t rows = raw_values.size();
+    std::vector<DatumRef> refs(read_column_ids.size() * rows);
+    for (size_t row = 0; row < rows; ++row)
+    {
+        const auto * raw_value = raw_values[row];
+        if (raw_value == nullptr)
+        {
+            for (size_t i = 0; i < read_column_ids.size(); ++i)
+                refs[i * rows + row].state = DatumRef::Deleted;
+            continue;
+        }
+        assert(isRowV2(*raw_value));
+        auto row_flag = readLittleEndian<UInt8>(&(*raw_value)[1]);
+        bool is_big = row_flag & RowV2::BigRowMask;
+        bool ok = is_big ? parseRowV2Header<true>(*raw_value, read_column_ids, row, rows, refs, force_decode)
+                         : parseRowV2Header<false>(*raw_value, read_column_ids, row, rows, refs, force_decode);
+        if (!ok)
+            return false;
+    }
+
+    for (size_t i = 0; i < read_column_ids.size(); ++i)
+    {
+        if (read_column_ids[i] == pk_handle_id)
+            continue;
+        auto * raw_column = const_cast<IColumn *>((block.getByPosition(block_column_pos + i)).column.get());
+        const IColumn & nested_column = raw_column->isColumnNullable() ? static_cast<const ColumnNullable &>(*raw_column).getNestedColumn() : *raw_column;
+        const auto & column_info = column_infos[read_column_info_pos[i]];
+        if (!appendDatumsToVectorColumn<Int64, UInt64, Int32, UInt32, Int16, UInt16, Int8, UInt8, Float64, Float32>(
+                nested_column,
+                raw_values,
+                &refs[i * rows],
+                *raw_column,
+                column_info,
+                block,
+                block_column_pos + i,
+                ignore_pk_if_absent,
+                force_decode))
+            return false;
+    }
+    return true;
+}
+
 bool appendRowV1ToBlock(
     const TiKVValue::Base & raw_value,
     SortedColumnIDWithPosConstIter column_ids_iter,
@@ -33,5 +33,19 @@ bool appendRowToBlock(
     const DecodingStorageSchemaSnapshotConstPtr & schema_snapshot,
     bool force_decode);
 
+bool isRowV2(const TiKVValue::Base & raw_value);
+
+/// Decode the rows encoded in row v2 into `block`, the same as calling `appendRowToBlock` for each row, but the
+/// header of each row is only parsed once and the datums are decoded column by column. A nullptr in `raw_values`
+/// is a deleted row, and all its columns except the pk handle are filled with default values.
+/// It is only used for the table which is not common handle, whose pk columns never need to be decoded from value.
+bool appendRowsV2ToBlock(
+    const std::vector<const TiKVValue::Base *> & raw_values,
+    SortedColumnIDWithPosConstIter column_ids_iter,
+    SortedColumnIDWithPosConstIter column_ids_iter_end,
+    Block & block,
+    size_t block_column_pos,
+    const DecodingStorageSchemaSnapshotConstPtr & schema_snapshot,
+    bool force_decode);
 
 } // namespace DB
@@ -15,6 +15,7 @@
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
 #include <Storages/Transaction/DatumCodec.h>
 #include <Storages/Transaction/RegionBlockReader.h>
+#include <Storages/Transaction/RowCodec.h>
 #include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 
@@ -109,6 +110,46 @@ protected:
         return reader.read(block, data_list_read, force_decode);
     }
 
+    /// Only decode the values, to compare decoding the rows one by one and in batch.
+    bool decodeValues(DecodingStorageSchemaSnapshotConstPtr decoding_schema, bool in_batch) const
+    {
+        Block block = createBlockSortByColumnID(decoding_schema);
+        // Skip the extra handle, del and version columns
+        constexpr size_t must_have_columns = 3;
+        auto column_ids_iter = std::next(decoding_schema->sorted_column_id_with_pos.begin(), must_have_columns);
+        auto column_ids_iter_end = decoding_schema->sorted_column_id_with_pos.end();
+        if (in_batch)
+        {
+            std::vector<const TiKVValue::Base *> raw_values;
+            raw_values.reserve(data_list_read.size());
+            for (const auto & data : data_list_read)
+                raw_values.push_back(std::get<3>(data).get());
+            return appendRowsV2ToBlock(raw_values, column_ids_iter, column_ids_iter_end, block, must_have_columns, decoding_schema, true);
+        }
+        for (const auto & data : data_list_read)
+        {
+            if (!appendRowToBlock(*std::get<3>(data), column_ids_iter, column_ids_iter_end, block, must_have_columns, decoding_schema, true))
+                return false;
+        }
+        return true;
+    }
+
+    std::pair<TableInfo, std::vector<Field>> getFixedWidthTableInfoFields() const
+    {
+        return getTableInfoAndFields(
+            {EXTRA_HANDLE_COLUMN_ID},
+            false,
+            ColumnIDValue(2, handle_value),
+            ColumnIDValue(3, std::numeric_limits<UInt64>::max()),
+            ColumnIDValue(4, std::numeric_limits<Int32>::min()),
+            ColumnIDValue(5, std::numeric_limits<UInt16>::max()),
+            ColumnIDValue(6, std::numeric_limits<Int8>::min()),
+            ColumnIDValue(7, std::numeric_limits<Float32>::min()),
+            ColumnIDValue(8, std::numeric_limits<Float64>::max()),
+            ColumnIDValueNull<Int64>(9),
+            ColumnIDValueNull<Float64>(10));
+    }
+
     std::pair<TableInfo, std::vector<Field>> getNormalTableInfoFields(const ColumnIDs & handle_ids, bool is_common_handle) const
     {
         return getTableInfoAndFields(
@@ -163,10 +204,38 @@ BENCHMARK_DEFINE_F(RegionBlockReaderBenchTest, PKIsHandle)
     }
 }
 
+BENCHMARK_DEFINE_F(RegionBlockReaderBenchTest, DecodeRowByRow)
+(benchmark::State & state)
+{
+    size_t num_rows = state.range(0);
+    auto [table_info, fields] = getFixedWidthTableInfoFields();
+    encodeColumns(table_info, fields, RowEncodeVersion::RowV2, num_rows);
+    auto decoding_schema = getDecodingStorageSchemaSnapshot(table_info);
+    for (auto _ : state)
+    {
+        decodeValues(decoding_schema, false);
+    }
+}
+
+BENCHMARK_DEFINE_F(RegionBlockReaderBenchTest, DecodeInBatch)
+(benchmark::State & state)
+{
+    size_t num_rows = state.range(0);
+    auto [table_info, fields] = getFixedWidthTableInfoFields();
+    encodeColumns(table_info, fields, RowEncodeVersion::RowV2, num_rows);
+    auto decoding_schema = getDecodingStorageSchemaSnapshot(table_info);
+    for (auto _ : state)
+    {
+        decodeValues(decoding_schema, true);
+    }
+}
+
 constexpr size_t num_iterations_test = 1000;
 
 BENCHMARK_REGISTER_F(RegionBlockReaderBenchTest, PKIsHandle)->Iterations(num_iterations_test)->Arg(1)->Arg(10)->Arg(100);
 BENCHMARK_REGISTER_F(RegionBlockReaderBenchTest, CommonHandle)->Iterations(num_iterations_test)->Arg(1)->Arg(10)->Arg(100);
 BENCHMARK_REGISTER_F(RegionBlockReaderBenchTest, PKIsNotHandle)->Iterations(num_iterations_test)->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK_REGISTER_F(RegionBlockReaderBenchTest, DecodeRowByRow)->Iterations(num_iterations_test)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK_REGISTER_F(RegionBlockReaderBenchTest, DecodeInBatch)->Iterations(num_iterations_test)->Arg(10)->Arg(100)->Arg(1000);
 
 } // namespace DB::tests
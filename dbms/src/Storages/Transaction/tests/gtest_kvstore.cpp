@@ -609,6 +609,57 @@ TEST_F(RegionKVStoreTest, RegionReadWrite)
     }
 }
 
+TEST_F(RegionKVStoreTest, RegionMemory)
+try
+{
+    TableID table_id = 100;
+    auto region = makeRegion(1, RecordKVFormat::genKey(table_id, 0), RecordKVFormat::genKey(table_id, 10000));
+    ASSERT_EQ(region->reservedDataMemory(), 0);
+
+    const size_t rows = 10000;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        region->insert("default", RecordKVFormat::genKey(table_id, i, 5), TiKVValue("value1"));
+        region->insert("write", RecordKVFormat::genKey(table_id, i, 8), RecordKVFormat::encodeWriteCfValue(RecordKVFormat::CFModifyFlag::PutFlag, 5));
+    }
+    const auto inserted_memory = region->reservedDataMemory();
+    ASSERT_GT(inserted_memory, 0);
+
+    {
+        // Most of the committed data is removed, the memory of them is released.
+        std::optional<RegionDataReadInfoList> data_list_read = ReadRegionCommitCache(region, true);
+        ASSERT_TRUE(data_list_read);
+        ASSERT_EQ(rows, data_list_read->size());
+        data_list_read->erase(data_list_read->begin() + rows * 9 / 10, data_list_read->end());
+        RemoveRegionCommitCache(region, *data_list_read);
+    }
+    ASSERT_EQ(rows / 10, region->writeCFCount());
+    const auto erased_memory = region->reservedDataMemory();
+    ASSERT_LT(erased_memory, inserted_memory / 4);
+
+    {
+        // Split [9000, 10000) into [9000, 9100) and [9100, 10000), the memory of the moved data is released.
+        auto new_region = splitRegion(region, RegionMeta(createPeer(2, true), createRegionInfo(2, RecordKVFormat::genKey(table_id, 9100), RecordKVFormat::genKey(table_id, 10000)), initialApplyState()));
+        ASSERT_EQ(rows / 100, region->writeCFCount());
+        ASSERT_EQ(rows * 9 / 100, new_region->writeCFCount());
+        ASSERT_GT(region->reservedDataMemory(), 0);
+        ASSERT_LT(region->reservedDataMemory(), erased_memory / 2);
+        ASSERT_GT(new_region->reservedDataMemory(), 0);
+        ASSERT_LE(new_region->reservedDataMemory(), erased_memory);
+    }
+
+    {
+        // All the committed data is removed.
+        std::optional<RegionDataReadInfoList> data_list_read = ReadRegionCommitCache(region, true);
+        ASSERT_TRUE(data_list_read);
+        ASSERT_EQ(rows / 100, data_list_read->size());
+        RemoveRegionCommitCache(region, *data_list_read);
+    }
+    ASSERT_EQ(0, region->writeCFCount());
+    ASSERT_EQ(0, region->reservedDataMemory());
+}
+CATCH
+
 TEST_F(RegionKVStoreTest, Writes)
 {
     createDefaultRegions();
@@ -637,5 +637,47 @@ try
 }
 CATCH
 
+TEST_F(RegionBlockReaderTest, DecodeRowsInBatch)
+try
+{
+    for (const auto & pk_col_ids : std::vector<ColumnIDs>{{EXTRA_HANDLE_COLUMN_ID}, {2}})
+    {
+        SetUp();
+        auto [table_info, fields] = getNormalTableInfoFields(pk_col_ids, false);
+        encodeColumns(table_info, fields, RowEncodeVersion::RowV2);
+        // Insert a deleted row between the rows in row v2
+        const auto pk = std::get<0>(data_list_read.front());
+        data_list_read.emplace(std::next(data_list_read.begin()), pk, Region::DelFlag, version_value, nullptr);
+        auto new_table_info = getTableInfoWithMoreColumns(pk_col_ids, false);
+        auto decoding_schema = getDecodingStorageSchemaSnapshot(new_table_info);
+
+        // All rows are in row v2, they are decoded column by column
+        Block batch_block = createBlockSortByColumnID(decoding_schema);
+        ASSERT_TRUE(RegionBlockReader(decoding_schema).read(batch_block, data_list_read, false));
+        ASSERT_EQ(batch_block.rows(), data_list_read.size());
+
+        // Append a row in row v1, then the rows are decoded one by one
+        WriteBufferFromOwnString value_buf;
+        std::vector<Field> value_fields;
+        for (size_t i = 0; i < table_info.columns.size(); ++i)
+        {
+            if (!table_info.pk_is_handle || !table_info.columns[i].hasPriKeyFlag())
+                value_fields.emplace_back(fields[i]);
+        }
+        encodeRowV1(table_info, value_fields, value_buf);
+        data_list_read.emplace_back(pk, del_mark_value, version_value, std::make_shared<const TiKVValue>(value_buf.releaseStr()));
+        Block row_block = createBlockSortByColumnID(decoding_schema);
+        ASSERT_TRUE(RegionBlockReader(decoding_schema).read(row_block, data_list_read, false));
+        ASSERT_EQ(row_block.rows(), data_list_read.size());
+
+        for (size_t pos = 0; pos < batch_block.columns(); ++pos)
+        {
+            const auto & batch_column = batch_block.getByPosition(pos);
+            auto row_column = row_block.getByPosition(pos).column->cut(0, batch_block.rows());
+            ASSERT_COLUMN_EQ(batch_column, ColumnWithTypeAndName(std::move(row_column), batch_column.type, batch_column.name));
+        }
+    }
+}
+CATCH
 
 } // namespace DB::tests
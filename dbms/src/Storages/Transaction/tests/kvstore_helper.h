@@ -170,6 +170,11 @@ protected:
     static void testRaftMerge(KVStore & kvs, TMTContext & tmt);
     static void testRaftMergeRollback(KVStore & kvs, TMTContext & tmt);
 
+    static RegionPtr splitRegion(const RegionPtr & region, RegionMeta && meta)
+    {
+        return region->splitInto(std::move(meta));
+    }
+
     static std::unique_ptr<PathPool> createCleanPathPool(const String & path)
     {
         // Drop files on disk
@@ -12,13 +12,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <DataTypes/DataTypeString.h>
 #include <Debug/MockTiDB.h>
 #include <Debug/dbgFuncCoprocessorUtils.h>
 #include <Debug/dbgQueryCompiler.h>
+#include <Flash/Coprocessor/DAGCodec.h>
 #include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Coprocessor/DAGExpressionAnalyzer.h>
 #include <Flash/Coprocessor/DAGQueryInfo.h>
 #include <Flash/Coprocessor/DAGQuerySource.h>
+#include <Flash/Coprocessor/DAGUtils.h>
 #include <Flash/Coprocessor/InterpreterUtils.h>
 #include <Functions/registerFunctions.h>
 #include <Interpreters/Context.h>
@@ -564,5 +567,62 @@ try
 }
 CATCH
 
+// The strings are filtered by the bloom filter index only if the comparison is under binary collation,
+// no matter what the collation of the column is.
+TEST_F(FilterParserTest, StringCollation)
+try
+{
+    DM::ColumnDefines columns_to_read{DM::ColumnDefine(2, "col_2", std::make_shared<DataTypeString>())};
+    TiDB::ColumnInfo column_info;
+    column_info.id = 2;
+    column_info.name = "col_2";
+    column_info.tp = TiDB::TypeVarchar;
+    // DAGQueryInfo keeps the references of them.
+    const ColumnInfos source_columns{column_info};
+    const google::protobuf::RepeatedPtrField<tipb::Expr> pushed_down_filters{};
+    const std::vector<int> runtime_filter_ids{};
+    auto create_attr_by_column_id = [&columns_to_read](ColumnID) -> DM::Attr {
+        return DM::Attr{.col_name = columns_to_read[0].name, .col_id = columns_to_read[0].id, .type = columns_to_read[0].type};
+    };
+
+    auto parse = [&](tipb::ScalarFuncSig sig, Int32 column_collation, Int32 compare_collation) {
+        tipb::Expr column_ref;
+        column_ref.set_tp(tipb::ExprType::ColumnRef);
+        WriteBufferFromOwnString ss;
+        encodeDAGInt64(/*column_index*/ 0, ss);
+        column_ref.set_val(ss.releaseStr());
+        column_ref.mutable_field_type()->set_tp(TiDB::TypeVarchar);
+        column_ref.mutable_field_type()->set_collate(column_collation);
+
+        google::protobuf::RepeatedPtrField<tipb::Expr> conditions;
+        auto * expr = conditions.Add();
+        expr->set_tp(tipb::ExprType::ScalarFunc);
+        expr->set_sig(sig);
+        expr->mutable_field_type()->set_tp(TiDB::TypeLongLong);
+        expr->mutable_field_type()->set_collate(compare_collation);
+        *expr->add_children() = column_ref;
+        *expr->add_children() = constructStringLiteralTiExpr("abc");
+        if (sig == tipb::ScalarFuncSig::InString)
+            *expr->add_children() = constructStringLiteralTiExpr("abd");
+
+        DAGQueryInfo dag_query(conditions, pushed_down_filters, source_columns, runtime_filter_ids, 0, default_timezone_info);
+        return DM::FilterParser::parseDAGQuery(dag_query, columns_to_read, create_attr_by_column_id, log)->name();
+    };
+
+    // The collation ids of the new collation framework are negative in tipb.
+    const Int32 binary = -TiDB::ITiDBCollator::BINARY;
+    const Int32 general_ci = -TiDB::ITiDBCollator::UTF8MB4_GENERAL_CI;
+    const Int32 utf8mb4_bin = -TiDB::ITiDBCollator::UTF8MB4_BIN;
+    EXPECT_EQ(parse(tipb::ScalarFuncSig::EQString, binary, binary), "equal");
+    EXPECT_EQ(parse(tipb::ScalarFuncSig::InString, binary, binary), "in");
+    EXPECT_EQ(parse(tipb::ScalarFuncSig::EQString, general_ci, binary), "equal");
+    // `col = 'abc'` is true for 'ABC' under general_ci, which the bloom filter of the binary content can not tell.
+    EXPECT_EQ(parse(tipb::ScalarFuncSig::EQString, binary, general_ci), "unsupported");
+    EXPECT_EQ(parse(tipb::ScalarFuncSig::InString, binary, general_ci), "unsupported");
+    // `col = 'abc'` is true for 'abc ' under the padding binary collations.
+    EXPECT_EQ(parse(tipb::ScalarFuncSig::EQString, binary, utf8mb4_bin), "unsupported");
+}
+CATCH
+
 } // namespace tests
 } // namespace DB